@@ -0,0 +1,66 @@
+//
+//  AssetChunkIndex.cpp
+//  assignment-client/src/assets
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkIndex.h"
+
+void AssetChunkIndex::addAsset(const AssetUtils::AssetHash& assetHash, const char* data, AssetUtils::DataOffset size) {
+    if (hasAsset(assetHash)) {
+        return;
+    }
+
+    // chunking hashes the whole asset, so it's done before taking the lock
+    auto chunks = AssetUtils::chunkContent(data, size);
+
+    QMutexLocker lock(&_mutex);
+    if (_assetChunks.contains(assetHash)) {
+        return;
+    }
+    for (const auto& chunk : chunks) {
+        // a chunk already found in another asset stays where it is
+        if (!_chunks.contains(chunk.hash)) {
+            _chunks.insert(chunk.hash, { assetHash, chunk.offset, chunk.size });
+        }
+    }
+    _assetChunks.insert(assetHash, std::move(chunks));
+}
+
+void AssetChunkIndex::removeAsset(const AssetUtils::AssetHash& assetHash) {
+    QMutexLocker lock(&_mutex);
+    auto it = _assetChunks.find(assetHash);
+    if (it == _assetChunks.end()) {
+        return;
+    }
+
+    // a chunk that other assets share is forgotten with the asset it was found in, it only costs an upload of the
+    // chunk the next time it is needed
+    for (const auto& chunk : it.value()) {
+        auto chunkIt = _chunks.find(chunk.hash);
+        if (chunkIt != _chunks.end() && chunkIt->assetHash == assetHash) {
+            _chunks.erase(chunkIt);
+        }
+    }
+    _assetChunks.erase(it);
+}
+
+bool AssetChunkIndex::hasAsset(const AssetUtils::AssetHash& assetHash) const {
+    QMutexLocker lock(&_mutex);
+    return _assetChunks.contains(assetHash);
+}
+
+bool AssetChunkIndex::find(const QByteArray& chunkHash, Location& location) const {
+    QMutexLocker lock(&_mutex);
+    auto it = _chunks.find(chunkHash);
+    if (it == _chunks.end()) {
+        return false;
+    }
+    location = it.value();
+    return true;
+}
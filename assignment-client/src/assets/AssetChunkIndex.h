@@ -0,0 +1,46 @@
+//
+//  AssetChunkIndex.h
+//  assignment-client/src/assets
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AssetChunkIndex_h
+#define overte_AssetChunkIndex_h
+
+#include <QtCore/QByteArray>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+
+#include <AssetChunking.h>
+#include <AssetUtils.h>
+
+// Where the content-defined chunks of the stored assets can be found, so that a delta upload only has to carry the
+// chunks the asset server doesn't have yet. The assets themselves stay whole files, a chunk is read back out of
+// whichever stored asset it was found in.
+class AssetChunkIndex {
+public:
+    struct Location {
+        AssetUtils::AssetHash assetHash;
+        AssetUtils::DataOffset offset;
+        AssetUtils::DataOffset size;
+    };
+
+    // Chunks the asset and indexes its chunks, if it isn't indexed yet
+    void addAsset(const AssetUtils::AssetHash& assetHash, const char* data, AssetUtils::DataOffset size);
+    void removeAsset(const AssetUtils::AssetHash& assetHash);
+
+    bool hasAsset(const AssetUtils::AssetHash& assetHash) const;
+    bool find(const QByteArray& chunkHash, Location& location) const;
+
+private:
+    mutable QMutex _mutex;
+    QHash<QByteArray, Location> _chunks;
+    QHash<AssetUtils::AssetHash, AssetUtils::ContentChunks> _assetChunks;
+};
+
+#endif // overte_AssetChunkIndex_h
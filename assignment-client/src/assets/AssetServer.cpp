@@ -25,6 +25,7 @@
 #include <QtCore/QJsonDocument>
 #include <QtCore/QSaveFile>
 #include <QtCore/QString>
+#include <QtCore/QThread>
 #include <QtGui/QImageReader>
 #include <QtCore/QVector>
 #include <QtCore/QUrlQuery>
@@ -37,6 +38,7 @@
 
 #include "AssetServerLogging.h"
 #include "BakeAssetTask.h"
+#include "IndexAssetChunksTask.h"
 #include "SendAssetTask.h"
 #include "UploadAssetTask.h"
 
@@ -113,24 +115,121 @@ QString getBakeMapping(const AssetUtils::AssetHash& hash, const QString& relativ
 
 const QString ASSET_SERVER_LOGGING_TARGET_NAME = "asset-server";
 
+// Bakes of smaller assets go first, one step of priority per doubling of the size. These priorities are all negative,
+// a bake of an asset that was asked for is moved above all of them.
+static int bakePriorityForSize(qint64 size) {
+    int priority = -1;
+    while (size > 1) {
+        size >>= 1;
+        --priority;
+    }
+    return priority;
+}
+
+static const int REQUESTED_BAKE_PRIORITY_BOOST = 1000;
+
 void AssetServer::bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) {
     qDebug() << "Starting bake for: " << assetPath << assetHash;
     auto it = _pendingBakes.find(assetHash);
     if (it == _pendingBakes.end()) {
         auto task = std::make_shared<BakeAssetTask>(assetHash, assetPath, filePath);
         task->setAutoDelete(false);
+        task->setPriority(bakePriorityForSize(QFileInfo(filePath).size()));
         _pendingBakes[assetHash] = task;
 
         connect(task.get(), &BakeAssetTask::bakeComplete, this, &AssetServer::handleCompletedBake);
         connect(task.get(), &BakeAssetTask::bakeFailed, this, &AssetServer::handleFailedBake);
         connect(task.get(), &BakeAssetTask::bakeAborted, this, &AssetServer::handleAbortedBake);
 
-        _bakingTaskPool.start(task.get());
+        updateBakingConcurrency();
+        _bakingTaskPool.start(task.get(), task->getPriority());
     } else {
         qDebug() << "Already in queue";
     }
 }
 
+void AssetServer::prioritizeBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end() || it.value()->getPriority() > 0) {
+        return;
+    }
+
+    // only a bake that hasn't started yet can be moved up the queue
+    auto& task = it.value();
+    if (_bakingTaskPool.tryTake(task.get())) {
+        qDebug() << "Moving bake of" << assetHash << "up the queue";
+        task->setPriority(task->getPriority() + REQUESTED_BAKE_PRIORITY_BOOST);
+        _bakingTaskPool.start(task.get(), task->getPriority());
+    }
+}
+
+void AssetServer::removePendingBake(const AssetUtils::AssetHash& assetHash) {
+    auto it = _pendingBakes.find(assetHash);
+    if (it == _pendingBakes.end()) {
+        return;
+    }
+
+    auto startTime = it.value()->getStartTime();
+    if (startTime > 0) {
+        auto now = usecTimestampNow();
+        auto queuedTime = it.value()->getQueuedTime();
+
+        ++_bakeStats.numBakes;
+        _bakeStats.totalWaitUsecs += startTime - queuedTime;
+        _bakeStats.totalBakeUsecs += now - startTime;
+        _bakeStats.maxLatencyUsecs = std::max(_bakeStats.maxLatencyUsecs, now - queuedTime);
+        ++_numCompletedBakes;
+    }
+
+    _pendingBakes.erase(it);
+    updateBakingConcurrency();
+}
+
+// the memory the system can still hand out, which getMemoryInfo doesn't give on Linux
+static bool getAvailableMemoryBytes(uint64_t& availableBytes) {
+#if defined(Q_OS_LINUX)
+    QFile meminfo("/proc/meminfo");
+    if (!meminfo.open(QIODevice::ReadOnly)) {
+        return false;
+    }
+    for (const auto& line : meminfo.readAll().split('\n')) {
+        if (line.startsWith("MemAvailable:")) {
+            // given in kB
+            availableBytes = line.mid(line.indexOf(':') + 1).trimmed().split(' ').first().toULongLong() * 1024;
+            return true;
+        }
+    }
+    return false;
+#else
+    MemoryInfo memoryInfo;
+    if (!getMemoryInfo(memoryInfo)) {
+        return false;
+    }
+    availableBytes = memoryInfo.availMemoryBytes;
+    return true;
+#endif
+}
+
+void AssetServer::updateBakingConcurrency() {
+    // each bake runs in an oven that spreads it over threads of its own, and a large model can take a lot of memory
+    static const int CORES_PER_BAKE = 2;
+    static const uint64_t MEMORY_PER_BAKE_BYTES = 1024ULL * 1024 * 1024;
+
+    int maxBakes = std::max(1, QThread::idealThreadCount() / CORES_PER_BAKE);
+
+    uint64_t availableMemoryBytes;
+    if (getAvailableMemoryBytes(availableMemoryBytes)) {
+        // the bakes already running have taken their memory out of what is available
+        auto memoryLimit = _bakingTaskPool.activeThreadCount() + (int)(availableMemoryBytes / MEMORY_PER_BAKE_BYTES);
+        maxBakes = std::max(1, std::min(maxBakes, memoryLimit));
+    }
+
+    if (maxBakes != _bakingTaskPool.maxThreadCount()) {
+        qCDebug(asset_server) << "Baking up to" << maxBakes << "assets at once";
+        _bakingTaskPool.setMaxThreadCount(maxBakes);
+    }
+}
+
 QString AssetServer::getPathToAssetHash(const AssetUtils::AssetHash& assetHash) {
     return _filesDirectory.absoluteFilePath(assetHash);
 }
@@ -304,11 +403,13 @@ AssetServer::AssetServer(ReceivedMessage& message) :
     // so the ideal is greater than the number of cores on the system.
     static const int TASK_POOL_THREAD_COUNT = 50;
     _transferTaskPool.setMaxThreadCount(TASK_POOL_THREAD_COUNT);
-    _bakingTaskPool.setMaxThreadCount(1);
+    updateBakingConcurrency();
 
     // Queue all requests until the Asset Server is fully setup
     auto& packetReceiver = DependencyManager::get<NodeList>()->getPacketReceiver();
-    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload, PacketType::AssetMappingOperation },
+    packetReceiver.registerListenerForTypes({ PacketType::AssetGet, PacketType::AssetGetInfo, PacketType::AssetUpload,
+                                              PacketType::AssetChunkQuery, PacketType::AssetDeltaUpload,
+                                              PacketType::AssetMappingOperation },
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::queueRequests));
 
 #ifdef Q_OS_WIN
@@ -330,6 +431,9 @@ void AssetServer::aboutToFinish() {
 
     // remove pending transfer tasks
     _transferTaskPool.clear();
+    if (_chunkIndexingTask) {
+        _chunkIndexingTask->abort();
+    }
 
     // abort each of our still running bake tasks, remove pending bakes that were never put on the thread pool
     auto it = _pendingBakes.begin();
@@ -427,6 +531,8 @@ void AssetServer::completeSetup() {
         return;
     }
 
+    _mappedAssets.setFilesDirectory(_filesDirectory);
+
     // load whatever mappings we currently have from the local file
     if (loadMappingsFromFile()) {
         qCInfo(asset_server) << "Serving files from: " << _filesDirectory.path();
@@ -447,6 +553,12 @@ void AssetServer::completeSetup() {
         nodeList->addSetOfNodeTypesToNodeInterestSet({ NodeType::Agent, NodeType::EntityScriptServer });
 
         bakeAssets();
+
+        // delta uploads can reuse the chunks of the assets that are left, indexing them runs behind the transfers
+        static const int CHUNK_INDEXING_TASK_PRIORITY = -1;
+        _chunkIndexingTask.reset(new IndexAssetChunksTask(_filesDirectory.entryList(QDir::Files).filter(hashFileRegex),
+                                                          _filesDirectory, _chunkIndex));
+        _transferTaskPool.start(_chunkIndexingTask.get(), CHUNK_INDEXING_TASK_PRIORITY);
     } else {
         qCCritical(asset_server) << "Asset Server assignment will not continue because mapping file could not be loaded.";
         setFinished(true);
@@ -473,6 +585,10 @@ void AssetServer::completeSetup() {
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetGetInfo));
     packetReceiver.registerListener(PacketType::AssetUpload,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload));
+    packetReceiver.registerListener(PacketType::AssetChunkQuery,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetChunkQuery));
+    packetReceiver.registerListener(PacketType::AssetDeltaUpload,
+        PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetUpload));
     packetReceiver.registerListener(PacketType::AssetMappingOperation,
         PacketReceiver::makeSourcedListenerReference<AssetServer>(this, &AssetServer::handleAssetMappingOperation));
 
@@ -512,8 +628,12 @@ void AssetServer::replayRequests() {
                 handleAssetGetInfo(request.first, request.second);
                 break;
             case PacketType::AssetUpload:
+            case PacketType::AssetDeltaUpload:
                 handleAssetUpload(request.first, request.second);
                 break;
+            case PacketType::AssetChunkQuery:
+                handleAssetChunkQuery(request.first, request.second);
+                break;
             case PacketType::AssetMappingOperation:
                 handleAssetMappingOperation(request.first, request.second);
                 break;
@@ -543,6 +663,8 @@ void AssetServer::cleanupUnmappedFiles() {
             }
             if (!matched) {
                 // remove the unmapped file
+                _mappedAssets.remove(filename);
+                _chunkIndex.removeAsset(filename);
                 QFile removeableFile { fileInfo.absoluteFilePath() };
 
                 if (removeableFile.remove()) {
@@ -646,6 +768,9 @@ void AssetServer::handleGetMappingOperation(ReceivedMessage& message, NLPacketLi
 
         // check if we should re-direct to a baked asset
         auto originalAssetHash = it->second;
+
+        // someone is waiting on this asset, if it is still to be baked that goes first
+        prioritizeBake(originalAssetHash);
         QString redirectedAssetHash;
         quint8 wasRedirected = false;
         bool bakingDisabled = false;
@@ -874,7 +999,7 @@ void AssetServer::handleAssetGet(QSharedPointer<ReceivedMessage> message, Shared
     }
 
     // Queue task
-    auto task = new SendAssetTask(message, senderNode, _filesDirectory);
+    auto task = new SendAssetTask(message, senderNode, _filesDirectory, _mappedAssets);
     _transferTaskPool.start(task);
 }
 
@@ -888,7 +1013,7 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     if (canWriteToAssetServer) {
         qCDebug(asset_server) << "Starting an UploadAssetTask for upload from" << message->getSourceID();
 
-        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit);
+        auto task = new UploadAssetTask(message, senderNode, _filesDirectory, _filesizeLimit, _mappedAssets, _chunkIndex);
         _transferTaskPool.start(task);
     } else {
         // this is a node the domain told us is not allowed to rez entities
@@ -914,6 +1039,54 @@ void AssetServer::handleAssetUpload(QSharedPointer<ReceivedMessage> message, Sha
     }
 }
 
+void AssetServer::handleAssetChunkQuery(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    auto minSize = qint64(sizeof(MessageID) + sizeof(uint64_t) + sizeof(uint32_t));
+
+    if (message->getSize() < minSize) {
+        qCDebug(asset_server) << "ERROR bad chunk query";
+        return;
+    }
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    uint64_t fileSize;
+    message->readPrimitive(&fileSize);
+
+    uint32_t numChunks;
+    message->readPrimitive(&numChunks);
+
+    if (message->getBytesLeftToRead() < qint64(numChunks) * qint64(AssetUtils::SHA256_HASH_LENGTH)) {
+        qCDebug(asset_server) << "ERROR bad chunk query";
+        return;
+    }
+
+    auto replyPacket = NLPacketList::create(PacketType::AssetChunkQueryReply, QByteArray(), true, true);
+    replyPacket->writePrimitive(messageID);
+
+    if (senderNode && !senderNode->getCanWriteToAssetServer()) {
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::PermissionDenied);
+    } else if (fileSize > _filesizeLimit) {
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
+    } else {
+        // tell the client which of its chunks it doesn't have to send
+        replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
+
+        AssetChunkIndex::Location location;
+        for (uint32_t i = 0; i < numChunks; ++i) {
+            uint8_t isStored = _chunkIndex.find(message->read(AssetUtils::SHA256_HASH_LENGTH), location) ? 1 : 0;
+            replyPacket->writePrimitive(isStored);
+        }
+    }
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    if (senderNode) {
+        nodeList->sendPacketList(std::move(replyPacket), *senderNode);
+    } else {
+        nodeList->sendPacketList(std::move(replyPacket), message->getSenderSockAddr());
+    }
+}
+
 void AssetServer::sendStatsPacket() {
     QJsonObject serverStats;
 
@@ -967,6 +1140,31 @@ void AssetServer::sendStatsPacket() {
         serverStats[uuid] = nodeStats;
     });
 
+    {
+        int numBaking = 0;
+        for (const auto& task : _pendingBakes) {
+            if (task->isBaking()) {
+                ++numBaking;
+            }
+        }
+
+        static const float USECS_PER_MSEC = 1000.0f;
+        auto numBakes = std::max(_bakeStats.numBakes, 1);
+
+        QJsonObject bakingStats;
+        bakingStats["1. Queued"] = _pendingBakes.size() - numBaking;
+        bakingStats["2. Baking"] = numBaking;
+        bakingStats["3. Max Concurrent"] = _bakingTaskPool.maxThreadCount();
+        bakingStats["4. Completed"] = _numCompletedBakes;
+        bakingStats["5. Avg Wait (ms)"] = (float)_bakeStats.totalWaitUsecs / numBakes / USECS_PER_MSEC;
+        bakingStats["6. Avg Bake (ms)"] = (float)_bakeStats.totalBakeUsecs / numBakes / USECS_PER_MSEC;
+        bakingStats["7. Max Latency (ms)"] = (float)_bakeStats.maxLatencyUsecs / USECS_PER_MSEC;
+        serverStats["Baking"] = bakingStats;
+
+        // the averages are over the bakes since the last stats packet
+        _bakeStats = BakeStats();
+    }
+
     // send off the stats packets
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(serverStats);
 }
@@ -1180,6 +1378,8 @@ bool AssetServer::deleteMappings(const AssetUtils::AssetPathList& paths) {
         // we now have a set of hashes that are unmapped - we will delete those asset files
         for (auto& hash : hashesToCheckForDeletion) {
             // remove the unmapped file
+            _mappedAssets.remove(hash);
+            _chunkIndex.removeAsset(hash);
             QFile removeableFile { _filesDirectory.absoluteFilePath(hash) };
 
             if (removeableFile.remove()) {
@@ -1319,7 +1519,7 @@ void AssetServer::handleFailedBake(QString originalAssetHash, QString assetPath,
 
     writeMetaFile(originalAssetHash, meta);
 
-    _pendingBakes.remove(originalAssetHash);
+    removePendingBake(originalAssetHash);
 }
 
 void AssetServer::handleCompletedBake(QString originalAssetHash, QString originalAssetPath,
@@ -1342,7 +1542,7 @@ void AssetServer::handleCompletedBake(QString originalAssetHash, QString origina
 
         writeMetaFile(originalAssetHash, meta);
 
-        _pendingBakes.remove(originalAssetHash);
+        removePendingBake(originalAssetHash);
     };
 
     bool errorCompletingBake { false };
@@ -1475,7 +1675,7 @@ void AssetServer::handleAbortedBake(QString originalAssetHash, QString assetPath
     qDebug() << "Aborted bake:" << originalAssetHash;
 
     // for an aborted bake we don't do anything but remove the BakeAssetTask from our pending bakes
-    _pendingBakes.remove(originalAssetHash);
+    removePendingBake(originalAssetHash);
 }
 
 static const QString BAKE_VERSION_KEY = "bake_version";
@@ -12,6 +12,8 @@
 #ifndef hifi_AssetServer_h
 #define hifi_AssetServer_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QSharedPointer>
 #include <QtCore/QThreadPool>
@@ -19,7 +21,10 @@
 
 #include <ThreadedAssignment.h>
 
+#include "AssetChunkIndex.h"
 #include "AssetUtils.h"
+#include "IndexAssetChunksTask.h"
+#include "MappedAssetCache.h"
 #include "ReceivedMessage.h"
 
 #include "RegisteredMetaTypes.h"
@@ -88,6 +93,7 @@ private slots:
     void handleAssetGetInfo(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetGet(QSharedPointer<ReceivedMessage> packet, SharedNodePointer senderNode);
     void handleAssetUpload(QSharedPointer<ReceivedMessage> packetList, SharedNodePointer senderNode);
+    void handleAssetChunkQuery(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetMappingOperation(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void sendStatsPacket() override;
@@ -137,6 +143,13 @@ private:
     bool needsToBeBaked(const AssetUtils::AssetPath& path, const AssetUtils::AssetHash& assetHash);
     void bakeAsset(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath);
 
+    /// Move the bake of an asset someone is waiting on ahead of the other queued bakes
+    void prioritizeBake(const AssetUtils::AssetHash& assetHash);
+    void removePendingBake(const AssetUtils::AssetHash& assetHash);
+
+    /// Fit the number of bakes running at once to the cores and the memory available
+    void updateBakingConcurrency();
+
     /// Move baked content for asset to baked directory and update baked status
     void handleCompletedBake(QString originalAssetHash, QString assetPath, QString bakedTempOutputDir);
     void handleFailedBake(QString originalAssetHash, QString assetPath, QString errors);
@@ -154,12 +167,28 @@ private:
     QDir _resourcesDirectory;
     QDir _filesDirectory;
 
+    /// Mappings of recently sent asset files, shared by the send tasks
+    MappedAssetCache _mappedAssets;
+
+    /// Chunks of the stored assets that delta uploads can reuse
+    AssetChunkIndex _chunkIndex;
+    std::unique_ptr<IndexAssetChunksTask> _chunkIndexingTask;
+
     /// Task pool for handling uploads and downloads of assets
     QThreadPool _transferTaskPool;
 
     QHash<AssetUtils::AssetHash, std::shared_ptr<BakeAssetTask>> _pendingBakes;
     QThreadPool _bakingTaskPool;
 
+    struct BakeStats {
+        int numBakes { 0 };
+        quint64 totalWaitUsecs { 0 };
+        quint64 totalBakeUsecs { 0 };
+        quint64 maxLatencyUsecs { 0 };
+    };
+    BakeStats _bakeStats;
+    int _numCompletedBakes { 0 };
+
     QMutex _queuedRequestsMutex;
     bool _isQueueingRequests { true };
     using RequestQueue = QVector<QPair<QSharedPointer<ReceivedMessage>, SharedNodePointer>>;
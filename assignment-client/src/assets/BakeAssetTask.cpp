@@ -13,21 +13,61 @@
 
 #include <mutex>
 
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 #include <QtCore/QThread>
 #include <QCoreApplication>
 
 #include <PathUtils.h>
+#include <SharedUtil.h>
 
 static const int OVEN_STATUS_CODE_SUCCESS { 0 };
 static const int OVEN_STATUS_CODE_FAIL { 1 };
 static const int OVEN_STATUS_CODE_ABORT { 2 };
 
+static const QString OVEN_WORKER_OPTION = "--worker";
+static const QString OVEN_BAKE_RESULT_PREFIX = "OVEN_BAKE_RESULT";
+
+// a worker is started over after this many bakes, so that whatever a bake leaves behind in it doesn't pile up
+static const int MAX_BAKES_PER_OVEN_WORKER = 16;
+static const int OVEN_WORKER_EXIT_TIMEOUT_MSECS = 5000;
+
+// Each baking thread keeps an oven running and sends it one bake after another, only the first bake on the thread
+// pays for starting the oven. It goes away with the thread when the pool lets the thread expire.
+static thread_local std::unique_ptr<QProcess> ovenWorker;
+static thread_local int ovenWorkerBakeCount { 0 };
+
+static void startOvenWorker() {
+    if (ovenWorker) {
+        // stopping reading jobs, the worker exits
+        ovenWorker->closeWriteChannel();
+        if (!ovenWorker->waitForFinished(OVEN_WORKER_EXIT_TIMEOUT_MSECS)) {
+            ovenWorker->kill();
+            ovenWorker->waitForFinished();
+        }
+        ovenWorker.reset();
+    }
+
+    auto base = QFileInfo(QCoreApplication::applicationFilePath()).absoluteDir();
+    QString path = base.absolutePath() + "/oven";
+
+    std::unique_ptr<QProcess> process { new QProcess() };
+    process->setStandardErrorFile(QProcess::nullDevice());
+    process->start(path, { OVEN_WORKER_OPTION });
+    qDebug() << "Running:" << path << OVEN_WORKER_OPTION;
+    if (process->waitForStarted()) {
+        ovenWorker = std::move(process);
+        ovenWorkerBakeCount = 0;
+    }
+}
+
 std::once_flag registerMetaTypesFlag;
 
 BakeAssetTask::BakeAssetTask(const AssetUtils::AssetHash& assetHash, const AssetUtils::AssetPath& assetPath, const QString& filePath) :
     _assetHash(assetHash),
     _assetPath(assetPath),
-    _filePath(filePath)
+    _filePath(filePath),
+    _queuedTime(usecTimestampNow())
 {
 
     std::call_once(registerMetaTypesFlag, []() {
@@ -41,6 +81,13 @@ void BakeAssetTask::run() {
         qWarning() << "Tried to start bake asset task while already baking";
         return;
     }
+    _startTime.store(usecTimestampNow());
+
+    if (_abortRequested) {
+        _wasAborted = true;
+        emit bakeAborted(_assetHash, _assetPath);
+        return;
+    }
 
     // Make a new temporary directory for the Oven to work in
     QString tempOutputDir = PathUtils::generateTemporaryDir();
@@ -63,34 +110,37 @@ void BakeAssetTask::run() {
         return;
     }
 
-    auto base = QFileInfo(QCoreApplication::applicationFilePath()).absoluteDir();
-    QString path = base.absolutePath() + "/oven";
+    if (!ovenWorker || ovenWorker->state() != QProcess::Running || ovenWorkerBakeCount >= MAX_BAKES_PER_OVEN_WORKER) {
+        startOvenWorker();
+    }
+    if (!ovenWorker) {
+        PathUtils::deleteMyTemporaryDir(tempOutputDirName);
+
+        QString errors = "Oven process failed to start";
+        emit bakeFailed(_assetHash, _assetPath, errors);
+        return;
+    }
+    ++ovenWorkerBakeCount;
+    _ovenProcess = ovenWorker.get();
+
     QString extension = _assetPath.mid(_assetPath.lastIndexOf('.') + 1);
-    QStringList args {
-        "-i", tempAssetPath,
-        "-o", tempOutputDir,
-        "-t", extension,
+    QJsonObject job {
+        { "input", tempAssetPath },
+        { "output", tempOutputDir },
+        { "type", extension }
     };
 
-    _ovenProcess.reset(new QProcess());
-
     QEventLoop loop;
 
-    connect(_ovenProcess.get(), static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
-            this, [&loop, this, tempOutputDir, tempAssetPath, tempOutputDirName](int exitCode, QProcess::ExitStatus exitStatus) {
-        qDebug() << "Baking process finished: " << exitCode << exitStatus;
+    // the worker outlives this bake, the connections go with this context
+    QObject bakeContext;
 
-        if (exitStatus == QProcess::CrashExit) {
-            PathUtils::deleteMyTemporaryDir(tempOutputDirName);
-            if (_wasAborted) {
-                emit bakeAborted(_assetHash, _assetPath);
-            } else {
-                QString errors = "Fatal error occurred while baking";
-                emit bakeFailed(_assetHash, _assetPath, errors);
-            }
-        } else if (exitCode == OVEN_STATUS_CODE_SUCCESS) {
+    auto handleResult = [&loop, this, tempOutputDir, tempOutputDirName](int exitCode) {
+        qDebug() << "Baking finished: " << exitCode;
+
+        if (exitCode == OVEN_STATUS_CODE_SUCCESS) {
             emit bakeComplete(_assetHash, _assetPath, tempOutputDir);
-        } else if (exitStatus == QProcess::NormalExit && exitCode == OVEN_STATUS_CODE_ABORT) {
+        } else if (exitCode == OVEN_STATUS_CODE_ABORT) {
             _wasAborted.store(true);
             PathUtils::deleteMyTemporaryDir(tempOutputDirName);
             emit bakeAborted(_assetHash, _assetPath);
@@ -112,31 +162,71 @@ void BakeAssetTask::run() {
         }
 
         loop.quit();
+    };
+
+    connect(_ovenProcess, &QProcess::readyReadStandardOutput, &bakeContext, [this, handleResult] {
+        // the oven logs to stdout as well, only the result line is of interest
+        while (_ovenProcess->canReadLine()) {
+            auto line = QString::fromUtf8(_ovenProcess->readLine()).trimmed();
+            if (line.startsWith(OVEN_BAKE_RESULT_PREFIX)) {
+                handleResult(line.mid(OVEN_BAKE_RESULT_PREFIX.length()).trimmed().toInt());
+                return;
+            }
+        }
     });
 
-    qDebug() << "Starting oven for " << _assetPath;
-    _ovenProcess->start(path, args, QIODevice::ReadOnly);
-    qDebug() << "Running:" << path << args;
-    if (!_ovenProcess->waitForStarted()) {
+    connect(_ovenProcess, static_cast<void(QProcess::*)(int, QProcess::ExitStatus)>(&QProcess::finished),
+            &bakeContext, [&loop, this, tempOutputDirName](int exitCode, QProcess::ExitStatus exitStatus) {
+        qDebug() << "Oven process finished while baking: " << exitCode << exitStatus;
+
         PathUtils::deleteMyTemporaryDir(tempOutputDirName);
+        if (_wasAborted) {
+            emit bakeAborted(_assetHash, _assetPath);
+        } else {
+            QString errors = "Fatal error occurred while baking";
+            emit bakeFailed(_assetHash, _assetPath, errors);
+        }
 
-        QString errors = "Oven process failed to start";
-        emit bakeFailed(_assetHash, _assetPath, errors);
-        return;
+        loop.quit();
+    });
+
+    {
+        // from here on an abort is handed to this thread, which the oven process belongs to
+        std::lock_guard<std::mutex> lock(_bakeContextMutex);
+        _bakeContext = &bakeContext;
+    }
+    if (_abortRequested) {
+        terminateOvenProcess();
     }
 
-    _isBaking = true;
+    qDebug() << "Sending bake of" << _assetPath << "to the oven";
+    _ovenProcess->write(QJsonDocument(job).toJson(QJsonDocument::Compact) + "\n");
 
     loop.exec();
+
+    {
+        std::lock_guard<std::mutex> lock(_bakeContextMutex);
+        _bakeContext = nullptr;
+    }
+    _ovenProcess = nullptr;
+    if (_wasAborted || ovenWorker->state() != QProcess::Running) {
+        ovenWorker.reset();
+    }
 }
 
 void BakeAssetTask::abort() {
-    if (QThread::currentThread() != thread()) {
-        QMetaObject::invokeMethod(this, "abort");
-        return;
-    }
     qDebug() << "Aborting BakeAssetTask for" << _assetHash;
-    if (_ovenProcess->state() != QProcess::NotRunning) {
+    _abortRequested = true;
+
+    // the oven process is only touched on the thread baking with it
+    std::lock_guard<std::mutex> lock(_bakeContextMutex);
+    if (_bakeContext) {
+        QMetaObject::invokeMethod(_bakeContext, [this] { terminateOvenProcess(); }, Qt::QueuedConnection);
+    }
+}
+
+void BakeAssetTask::terminateOvenProcess() {
+    if (_ovenProcess && _ovenProcess->state() != QProcess::NotRunning) {
         qDebug() << "Teminating oven process for" << _assetHash;
         _wasAborted = true;
         _ovenProcess->terminate();
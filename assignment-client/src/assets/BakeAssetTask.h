@@ -12,7 +12,9 @@
 #ifndef hifi_BakeAssetTask_h
 #define hifi_BakeAssetTask_h
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 
 #include <QtCore/QDebug>
 #include <QtCore/QObject>
@@ -30,6 +32,12 @@ public:
     // Thread-safe inspection methods
     bool isBaking() { return _isBaking.load(); }
     bool wasAborted() const { return _wasAborted.load(); }
+    quint64 getQueuedTime() const { return _queuedTime; }
+    quint64 getStartTime() const { return _startTime.load(); } // 0 until the bake starts
+
+    // Priority of the bake in the baking task pool, only used by the asset server thread
+    int getPriority() const { return _priority; }
+    void setPriority(int priority) { _priority = priority; }
 
     void run() override;
 
@@ -42,12 +50,20 @@ signals:
     void bakeAborted(QString assetHash, QString assetPath);
     
 private:
+    void terminateOvenProcess(); // on the bake thread
+
     std::atomic<bool> _isBaking { false };
     AssetUtils::AssetHash _assetHash;
     AssetUtils::AssetPath _assetPath;
     QString _filePath;
-    std::unique_ptr<QProcess> _ovenProcess { nullptr };
+    QProcess* _ovenProcess { nullptr }; // the oven worker of the thread, while baking - only used on the bake thread
     std::atomic<bool> _wasAborted { false };
+    std::atomic<bool> _abortRequested { false };
+    std::mutex _bakeContextMutex;
+    QObject* _bakeContext { nullptr }; // lives on the bake thread while baking, aborts are posted to it
+    quint64 _queuedTime;
+    std::atomic<quint64> _startTime { 0 };
+    int _priority { 0 };
 };
 
 #endif // hifi_BakeAssetTask_h
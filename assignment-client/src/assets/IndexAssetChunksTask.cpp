@@ -0,0 +1,57 @@
+//
+//  IndexAssetChunksTask.cpp
+//  assignment-client/src/assets
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "IndexAssetChunksTask.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QFile>
+
+#include "AssetServerLogging.h"
+
+IndexAssetChunksTask::IndexAssetChunksTask(const QStringList& assetHashes, const QDir& filesDirectory,
+                                           AssetChunkIndex& chunkIndex) :
+    _assetHashes(assetHashes),
+    _filesDirectory(filesDirectory),
+    _chunkIndex(chunkIndex)
+{
+    // the asset server holds on to the task so that it can abort it
+    setAutoDelete(false);
+}
+
+void IndexAssetChunksTask::run() {
+    QElapsedTimer timer;
+    timer.start();
+
+    int numIndexed = 0;
+    for (const auto& hash : _assetHashes) {
+        if (_wasAborted.load()) {
+            return;
+        }
+
+        QFile file { _filesDirectory.filePath(hash) };
+        if (!file.open(QIODevice::ReadOnly)) {
+            continue;
+        }
+
+        if (file.size() == 0) {
+            _chunkIndex.addAsset(hash, nullptr, 0);
+        } else if (auto data = file.map(0, file.size())) {
+            _chunkIndex.addAsset(hash, reinterpret_cast<const char*>(data), file.size());
+            file.unmap(data);
+        } else {
+            auto contents = file.readAll();
+            _chunkIndex.addAsset(hash, contents.constData(), contents.size());
+        }
+        ++numIndexed;
+    }
+
+    qCDebug(asset_server) << "Indexed the chunks of" << numIndexed << "assets in" << timer.elapsed() << "ms";
+}
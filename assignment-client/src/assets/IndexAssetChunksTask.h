@@ -0,0 +1,40 @@
+//
+//  IndexAssetChunksTask.h
+//  assignment-client/src/assets
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_IndexAssetChunksTask_h
+#define overte_IndexAssetChunksTask_h
+
+#include <atomic>
+
+#include <QtCore/QDir>
+#include <QtCore/QRunnable>
+#include <QtCore/QStringList>
+
+#include "AssetChunkIndex.h"
+
+// Indexes the chunks of the assets already on disk when the asset server starts, so that delta uploads can reuse them
+class IndexAssetChunksTask : public QRunnable {
+public:
+    IndexAssetChunksTask(const QStringList& assetHashes, const QDir& filesDirectory, AssetChunkIndex& chunkIndex);
+
+    void run() override;
+
+    // Thread-safe, stops the task after the asset it is indexing
+    void abort() { _wasAborted.store(true); }
+
+private:
+    QStringList _assetHashes;
+    QDir _filesDirectory;
+    AssetChunkIndex& _chunkIndex;
+    std::atomic<bool> _wasAborted { false };
+};
+
+#endif // overte_IndexAssetChunksTask_h
@@ -0,0 +1,78 @@
+//
+//  MappedAssetCache.cpp
+//  assignment-client/src/assets
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "MappedAssetCache.h"
+
+#include <QtCore/QFileInfo>
+
+#include "AssetServerLogging.h"
+
+void MappedAssetCache::setFilesDirectory(const QDir& filesDirectory) {
+    QMutexLocker locker(&_mutex);
+    _filesDirectory = filesDirectory;
+    _entries.clear();
+}
+
+MappedAssetPointer MappedAssetCache::get(const QString& hexHash) {
+    QMutexLocker locker(&_mutex);
+
+    QFileInfo fileInfo(_filesDirectory.filePath(hexHash));
+    if (!fileInfo.exists()) {
+        _entries.remove(hexHash);
+        return MappedAssetPointer();
+    }
+
+    auto it = _entries.find(hexHash);
+    if (it != _entries.end()) {
+        const auto& asset = it->asset;
+        if (asset->getSize() == fileInfo.size() && asset->_lastModified == fileInfo.lastModified()) {
+            it->lastUse = ++_useCount;
+            return asset;
+        }
+
+        // the file was replaced, anyone still sending the old one keeps their mapping
+        _entries.erase(it);
+    }
+
+    auto asset = std::shared_ptr<MappedAsset>(new MappedAsset(fileInfo.absoluteFilePath()));
+    if (!asset->_file.open(QIODevice::ReadOnly)) {
+        return MappedAssetPointer();
+    }
+
+    asset->_size = asset->_file.size();
+    asset->_lastModified = fileInfo.lastModified();
+    if (asset->_size > 0) {
+        asset->_data = reinterpret_cast<const char*>(asset->_file.map(0, asset->_size));
+        if (!asset->_data) {
+            qCWarning(asset_server) << "Could not map" << hexHash << "-" << asset->_file.errorString();
+            return MappedAssetPointer();
+        }
+    }
+
+    // evict the least recently used mapping
+    if (_entries.size() >= _maxMappedAssets) {
+        auto leastRecentlyUsed = _entries.begin();
+        for (auto entry = _entries.begin(); entry != _entries.end(); ++entry) {
+            if (entry->lastUse < leastRecentlyUsed->lastUse) {
+                leastRecentlyUsed = entry;
+            }
+        }
+        _entries.erase(leastRecentlyUsed);
+    }
+
+    _entries.insert(hexHash, { asset, ++_useCount });
+    return asset;
+}
+
+void MappedAssetCache::remove(const QString& hexHash) {
+    QMutexLocker locker(&_mutex);
+    _entries.remove(hexHash);
+}
@@ -0,0 +1,74 @@
+//
+//  MappedAssetCache.h
+//  assignment-client/src/assets
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_MappedAssetCache_h
+#define overte_MappedAssetCache_h
+
+#include <memory>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QDir>
+#include <QtCore/QFile>
+#include <QtCore/QHash>
+#include <QtCore/QMutex>
+#include <QtCore/QString>
+
+// An asset file mapped into memory for serving. The mapping stays valid for as long as the asset is held, even if the
+// cache has moved on.
+class MappedAsset {
+public:
+    const char* getData() const { return _data; }
+    qint64 getSize() const { return _size; }
+
+private:
+    friend class MappedAssetCache;
+
+    MappedAsset(const QString& filePath) : _file(filePath) {}
+
+    QFile _file;
+    const char* _data { nullptr };
+    qint64 _size { 0 };
+    QDateTime _lastModified;
+};
+
+using MappedAssetPointer = std::shared_ptr<const MappedAsset>;
+
+// Keeps the most recently requested asset files mapped, so that concurrent and repeated downloads of a hot asset share
+// one mapping and are served from the page cache rather than each reading the file onto the heap.
+class MappedAssetCache {
+public:
+    static const int DEFAULT_MAX_MAPPED_ASSETS = 64;
+
+    MappedAssetCache(int maxMappedAssets = DEFAULT_MAX_MAPPED_ASSETS) : _maxMappedAssets(maxMappedAssets) {}
+
+    void setFilesDirectory(const QDir& filesDirectory);
+
+    // Returns the mapped asset for the hash, or nullptr if the file doesn't exist or can't be mapped.
+    // A file that changed on disk since it was mapped is mapped again.
+    MappedAssetPointer get(const QString& hexHash);
+
+    // Unmaps the asset, ahead of it being deleted
+    void remove(const QString& hexHash);
+
+private:
+    struct Entry {
+        MappedAssetPointer asset;
+        quint64 lastUse;
+    };
+
+    QMutex _mutex;
+    QDir _filesDirectory;
+    QHash<QString, Entry> _entries;
+    quint64 _useCount { 0 };
+    int _maxMappedAssets;
+};
+
+#endif // overte_MappedAssetCache_h
@@ -12,8 +12,7 @@
 #include "SendAssetTask.h"
 
 #include <cmath>
-
-#include <QFile>
+#include <cstring>
 
 #include <DependencyManager.h>
 #include <NetworkLogging.h>
@@ -26,11 +25,13 @@
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
 
-SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode, const QDir& resourcesDir) :
+SendAssetTask::SendAssetTask(QSharedPointer<ReceivedMessage> message, const SharedNodePointer& sendToNode,
+                             const QDir& resourcesDir, MappedAssetCache& mappedAssets) :
     QRunnable(),
     _message(message),
     _senderNode(sendToNode),
-    _resourcesDir(resourcesDir)
+    _resourcesDir(resourcesDir),
+    _mappedAssets(mappedAssets)
 {
     
 }
@@ -63,18 +64,16 @@ void SendAssetTask::run() {
     if (!byteRange.isValid()) {
         replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
     } else {
-        QString filePath = _resourcesDir.filePath(QString(hexHash));
-        
-        QFile file { filePath };
+        auto asset = _mappedAssets.get(hexHash);
 
-        if (file.open(QIODevice::ReadOnly)) {
+        if (asset) {
 
             // first fixup the range based on the now known file size
-            byteRange.fixupRange(file.size());
+            byteRange.fixupRange(asset->getSize());
 
             // check if we're being asked to read data that we just don't have
             // because of the file size
-            if (file.size() < byteRange.fromInclusive || file.size() < byteRange.toExclusive) {
+            if (asset->getSize() < byteRange.fromInclusive || asset->getSize() < byteRange.toExclusive) {
                 replyPacketList->writePrimitive(AssetUtils::AssetServerError::InvalidByteRange);
                 qCDebug(networking) << "Bad byte range: " << hexHash << " "
                     << byteRange.fromInclusive << ":" << byteRange.toExclusive;
@@ -82,31 +81,25 @@ void SendAssetTask::run() {
                 // we have a valid byte range, handle it and send the asset
                 auto size = byteRange.size();
 
-                if (byteRange.fromInclusive >= 0) {
-
-                    // this range is positive, meaning we just need to seek into the file and then read from there
-                    file.seek(byteRange.fromInclusive);
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
-                    replyPacketList->write(file.read(size));
-                } else {
-                    // this range is negative, at least the first part of the read will be back into the end of the file
-
-                    // seek to the part of the file where the negative range begins
-                    file.seek(file.size() + byteRange.fromInclusive);
+                // a negative range is read back from the end of the file
+                auto offset = byteRange.fromInclusive >= 0 ? byteRange.fromInclusive
+                                                           : asset->getSize() + byteRange.fromInclusive;
 
-                    replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
-                    replyPacketList->writePrimitive(size);
+                replyPacketList->writePrimitive(AssetUtils::AssetServerError::NoError);
+                replyPacketList->writePrimitive(size);
 
-                    // first write everything from the negative range to the end of the file
-                    replyPacketList->write(file.read(size));
-                }
+                // the data is copied from the mapping into each packet as the send queue gets to it, so a transfer
+                // only holds the packets in flight rather than the whole range
+                replyPacketList->setStreamSource(size, [asset, offset](char* data, qint64 maxSize) mutable {
+                    memcpy(data, asset->getData() + offset, maxSize);
+                    offset += maxSize;
+                    return maxSize;
+                });
 
                 qCDebug(networking) << "Sending asset: " << hexHash;
             }
-            file.close();
         } else {
-            qCDebug(networking) << "Asset not found: " << filePath << "(" << hexHash << ")";
+            qCDebug(networking) << "Asset not found: " << _resourcesDir.filePath(hexHash) << "(" << hexHash << ")";
             replyPacketList->writePrimitive(AssetUtils::AssetServerError::AssetNotFound);
         }
     }
@@ -11,8 +11,11 @@
 
 #include "UploadAssetTask.h"
 
+#include <cstring>
+
 #include <QtCore/QBuffer>
 #include <QtCore/QFile>
+#include <QtCore/QSaveFile>
 
 #include <AssetUtils.h>
 #include <NodeList.h>
@@ -21,15 +24,70 @@
 #include "ClientServerUtils.h"
 
 UploadAssetTask::UploadAssetTask(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode,
-                                 const QDir& resourcesDir, uint64_t filesizeLimit) :
+                                 const QDir& resourcesDir, uint64_t filesizeLimit,
+                                 MappedAssetCache& mappedAssets, AssetChunkIndex& chunkIndex) :
     _receivedMessage(receivedMessage),
     _senderNode(senderNode),
     _resourcesDir(resourcesDir),
-    _filesizeLimit(filesizeLimit)
+    _filesizeLimit(filesizeLimit),
+    _mappedAssets(mappedAssets),
+    _chunkIndex(chunkIndex)
 {
     
 }
 
+bool UploadAssetTask::readDeltaUpload(QIODevice& buffer, uint64_t fileSize, QByteArray& fileData) {
+    uint32_t numChunks;
+    if (buffer.read(reinterpret_cast<char*>(&numChunks), sizeof(numChunks)) != (qint64)sizeof(numChunks)) {
+        return false;
+    }
+
+    fileData.resize((int)fileSize);
+    char* destination = fileData.data();
+    uint64_t sizeRemaining = fileSize;
+
+    // most of the reused chunks come from the previous version of the asset, hold on to its mapping
+    QHash<AssetUtils::AssetHash, MappedAssetPointer> sourceAssets;
+
+    for (uint32_t i = 0; i < numChunks; ++i) {
+        // each chunk is either included or named by its hash
+        uint32_t chunkSize;
+        uint8_t isIncluded;
+        if (buffer.read(reinterpret_cast<char*>(&chunkSize), sizeof(chunkSize)) != (qint64)sizeof(chunkSize) ||
+            buffer.read(reinterpret_cast<char*>(&isIncluded), sizeof(isIncluded)) != (qint64)sizeof(isIncluded) ||
+            chunkSize > sizeRemaining) {
+            return false;
+        }
+
+        if (isIncluded) {
+            if (buffer.read(destination, chunkSize) != (qint64)chunkSize) {
+                return false;
+            }
+        } else {
+            auto chunkHash = buffer.read(AssetUtils::SHA256_HASH_LENGTH);
+            AssetChunkIndex::Location location;
+            if (!_chunkIndex.find(chunkHash, location) || location.size != chunkSize) {
+                return false;
+            }
+
+            auto& source = sourceAssets[location.assetHash];
+            if (!source) {
+                source = _mappedAssets.get(location.assetHash);
+            }
+            if (!source || location.offset + location.size > source->getSize()) {
+                return false;
+            }
+            memcpy(destination, source->getData() + location.offset, chunkSize);
+        }
+
+        destination += chunkSize;
+        sizeRemaining -= chunkSize;
+    }
+
+    // the chunks aren't checked one by one, the hash of the whole asset is checked once it is put together
+    return sizeRemaining == 0;
+}
+
 void UploadAssetTask::run() {
     auto data = _receivedMessage->getMessage();
     
@@ -42,6 +100,8 @@ void UploadAssetTask::run() {
     uint64_t fileSize;
     buffer.read(reinterpret_cast<char*>(&fileSize), sizeof(fileSize));
 
+    bool isDeltaUpload = _receivedMessage->getType() == PacketType::AssetDeltaUpload;
+
     if (_senderNode) {
         qDebug() << "UploadAssetTask reading a file of " << fileSize << "bytes from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID());
     } else {
@@ -54,11 +114,29 @@ void UploadAssetTask::run() {
     if (fileSize > _filesizeLimit) {
         replyPacket->writePrimitive(AssetUtils::AssetServerError::AssetTooLarge);
     } else {
-        QByteArray fileData = buffer.read(fileSize);
+        QByteArray fileData;
+        QByteArray expectedHash;
+        if (isDeltaUpload) {
+            expectedHash = buffer.read(AssetUtils::SHA256_HASH_LENGTH);
+            if (!readDeltaUpload(buffer, fileSize, fileData)) {
+                fileData.clear();
+            }
+        } else {
+            fileData = buffer.read(fileSize);
+        }
         
         auto hash = AssetUtils::hashData(fileData);
         auto hexHash = hash.toHex();
 
+        if (isDeltaUpload && hash != expectedHash) {
+            // a chunk the client expected us to have is gone, it has to send the whole asset
+            qDebug() << "Delta upload of" << expectedHash.toHex() << "could not be put together, asking for all of it";
+
+            replyPacket->writePrimitive(AssetUtils::AssetServerError::ChunkNotFound);
+            sendReply(std::move(replyPacket));
+            return;
+        }
+
         if (_senderNode) {
             qDebug() << "Hash for uploaded file from" << uuidStringWithoutCurlyBraces(_senderNode->getUUID()) << "is: (" << hexHash << ")";
         } else {
@@ -78,6 +156,7 @@ void UploadAssetTask::run() {
 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
                 replyPacket->write(hash);
+                _chunkIndex.addAsset(QString(hexHash), fileData.constData(), fileData.size());
             } else {
                 qDebug() << "Overwriting an existing file whose contents did not match the expected hash: " << hexHash;
                 file.close();
@@ -85,17 +164,20 @@ void UploadAssetTask::run() {
         }
 
         if (!existingCorrectFile) {
-            if (file.open(QIODevice::WriteOnly) && file.write(fileData) == qint64(fileSize)) {
+            // replace the file rather than overwrite it, a send of the old contents may still have it mapped
+            QSaveFile saveFile { file.fileName() };
+
+            if (saveFile.open(QIODevice::WriteOnly) && saveFile.write(fileData) == qint64(fileSize) && saveFile.commit()) {
                 qDebug() << "Wrote file" << hexHash << "to disk. Upload complete";
-                file.close();
 
                 replyPacket->writePrimitive(AssetUtils::AssetServerError::NoError);
                 replyPacket->write(hash);
+                _chunkIndex.addAsset(QString(hexHash), fileData.constData(), fileData.size());
             } else {
                 qWarning() << "Failed to upload or write to file" << hexHash << " - upload failed.";
 
                 // upload has failed - remove the file and return an error
-                auto removed = file.remove();
+                auto removed = !file.exists() || file.remove();
 
                 if (!removed) {
                     qWarning() << "Removal of failed upload file" << hexHash << "failed.";
@@ -108,6 +190,10 @@ void UploadAssetTask::run() {
 
     }
     
+    sendReply(std::move(replyPacket));
+}
+
+void UploadAssetTask::sendReply(std::unique_ptr<NLPacket> replyPacket) {
     auto nodeList = DependencyManager::get<NodeList>();
     if (_senderNode) {
         nodeList->sendPacket(std::move(replyPacket), *_senderNode);
@@ -14,28 +14,40 @@
 #ifndef hifi_UploadAssetTask_h
 #define hifi_UploadAssetTask_h
 
+#include <memory>
+
 #include <QtCore/QDir>
 #include <QtCore/QObject>
 #include <QtCore/QRunnable>
 #include <QtCore/QSharedPointer>
 
+#include "AssetChunkIndex.h"
+#include "MappedAssetCache.h"
 #include "ReceivedMessage.h"
 
+class NLPacket;
 class NLPacketList;
 class Node;
 
 class UploadAssetTask : public QRunnable {
 public:
     UploadAssetTask(QSharedPointer<ReceivedMessage> message, QSharedPointer<Node> senderNode, 
-                    const QDir& resourcesDir, uint64_t filesizeLimit);
+                    const QDir& resourcesDir, uint64_t filesizeLimit,
+                    MappedAssetCache& mappedAssets, AssetChunkIndex& chunkIndex);
 
     void run() override;
 
 private:
+    // Puts the asset of a delta upload back together from the chunks it carries and those already stored
+    bool readDeltaUpload(QIODevice& buffer, uint64_t fileSize, QByteArray& fileData);
+    void sendReply(std::unique_ptr<NLPacket> replyPacket);
+
     QSharedPointer<ReceivedMessage> _receivedMessage;
     QSharedPointer<Node> _senderNode;
     QDir _resourcesDir;
     uint64_t _filesizeLimit;
+    MappedAssetCache& _mappedAssets;
+    AssetChunkIndex& _chunkIndex;
 };
 
 #endif // hifi_UploadAssetTask_h
@@ -11,6 +11,8 @@
 
 #include "AudioMixer.h"
 
+#include <algorithm>
+#include <cmath>
 #include <thread>
 
 #include <QtCore/QJsonArray>
@@ -45,6 +47,7 @@ using namespace std;
 static const float DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE = 0.5f;    // attenuation = -6dB * log2(distance)
 static const int DISABLE_STATIC_JITTER_FRAMES = -1;
 static const float DEFAULT_NOISE_MUTING_THRESHOLD = 1.0f;
+static const float DEFAULT_AUDIBILITY_THRESHOLD_DB = -90.0f; // below the resolution of 16-bit audio
 static const QString AUDIO_MIXER_LOGGING_TARGET_NAME = "audio-mixer";
 static const QString AUDIO_ENV_GROUP_KEY = "audio_env";
 static const QString AUDIO_BUFFER_GROUP_KEY = "audio_buffer";
@@ -53,6 +56,7 @@ static const QString AUDIO_THREADING_GROUP_KEY = "audio_threading";
 
 int AudioMixer::_numStaticJitterFrames{ DISABLE_STATIC_JITTER_FRAMES };
 float AudioMixer::_noiseMutingThreshold{ DEFAULT_NOISE_MUTING_THRESHOLD };
+float AudioMixer::_audibilityThreshold{ powf(10.0f, DEFAULT_AUDIBILITY_THRESHOLD_DB / 20.0f) };
 float AudioMixer::_attenuationPerDoublingInDistance{ DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE };
 map<QString, shared_ptr<CodecPlugin>> AudioMixer::_availableCodecs{ };
 QStringList AudioMixer::_codecPreferenceOrder{};
@@ -320,6 +324,29 @@ void AudioMixer::sendStatsPacket() {
     // call it "avg_..." to keep it higher in the display, sorted alphabetically
     statsObject["avg_timing_stats"] = timingStats;
 
+    // frame deadline stats
+    QJsonObject deadlineStats;
+    deadlineStats["us_avg_slack"] = (qint64)(_sumFrameSlack / _numStatFrames);
+    deadlineStats["us_avg_overrun"] = (qint64)(_numFrameOverruns > 0 ? _sumFrameOverrun / _numFrameOverruns : 0);
+    deadlineStats["us_max_overrun"] = (qint64)_maxFrameOverrun;
+    deadlineStats["%_overruns"] = (float)_numFrameOverruns / (float)_numStatFrames * 100.0f;
+    deadlineStats["steals_per_frame"] = (float)_stats.steals / (float)_numStatFrames;
+    statsObject["frame_deadline_stats"] = deadlineStats;
+
+    _sumFrameSlack = _sumFrameOverrun = _maxFrameOverrun = 0;
+    _numFrameOverruns = 0;
+
+    // encode stats, as a share of the listener frames
+    QJsonObject encodeStats;
+    float numListenerFrames = (float)std::max(_stats.sumListeners, 1);
+    encodeStats["encodes_per_frame"] = (float)_stats.encodes / (float)_numStatFrames;
+    encodeStats["shared_encodes_per_frame"] = (float)_stats.sharedEncodes / (float)_numStatFrames;
+    encodeStats["%_silent"] = (float)_stats.sumListenersSilent / numListenerFrames * 100.0f;
+    encodeStats["%_shared"] = (float)_stats.sharedEncodes / numListenerFrames * 100.0f;
+    encodeStats["%_encoder_skipped"] =
+        (float)(_stats.sumListenersSilent + _stats.sharedEncodes) / numListenerFrames * 100.0f;
+    statsObject["encode_stats"] = encodeStats;
+
     // mix stats
     QJsonObject mixStats;
 
@@ -330,10 +357,13 @@ void AudioMixer::sendStatsPacket() {
     mixStats["1_hrtf_renders"] = (int)(_stats.hrtfRenders / (float)_numStatFrames);
     mixStats["1_hrtf_resets"] = (int)(_stats.hrtfResets / (float)_numStatFrames);
     mixStats["1_hrtf_updates"] = (int)(_stats.hrtfUpdates / (float)_numStatFrames);
+    mixStats["1_hrtf_shared_renders"] = (int)(_stats.hrtfSharedRenders / (float)_numStatFrames);
+    mixStats["1_hrtf_shared_buckets"] = _workerSharedData.hrtfCache.size();
 
     mixStats["2_skipped_streams"] = (int)(_stats.skipped / (float)_numStatFrames);
     mixStats["2_inactive_streams"] = (int)(_stats.inactive / (float)_numStatFrames);
     mixStats["2_active_streams"] = (int)(_stats.active / (float)_numStatFrames);
+    mixStats["2_distant_streams"] = (int)(_stats.distant / (float)_numStatFrames);
 
     mixStats["3_skippped_to_active"] = (int)(_stats.skippedToActive / (float)_numStatFrames);
     mixStats["3_skippped_to_inactive"] = (int)(_stats.skippedToInactive / (float)_numStatFrames);
@@ -341,6 +371,9 @@ void AudioMixer::sendStatsPacket() {
     mixStats["3_inactive_to_active"] = (int)(_stats.inactiveToActive / (float)_numStatFrames);
     mixStats["3_active_to_skippped"] = (int)(_stats.activeToSkipped / (float)_numStatFrames);
     mixStats["3_active_to_inactive"] = (int)(_stats.activeToInactive / (float)_numStatFrames);
+    mixStats["3_active_to_distant"] = (int)(_stats.activeToDistant / (float)_numStatFrames);
+    mixStats["3_inactive_to_distant"] = (int)(_stats.inactiveToDistant / (float)_numStatFrames);
+    mixStats["3_distant_to_inactive"] = (int)(_stats.distantToInactive / (float)_numStatFrames);
 
     mixStats["total_mixes"] = _stats.totalMixes;
     mixStats["avg_mixes_per_block"] = _stats.totalMixes / _numStatFrames;
@@ -463,17 +496,41 @@ void AudioMixer::start() {
             numToRetain = nodeList->size() * (1.0f - _throttlingRatio);
         }
         nodeList->nestedEach([&](NodeList::const_iterator cbegin, NodeList::const_iterator cend) {
+            // index the stream positions for the listeners' range queries
+            _workerSharedData.streamGrid.build(cbegin, cend);
+
             // mix across slave threads
             auto mixTimer = _mixTiming.timer();
             _slavePool.mix(cbegin, cend, frame, numToRetain);
         });
 
+        if (_workerSharedData.hrtfCache.isEnabled()) {
+            _workerSharedData.hrtfCache.prune(frame);
+        }
+        if (_workerSharedData.encodeCache.isEnabled()) {
+            _workerSharedData.encodeCache.clear();
+        }
+
         // gather stats
         _slavePool.each([&](AudioMixerSlave& slave) {
             _stats.accumulate(slave.stats);
             slave.stats.reset();
         });
 
+        // measure against the frame deadline
+        {
+            auto frameEnd = _startFrameTimestamp + chrono::microseconds(AudioConstants::NETWORK_FRAME_USECS);
+            auto now = p_high_resolution_clock::now();
+            if (now <= frameEnd) {
+                _sumFrameSlack += chrono::duration_cast<chrono::microseconds>(frameEnd - now).count();
+            } else {
+                uint64_t overrun = chrono::duration_cast<chrono::microseconds>(now - frameEnd).count();
+                _sumFrameOverrun += overrun;
+                _maxFrameOverrun = max(_maxFrameOverrun, overrun);
+                ++_numFrameOverruns;
+            }
+        }
+
         ++frame;
         ++_numStatFrames;
 
@@ -553,10 +610,13 @@ void AudioMixer::clearDomainSettings() {
     _numStaticJitterFrames = DISABLE_STATIC_JITTER_FRAMES;
     _attenuationPerDoublingInDistance = DEFAULT_ATTENUATION_PER_DOUBLING_IN_DISTANCE;
     _noiseMutingThreshold = DEFAULT_NOISE_MUTING_THRESHOLD;
+    _audibilityThreshold = powf(10.0f, DEFAULT_AUDIBILITY_THRESHOLD_DB / 20.0f);
     _codecPreferenceOrder.clear();
     _audioZones.clear();
     _zoneSettings.clear();
     _zoneReverbSettings.clear();
+    _workerSharedData.hrtfCache.setSettings(AudioMixerHRTFCache::Settings());
+    _workerSharedData.encodeCache.setEnabled(false);
 }
 
 void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
@@ -594,6 +654,29 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
         }
 
         qCDebug(audio) << "Throttle Start:" << _throttleStartTarget << "Throttle Backoff:" << _throttleBackoffTarget;
+
+        AudioMixerHRTFCache::Settings hrtfCacheSettings;
+        const QString SHARED_HRTF_KEY = "shared_hrtf";
+        const QString SHARED_HRTF_AZIMUTH_STEP_KEY = "shared_hrtf_azimuth_step";
+        const QString SHARED_HRTF_DISTANCE_STEP_KEY = "shared_hrtf_distance_step";
+        const QString SHARED_HRTF_GAIN_STEP_KEY = "shared_hrtf_gain_step";
+        hrtfCacheSettings.enabled = audioThreadingGroupObject[SHARED_HRTF_KEY].toBool(hrtfCacheSettings.enabled);
+        hrtfCacheSettings.azimuthStep =
+            audioThreadingGroupObject[SHARED_HRTF_AZIMUTH_STEP_KEY].toDouble(hrtfCacheSettings.azimuthStep);
+        hrtfCacheSettings.distanceStep =
+            audioThreadingGroupObject[SHARED_HRTF_DISTANCE_STEP_KEY].toDouble(hrtfCacheSettings.distanceStep);
+        hrtfCacheSettings.gainStep = audioThreadingGroupObject[SHARED_HRTF_GAIN_STEP_KEY].toDouble(hrtfCacheSettings.gainStep);
+        _workerSharedData.hrtfCache.setSettings(hrtfCacheSettings);
+
+        if (hrtfCacheSettings.enabled) {
+            qCDebug(audio) << "Shared HRTF renders enabled, azimuth step:" << hrtfCacheSettings.azimuthStep
+                << "distance step:" << hrtfCacheSettings.distanceStep << "gain step:" << hrtfCacheSettings.gainStep;
+        }
+
+        const QString SHARED_ENCODES_KEY = "shared_encodes";
+        bool sharedEncodes = audioThreadingGroupObject[SHARED_ENCODES_KEY].toBool(false);
+        _workerSharedData.encodeCache.setEnabled(sharedEncodes);
+        qCDebug(audio) << "Shared encodes:" << sharedEncodes;
     }
 
     if (settingsObject.contains(AUDIO_BUFFER_GROUP_KEY)) {
@@ -680,6 +763,16 @@ void AudioMixer::parseSettingsObject(const QJsonObject& settingsObject) {
             }
         }
 
+        const QString AUDIBILITY_THRESHOLD = "audibility_threshold";
+        if (audioEnvGroupObject[AUDIBILITY_THRESHOLD].isString()) {
+            bool ok = false;
+            float audibilityThresholdDB = audioEnvGroupObject[AUDIBILITY_THRESHOLD].toString().toFloat(&ok);
+            if (ok) {
+                _audibilityThreshold = powf(10.0f, audibilityThresholdDB / 20.0f);
+                qCDebug(audio) << "Audibility threshold changed to" << audibilityThresholdDB << "dB";
+            }
+        }
+
         const QString NOISE_MUTING_THRESHOLD = "noise_muting_threshold";
         if (audioEnvGroupObject[NOISE_MUTING_THRESHOLD].isString()) {
             bool ok = false;
@@ -54,6 +54,7 @@ public:
 
     static int getStaticJitterFrames() { return _numStaticJitterFrames; }
     static bool shouldMute(float quietestFrame) { return quietestFrame > _noiseMutingThreshold; }
+    static float getAudibilityThreshold() { return _audibilityThreshold; }
     static float getAttenuationPerDoublingInDistance() { return _attenuationPerDoublingInDistance; }
     static const std::vector<ZoneDescription>& getAudioZones() { return _audioZones; }
     static const std::vector<ZoneSettings>& getZoneSettings() { return _zoneSettings; }
@@ -107,6 +108,12 @@ private:
     int _numStatFrames { 0 };
     AudioMixerStats _stats;
 
+    // time left before the frame deadline once mixing is done, or past it on overrun
+    uint64_t _sumFrameSlack { 0 };
+    uint64_t _sumFrameOverrun { 0 };
+    uint64_t _maxFrameOverrun { 0 };
+    int _numFrameOverruns { 0 };
+
     AudioMixerSlavePool _slavePool { _workerSharedData };
 
     class Timer {
@@ -142,6 +149,7 @@ private:
 
     static int _numStaticJitterFrames; // -1 denotes dynamic jitter buffering
     static float _noiseMutingThreshold;
+    static float _audibilityThreshold;
     static float _attenuationPerDoublingInDistance;
     static std::map<QString, CodecPluginPointer> _availableCodecs;
     static QStringList _codecPreferenceOrder;
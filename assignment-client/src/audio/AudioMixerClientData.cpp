@@ -11,6 +11,7 @@
 
 #include "AudioMixerClientData.h"
 
+#include <algorithm>
 #include <random>
 
 #include <glm/common.hpp>
@@ -774,22 +775,81 @@ void AudioMixerClientData::sendSelectAudioFormat(SharedNodePointer node, const Q
     nodeList->sendPacket(std::move(replyPacket), *node);
 }
 
-void AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
+void AudioMixerClientData::encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer, uint64_t mixHash) {
+    if (_encoder) {
+        catchUpEncoder();
+        _encoder->encode(decodedBuffer, encodedBuffer);
+    } else {
+        encodedBuffer = decodedBuffer;
+    }
+    // once you have encoded, you need to flush eventually.
+    _shouldFlushEncoder = true;
+    updateEncoderHistory(mixHash);
+}
+
+void AudioMixerClientData::skipEncode(const QByteArray& decodedBuffer, uint64_t mixHash) {
+    _skippedFrames[_numSkippedFrames % ENCODER_HISTORY_FRAMES] = decodedBuffer;
+    ++_numSkippedFrames;
+    _shouldFlushEncoder = true;
+    updateEncoderHistory(mixHash);
+}
+
+bool AudioMixerClientData::encodeFrameOfZeros(QByteArray& encodedZeros) {
     static QByteArray zeros(AudioConstants::NETWORK_FRAME_BYTES_STEREO, 0);
+    bool didEncode = false;
     if (_shouldFlushEncoder) {
         if (_encoder) {
+            catchUpEncoder();
             _encoder->encode(zeros, encodedZeros);
+            didEncode = true;
         } else {
             encodedZeros = zeros;
         }
+        const uint64_t SILENT_MIX = 1;
+        updateEncoderHistory(SILENT_MIX);
     }
     _shouldFlushEncoder = false;
+    return didEncode;
+}
+
+void AudioMixerClientData::updateEncoderHistory(uint64_t mixHash) {
+    if (mixHash == UNIQUE_MIX) {
+        // no other listener can match this history until these frames have left it
+        mixHash = (uint64_t)(uintptr_t)this;
+    }
+
+    uint64_t history = qHash(_selectedCodecName);
+    for (int i = ENCODER_HISTORY_FRAMES - 1; i > 0; --i) {
+        _recentMixHashes[i] = _recentMixHashes[i - 1];
+        history = history * 31 + _recentMixHashes[i];
+    }
+    _recentMixHashes[0] = mixHash;
+    _encoderHistory = history * 31 + mixHash;
+}
+
+void AudioMixerClientData::catchUpEncoder() {
+    if (_numSkippedFrames == 0) {
+        return;
+    }
+
+    // feed the encoder the frames that it missed, which brings it to about the state of the encoder it shared with;
+    // older frames have little effect on the encoder state
+    QByteArray discarded;
+    for (int i = std::max(0, _numSkippedFrames - ENCODER_HISTORY_FRAMES); i < _numSkippedFrames; ++i) {
+        _encoder->encode(_skippedFrames[i % ENCODER_HISTORY_FRAMES], discarded);
+    }
+    _numSkippedFrames = 0;
 }
 
 void AudioMixerClientData::setupCodec(CodecPluginPointer codec, const QString& codecName) {
     cleanupCodec(); // cleanup any previously allocated coders first
     _codec = codec;
     _selectedCodecName = codecName;
+
+    // a new encoder starts without history
+    std::fill(std::begin(_recentMixHashes), std::end(_recentMixHashes), 0);
+    _encoderHistory = qHash(_selectedCodecName);
+    _numSkippedFrames = 0;
     if (codec) {
         _encoder = codec->createEncoder(AudioConstants::SAMPLE_RATE, AudioConstants::STEREO);
         _decoder = codec->createDecoder(AudioConstants::SAMPLE_RATE, AudioConstants::MONO);
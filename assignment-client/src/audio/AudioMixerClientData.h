@@ -13,6 +13,7 @@
 #define hifi_AudioMixerClientData_h
 
 #include <queue>
+#include <unordered_map>
 
 #if !defined(Q_MOC_RUN)
 // Work around https://bugreports.qt.io/browse/QTBUG-80990
@@ -95,17 +96,20 @@ public:
 
     void setupCodec(CodecPluginPointer codec, const QString& codecName);
     void cleanupCodec();
-    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer) {
-        if (_encoder) {
-            _encoder->encode(decodedBuffer, encodedBuffer);
-        } else {
-            encodedBuffer = decodedBuffer;
-        }
-        // once you have encoded, you need to flush eventually.
-        _shouldFlushEncoder = true;
-    }
-    void encodeFrameOfZeros(QByteArray& encodedZeros);
+    // mixHash identifies the mix for the encoder history, UNIQUE_MIX if it can't be the same as another listener's
+    static const uint64_t UNIQUE_MIX = 0;
+    void encode(const QByteArray& decodedBuffer, QByteArray& encodedBuffer, uint64_t mixHash = UNIQUE_MIX);
+    bool encodeFrameOfZeros(QByteArray& encodedZeros); // returns whether the encoder ran
     bool shouldFlushEncoder() { return _shouldFlushEncoder; }
+    bool hasEncoder() const { return _encoder != nullptr; }
+
+    // A hash of the codec and of the last few frames fed to the encoder. Encoders with the same history are in about
+    // the same state, so one can encode an identical mix for the others (see AudioMixerEncodeCache).
+    uint64_t getEncoderHistory() const { return _encoderHistory; }
+
+    // Records a frame that was sent using another listener's encode. The encoder is caught up on the frames it
+    // skipped before it next encodes.
+    void skipEncode(const QByteArray& decodedBuffer, uint64_t mixHash);
 
     QString getCodecName() { return _selectedCodecName; }
 
@@ -136,6 +140,9 @@ public:
         MixableStreamsVector active;
         MixableStreamsVector inactive;
         MixableStreamsVector skipped;
+
+        // streams out of audible range, only looked at again when the listener's spatial query finds them
+        std::unordered_map<const PositionalAudioStream*, MixableStream> distant;
     };
 
     Streams& getStreams() { return _streams; }
@@ -204,6 +211,15 @@ private:
 
     bool _shouldFlushEncoder { false };
 
+    void updateEncoderHistory(uint64_t mixHash);
+    void catchUpEncoder();
+
+    static const int ENCODER_HISTORY_FRAMES = 2;
+    uint64_t _encoderHistory { 0 };
+    uint64_t _recentMixHashes[ENCODER_HISTORY_FRAMES] {};
+    QByteArray _skippedFrames[ENCODER_HISTORY_FRAMES]; // the most recent frames the encoder didn't see
+    int _numSkippedFrames { 0 };
+
     bool _shouldMuteClient { false };
     bool _requestsDomainListData { false };
 
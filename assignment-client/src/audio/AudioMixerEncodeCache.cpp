@@ -0,0 +1,60 @@
+//
+//  AudioMixerEncodeCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerEncodeCache.h"
+
+#include <cstring>
+
+#include <AudioConstants.h>
+
+void AudioMixerEncodeCache::setEnabled(bool enabled) {
+    _enabled = enabled;
+    _entries.clear();
+}
+
+uint64_t AudioMixerEncodeCache::hashMix(const float* mix) {
+    static_assert(AudioConstants::NETWORK_FRAME_SAMPLES_STEREO % 2 == 0, "mix must be a whole number of words");
+
+    // 64-bit FNV-1a over words, with the bits of the floats so that equal mixes hash equally
+    const uint64_t FNV_OFFSET_BASIS = 14695981039346656037ull;
+    const uint64_t FNV_PRIME = 1099511628211ull;
+    uint64_t hash = FNV_OFFSET_BASIS;
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; i += 2) {
+        uint64_t word;
+        memcpy(&word, &mix[i], sizeof(word));
+        hash = (hash ^ word) * FNV_PRIME;
+    }
+    return hash;
+}
+
+bool AudioMixerEncodeCache::encode(uint64_t encoderHistory, uint64_t mixHash, QByteArray& encodedBuffer,
+                                   const Encode& encode) {
+    Key key { encoderHistory, mixHash };
+
+    auto itr = _entries.find(key);
+    if (itr == _entries.end()) {
+        // if another slave inserts the same key first, this one is dropped and theirs is used
+        itr = _entries.insert({ key, std::make_shared<Entry>() }).first;
+    }
+    Entry& entry = *itr->second;
+
+    // the other listeners wait for the first one to finish its encode
+    std::lock_guard<std::mutex> lock(entry.mutex);
+    if (entry.isEncoded) {
+        encodedBuffer = entry.encodedBuffer;
+        return true;
+    }
+
+    encode(encodedBuffer);
+    entry.encodedBuffer = encodedBuffer;
+    entry.isEncoded = true;
+    return false;
+}
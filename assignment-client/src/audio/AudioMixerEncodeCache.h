@@ -0,0 +1,74 @@
+//
+//  AudioMixerEncodeCache.h
+//  assignment-client/src/audio
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AudioMixerEncodeCache_h
+#define overte_AudioMixerEncodeCache_h
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+
+#include <QtCore/QByteArray>
+
+#include <TBBHelpers.h>
+
+// Encoded mixes of the current frame, shared by the listeners that hear an identical mix.
+//
+// Only mixes without spatialized streams can be identical for two listeners, e.g. a single stereo injector. The codec
+// is stateful, so an encode is only shared between listeners whose encoders were recently fed the same frames; the
+// encoder history (see AudioMixerClientData::getEncoderHistory) is part of the key.
+//
+// encode() is called concurrently from the mixing slaves; setEnabled() and clear() only between frames.
+class AudioMixerEncodeCache {
+public:
+    using Encode = std::function<void(QByteArray& encodedBuffer)>;
+
+    void setEnabled(bool enabled);
+    bool isEnabled() const { return _enabled; }
+
+    static uint64_t hashMix(const float* mix);
+
+    // Sets encodedBuffer to the encode of this mix shared by another listener, or to a new encode made by calling
+    // encode if this is the first listener with this history and mix. Returns true if it was shared.
+    bool encode(uint64_t encoderHistory, uint64_t mixHash, QByteArray& encodedBuffer, const Encode& encode);
+
+    // drops the encodes of the last frame
+    void clear() { _entries.clear(); }
+
+    int size() const { return (int)_entries.size(); }
+
+private:
+    struct Key {
+        uint64_t encoderHistory;
+        uint64_t mixHash;
+
+        bool operator==(const Key& other) const {
+            return encoderHistory == other.encoderHistory && mixHash == other.mixHash;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const { return (size_t)(key.encoderHistory ^ (key.mixHash * 31)); }
+    };
+
+    struct Entry {
+        std::mutex mutex;
+        bool isEncoded { false };
+        QByteArray encodedBuffer;
+    };
+
+    bool _enabled { false };
+
+    tbb::concurrent_unordered_map<Key, std::shared_ptr<Entry>, KeyHasher> _entries;
+};
+
+#endif // overte_AudioMixerEncodeCache_h
@@ -0,0 +1,90 @@
+//
+//  AudioMixerHRTFCache.cpp
+//  assignment-client/src/audio
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerHRTFCache.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+#include <glm/glm.hpp>
+
+#include <QtCore/QHash>
+
+static const int HRTF_DATASET_INDEX = 1;
+static const unsigned int MAX_IDLE_FRAMES = 100; // 1 second
+
+size_t AudioMixerHRTFCache::KeyHasher::operator()(const Key& key) const {
+    size_t hash = qHash(key.streamID);
+    hash = hash * 31 + key.nodeLocalID;
+    hash = hash * 31 + (size_t)key.azimuth;
+    hash = hash * 31 + (size_t)key.distance;
+    hash = hash * 31 + (size_t)key.gain;
+    return hash;
+}
+
+void AudioMixerHRTFCache::setSettings(const Settings& settings) {
+    const float MIN_STEP = 0.001f;
+    _enabled = settings.enabled;
+    _azimuthStep = glm::radians(std::max(settings.azimuthStep, MIN_STEP));
+    _logDistanceStep = std::log1p(std::max(settings.distanceStep, MIN_STEP));
+    _logGainStep = std::max(settings.gainStep, MIN_STEP) * std::log(10.0f) / 20.0f;
+
+    // the buckets have changed
+    _entries.clear();
+}
+
+bool AudioMixerHRTFCache::render(const NodeIDStreamID& source, AudioRingBuffer::ConstIterator input, float azimuth,
+                                 float distance, float gain, unsigned int frame, float* output) {
+    Key key { source.nodeLocalID, source.streamID,
+              (int)std::lround(azimuth / _azimuthStep),
+              (int)std::lround(std::log(distance) / _logDistanceStep),
+              (int)std::lround(std::log(gain) / _logGainStep) };
+
+    auto itr = _entries.find(key);
+    if (itr == _entries.end()) {
+        // if another slave inserts the same bucket first, this one is dropped and theirs is used
+        itr = _entries.insert({ key, std::make_shared<Entry>() }).first;
+    }
+    Entry& entry = *itr->second;
+
+    bool rendered = false;
+    {
+        std::lock_guard<std::mutex> lock(entry.mutex);
+        if (entry.frame != frame) {
+            int16_t samples[AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL];
+            input.readSamples(samples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+
+            memset(entry.mix, 0, sizeof(entry.mix));
+            entry.hrtf.render(samples, entry.mix, HRTF_DATASET_INDEX, key.azimuth * _azimuthStep,
+                              std::exp(key.distance * _logDistanceStep), std::exp(key.gain * _logGainStep),
+                              AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
+            entry.frame = frame;
+            rendered = true;
+        }
+    }
+
+    // the render is not touched again until the next frame
+    for (int i = 0; i < AudioConstants::NETWORK_FRAME_SAMPLES_STEREO; ++i) {
+        output[i] += entry.mix[i];
+    }
+    return rendered;
+}
+
+void AudioMixerHRTFCache::prune(unsigned int frame) {
+    for (auto itr = _entries.begin(); itr != _entries.end();) {
+        if (frame - itr->second->frame > MAX_IDLE_FRAMES) {
+            itr = _entries.unsafe_erase(itr);
+        } else {
+            ++itr;
+        }
+    }
+}
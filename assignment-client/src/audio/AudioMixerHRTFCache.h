@@ -0,0 +1,86 @@
+//
+//  AudioMixerHRTFCache.h
+//  assignment-client/src/audio
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AudioMixerHRTFCache_h
+#define overte_AudioMixerHRTFCache_h
+
+#include <memory>
+#include <mutex>
+
+#include <AudioConstants.h>
+#include <AudioHRTF.h>
+#include <AudioRingBuffer.h>
+#include <PositionalAudioStream.h>
+#include <TBBHelpers.h>
+
+// HRTF renders of a stream that are shared by the listeners that hear it from about the same place.
+//
+// Azimuth, distance and gain are quantized into buckets, and each source is rendered once per bucket per frame at the
+// bucket's center; every listener in the bucket then mixes in that render. Each bucket keeps its own HRTF state from
+// frame to frame, so a listener that stays in a bucket hears a continuous render.
+//
+// render() is called concurrently from the mixing slaves; setSettings() and prune() only between frames.
+class AudioMixerHRTFCache {
+public:
+    struct Settings {
+        bool enabled { false };
+        float azimuthStep { 5.0f };  // degrees, the resolution of the HRTF tables
+        float distanceStep { 0.1f }; // relative distance
+        float gainStep { 1.0f };     // dB
+    };
+
+    void setSettings(const Settings& settings);
+    bool isEnabled() const { return _enabled; }
+
+    // Adds the stream's shared render for the given parameters to output, rendering it if this is the first listener
+    // in its bucket this frame. Returns true if it rendered. The gain must be greater than zero.
+    bool render(const NodeIDStreamID& source, AudioRingBuffer::ConstIterator input, float azimuth, float distance,
+                float gain, unsigned int frame, float* output);
+
+    // drops the buckets that have not been rendered for a while
+    void prune(unsigned int frame);
+
+    int size() const { return (int)_entries.size(); }
+
+private:
+    struct Key {
+        Node::LocalID nodeLocalID;
+        StreamID streamID;
+        int azimuth;
+        int distance;
+        int gain;
+
+        bool operator==(const Key& other) const {
+            return nodeLocalID == other.nodeLocalID && streamID == other.streamID && azimuth == other.azimuth &&
+                distance == other.distance && gain == other.gain;
+        }
+    };
+
+    struct KeyHasher {
+        size_t operator()(const Key& key) const;
+    };
+
+    struct Entry {
+        std::mutex mutex;
+        unsigned int frame { 0 };
+        AudioHRTF hrtf;
+        float mix[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    };
+
+    bool _enabled { false };
+    float _azimuthStep { 0.0f };      // radians
+    float _logDistanceStep { 0.0f };
+    float _logGainStep { 0.0f };
+
+    tbb::concurrent_unordered_map<Key, std::shared_ptr<Entry>, KeyHasher> _entries;
+};
+
+#endif // overte_AudioMixerHRTFCache_h
@@ -12,6 +12,8 @@
 #include "AudioMixerSlave.h"
 
 #include <algorithm>
+#include <cmath>
+#include <limits>
 
 #include <glm/glm.hpp>
 #include <glm/gtx/norm.hpp>
@@ -54,6 +56,9 @@ inline float computeGain(float masterAvatarGain, float masterInjectorGain, const
         const PositionalAudioStream& streamToAdd, const glm::vec3& relativePosition, float distance);
 inline float computeAzimuth(const AvatarAudioStream& listeningNodeStream, const PositionalAudioStream& streamToAdd,
         const glm::vec3& relativePosition);
+inline float computeAttenuationCoefficient(const glm::vec3& sourcePosition, const glm::vec3& listenerPosition);
+inline float computeAudibleDistance(float attenuationPerDoublingInDistance);
+inline float computeMaxAudibleDistance(const glm::vec3& listenerPosition);
 
 void AudioMixerSlave::processPackets(const SharedNodePointer& node) {
     AudioMixerClientData* data = (AudioMixerClientData*)node->getLinkedData();
@@ -105,10 +110,28 @@ void AudioMixerSlave::mix(const SharedNodePointer& node) {
             if (mixHasAudio) {
                 // encode the audio
                 QByteArray decodedBuffer(reinterpret_cast<char*>(_bufferSamples), AudioConstants::NETWORK_FRAME_BYTES_STEREO);
-                data->encode(decodedBuffer, encodedBuffer);
+                if (_mixIsShareable && _sharedData.encodeCache.isEnabled() && data->hasEncoder()) {
+                    // reuse the encode of another listener that hears the same mix
+                    uint64_t mixHash = AudioMixerEncodeCache::hashMix(_mixSamples);
+                    bool isShared = _sharedData.encodeCache.encode(data->getEncoderHistory(), mixHash, encodedBuffer,
+                                                                   [&](QByteArray& encoded) {
+                        data->encode(decodedBuffer, encoded, mixHash);
+                    });
+                    if (isShared) {
+                        data->skipEncode(decodedBuffer, mixHash);
+                        ++stats.sharedEncodes;
+                    } else {
+                        ++stats.encodes;
+                    }
+                } else {
+                    data->encode(decodedBuffer, encodedBuffer);
+                    ++stats.encodes;
+                }
             } else {
                 // time to flush (resets shouldFlush until the next encode)
-                data->encodeFrameOfZeros(encodedBuffer);
+                if (data->encodeFrameOfZeros(encodedBuffer)) {
+                    ++stats.encodes;
+                }
             }
 
             sendMixPacket(node, *data, encodedBuffer);
@@ -306,12 +329,77 @@ float approximateVolume(const MixableStream& stream, const AvatarAudioStream* li
     return stream.positionalStream->getLastPopOutputTrailingLoudness() * gain;
 };
 
+// streams are culled a little beyond their audible distance, so that they don't go back and forth at the boundary
+bool isDistant(const MixableStream& stream, const AvatarAudioStream& listenerAudioStream, float margin) {
+    if (stream.positionalStream == &listenerAudioStream) {
+        // the echo is not attenuated
+        return false;
+    }
+
+    const glm::vec3& sourcePosition = stream.positionalStream->getPosition();
+    const glm::vec3& listenerPosition = listenerAudioStream.getPosition();
+    float audibleDistance = computeAudibleDistance(computeAttenuationCoefficient(sourcePosition, listenerPosition));
+    return glm::distance(sourcePosition, listenerPosition) > audibleDistance * margin;
+}
+
+const float DISTANT_CULL_MARGIN = 1.25f;
+
+void AudioMixerSlave::gatherStreams(const Node& listener, AudioMixerClientData& listenerData, bool isSoloing) {
+    auto& streams = listenerData.getStreams();
+    if (streams.distant.empty()) {
+        return;
+    }
+
+    // forget the distant streams that are gone
+    if (!_sharedData.removedNodes.empty() || !_sharedData.removedStreams.empty()) {
+        for (auto itr = streams.distant.begin(); itr != streams.distant.end();) {
+            if (shouldBeRemoved(itr->second, _sharedData)) {
+                itr = streams.distant.erase(itr);
+            } else {
+                ++itr;
+            }
+        }
+    }
+
+    auto gather = [&](MixableStream& stream) {
+        // the listener's ignores were not tracked while the stream was distant
+        stream.ignoredByListener = contains(listener.getIgnoredNodeIDs(), stream.nodeStreamID.nodeID);
+        stream.ignoringListener = contains(listenerData.getIgnoringNodeIDs(), stream.nodeStreamID.nodeID);
+
+        // inactive streams are sorted into active or skipped by prepareMix
+        streams.inactive.push_back(move(stream));
+        ++stats.distantToInactive;
+    };
+
+    if (isSoloing) {
+        // soloed streams are heard at any distance
+        for (auto& distant : streams.distant) {
+            gather(distant.second);
+        }
+        streams.distant.clear();
+        return;
+    }
+
+    // only the streams within audible range of the listener are looked at
+    const AvatarAudioStream& listenerAudioStream = *listenerData.getAvatarAudioStream();
+    const glm::vec3& listenerPosition = listenerAudioStream.getPosition();
+    _sharedData.streamGrid.query(listenerPosition, computeMaxAudibleDistance(listenerPosition),
+                                 [&](PositionalAudioStream* positionalStream) {
+        auto itr = streams.distant.find(positionalStream);
+        if (itr != streams.distant.end() && !isDistant(itr->second, listenerAudioStream, 1.0f)) {
+            gather(itr->second);
+            streams.distant.erase(itr);
+        }
+    });
+}
+
 bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     AvatarAudioStream* listenerAudioStream = static_cast<AudioMixerClientData*>(listener->getLinkedData())->getAvatarAudioStream();
     AudioMixerClientData* listenerData = static_cast<AudioMixerClientData*>(listener->getLinkedData());
 
     // zero out the mix for this listener
     memset(_mixSamples, 0, sizeof(_mixSamples));
+    _mixIsShareable = true;
 
     bool isThrottling = _numToRetain != -1;
     bool isSoloing = !listenerData->getSoloedNodes().empty();
@@ -319,6 +407,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     auto& streams = listenerData->getStreams();
 
     addStreams(*listener, *listenerData);
+    gatherStreams(*listener, *listenerData, isSoloing);
 
     // Process skipped streams
     erase_if(streams.skipped, [&](MixableStream& stream) {
@@ -356,6 +445,13 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
             return true;
         }
 
+        if (!isSoloing && isDistant(stream, *listenerAudioStream, DISTANT_CULL_MARGIN)) {
+            auto positionalStream = stream.positionalStream;
+            streams.distant.emplace(positionalStream, move(stream));
+            ++stats.inactiveToDistant;
+            return true;
+        }
+
         if (!shouldBeInactive(stream)) {
             streams.active.push_back(move(stream));
             ++stats.inactiveToActive;
@@ -387,6 +483,14 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 return true;
             }
 
+            if (!isSoloing && isDistant(stream, *listenerAudioStream, DISTANT_CULL_MARGIN)) {
+                resetHRTFState(stream);
+                auto positionalStream = stream.positionalStream;
+                streams.distant.emplace(positionalStream, move(stream));
+                ++stats.activeToDistant;
+                return true;
+            }
+
             addStream(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain(),
                       isSoloing);
 
@@ -423,6 +527,14 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 return true;
             }
 
+            if (!isSoloing && isDistant(stream, *listenerAudioStream, DISTANT_CULL_MARGIN)) {
+                resetHRTFState(stream);
+                auto positionalStream = stream.positionalStream;
+                streams.distant.emplace(positionalStream, move(stream));
+                ++stats.activeToDistant;
+                return true;
+            }
+
             addStream(stream, *listenerAudioStream, listenerData->getMasterAvatarGain(), listenerData->getMasterInjectorGain(),
                       isSoloing);
 
@@ -450,6 +562,13 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
                 return true;
             }
 
+            if (!isSoloing && isDistant(stream, *listenerAudioStream, DISTANT_CULL_MARGIN)) {
+                auto positionalStream = stream.positionalStream;
+                streams.distant.emplace(positionalStream, move(stream));
+                ++stats.activeToDistant;
+                return true;
+            }
+
             if (shouldBeInactive(stream)) {
                 streams.inactive.push_back(move(stream));
                 ++stats.activeToInactive;
@@ -463,6 +582,7 @@ bool AudioMixerSlave::prepareMix(const SharedNodePointer& listener) {
     stats.skipped += (int)streams.skipped.size();
     stats.inactive += (int)streams.inactive.size();
     stats.active += (int)streams.active.size();
+    stats.distant += (int)streams.distant.size();
 
     // clear the newly ignored, un-ignored, ignoring, and un-ignoring streams now that we've processed them
     listenerData->clearStagedIgnoreChanges();
@@ -501,6 +621,11 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
     // check if this is a server echo of a source back to itself
     bool isEcho = (streamToAdd == &listeningNodeStream);
 
+    // only the stereo mixes can be the same for other listeners
+    if (!streamToAdd->isStereo()) {
+        _mixIsShareable = false;
+    }
+
     glm::vec3 relativePosition = streamToAdd->getPosition() - listeningNodeStream.getPosition();
 
     float distance = glm::max(glm::length(relativePosition), EPSILON);
@@ -565,6 +690,19 @@ void AudioMixerSlave::addStream(AudioMixerClientData::MixableStream& mixableStre
         mixableStream.hrtf->mixMono(_bufferSamples, _mixSamples, gain, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
 
         ++stats.manualEchoMixes;
+    } else if (_sharedData.hrtfCache.isEnabled() && gain > 0.0f) {
+
+        // share one render with the other listeners that hear this stream from about the same place
+        float adjustedGain = gain * mixableStream.hrtf->getGainAdjustment();
+        if (_sharedData.hrtfCache.render(mixableStream.nodeStreamID, streamPopOutput, azimuth, distance, adjustedGain,
+                                         _frame, _mixSamples)) {
+            ++stats.hrtfRenders;
+        } else {
+            ++stats.hrtfSharedRenders;
+        }
+
+        // keep this listener's own HRTF current for when it stops sharing
+        mixableStream.hrtf->setParameterHistory(azimuth, distance, gain);
     } else {
 
         streamPopOutput.readSamples(_bufferSamples, AudioConstants::NETWORK_FRAME_SAMPLES_PER_CHANNEL);
@@ -758,18 +896,9 @@ float computeGain(float masterAvatarGain,
         gain *= masterAvatarGain;
     }
 
-    auto& audioZones = AudioMixer::getAudioZones();
-    auto& zoneSettings = AudioMixer::getZoneSettings();
-
     // find distance attenuation coefficient
-    float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
-    for (const auto& settings : zoneSettings) {
-        if (audioZones[settings.source].area.contains(streamToAdd.getPosition()) &&
-            audioZones[settings.listener].area.contains(listeningNodeStream.getPosition())) {
-            attenuationPerDoublingInDistance = settings.coefficient;
-            break;
-        }
-    }
+    float attenuationPerDoublingInDistance =
+        computeAttenuationCoefficient(streamToAdd.getPosition(), listeningNodeStream.getPosition());
 
     if (attenuationPerDoublingInDistance < 0.0f) {
         // translate a negative zone setting to distance limit
@@ -801,6 +930,59 @@ float computeGain(float masterAvatarGain,
     return gain;
 }
 
+float computeAttenuationCoefficient(const glm::vec3& sourcePosition, const glm::vec3& listenerPosition) {
+    auto& audioZones = AudioMixer::getAudioZones();
+    auto& zoneSettings = AudioMixer::getZoneSettings();
+
+    float attenuationPerDoublingInDistance = AudioMixer::getAttenuationPerDoublingInDistance();
+    for (const auto& settings : zoneSettings) {
+        if (audioZones[settings.source].area.contains(sourcePosition) &&
+            audioZones[settings.listener].area.contains(listenerPosition)) {
+            attenuationPerDoublingInDistance = settings.coefficient;
+            break;
+        }
+    }
+    return attenuationPerDoublingInDistance;
+}
+
+// the distance beyond which computeGain's distance attenuation is below the audibility threshold
+float computeAudibleDistance(float attenuationPerDoublingInDistance) {
+    if (attenuationPerDoublingInDistance < 0.0f) {
+        // a negative zone setting is a distance limit
+        const float MIN_DISTANCE_LIMIT = ATTN_DISTANCE_REF + 1.0f;
+        return std::max(-attenuationPerDoublingInDistance, MIN_DISTANCE_LIMIT);
+
+    } else if (attenuationPerDoublingInDistance < 1.0f) {
+        const float MIN_ATTENUATION_COEFFICIENT = 0.001f;
+        float g = glm::clamp(1.0f - attenuationPerDoublingInDistance, MIN_ATTENUATION_COEFFICIENT, 1.0f);
+        if (g >= 1.0f) {
+            // no attenuation
+            return std::numeric_limits<float>::infinity();
+        }
+
+        // solve g^log2(distance / ATTN_DISTANCE_REF) == threshold, infinite for a zero threshold
+        return ATTN_DISTANCE_REF * exp2f(log2f(AudioMixer::getAudibilityThreshold()) / log2f(g));
+
+    } else {
+        // silent at any distance
+        return 0.0f;
+    }
+}
+
+// the furthest that a source can be heard from, for any of the source zones
+float computeMaxAudibleDistance(const glm::vec3& listenerPosition) {
+    auto& audioZones = AudioMixer::getAudioZones();
+    auto& zoneSettings = AudioMixer::getZoneSettings();
+
+    float distance = computeAudibleDistance(AudioMixer::getAttenuationPerDoublingInDistance());
+    for (const auto& settings : zoneSettings) {
+        if (audioZones[settings.listener].area.contains(listenerPosition)) {
+            distance = std::max(distance, computeAudibleDistance(settings.coefficient));
+        }
+    }
+    return distance;
+}
+
 float computeAzimuth(const AvatarAudioStream& listeningNodeStream,
                      const PositionalAudioStream& streamToAdd,
                      const glm::vec3& relativePosition) {
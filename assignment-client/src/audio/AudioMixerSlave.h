@@ -26,6 +26,9 @@
 #include <PositionalAudioStream.h>
 
 #include "AudioMixerClientData.h"
+#include "AudioMixerEncodeCache.h"
+#include "AudioMixerHRTFCache.h"
+#include "AudioMixerStreamGrid.h"
 #include "AudioMixerStats.h"
 
 class AvatarAudioStream;
@@ -39,6 +42,9 @@ public:
         AudioMixerClientData::ConcurrentAddedStreams addedStreams;
         std::vector<Node::LocalID> removedNodes;
         std::vector<NodeIDStreamID> removedStreams;
+        AudioMixerHRTFCache hrtfCache;
+        AudioMixerEncodeCache encodeCache;
+        AudioMixerStreamGrid streamGrid;
     };
 
     AudioMixerSlave(SharedData& sharedData) : _sharedData(sharedData) {};
@@ -70,10 +76,12 @@ private:
     void resetHRTFState(AudioMixerClientData::MixableStream& mixableStream);
 
     void addStreams(Node& listener, AudioMixerClientData& listenerData);
+    void gatherStreams(const Node& listener, AudioMixerClientData& listenerData, bool isSoloing);
 
     // mixing buffers
     float _mixSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
     int16_t _bufferSamples[AudioConstants::NETWORK_FRAME_SAMPLES_STEREO];
+    bool _mixIsShareable { false }; // the mix has no spatialized streams
 
     // frame state
     ConstIter _begin;
@@ -17,15 +17,61 @@
 #include <algorithm>
 
 #include <ThreadHelpers.h>
+#include <NodeList.h>
+
+void AudioMixerWorkDeque::clear() {
+    _nodes.clear();
+    _bounds.store(0, std::memory_order_relaxed);
+}
+
+void AudioMixerWorkDeque::publish() {
+    // the slaves are started through the pool's mutex, which orders this before their first pop
+    _bounds.store(pack(0, (uint32_t)_nodes.size()), std::memory_order_relaxed);
+}
+
+bool AudioMixerWorkDeque::popFront(SharedNodePointer& node) {
+    uint64_t bounds = _bounds.load(std::memory_order_relaxed);
+    while (true) {
+        uint32_t front = (uint32_t)bounds;
+        uint32_t back = (uint32_t)(bounds >> 32);
+        if (front >= back) {
+            return false;
+        }
+        if (_bounds.compare_exchange_weak(bounds, pack(front + 1, back), std::memory_order_relaxed)) {
+            node = _nodes[front];
+            return true;
+        }
+    }
+}
+
+bool AudioMixerWorkDeque::popBack(SharedNodePointer& node) {
+    uint64_t bounds = _bounds.load(std::memory_order_relaxed);
+    while (true) {
+        uint32_t front = (uint32_t)bounds;
+        uint32_t back = (uint32_t)(bounds >> 32);
+        if (front >= back) {
+            return false;
+        }
+        if (_bounds.compare_exchange_weak(bounds, pack(front, back - 1), std::memory_order_relaxed)) {
+            node = _nodes[back - 1];
+            return true;
+        }
+    }
+}
 
 void AudioMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        {
+            // coalesce the packets sent to every node this thread handles in this frame into as few syscalls as possible
+            NodeList::SendBatch sendBatch(*DependencyManager::get<NodeList>());
+
+            // iterate over all available nodes
+            SharedNodePointer node;
+            while (try_pop(node)) {
+                (this->*_function)(node);
+            }
         }
 
         bool stopping = _stop;
@@ -65,13 +111,26 @@ void AudioMixerSlaveThread::notify(bool stopping) {
 }
 
 bool AudioMixerSlaveThread::try_pop(SharedNodePointer& node) {
-    return _pool._queue.try_pop(node);
+    auto& deques = _pool._deques;
+    if (deques[_index]->popFront(node)) {
+        return true;
+    }
+
+    // out of our own nodes, so steal the cheapest remaining node from another thread
+    int numDeques = _pool._numThreads;
+    for (int i = 1; i < numDeques; ++i) {
+        if (deques[(_index + i) % numDeques]->popBack(node)) {
+            ++stats.steals;
+            return true;
+        }
+    }
+    return false;
 }
 
 void AudioMixerSlavePool::processPackets(ConstIter begin, ConstIter end) {
     _function = &AudioMixerSlave::processPackets;
     _configure = [](AudioMixerSlave& slave) {};
-    run(begin, end);
+    run(begin, end, [](const SharedNodePointer& node) { return 1; });
 }
 
 void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame, int numToRetain) {
@@ -80,17 +139,48 @@ void AudioMixerSlavePool::mix(ConstIter begin, ConstIter end, unsigned int frame
         slave.configureMix(_begin, _end, frame, numToRetain);
     };
 
-    run(begin, end);
+    // a listener costs about as much as the number of streams it mixed last frame
+    run(begin, end, [](const SharedNodePointer& node) {
+        auto data = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (!data) {
+            return 1;
+        }
+        auto& streams = data->getStreams();
+        return 1 + (int)(streams.active.size() + streams.inactive.size() + streams.skipped.size());
+    });
 }
 
-void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
+void AudioMixerSlavePool::seed(const Cost& cost) {
+    _costs.clear();
+    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
+        _costs.emplace_back(cost(node), node);
+    });
+
+    // hand out the most expensive nodes first, each to the least loaded thread,
+    // so that only the cheap nodes at the back of each deque are left to steal
+    std::stable_sort(_costs.begin(), _costs.end(), [](const auto& a, const auto& b) {
+        return a.first > b.first;
+    });
+
+    _loads.assign(_numThreads, 0);
+    for (auto& nodeCost : _costs) {
+        auto lightest = std::min_element(_loads.begin(), _loads.end());
+        *lightest += nodeCost.first;
+        _deques[lightest - _loads.begin()]->push(nodeCost.second);
+    }
+    _costs.clear();
+
+    for (int i = 0; i < _numThreads; ++i) {
+        _deques[i]->publish();
+    }
+}
+
+void AudioMixerSlavePool::run(ConstIter begin, ConstIter end, const Cost& cost) {
     _begin = begin;
     _end = end;
 
-    // fill the queue
-    std::for_each(_begin, _end, [&](const SharedNodePointer& node) {
-        _queue.push(node);
-    });
+    // fill the deques
+    seed(cost);
 
     {
         Lock lock(_mutex);
@@ -108,7 +198,10 @@ void AudioMixerSlavePool::run(ConstIter begin, ConstIter end) {
         assert(_numStarted == _numThreads);
     }
 
-    assert(_queue.empty());
+    // release this frame's nodes
+    for (auto& deque : _deques) {
+        deque->clear();
+    }
 }
 
 void AudioMixerSlavePool::each(std::function<void(AudioMixerSlave& slave)> functor) {
@@ -157,10 +250,15 @@ void AudioMixerSlavePool::resize(int numThreads) {
 
     Lock lock(_mutex);
 
+    // every slave, including any that are about to stop, needs a deque to look in
+    while ((int)_deques.size() < numThreads) {
+        _deques.emplace_back(new AudioMixerWorkDeque);
+    }
+
     if (numThreads > _numThreads) {
         // start new slaves
-        for (int i = 0; i < numThreads - _numThreads; ++i) {
-            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData);
+        for (int i = _numThreads; i < numThreads; ++i) {
+            auto slave = new AudioMixerSlaveThread(*this, _workerSharedData, i);
             QObject::connect(slave, &QThread::started, [] { setThreadName("AudioMixerSlaveThread"); });
             slave->start();
             _slaves.emplace_back(slave);
@@ -197,6 +295,7 @@ void AudioMixerSlavePool::resize(int numThreads) {
 
         // ...and erase them
         _slaves.erase(extraBegin, _slaves.end());
+        _deques.resize(numThreads);
     }
 
     _numThreads = _numStarted = _numFinished = numThreads;
@@ -12,6 +12,7 @@
 #ifndef hifi_AudioMixerSlavePool_h
 #define hifi_AudioMixerSlavePool_h
 
+#include <atomic>
 #include <condition_variable>
 #include <mutex>
 #include <vector>
@@ -24,6 +25,25 @@
 
 class AudioMixerSlavePool;
 
+// A frame's worth of nodes for one slave thread. The owning thread takes nodes from the front and idle threads steal
+// from the back; both bounds live in one atomic so that either end is claimed with a single compare-and-swap.
+// It is filled by the pool while the slaves are waiting, and not changed again until the next frame.
+class AudioMixerWorkDeque {
+public:
+    void clear();
+    void push(const SharedNodePointer& node) { _nodes.push_back(node); }
+    void publish();
+
+    bool popFront(SharedNodePointer& node);
+    bool popBack(SharedNodePointer& node);
+
+private:
+    static uint64_t pack(uint32_t front, uint32_t back) { return ((uint64_t)back << 32) | front; }
+
+    std::vector<SharedNodePointer> _nodes;
+    std::atomic<uint64_t> _bounds { 0 };
+};
+
 class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     Q_OBJECT
     using ConstIter = NodeList::const_iterator;
@@ -31,8 +51,8 @@ class AudioMixerSlaveThread : public QThread, public AudioMixerSlave {
     using Lock = std::unique_lock<Mutex>;
 
 public:
-    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData)
-        : AudioMixerSlave(sharedData), _pool(pool) {}
+    AudioMixerSlaveThread(AudioMixerSlavePool& pool, AudioMixerSlave::SharedData& sharedData, int index)
+        : AudioMixerSlave(sharedData), _pool(pool), _index(index) {}
 
     void run() override final;
 
@@ -44,6 +64,7 @@ private:
     bool try_pop(SharedNodePointer& node);
 
     AudioMixerSlavePool& _pool;
+    int _index; // of this thread's work deque
     void (AudioMixerSlave::*_function)(const SharedNodePointer& node) { nullptr };
     bool _stop { false };
 };
@@ -51,7 +72,6 @@ private:
 // Slave pool for audio mixers
 //   AudioMixerSlavePool is not thread-safe! It should be instantiated and used from a single thread.
 class AudioMixerSlavePool {
-    using Queue = tbb::concurrent_queue<SharedNodePointer>;
     using Mutex = std::mutex;
     using Lock = std::unique_lock<Mutex>;
     using ConditionVariable = std::condition_variable;
@@ -80,7 +100,10 @@ public:
     int numThreads() { return _numThreads; }
 
 private:
-    void run(ConstIter begin, ConstIter end);
+    using Cost = std::function<int(const SharedNodePointer& node)>;
+
+    void run(ConstIter begin, ConstIter end, const Cost& cost);
+    void seed(const Cost& cost);
     void resize(int numThreads);
 
     std::vector<std::unique_ptr<AudioMixerSlaveThread>> _slaves;
@@ -101,7 +124,9 @@ private:
     int _numStopped { 0 }; // guarded by _mutex
 
     // frame state
-    Queue _queue;
+    std::vector<std::unique_ptr<AudioMixerWorkDeque>> _deques;
+    std::vector<std::pair<int, SharedNodePointer>> _costs;
+    std::vector<int> _loads;
     ConstIter _begin;
     ConstIter _end;
 
@@ -21,6 +21,7 @@ void AudioMixerStats::reset() {
     hrtfRenders = 0;
     hrtfResets = 0;
     hrtfUpdates = 0;
+    hrtfSharedRenders = 0;
 
     manualStereoMixes = 0;
     manualEchoMixes = 0;
@@ -31,10 +32,19 @@ void AudioMixerStats::reset() {
     inactiveToActive = 0;
     activeToSkipped = 0;
     activeToInactive = 0;
+    activeToDistant = 0;
+    inactiveToDistant = 0;
+    distantToInactive = 0;
 
     skipped = 0;
     inactive = 0;
     active = 0;
+    distant = 0;
+
+    steals = 0;
+
+    encodes = 0;
+    sharedEncodes = 0;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime = 0;
@@ -51,6 +61,7 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     hrtfRenders += otherStats.hrtfRenders;
     hrtfResets += otherStats.hrtfResets;
     hrtfUpdates += otherStats.hrtfUpdates;
+    hrtfSharedRenders += otherStats.hrtfSharedRenders;
 
     manualStereoMixes += otherStats.manualStereoMixes;
     manualEchoMixes += otherStats.manualEchoMixes;
@@ -61,10 +72,19 @@ void AudioMixerStats::accumulate(const AudioMixerStats& otherStats) {
     inactiveToActive += otherStats.inactiveToActive;
     activeToSkipped += otherStats.activeToSkipped;
     activeToInactive += otherStats.activeToInactive;
+    activeToDistant += otherStats.activeToDistant;
+    inactiveToDistant += otherStats.inactiveToDistant;
+    distantToInactive += otherStats.distantToInactive;
 
     skipped += otherStats.skipped;
     inactive += otherStats.inactive;
     active += otherStats.active;
+    distant += otherStats.distant;
+
+    steals += otherStats.steals;
+
+    encodes += otherStats.encodes;
+    sharedEncodes += otherStats.sharedEncodes;
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     mixTime += otherStats.mixTime;
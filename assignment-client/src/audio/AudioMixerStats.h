@@ -26,6 +26,7 @@ struct AudioMixerStats {
     int hrtfRenders { 0 };
     int hrtfResets { 0 };
     int hrtfUpdates { 0 };
+    int hrtfSharedRenders { 0 }; // mixes that reused another listener's render
 
     int manualStereoMixes { 0 };
     int manualEchoMixes { 0 };
@@ -36,10 +37,19 @@ struct AudioMixerStats {
     int inactiveToActive { 0 };
     int activeToSkipped { 0 };
     int activeToInactive { 0 };
+    int activeToDistant { 0 };
+    int inactiveToDistant { 0 };
+    int distantToInactive { 0 };
 
     int skipped { 0 };
     int inactive { 0 };
     int active { 0 };
+    int distant { 0 }; // streams out of audible range, not looked at
+
+    int steals { 0 }; // nodes a slave took from another slave's deque
+
+    int encodes { 0 };
+    int sharedEncodes { 0 }; // mixes sent with another listener's encode
 
 #ifdef HIFI_AUDIO_MIXER_DEBUG
     uint64_t mixTime { 0 };
@@ -0,0 +1,40 @@
+//
+//  AudioMixerStreamGrid.cpp
+//  assignment-client/src/audio
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioMixerStreamGrid.h"
+
+#include <algorithm>
+
+#include "AudioMixerClientData.h"
+
+void AudioMixerStreamGrid::build(NodeList::const_iterator begin, NodeList::const_iterator end) {
+    // keep the cells' storage from frame to frame, and drop the cells that stayed empty
+    for (auto itr = _cells.begin(); itr != _cells.end();) {
+        if (itr->second.empty()) {
+            itr = _cells.erase(itr);
+        } else {
+            itr->second.clear();
+            ++itr;
+        }
+    }
+    _numStreams = 0;
+
+    std::for_each(begin, end, [&](const SharedNodePointer& node) {
+        AudioMixerClientData* nodeData = static_cast<AudioMixerClientData*>(node->getLinkedData());
+        if (nodeData) {
+            for (auto& stream : nodeData->getAudioStreams()) {
+                glm::vec3 position = stream->getPosition();
+                _cells[keyOf(cellOf(position))].push_back({ position, stream.get() });
+                ++_numStreams;
+            }
+        }
+    });
+}
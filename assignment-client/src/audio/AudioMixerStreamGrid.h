@@ -0,0 +1,95 @@
+//
+//  AudioMixerStreamGrid.h
+//  assignment-client/src/audio
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AudioMixerStreamGrid_h
+#define overte_AudioMixerStreamGrid_h
+
+#include <cmath>
+#include <unordered_map>
+#include <vector>
+
+#include <glm/glm.hpp>
+
+#include <NodeList.h>
+#include <PositionalAudioStream.h>
+
+// A uniform grid of the positions of all the audio streams, built once per frame before mixing, so that each listener
+// can find the streams within its audible range without looking at every stream in the domain.
+//
+// build() is called between frames; query() concurrently from the mixing slaves.
+static const float STREAM_GRID_CELL_SIZE = 16.0f; // meters
+
+class AudioMixerStreamGrid {
+public:
+    void build(NodeList::const_iterator begin, NodeList::const_iterator end);
+
+    // calls function(PositionalAudioStream*) for each stream within radius of center
+    template <typename Function>
+    void query(const glm::vec3& center, float radius, Function function) const;
+
+    int size() const { return _numStreams; }
+
+private:
+    struct Entry {
+        glm::vec3 position;
+        PositionalAudioStream* stream;
+    };
+    using Cell = std::vector<Entry>;
+
+    static glm::ivec3 cellOf(const glm::vec3& position) {
+        return glm::ivec3(glm::floor(position / STREAM_GRID_CELL_SIZE));
+    }
+    static int64_t keyOf(const glm::ivec3& cell) {
+        const int64_t MASK = (1 << 21) - 1;
+        return ((cell.x & MASK) << 42) | ((cell.y & MASK) << 21) | (cell.z & MASK);
+    }
+
+    std::unordered_map<int64_t, Cell> _cells;
+    int _numStreams { 0 };
+};
+
+template <typename Function>
+void AudioMixerStreamGrid::query(const glm::vec3& center, float radius, Function function) const {
+    float radius2 = radius * radius;
+    auto visit = [&](const Cell& cell) {
+        for (const auto& entry : cell) {
+            glm::vec3 offset = entry.position - center;
+            if (glm::dot(offset, offset) <= radius2) {
+                function(entry.stream);
+            }
+        }
+    };
+
+    // visit the cells that overlap the sphere, or every cell if that is fewer
+    double cellsAcross = 2.0 * std::ceil(radius / STREAM_GRID_CELL_SIZE) + 1.0;
+    if (!(cellsAcross * cellsAcross * cellsAcross <= (double)_cells.size())) {
+        for (const auto& cell : _cells) {
+            visit(cell.second);
+        }
+        return;
+    }
+
+    glm::ivec3 low = cellOf(center - glm::vec3(radius));
+    glm::ivec3 high = cellOf(center + glm::vec3(radius));
+
+    for (int x = low.x; x <= high.x; ++x) {
+        for (int y = low.y; y <= high.y; ++y) {
+            for (int z = low.z; z <= high.z; ++z) {
+                auto itr = _cells.find(keyOf(glm::ivec3(x, y, z)));
+                if (itr != _cells.end()) {
+                    visit(itr->second);
+                }
+            }
+        }
+    }
+}
+
+#endif // overte_AudioMixerStreamGrid_h
@@ -847,6 +847,8 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["sent_5_averageTraitsBytes"] = TIGHT_LOOP_STAT(aggregateStats.numTraitsBytesSent);
     slavesAggregatObject["sent_6_averageIdentityBytes"] = TIGHT_LOOP_STAT(aggregateStats.numIdentityBytesSent);
     slavesAggregatObject["sent_7_averageHeroAvatars"] = TIGHT_LOOP_STAT(aggregateStats.numHeroesIncluded);
+    slavesAggregatObject["sent_8_sharedAvatarDataEncodes"] = TIGHT_LOOP_STAT(aggregateStats.numSharedAvatarDataEncodes);
+    slavesAggregatObject["sent_9_sharedAvatarDataReuses"] = TIGHT_LOOP_STAT(aggregateStats.numSharedAvatarDataReuses);
 
     slavesAggregatObject["timing_1_processIncomingPackets"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.processIncomingPacketsElapsedTime);
     slavesAggregatObject["timing_2_ignoreCalculation"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.ignoreCalculationElapsedTime);
@@ -854,6 +856,7 @@ void AvatarMixer::sendStatsPacket() {
     slavesAggregatObject["timing_4_avatarDataPacking"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.avatarDataPackingElapsedTime);
     slavesAggregatObject["timing_5_packetSending"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.packetSendingElapsedTime);
     slavesAggregatObject["timing_6_jobElapsedTime"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.jobElapsedTime);
+    slavesAggregatObject["timing_7_toByteArraySaved"] = TIGHT_LOOP_STAT_UINT64(aggregateStats.toByteArraySavedTime);
 
     statsObject["slaves_aggregate (per frame)"] = slavesAggregatObject;
 
@@ -1112,7 +1115,7 @@ void AvatarMixer::handleOctreePacket(QSharedPointer<ReceivedMessage> message, Sh
         const auto piggyBackedSizeWithHeader = message->getBytesLeftToRead();
         if (piggyBackedSizeWithHeader > 0) {
             // pull out the piggybacked packet and create a new QSharedPointer<NLPacket> for it
-            auto buffer = std::unique_ptr<char[]>(new char[piggyBackedSizeWithHeader]);
+            auto buffer = udt::PacketBufferPool::acquire(piggyBackedSizeWithHeader);
             memcpy(buffer.get(), message->getRawMessage() + message->getPosition(), piggyBackedSizeWithHeader);
 
             auto newPacket = NLPacket::fromReceivedPacket(std::move(buffer), piggyBackedSizeWithHeader, message->getSenderSockAddr());
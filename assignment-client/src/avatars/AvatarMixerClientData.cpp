@@ -45,6 +45,41 @@ void AvatarMixerClientData::setLastOtherAvatarEncodeTime(NLPacket::LocalID other
     }
 }
 
+QByteArray AvatarMixerClientData::getSharedAvatarData(HRCTime frameTimestamp, AvatarData::AvatarDataDetail detail,
+                                                      AvatarDataPacket::HasFlags flags, bool& wasShared,
+                                                      quint64& encodeTime) const {
+    // the level of detail only changes how the joints are encoded
+    if (!(flags & AvatarDataPacket::PACKET_HAS_ANY_JOINT_DATA)) {
+        detail = AvatarData::NoData;
+    }
+
+    std::lock_guard<std::mutex> lock(_sharedAvatarDataMutex);
+
+    if (_sharedAvatarDataFrame != frameTimestamp) {
+        // the avatar may have changed since the last broadcast, start over
+        _sharedAvatarData.clear();
+        _sharedAvatarDataFrame = frameTimestamp;
+    }
+
+    auto itr = std::find_if(_sharedAvatarData.begin(), _sharedAvatarData.end(), [&](const SharedAvatarData& data) {
+        return data.detail == detail && data.flags == flags;
+    });
+    if (itr != _sharedAvatarData.end()) {
+        wasShared = true;
+        encodeTime = itr->encodeTime;
+        return itr->bytes;
+    }
+
+    auto start = usecTimestampNow();
+
+    QByteArray bytes = _avatar->toSharedByteArray(detail, flags);
+
+    wasShared = false;
+    encodeTime = usecTimestampNow() - start;
+    _sharedAvatarData.push_back({ detail, flags, bytes, encodeTime });
+    return bytes;
+}
+
 void AvatarMixerClientData::queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node) {
     if (!_packetQueue.node) {
         _packetQueue.node = node;
@@ -14,6 +14,7 @@
 
 #include <algorithm>
 #include <cfloat>
+#include <mutex>
 #include <unordered_map>
 #include <vector>
 #include <queue>
@@ -129,6 +130,12 @@ public:
 
     QVector<JointData>& getLastOtherAvatarSentJoints(NLPacket::LocalID otherAvatar) { return _lastOtherAvatarSentJoints[otherAvatar]; }
 
+    // Returns this avatar's data encoded with exactly the given flags (UUID included). Encodings that don't depend on
+    // the listener are made once per broadcast frame and shared by every slave; wasShared is set when the bytes came
+    // from an earlier call in the same frame, and encodeTime is what that encode cost in microseconds.
+    QByteArray getSharedAvatarData(HRCTime frameTimestamp, AvatarData::AvatarDataDetail detail,
+                                   AvatarDataPacket::HasFlags flags, bool& wasShared, quint64& encodeTime) const;
+
     void queuePacket(QSharedPointer<ReceivedMessage> message, SharedNodePointer node);
     int processPackets(const SlaveSharedData& slaveSharedData); // returns number of packets processed
 
@@ -177,6 +184,16 @@ private:
     std::unordered_map<NLPacket::LocalID, uint64_t> _lastOtherAvatarEncodeTime;
     std::unordered_map<NLPacket::LocalID, QVector<JointData>> _lastOtherAvatarSentJoints;
 
+    struct SharedAvatarData {
+        AvatarData::AvatarDataDetail detail;
+        AvatarDataPacket::HasFlags flags;
+        QByteArray bytes;
+        quint64 encodeTime;
+    };
+    mutable std::mutex _sharedAvatarDataMutex;
+    mutable HRCTime _sharedAvatarDataFrame;
+    mutable std::vector<SharedAvatarData> _sharedAvatarData;
+
     uint64_t _identityChangeTimestamp;
     bool _avatarSessionDisplayNameMustChange{ true };
     bool _avatarSkeletonModelUrlMustChange{ false };
@@ -311,6 +311,39 @@ namespace {
 
 }  // Close anonymous namespace.
 
+// Encodes the first chunk of a source avatar's data for a listener. Everything but the joints is independent of the
+// listener, so it's encoded once per frame and shared; only the joint deltas against what this listener last received
+// are encoded here. Returns false without touching sendStatus if the shared part doesn't fit in maxDataSize.
+bool AvatarMixerSlave::encodeFromSharedAvatarData(const AvatarMixerClientData* sourceNodeData,
+                                                  AvatarData::AvatarDataDetail detail, quint64 lastSentTime,
+                                                  QVector<JointData>& lastSentJoints,
+                                                  AvatarDataPacket::SendStatus& sendStatus, glm::vec3 viewerPosition,
+                                                  int maxDataSize, QByteArray& bytes) {
+    if (detail == AvatarData::NoData) {
+        return false;
+    }
+
+    const MixerAvatar* sourceAvatar = sourceNodeData->getConstAvatarData();
+    const bool dropFaceTracking = false;
+    AvatarDataPacket::HasFlags wantedFlags = sourceAvatar->getWantedDataFlags(detail, lastSentTime, dropFaceTracking);
+    AvatarDataPacket::HasFlags jointFlags = wantedFlags & AvatarDataPacket::PACKET_HAS_ANY_JOINT_DATA;
+    AvatarDataPacket::HasFlags sharedFlags = wantedFlags & ~jointFlags;
+
+    bool wasShared = false;
+    quint64 encodeTime = 0;
+    QByteArray sharedBytes = sourceNodeData->getSharedAvatarData(_lastFrameTimestamp, detail, sharedFlags, wasShared,
+                                                                 encodeTime);
+    if (wasShared) {
+        _stats.numSharedAvatarDataReuses++;
+        _stats.toByteArraySavedTime += encodeTime;
+    } else {
+        _stats.numSharedAvatarDataEncodes++;
+    }
+
+    return sourceAvatar->appendToSharedByteArray(sharedBytes, detail, lastSentTime, lastSentJoints, jointFlags, sendStatus,
+                                                 dropFaceTracking, viewerPosition, maxDataSize, bytes);
+}
+
 void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node) {
     const Node* destinationNode = node.data();
 
@@ -580,11 +613,17 @@ void AvatarMixerSlave::broadcastAvatarDataToAgent(const SharedNodePointer& node)
             AvatarDataPacket::SendStatus sendStatus;
             sendStatus.sendUUID = true;
 
+            bool isFirstChunk = true;
             do {
                 auto startSerialize = chrono::high_resolution_clock::now();
-                QByteArray bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
-                    sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
-                    &lastSentJointsForOther, avatarSpaceAvailable);
+                QByteArray bytes;
+                if (!(isFirstChunk && encodeFromSharedAvatarData(sourceNodeData, detail, lastEncodeForOther,
+                        lastSentJointsForOther, sendStatus, destinationPosition, avatarSpaceAvailable, bytes))) {
+                    bytes = sourceAvatar->toByteArray(detail, lastEncodeForOther, lastSentJointsForOther,
+                        sendStatus, dropFaceTracking, distanceAdjust, destinationPosition,
+                        &lastSentJointsForOther, avatarSpaceAvailable);
+                }
+                isFirstChunk = false;
                 auto endSerialize = chrono::high_resolution_clock::now();
                 _stats.toByteArrayElapsedTime +=
                     (quint64)chrono::duration_cast<chrono::microseconds>(endSerialize - startSerialize).count();
@@ -12,6 +12,7 @@
 #ifndef hifi_AvatarMixerSlave_h
 #define hifi_AvatarMixerSlave_h
 
+#include <AvatarData.h>
 #include <NodeList.h>
 
 class AvatarMixerClientData;
@@ -33,11 +34,14 @@ public:
     int numOthersIncluded { 0 };
     int overBudgetAvatars { 0 };
     int numHeroesIncluded { 0 };
+    int numSharedAvatarDataEncodes { 0 };
+    int numSharedAvatarDataReuses { 0 };
 
     quint64 ignoreCalculationElapsedTime { 0 };
     quint64 avatarDataPackingElapsedTime { 0 };
     quint64 packetSendingElapsedTime { 0 };
     quint64 toByteArrayElapsedTime { 0 };
+    quint64 toByteArraySavedTime { 0 }; // encode time avoided by reusing shared avatar data
     quint64 jobElapsedTime { 0 };
 
     void reset() {
@@ -59,11 +63,14 @@ public:
         numOthersIncluded = 0;
         overBudgetAvatars = 0;
         numHeroesIncluded = 0;
+        numSharedAvatarDataEncodes = 0;
+        numSharedAvatarDataReuses = 0;
 
         ignoreCalculationElapsedTime = 0;
         avatarDataPackingElapsedTime = 0;
         packetSendingElapsedTime = 0;
         toByteArrayElapsedTime = 0;
+        toByteArraySavedTime = 0;
         jobElapsedTime = 0;
     }
 
@@ -83,11 +90,14 @@ public:
         numOthersIncluded += rhs.numOthersIncluded;
         overBudgetAvatars += rhs.overBudgetAvatars;
         numHeroesIncluded += rhs.numHeroesIncluded;
+        numSharedAvatarDataEncodes += rhs.numSharedAvatarDataEncodes;
+        numSharedAvatarDataReuses += rhs.numSharedAvatarDataReuses;
 
         ignoreCalculationElapsedTime += rhs.ignoreCalculationElapsedTime;
         avatarDataPackingElapsedTime += rhs.avatarDataPackingElapsedTime;
         packetSendingElapsedTime += rhs.packetSendingElapsedTime;
         toByteArrayElapsedTime += rhs.toByteArrayElapsedTime;
+        toByteArraySavedTime += rhs.toByteArraySavedTime;
         jobElapsedTime += rhs.jobElapsedTime;
         return *this;
     }
@@ -131,6 +141,11 @@ private:
                                         const AvatarMixerClientData* sendingNodeData,
                                         NLPacketList& traitsPacketList);
 
+    bool encodeFromSharedAvatarData(const AvatarMixerClientData* sourceNodeData, AvatarData::AvatarDataDetail detail,
+                                    quint64 lastSentTime, QVector<JointData>& lastSentJoints,
+                                    AvatarDataPacket::SendStatus& sendStatus, glm::vec3 viewerPosition,
+                                    int maxDataSize, QByteArray& bytes);
+
     void broadcastAvatarDataToAgent(const SharedNodePointer& node);
     void broadcastAvatarDataToDownstreamMixer(const SharedNodePointer& node);
 
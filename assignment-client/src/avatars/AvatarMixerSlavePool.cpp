@@ -18,10 +18,15 @@ void AvatarMixerSlaveThread::run() {
     while (true) {
         wait();
 
-        // iterate over all available nodes
-        SharedNodePointer node;
-        while (try_pop(node)) {
-            (this->*_function)(node);
+        {
+            // coalesce the packets sent to every node this thread handles in this frame into as few syscalls as possible
+            NodeList::SendBatch sendBatch(*DependencyManager::get<NodeList>());
+
+            // iterate over all available nodes
+            SharedNodePointer node;
+            while (try_pop(node)) {
+                (this->*_function)(node);
+            }
         }
 
         bool stopping = _stop;
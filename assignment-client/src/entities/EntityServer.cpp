@@ -105,7 +105,7 @@ OctreePointer EntityServer::createTree() {
 }
 
 OctreeServer::UniqueSendThread EntityServer::newSendThread(const SharedNodePointer& node) {
-    return std::unique_ptr<EntityTreeSendThread>(new EntityTreeSendThread(this, node));
+    return UniqueSendThread(new EntityTreeSendThread(this, node));
 }
 
 void EntityServer::beforeRun() {
@@ -22,6 +22,9 @@ EntityTreeSendThread::EntityTreeSendThread(OctreeServer* myServer, const SharedN
 {
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::editingEntityPointer, this, &EntityTreeSendThread::editingEntityPointer, Qt::QueuedConnection);
     connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::deletingEntityPointer, this, &EntityTreeSendThread::deletingEntityPointer, Qt::QueuedConnection);
+    // new entities and the server's simulation of entities are found by the next traversal, we only need to be woken for it
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::addingEntityPointer, this, &EntityTreeSendThread::wakeUp, Qt::QueuedConnection);
+    connect(std::static_pointer_cast<EntityTree>(myServer->getOctree()).get(), &EntityTree::simulationChangedEntities, this, &EntityTreeSendThread::wakeUp, Qt::QueuedConnection);
 
     // connect to connection ID change on EntityNodeData so we can clear state for this receiver
     auto nodeData = static_cast<EntityNodeData*>(node->getLinkedData());
@@ -33,6 +36,7 @@ void EntityTreeSendThread::resetState() {
 
     _knownState.clear();
     _traversal.reset();
+    wakeUp();
 }
 
 void EntityTreeSendThread::preDistributionProcessing() {
@@ -377,7 +381,7 @@ bool EntityTreeSendThread::traverseTreeAndBuildNextPacketPayload(EncodeBitstream
                     // Record explicitly filtered-in entity so that extra entities can be flagged.
                     entityNodeData->insertSentFilteredEntity(entityID);
                 }
-                OctreeElement::AppendState appendEntityState = entity->appendEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
+                OctreeElement::AppendState appendEntityState = entity->appendCachedEntityData(&_packetData, params, _extraEncodeData, entityNode->getCanGetAndSetPrivateUserData());
 
                 if (appendEntityState != OctreeElement::COMPLETED) {
                     if (appendEntityState == OctreeElement::PARTIAL) {
@@ -432,8 +436,10 @@ void EntityTreeSendThread::editingEntityPointer(const EntityItemPointer& entity)
             }
         }
     }
+    wakeUp();
 }
 
 void EntityTreeSendThread::deletingEntityPointer(EntityItem* entity) {
     _knownState.erase(entity);
+    wakeUp();
 }
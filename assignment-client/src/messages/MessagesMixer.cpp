@@ -13,6 +13,7 @@
 
 #include <QtCore/QCoreApplication>
 #include <QtCore/QJsonObject>
+#include <QtCore/QTimer>
 #include <QBuffer>
 #include <LogHandler.h>
 #include <MessagesClient.h>
@@ -21,6 +22,7 @@
 
 const QString MESSAGES_MIXER_LOGGING_NAME = "messages-mixer";
 const int MESSAGES_MIXER_RATE_LIMITER_INTERVAL = 1000; // 1 second
+const int MAX_BATCHED_MESSAGES_SIZE = 64 * 1024; // send a node's batch early once it gets this big
 
 MessagesMixer::MessagesMixer(ReceivedMessage& message) : ThreadedAssignment(message)
 {
@@ -38,6 +40,7 @@ void MessagesMixer::nodeKilled(SharedNodePointer killedNode) {
     for (auto& channel : _channelSubscribers) {
         channel.remove(killedNode->getUUID());
     }
+    _batchedMessages.remove(killedNode->getUUID());
 }
 
 void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessage, SharedNodePointer senderNode) {
@@ -47,27 +50,75 @@ void MessagesMixer::handleMessages(QSharedPointer<ReceivedMessage> receivedMessa
     bool isText;
     auto senderUUID = senderNode->getUUID();
     MessagesClient::decodeMessagesPacket(receivedMessage, channel, isText, message, data, senderID);
-
-    auto nodeList = DependencyManager::get<NodeList>();
+    ++_numMessagesReceived;
 
     auto itr = _allSubscribers.find(senderUUID);
     if (itr == _allSubscribers.end()) {
         _allSubscribers[senderUUID] = 1;
     } else if (*itr >= _maxMessagesPerSecond) {
+        ++_numMessagesRateLimited;
         return;
     } else {
         *itr += 1;
     }
 
-    nodeList->eachMatchingNode(
-        [&](const SharedNodePointer& node)->bool {
-        return node->getActiveSocket() && _channelSubscribers[channel].contains(node->getUUID());
-    },
-        [&](const SharedNodePointer& node) {
-        auto packetList = isText ? MessagesClient::encodeMessagesPacket(channel, message, senderID) :
-                                   MessagesClient::encodeMessagesDataPacket(channel, data, senderID);
-        nodeList->sendPacketList(std::move(packetList), *node);
-    });
+    auto subscribers = _channelSubscribers.constFind(channel);
+    if (subscribers == _channelSubscribers.cend() || subscribers->isEmpty()) {
+        ++_numMessagesWithoutSubscribers;
+        return;
+    }
+
+    // encode the message once and copy it to each subscriber
+    QByteArray encodedMessage = MessagesClient::encodeMessage(channel, isText, isText ? message.toUtf8() : data, senderID);
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (const auto& subscriberUUID : *subscribers) {
+        auto node = nodeList->nodeWithUUID(subscriberUUID);
+        if (!node || !node->getActiveSocket()) {
+            continue;
+        }
+        ++_numMessagesForwarded;
+
+        if (_batchMessages) {
+            QByteArray& batch = _batchedMessages[subscriberUUID];
+            batch.append(encodedMessage);
+            if (batch.size() >= MAX_BATCHED_MESSAGES_SIZE) {
+                sendEncodedMessages(batch, *node);
+                batch.clear();
+            }
+        } else {
+            sendEncodedMessages(encodedMessage, *node);
+        }
+    }
+
+    if (_batchMessages && !_flushScheduled) {
+        // flush once the packets that are already queued for us have been handled
+        _flushScheduled = true;
+        QTimer::singleShot(0, this, &MessagesMixer::flushBatchedMessages);
+    }
+}
+
+void MessagesMixer::flushBatchedMessages() {
+    _flushScheduled = false;
+
+    auto nodeList = DependencyManager::get<NodeList>();
+    for (auto itr = _batchedMessages.cbegin(); itr != _batchedMessages.cend(); ++itr) {
+        if (itr->isEmpty()) {
+            continue;
+        }
+        auto node = nodeList->nodeWithUUID(itr.key());
+        if (node && node->getActiveSocket()) {
+            sendEncodedMessages(*itr, *node);
+        }
+    }
+    _batchedMessages.clear();
+}
+
+void MessagesMixer::sendEncodedMessages(const QByteArray& encodedMessages, const Node& destinationNode) {
+    auto packetList = NLPacketList::create(PacketType::MessagesData, QByteArray(), true, true);
+    packetList->write(encodedMessages);
+    DependencyManager::get<NodeList>()->sendPacketList(std::move(packetList), destinationNode);
+    ++_numPacketListsSent;
 }
 
 void MessagesMixer::handleMessagesSubscribe(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
@@ -99,6 +150,21 @@ void MessagesMixer::sendStatsPacket() {
     });
 
     statsObject["messages"] = messagesMixerObject;
+
+    QJsonObject fanOutStats;
+    fanOutStats["batching"] = _batchMessages;
+    fanOutStats["messages_received"] = _numMessagesReceived;
+    fanOutStats["messages_rate_limited"] = _numMessagesRateLimited;
+    fanOutStats["messages_without_subscribers"] = _numMessagesWithoutSubscribers;
+    fanOutStats["messages_forwarded"] = _numMessagesForwarded;
+    fanOutStats["packet_lists_sent"] = _numPacketListsSent;
+    statsObject["fan_out"] = fanOutStats;
+
+    _numMessagesReceived = 0;
+    _numMessagesRateLimited = 0;
+    _numMessagesWithoutSubscribers = 0;
+    _numMessagesForwarded = 0;
+    _numPacketListsSent = 0;
     ThreadedAssignment::addPacketStatsAndSendStatsPacket(statsObject);
 }
 
@@ -129,6 +195,9 @@ void MessagesMixer::parseDomainServerSettings(const QJsonObject& domainSettings)
     const QString NODE_MESSAGES_PER_SECOND_KEY = "max_node_messages_per_second";
     QJsonValue maxMessagesPerSecondValue = messagesMixerGroupObject.value(NODE_MESSAGES_PER_SECOND_KEY);
     _maxMessagesPerSecond = maxMessagesPerSecondValue.toInt(DEFAULT_NODE_MESSAGES_PER_SECOND);
+
+    const QString BATCH_MESSAGES_KEY = "batch_messages";
+    _batchMessages = messagesMixerGroupObject.value(BATCH_MESSAGES_KEY).toBool(false);
 }
 
 void MessagesMixer::processMaxMessagesContainer() {
@@ -15,6 +15,7 @@
 #ifndef hifi_MessagesMixer_h
 #define hifi_MessagesMixer_h
 
+#include <QtCore/QHash>
 #include <QtCore/QSharedPointer>
 
 #include <ThreadedAssignment.h>
@@ -41,13 +42,29 @@ private slots:
     void stopMaxMessagesProcessor();
     void processMaxMessagesContainer();
 
+    void flushBatchedMessages();
+
 private:
+    void sendEncodedMessages(const QByteArray& encodedMessages, const Node& destinationNode);
+
     QHash<QString, QSet<QUuid>> _channelSubscribers;
     QHash<QUuid, int> _allSubscribers;
 
     const int DEFAULT_NODE_MESSAGES_PER_SECOND = 1000;
     int _maxMessagesPerSecond { 0 };
 
+    // when batching, messages for each node are held until the queued packets have been handled
+    bool _batchMessages { false };
+    bool _flushScheduled { false };
+    QHash<QUuid, QByteArray> _batchedMessages;
+
+    // since the last stats packet
+    int _numMessagesReceived { 0 };
+    int _numMessagesRateLimited { 0 };
+    int _numMessagesWithoutSubscribers { 0 };
+    int _numMessagesForwarded { 0 };
+    int _numPacketListsSent { 0 };
+
     QTimer* _maxMessagesTimer { nullptr };
 };
 
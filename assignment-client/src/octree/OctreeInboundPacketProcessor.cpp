@@ -158,13 +158,23 @@ void OctreeInboundPacketProcessor::processPacket(QSharedPointer<ReceivedMessage>
                         message->getPosition(), maxSize);
             }
 
+            // edits that change items in place only need the read lock, so send threads can keep traversing the tree
+            auto octree = _myServer->getOctree();
             quint64 startProcess, startLock = usecTimestampNow();
-            int editDataBytesRead;
-            _myServer->getOctree()->withWriteLock([&] {
+            int editDataBytesRead = 0;
+            bool processedInPlace = false;
+            octree->withReadLock([&] {
                 startProcess = usecTimestampNow();
-                editDataBytesRead =
-                    _myServer->getOctree()->processEditPacketData(*message, editData, maxSize, sendingNode);
+                processedInPlace =
+                    octree->processEditPacketDataInPlace(*message, editData, maxSize, sendingNode, editDataBytesRead);
             });
+            if (!processedInPlace) {
+                quint64 startWriteLock = usecTimestampNow();
+                octree->withWriteLock([&] {
+                    startProcess += usecTimestampNow() - startWriteLock;
+                    editDataBytesRead = octree->processEditPacketData(*message, editData, maxSize, sendingNode);
+                });
+            }
             quint64 endProcess = usecTimestampNow();
 
             if (debugProcessPacket) {
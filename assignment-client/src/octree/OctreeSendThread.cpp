@@ -11,13 +11,11 @@
 
 #include "OctreeSendThread.h"
 
-#include <chrono>
-#include <thread>
+#include <QtCore/QTimer>
 
 #include <NodeList.h>
 #include <NumericalConstants.h>
 #include <udt/PacketHeaders.h>
-#include <PerfStat.h>
 
 #include "OctreeServer.h"
 #include "OctreeServerConsts.h"
@@ -66,6 +64,48 @@ void OctreeSendThread::setIsShuttingDown() {
 }
 
 
+void OctreeSendThread::initializePooled(QThread* workerThread) {
+    initialize(false);
+
+    _sendTimer = new QTimer(this);
+    _sendTimer->setSingleShot(true);
+    _sendTimer->setTimerType(Qt::PreciseTimer);
+    connect(_sendTimer, &QTimer::timeout, this, &OctreeSendThread::sendAndSchedule);
+
+    moveToThread(workerThread);
+    QMetaObject::invokeMethod(this, "wakeUp");
+}
+
+void OctreeSendThread::wakeUp() {
+    if (!_sendTimer || !_isIdle) {
+        return; // a send is already due
+    }
+    _isIdle = false;
+
+    // don't send more often than every interval, however often we're woken
+    qint64 usecSinceLastSend = usecTimestampNow() - _lastSendAt;
+    _sendTimer->start((int)(std::max<qint64>(0, OCTREE_SEND_INTERVAL_USECS - usecSinceLastSend) / USECS_PER_MSEC));
+}
+
+void OctreeSendThread::sendAndSchedule() {
+    quint64 start = usecTimestampNow();
+    if (!process()) {
+        emit finished();
+        return;
+    }
+    _lastSendAt = start;
+
+    if (_hasMoreToSend) {
+        // fire off the next set of octree elements next interval
+        int elapsed = (usecTimestampNow() - start);
+        _sendTimer->start((int)(std::max(0, OCTREE_SEND_INTERVAL_USECS - elapsed) / USECS_PER_MSEC));
+    } else {
+        // sleep until woken, checking back now and then for changes that don't wake us
+        _isIdle = true;
+        _sendTimer->start(OCTREE_IDLE_SEND_INTERVAL_MSECS);
+    }
+}
+
 bool OctreeSendThread::process() {
     if (_isShuttingDown) {
         return false; // exit early if we're shutting down
@@ -73,11 +113,12 @@ bool OctreeSendThread::process() {
 
     OctreeServer::didProcess(this);
 
-    quint64  start = usecTimestampNow();
-
     // we'd better have a server at this point, or we're in trouble
     assert(_myServer);
 
+    // keep checking back until we can send
+    _hasMoreToSend = true;
+
     // don't do any send processing until the initial load of the octree is complete...
     if (_myServer->isInitialLoadComplete()) {
         if (auto node = _node.lock()) {
@@ -91,39 +132,20 @@ bool OctreeSendThread::process() {
             if (nodeData && nodeData->hasReceivedFirstQuery() && node->getActiveSocket() && !nodeData->isShuttingDown()) {
                 bool viewFrustumChanged = nodeData->updateCurrentViewFrustum();
                 packetDistributor(node, nodeData, viewFrustumChanged);
+
+                _hasMoreToSend = hasSomethingToSend(nodeData) || !shouldStartNewTraversal(nodeData, false) ||
+                    nodeData->isPacketWaiting() || nodeData->hasNextNackedPacket();
+            } else if (nodeData && !nodeData->hasReceivedFirstQuery()) {
+                _hasMoreToSend = false; // the query wakes us
             }
         } else {
             return false; // exit early if we're shutting down
         }
     }
 
-    if (_isShuttingDown) {
-        return false; // exit early if we're shutting down
-    }
-
-    // Only sleep if we're still running and we got the lock last time we tried, otherwise try to get the lock asap
-    if (isStillRunning()) {
-        // dynamically sleep until we need to fire off the next set of octree elements
-        int elapsed = (usecTimestampNow() - start);
-        int usecToSleep =  OCTREE_SEND_INTERVAL_USECS - elapsed;
-
-        if (usecToSleep <= 0) {
-            const int MIN_USEC_TO_SLEEP = 1;
-            usecToSleep = MIN_USEC_TO_SLEEP;
-        }
-
-        {
-            PerformanceWarning warn(false,"OctreeSendThread... usleep()",false,&_usleepTime,&_usleepCalls);
-            std::this_thread::sleep_for(std::chrono::microseconds(usecToSleep));
-        }
-
-    }
-
-    return isStillRunning();  // keep running till they terminate us
+    return !_isShuttingDown;
 }
 
-AtomicUIntStat OctreeSendThread::_usleepTime { 0 };
-AtomicUIntStat OctreeSendThread::_usleepCalls { 0 };
 AtomicUIntStat OctreeSendThread::_totalBytes { 0 };
 AtomicUIntStat OctreeSendThread::_totalWastedBytes { 0 };
 AtomicUIntStat OctreeSendThread::_totalPackets { 0 };
@@ -23,16 +23,22 @@
 
 class OctreeQueryNode;
 class OctreeServer;
+class QTimer;
 
 using AtomicUIntStat = std::atomic<uintmax_t>;
 
-/// Threaded processor for sending octree packets to a single client
+/// Processor for sending octree packets to a single client. It runs non-threaded on a worker of the server's
+/// OctreeSendWorkerPool: a send is scheduled every interval while there's more to send, once there's nothing left it sleeps
+/// until woken by a new query, a nack or a change to the tree.
 class OctreeSendThread : public GenericThread {
     Q_OBJECT
 public:
     OctreeSendThread(OctreeServer* myServer, const SharedNodePointer& node);
     virtual ~OctreeSendThread();
 
+    /// Moves the send thread to the given worker thread, and schedules its first send there
+    void initializePooled(QThread* workerThread);
+
     void setIsShuttingDown();
     bool isShuttingDown() { return _isShuttingDown; }
 
@@ -45,11 +51,12 @@ public:
     static AtomicUIntStat _totalSpecialBytes;
     static AtomicUIntStat _totalSpecialPackets;
 
-    static AtomicUIntStat _usleepTime;
-    static AtomicUIntStat _usleepCalls;
+public slots:
+    /// Schedules a send if there's none due, call through a queued connection from other threads
+    void wakeUp();
 
 protected:
-    /// Implements generic processing behavior for this thread.
+    /// Sends to the client once, returns false once the client is gone.
     virtual bool process() override;
 
     virtual bool traverseTreeAndSendContents(SharedNodePointer node, OctreeQueryNode* nodeData,
@@ -73,7 +80,15 @@ private:
     int _truePacketsSent { 0 }; // available for debug stats
     int _trueBytesSent { 0 }; // available for debug stats
     int _packetsSentThisInterval { 0 }; // used for bandwidth throttle condition
-    bool _isShuttingDown { false };
+    std::atomic<bool> _isShuttingDown { false };
+
+    QTimer* _sendTimer { nullptr };
+    quint64 _lastSendAt { 0 };
+    bool _hasMoreToSend { false }; // set by process()
+    bool _isIdle { true }; // nothing is left to send, the timer only checks back now and then
+
+private slots:
+    void sendAndSchedule();
 };
 
 #endif // hifi_OctreeSendThread_h
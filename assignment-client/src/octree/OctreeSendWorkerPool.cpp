@@ -0,0 +1,58 @@
+//
+//  OctreeSendWorkerPool.cpp
+//  assignment-client/src/octree
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSendWorkerPool.h"
+
+#include <algorithm>
+
+#include <QtCore/QThread>
+
+#include "OctreeSendThread.h"
+
+OctreeSendWorkerPool::OctreeSendWorkerPool(int numWorkers) {
+    numWorkers = std::max(numWorkers, 1);
+    _workers.reserve(numWorkers);
+    for (int i = 0; i < numWorkers; ++i) {
+        auto thread = new QThread();
+        thread->setObjectName(QString("Octree Send Worker %1").arg(i));
+        thread->start();
+        _workers.push_back({ thread, 0 });
+    }
+}
+
+OctreeSendWorkerPool::~OctreeSendWorkerPool() {
+    // send threads deleted later are deleted as their worker finishes
+    for (auto& worker : _workers) {
+        worker.thread->quit();
+    }
+    for (auto& worker : _workers) {
+        worker.thread->wait();
+        delete worker.thread;
+    }
+}
+
+void OctreeSendWorkerPool::add(OctreeSendThread* sendThread) {
+    size_t workerIndex = 0;
+    {
+        std::lock_guard<std::mutex> lock(_workersMutex);
+        auto leastLoaded = std::min_element(_workers.begin(), _workers.end(), [](const Worker& a, const Worker& b) {
+            return a.numSendThreads < b.numSendThreads;
+        });
+        ++leastLoaded->numSendThreads;
+        workerIndex = leastLoaded - _workers.begin();
+    }
+
+    QObject::connect(sendThread, &QObject::destroyed, [this, workerIndex] {
+        std::lock_guard<std::mutex> lock(_workersMutex);
+        --_workers[workerIndex].numSendThreads;
+    });
+    sendThread->initializePooled(_workers[workerIndex].thread);
+}
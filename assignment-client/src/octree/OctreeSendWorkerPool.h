@@ -0,0 +1,43 @@
+//
+//  OctreeSendWorkerPool.h
+//  assignment-client/src/octree
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_OctreeSendWorkerPool_h
+#define overte_OctreeSendWorkerPool_h
+
+#include <mutex>
+#include <vector>
+
+class QThread;
+class OctreeSendThread;
+
+/// Fixed set of worker threads the send threads of an octree server run on. Each send thread is given to the worker
+/// with the fewest clients and stays there, its sends and wake ups are events on that worker's event loop.
+class OctreeSendWorkerPool {
+public:
+    OctreeSendWorkerPool(int numWorkers);
+    ~OctreeSendWorkerPool(); /// waits for the workers to finish, delete the send threads before
+
+    int getNumWorkers() const { return (int)_workers.size(); }
+
+    /// Starts the send thread on a worker, it must be deleted with deleteLater() from then on
+    void add(OctreeSendThread* sendThread);
+
+private:
+    struct Worker {
+        QThread* thread;
+        int numSendThreads;
+    };
+
+    std::mutex _workersMutex; // guards the send thread counts, decremented on the workers
+    std::vector<Worker> _workers;
+};
+
+#endif // overte_OctreeSendWorkerPool_h
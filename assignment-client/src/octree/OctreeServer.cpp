@@ -906,7 +906,7 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 
     // we want to be notified when the thread finishes
     connect(sendThread.get(), &GenericThread::finished, this, &OctreeServer::removeSendThread);
-    sendThread->initialize(true);
+    _sendWorkerPool->add(sendThread.get());
 
     return sendThread;
 }
@@ -914,8 +914,12 @@ OctreeServer::UniqueSendThread OctreeServer::createSendThread(const SharedNodePo
 void OctreeServer::removeSendThread() {
     // If the object has been deleted since the event was queued, sender() will return nullptr
     if (auto sendThread = qobject_cast<OctreeSendThread*>(sender())) {
-        // This deletes the unique_ptr, so sendThread is destructed after that line
-        _sendThreads.erase(sendThread->getNodeUuid());
+        // The node may have a new send thread by now, only remove the one that finished
+        auto it = _sendThreads.find(sendThread->getNodeUuid());
+        if (it != _sendThreads.end() && it->second.get() == sendThread) {
+            // This deletes the unique_ptr, so sendThread is deleted later on its worker
+            _sendThreads.erase(it);
+        }
     }
 }
 
@@ -933,6 +937,9 @@ void OctreeServer::handleOctreeQueryPacket(QSharedPointer<ReceivedMessage> messa
             _sendThreads.erase(it); // Remove right away and wait on thread to be
 
             _sendThreads.emplace(senderNode->getUUID(), createSendThread(senderNode));
+        } else {
+            // the view may have changed
+            QMetaObject::invokeMethod(it->second.get(), "wakeUp");
         }
     }
 }
@@ -943,6 +950,11 @@ void OctreeServer::handleOctreeDataNackPacket(QSharedPointer<ReceivedMessage> me
     OctreeQueryNode* nodeData = dynamic_cast<OctreeQueryNode*>(senderNode->getLinkedData());
     if (nodeData) {
         nodeData->parseNackPacket(*message);
+
+        auto it = _sendThreads.find(senderNode->getUUID());
+        if (it != _sendThreads.end()) {
+            QMetaObject::invokeMethod(it->second.get(), "wakeUp");
+        }
     }
 }
 
@@ -1126,6 +1138,15 @@ void OctreeServer::readConfiguration() {
     qDebug("packetsPerSecondTotalMax=%d _packetsTotalPerInterval=%d",
                     packetsPerSecondTotalMax, _packetsTotalPerInterval);
 
+    // Check to see if the user passed in a command line option for the number of send threads, 0 is one per core
+    int sendThreads = 0;
+    readOptionInt(QString("sendThreads"), settingsSectionObject, sendThreads);
+    if (sendThreads <= 0) {
+        sendThreads = QThread::idealThreadCount();
+    }
+    _sendWorkerPool.reset(new OctreeSendWorkerPool(sendThreads));
+    qDebug("sendThreads=%d", _sendWorkerPool->getNumWorkers());
+
 
     readAdditionalConfiguration(settingsSectionObject);
 }
@@ -1286,6 +1307,7 @@ void OctreeServer::nodeKilled(SharedNodePointer node) {
     if (it != _sendThreads.end()) {
         auto& sendThread = *it->second;
         sendThread.setIsShuttingDown();
+        QMetaObject::invokeMethod(&sendThread, "wakeUp"); // to finish
     }
 
     // calling this here since nodeKilled slot in ReceivedPacketProcessor can't be triggered by signals yet!!
@@ -1327,12 +1349,12 @@ void OctreeServer::aboutToFinish() {
     for (auto& it : _sendThreads) {
         auto& sendThread = *it.second;
         sendThread.setIsShuttingDown();
-        sendThread.terminate();
     }
 
-    // Clear will destruct all the unique_ptr to OctreeSendThreads which will call the GenericThread's dtor
-    // which waits on the thread to be done before returning
+    // Clear will delete all the OctreeSendThreads later on their workers, which happens at the latest as the
+    // workers finish, and destroying the pool waits on that before returning
     _sendThreads.clear(); // Cleans up all the send threads.
+    _sendWorkerPool.reset();
 
     if (_persistManager) {
         _persistThread.quit();
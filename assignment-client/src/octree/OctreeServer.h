@@ -25,6 +25,7 @@
 
 #include "OctreePersistThread.h"
 #include "OctreeSendThread.h"
+#include "OctreeSendWorkerPool.h"
 #include "OctreeServerConsts.h"
 #include "OctreeInboundPacketProcessor.h"
 
@@ -145,7 +146,11 @@ private slots:
     void removeSendThread();
 
 protected:
-    using UniqueSendThread = std::unique_ptr<OctreeSendThread>;
+    // send threads live on the workers of the send worker pool, so are deleted there
+    struct SendThreadDeleter {
+        void operator()(OctreeSendThread* sendThread) const { sendThread->deleteLater(); }
+    };
+    using UniqueSendThread = std::unique_ptr<OctreeSendThread, SendThreadDeleter>;
     using SendThreads = std::unordered_map<QUuid, UniqueSendThread>;
     
     virtual OctreePointer createTree() = 0;
@@ -204,6 +209,7 @@ protected:
     quint64 _startedUSecs;
     QString _safeServerName;
     
+    std::unique_ptr<OctreeSendWorkerPool> _sendWorkerPool;
     SendThreads _sendThreads;
 
     static int _clientCount;
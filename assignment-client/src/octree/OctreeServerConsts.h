@@ -26,4 +26,9 @@ const int MAX_FILENAME_LENGTH = 1024;
 const int INTERVALS_PER_SECOND = 90;
 const int OCTREE_SEND_INTERVAL_USECS = (1000 * 1000)/INTERVALS_PER_SECOND;
 
+/// A client that has been sent everything is only sent to again when something changes, which wakes its send thread:
+/// edits, adds, deletes and the server's simulation of entities do. Changes that don't wake it are picked up at this
+/// interval.
+const int OCTREE_IDLE_SEND_INTERVAL_MSECS = 1000;
+
 #endif // hifi_OctreeServerConsts_h
@@ -855,6 +855,21 @@ void DomainServer::setupNodeListAndAssignments() {
     bool isAuthEnabled = _settingsManager.valueOrDefaultValueForKeyPath(ENABLE_PACKET_AUTHENTICATION).toBool();
     nodeList->setAuthenticatePackets(isAuthEnabled);
 
+    static const QString PACKET_VERIFICATION_METHOD = "metaverse.packet_verification_method";
+    static const QString SIPHASH_VERIFICATION_METHOD = "siphash";
+    bool useSipHash = _settingsManager.valueOrDefaultValueForKeyPath(PACKET_VERIFICATION_METHOD).toString()
+        == SIPHASH_VERIFICATION_METHOD;
+    nodeList->setAuthenticationMethod(useSipHash ? HMACAuth::SIPHASH128 : HMACAuth::MD5);
+
+    static const QString VERIFICATION_WORKER_THREADS = "transport.verification_worker_threads";
+    nodeList->setVerificationWorkerCount(_settingsManager.valueOrDefaultValueForKeyPath(VERIFICATION_WORKER_THREADS).toInt());
+
+    static const QString CONNECTION_WORKER_THREADS = "transport.connection_worker_threads";
+    nodeList->setConnectionWorkerCount(_settingsManager.valueOrDefaultValueForKeyPath(CONNECTION_WORKER_THREADS).toInt());
+
+    static const QString CONGESTION_CONTROL = "transport.congestion_control";
+    nodeList->setCongestionControl(_settingsManager.valueOrDefaultValueForKeyPath(CONGESTION_CONTROL).toString());
+
     connect(nodeList.data(), &LimitedNodeList::nodeAdded, this, &DomainServer::nodeAdded);
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &DomainServer::nodeKilled);
     connect(nodeList.data(), &LimitedNodeList::localSockAddrChanged, this,
@@ -1375,7 +1390,7 @@ void DomainServer::handleConnectedNode(SharedNodePointer newNode, quint64 reques
 
 void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 requestPacketReceiveTime, const SockAddr &senderSockAddr, bool newConnection) {
     const int NUM_DOMAIN_LIST_EXTENDED_HEADER_BYTES = NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID +
-        NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 4;
+        NUM_BYTES_RFC4122_UUID + NLPacket::NUM_BYTES_LOCALID + 5;
 
     // setup the extended header for the domain list packets
     // this data is at the beginning of each of the domain list packets
@@ -1390,6 +1405,7 @@ void DomainServer::sendDomainListToNode(const SharedNodePointer& node, quint64 r
     extendedHeaderStream << node->getLocalID();
     extendedHeaderStream << node->getPermissions();
     extendedHeaderStream << limitedNodeList->getAuthenticatePackets();
+    extendedHeaderStream << quint8(limitedNodeList->getAuthenticationMethod());
     extendedHeaderStream << nodeData->getLastDomainCheckinTimestamp();
     extendedHeaderStream << quint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
     extendedHeaderStream << quint64(duration_cast<microseconds>(p_high_resolution_clock::now().time_since_epoch()).count()) - requestPacketReceiveTime;
@@ -15,6 +15,7 @@
 #include <assert.h>
 
 #include "AudioFOAData.h"
+#include "AudioKernels.h"
 
 #if defined(_MSC_VER)
 #define ALIGN32 __declspec(align(32))
@@ -940,6 +941,8 @@ void rifft512_AVX2(float buf[512]);
 void rfft512_cmadd_1X2_AVX2(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
 void convertInput_AVX2(int16_t* src, float *dst[4], float gain, int numFrames);
 void rotate_4x4_AVX2(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+void rfft512_cmadd_1X2_AVX512(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]);
+void rotate_4x4_AVX512(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
 
 static void rfft512(float buf[512]) {
     static auto f = cpuSupportsAVX2() ? rfft512_AVX2 : rfft512_ref;
@@ -951,31 +954,161 @@ static void rifft512(float buf[512]) {
     (*f)(buf);  // dispatch
 }
 
-static void rfft512_cmadd_1X2(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
-    static auto f = cpuSupportsAVX2() ? rfft512_cmadd_1X2_AVX2 : rfft512_cmadd_1X2_ref;
-    (*f)(src, coef0, coef1, dst0, dst1);    // dispatch
-}
-
 static void convertInput(int16_t* src, float *dst[4], float gain, int numFrames) {
     static auto f = cpuSupportsAVX2() ? convertInput_AVX2 : convertInput_ref;
     (*f)(src, dst, gain, numFrames);  // dispatch
 }
 
-static void rotate_4x4(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
-    static auto f = cpuSupportsAVX2() ? rotate_4x4_AVX2 : rotate_4x4_ref;
-    (*f)(buf, m0, m1, win, numFrames);  // dispatch
-}
-
 #else   // portable reference code
 
 static auto& rfft512 = rfft512_ref;
 static auto& rifft512 = rifft512_ref;
-static auto& rfft512_cmadd_1X2 = rfft512_cmadd_1X2_ref;
 static auto& convertInput = convertInput_ref;
-static auto& rotate_4x4 = rotate_4x4_ref;
 
 #endif
 
+//
+// on ARM64 architecture, NEON is always present
+//
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+static void rfft512_cmadd_1X2_NEON(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
+
+    // NOTE: x[n/2].re is packed into x[0].im
+    float t00 = dst0[0] + src[0] * coef0[0];    // first bin is real
+    float t01 = dst0[1] + src[1] * coef0[1];    // last bin is real
+
+    float t10 = dst1[0] + src[0] * coef1[0];    // first bin is real
+    float t11 = dst1[1] + src[1] * coef1[1];    // last bin is real
+
+    for (int i = 0; i < 512; i += 8) {
+
+        float32x4x2_t a = vld2q_f32(&src[i]);   // deinterleave into { re, im }
+        float32x4x2_t b = vld2q_f32(&coef0[i]);
+        float32x4x2_t c = vld2q_f32(&coef1[i]);
+
+        float32x4x2_t d0 = vld2q_f32(&dst0[i]);
+        float32x4x2_t d1 = vld2q_f32(&dst1[i]);
+
+        d0.val[0] = vaddq_f32(d0.val[0], vsubq_f32(vmulq_f32(a.val[0], b.val[0]), vmulq_f32(a.val[1], b.val[1])));  // re
+        d0.val[1] = vaddq_f32(d0.val[1], vaddq_f32(vmulq_f32(a.val[0], b.val[1]), vmulq_f32(a.val[1], b.val[0])));  // im
+
+        d1.val[0] = vaddq_f32(d1.val[0], vsubq_f32(vmulq_f32(a.val[0], c.val[0]), vmulq_f32(a.val[1], c.val[1])));  // re
+        d1.val[1] = vaddq_f32(d1.val[1], vaddq_f32(vmulq_f32(a.val[0], c.val[1]), vmulq_f32(a.val[1], c.val[0])));  // im
+
+        vst2q_f32(&dst0[i], d0);
+        vst2q_f32(&dst1[i], d1);
+    }
+
+    // fix the real values
+    dst0[0] = t00;
+    dst0[1] = t01;
+
+    dst1[0] = t10;
+    dst1[1] = t11;
+}
+
+static void rotate_4x4_NEON(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
+
+    // matrix difference
+    const float md[4][4] = {
+        { m0[0][0] - m1[0][0], m0[0][1] - m1[0][1], m0[0][2] - m1[0][2], m0[0][3] - m1[0][3] },
+        { m0[1][0] - m1[1][0], m0[1][1] - m1[1][1], m0[1][2] - m1[1][2], m0[1][3] - m1[1][3] },
+        { m0[2][0] - m1[2][0], m0[2][1] - m1[2][1], m0[2][2] - m1[2][2], m0[2][3] - m1[2][3] },
+        { m0[3][0] - m1[3][0], m0[3][1] - m1[3][1], m0[3][2] - m1[3][2], m0[3][3] - m1[3][3] },
+    };
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t frac = vld1q_f32(&win[i]);
+
+        // interpolate the matrix
+        float32x4_t m00 = vaddq_f32(vdupq_n_f32(m1[0][0]), vmulq_n_f32(frac, md[0][0]));
+
+        float32x4_t m11 = vaddq_f32(vdupq_n_f32(m1[1][1]), vmulq_n_f32(frac, md[1][1]));
+        float32x4_t m21 = vaddq_f32(vdupq_n_f32(m1[2][1]), vmulq_n_f32(frac, md[2][1]));
+        float32x4_t m31 = vaddq_f32(vdupq_n_f32(m1[3][1]), vmulq_n_f32(frac, md[3][1]));
+
+        float32x4_t m12 = vaddq_f32(vdupq_n_f32(m1[1][2]), vmulq_n_f32(frac, md[1][2]));
+        float32x4_t m22 = vaddq_f32(vdupq_n_f32(m1[2][2]), vmulq_n_f32(frac, md[2][2]));
+        float32x4_t m32 = vaddq_f32(vdupq_n_f32(m1[3][2]), vmulq_n_f32(frac, md[3][2]));
+
+        float32x4_t m13 = vaddq_f32(vdupq_n_f32(m1[1][3]), vmulq_n_f32(frac, md[1][3]));
+        float32x4_t m23 = vaddq_f32(vdupq_n_f32(m1[2][3]), vmulq_n_f32(frac, md[2][3]));
+        float32x4_t m33 = vaddq_f32(vdupq_n_f32(m1[3][3]), vmulq_n_f32(frac, md[3][3]));
+
+        float32x4_t b1 = vld1q_f32(&buf[1][i]);
+        float32x4_t b2 = vld1q_f32(&buf[2][i]);
+        float32x4_t b3 = vld1q_f32(&buf[3][i]);
+
+        // matrix multiply
+        float32x4_t w = vmulq_f32(m00, vld1q_f32(&buf[0][i]));
+
+        float32x4_t x = vaddq_f32(vaddq_f32(vmulq_f32(m11, b1), vmulq_f32(m12, b2)), vmulq_f32(m13, b3));
+        float32x4_t y = vaddq_f32(vaddq_f32(vmulq_f32(m21, b1), vmulq_f32(m22, b2)), vmulq_f32(m23, b3));
+        float32x4_t z = vaddq_f32(vaddq_f32(vmulq_f32(m31, b1), vmulq_f32(m32, b2)), vmulq_f32(m33, b3));
+
+        vst1q_f32(&buf[0][i], w);
+        vst1q_f32(&buf[1][i], x);
+        vst1q_f32(&buf[2][i], y);
+        vst1q_f32(&buf[3][i], z);
+    }
+}
+
+#endif
+
+//
+// Kernel tables
+//
+
+const AudioKernels::Table<AudioKernels::FOARotation>& AudioKernels::foaRotation() {
+    static const Table<FOARotation> table = [] {
+        Table<FOARotation> table;
+        table.variants[SCALAR] = rotate_4x4_ref;
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        table.variants[AVX2] = rotate_4x4_AVX2;
+#ifndef STACK_PROTECTOR
+        table.variants[AVX512] = rotate_4x4_AVX512;
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+        table.variants[NEON] = rotate_4x4_NEON;
+#endif
+        return table;
+    }();
+    return table;
+}
+
+const AudioKernels::Table<AudioKernels::FOAConvolution>& AudioKernels::foaConvolution() {
+    static const Table<FOAConvolution> table = [] {
+        Table<FOAConvolution> table;
+        table.variants[SCALAR] = rfft512_cmadd_1X2_ref;
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        table.variants[AVX2] = rfft512_cmadd_1X2_AVX2;
+#ifndef STACK_PROTECTOR
+        table.variants[AVX512] = rfft512_cmadd_1X2_AVX512;
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+        table.variants[NEON] = rfft512_cmadd_1X2_NEON;
+#endif
+        return table;
+    }();
+    return table;
+}
+
+static void rfft512_cmadd_1X2(const float src[512], const float coef0[512], const float coef1[512], float dst0[512], float dst1[512]) {
+    static auto f = AudioKernels::foaConvolution().select();
+    (*f)(src, coef0, coef1, dst0, dst1);    // dispatch
+}
+
+static void rotate_4x4(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames) {
+    static auto f = AudioKernels::foaRotation().select();
+    (*f)(buf, m0, m1, win, numFrames);  // dispatch
+}
+
 //
 // Equal-gain crossfade
 //
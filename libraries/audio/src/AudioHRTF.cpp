@@ -16,6 +16,7 @@
 #include <assert.h>
 
 #include "AudioHRTFData.h"
+#include "AudioKernels.h"
 
 #if defined(_MSC_VER)
 #define ALIGN32 __declspec(align(32))
@@ -150,6 +151,75 @@ static const float lowpassTable[NLOWPASS+1][5] = {  // { b0, b1, b2, a1, a2 }
     { 0.0000208917f, 0.0000066920f, -0.0000002695f, -1.9925952275f, 0.9926225417f },
 };
 
+//
+// portable reference code
+//
+
+// 1 channel input, 4 channel output
+static void FIR_1x4_ref(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        dst0[i+0] = 0.0f;
+        dst0[i+1] = 0.0f;
+        dst0[i+2] = 0.0f;
+        dst0[i+3] = 0.0f;
+
+        dst1[i+0] = 0.0f;
+        dst1[i+1] = 0.0f;
+        dst1[i+2] = 0.0f;
+        dst1[i+3] = 0.0f;
+
+        dst2[i+0] = 0.0f;
+        dst2[i+1] = 0.0f;
+        dst2[i+2] = 0.0f;
+        dst2[i+3] = 0.0f;
+
+        dst3[i+0] = 0.0f;
+        dst3[i+1] = 0.0f;
+        dst3[i+2] = 0.0f;
+        dst3[i+3] = 0.0f;
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            // channel 0
+            dst0[i+0] += coef0[-k-0] * ps[k+0] + coef0[-k-1] * ps[k+1] + coef0[-k-2] * ps[k+2] + coef0[-k-3] * ps[k+3];
+            dst0[i+1] += coef0[-k-0] * ps[k+1] + coef0[-k-1] * ps[k+2] + coef0[-k-2] * ps[k+3] + coef0[-k-3] * ps[k+4];
+            dst0[i+2] += coef0[-k-0] * ps[k+2] + coef0[-k-1] * ps[k+3] + coef0[-k-2] * ps[k+4] + coef0[-k-3] * ps[k+5];
+            dst0[i+3] += coef0[-k-0] * ps[k+3] + coef0[-k-1] * ps[k+4] + coef0[-k-2] * ps[k+5] + coef0[-k-3] * ps[k+6];
+
+            // channel 1
+            dst1[i+0] += coef1[-k-0] * ps[k+0] + coef1[-k-1] * ps[k+1] + coef1[-k-2] * ps[k+2] + coef1[-k-3] * ps[k+3];
+            dst1[i+1] += coef1[-k-0] * ps[k+1] + coef1[-k-1] * ps[k+2] + coef1[-k-2] * ps[k+3] + coef1[-k-3] * ps[k+4];
+            dst1[i+2] += coef1[-k-0] * ps[k+2] + coef1[-k-1] * ps[k+3] + coef1[-k-2] * ps[k+4] + coef1[-k-3] * ps[k+5];
+            dst1[i+3] += coef1[-k-0] * ps[k+3] + coef1[-k-1] * ps[k+4] + coef1[-k-2] * ps[k+5] + coef1[-k-3] * ps[k+6];
+
+            // channel 2
+            dst2[i+0] += coef2[-k-0] * ps[k+0] + coef2[-k-1] * ps[k+1] + coef2[-k-2] * ps[k+2] + coef2[-k-3] * ps[k+3];
+            dst2[i+1] += coef2[-k-0] * ps[k+1] + coef2[-k-1] * ps[k+2] + coef2[-k-2] * ps[k+3] + coef2[-k-3] * ps[k+4];
+            dst2[i+2] += coef2[-k-0] * ps[k+2] + coef2[-k-1] * ps[k+3] + coef2[-k-2] * ps[k+4] + coef2[-k-3] * ps[k+5];
+            dst2[i+3] += coef2[-k-0] * ps[k+3] + coef2[-k-1] * ps[k+4] + coef2[-k-2] * ps[k+5] + coef2[-k-3] * ps[k+6];
+
+            // channel 3
+            dst3[i+0] += coef3[-k-0] * ps[k+0] + coef3[-k-1] * ps[k+1] + coef3[-k-2] * ps[k+2] + coef3[-k-3] * ps[k+3];
+            dst3[i+1] += coef3[-k-0] * ps[k+1] + coef3[-k-1] * ps[k+2] + coef3[-k-2] * ps[k+3] + coef3[-k-3] * ps[k+4];
+            dst3[i+2] += coef3[-k-0] * ps[k+2] + coef3[-k-1] * ps[k+3] + coef3[-k-2] * ps[k+4] + coef3[-k-3] * ps[k+5];
+            dst3[i+3] += coef3[-k-0] * ps[k+3] + coef3[-k-1] * ps[k+4] + coef3[-k-2] * ps[k+5] + coef3[-k-3] * ps[k+6];
+        }
+    }
+}
+
 //
 // on x86 architecture, assume that SSE2 is present
 //
@@ -380,23 +450,11 @@ static void interpolate_SSE(const float* src0, const float* src1, float* dst, fl
 
 #include "CPUDetect.h"
 
-void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
-void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
 void interleave_4x4_AVX2(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames);
 void biquad2_4x4_AVX2(float* src, float* dst, float coef[5][8], float state[3][8], int numFrames);
 void crossfade_4x2_AVX2(float* src, float* dst, const float* win, int numFrames);
 void interpolate_AVX2(const float* src0, const float* src1, float* dst, float frac, float gain);
 
-static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
-#ifndef STACK_PROTECTOR
-    // Enabling -fstack-protector on gcc causes an undefined reference to FIR_1x4_AVX512 here
-    static auto f = cpuSupportsAVX512() ? FIR_1x4_AVX512 : (cpuSupportsAVX2() ? FIR_1x4_AVX2 : FIR_1x4_SSE);
-#else
-    static auto f = cpuSupportsAVX2() ? FIR_1x4_AVX2 : FIR_1x4_SSE;
-#endif
-    (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
-}
-
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
     static auto f = cpuSupportsAVX2() ? interleave_4x4_AVX2 : interleave_4x4_SSE;
     (*f)(src0, src1, src2, src3, dst, numFrames); // dispatch
@@ -419,71 +477,6 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
 
 #else   // portable reference code
 
-// 1 channel input, 4 channel output
-static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
-
-    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
-    float* coef1 = coef[1] + HRTF_TAPS - 1;
-    float* coef2 = coef[2] + HRTF_TAPS - 1;
-    float* coef3 = coef[3] + HRTF_TAPS - 1;
-
-    assert(numFrames % 4 == 0);
-
-    for (int i = 0; i < numFrames; i += 4) {
-
-        dst0[i+0] = 0.0f;
-        dst0[i+1] = 0.0f;
-        dst0[i+2] = 0.0f;
-        dst0[i+3] = 0.0f;
-
-        dst1[i+0] = 0.0f;
-        dst1[i+1] = 0.0f;
-        dst1[i+2] = 0.0f;
-        dst1[i+3] = 0.0f;
-
-        dst2[i+0] = 0.0f;
-        dst2[i+1] = 0.0f;
-        dst2[i+2] = 0.0f;
-        dst2[i+3] = 0.0f;
-
-        dst3[i+0] = 0.0f;
-        dst3[i+1] = 0.0f;
-        dst3[i+2] = 0.0f;
-        dst3[i+3] = 0.0f;
-
-        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
-
-        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
-
-        for (int k = 0; k < HRTF_TAPS; k += 4) {
-
-            // channel 0
-            dst0[i+0] += coef0[-k-0] * ps[k+0] + coef0[-k-1] * ps[k+1] + coef0[-k-2] * ps[k+2] + coef0[-k-3] * ps[k+3];
-            dst0[i+1] += coef0[-k-0] * ps[k+1] + coef0[-k-1] * ps[k+2] + coef0[-k-2] * ps[k+3] + coef0[-k-3] * ps[k+4];
-            dst0[i+2] += coef0[-k-0] * ps[k+2] + coef0[-k-1] * ps[k+3] + coef0[-k-2] * ps[k+4] + coef0[-k-3] * ps[k+5];
-            dst0[i+3] += coef0[-k-0] * ps[k+3] + coef0[-k-1] * ps[k+4] + coef0[-k-2] * ps[k+5] + coef0[-k-3] * ps[k+6];
-
-            // channel 1
-            dst1[i+0] += coef1[-k-0] * ps[k+0] + coef1[-k-1] * ps[k+1] + coef1[-k-2] * ps[k+2] + coef1[-k-3] * ps[k+3];
-            dst1[i+1] += coef1[-k-0] * ps[k+1] + coef1[-k-1] * ps[k+2] + coef1[-k-2] * ps[k+3] + coef1[-k-3] * ps[k+4];
-            dst1[i+2] += coef1[-k-0] * ps[k+2] + coef1[-k-1] * ps[k+3] + coef1[-k-2] * ps[k+4] + coef1[-k-3] * ps[k+5];
-            dst1[i+3] += coef1[-k-0] * ps[k+3] + coef1[-k-1] * ps[k+4] + coef1[-k-2] * ps[k+5] + coef1[-k-3] * ps[k+6];
-
-            // channel 2
-            dst2[i+0] += coef2[-k-0] * ps[k+0] + coef2[-k-1] * ps[k+1] + coef2[-k-2] * ps[k+2] + coef2[-k-3] * ps[k+3];
-            dst2[i+1] += coef2[-k-0] * ps[k+1] + coef2[-k-1] * ps[k+2] + coef2[-k-2] * ps[k+3] + coef2[-k-3] * ps[k+4];
-            dst2[i+2] += coef2[-k-0] * ps[k+2] + coef2[-k-1] * ps[k+3] + coef2[-k-2] * ps[k+4] + coef2[-k-3] * ps[k+5];
-            dst2[i+3] += coef2[-k-0] * ps[k+3] + coef2[-k-1] * ps[k+4] + coef2[-k-2] * ps[k+5] + coef2[-k-3] * ps[k+6];
-
-            // channel 3
-            dst3[i+0] += coef3[-k-0] * ps[k+0] + coef3[-k-1] * ps[k+1] + coef3[-k-2] * ps[k+2] + coef3[-k-3] * ps[k+3];
-            dst3[i+1] += coef3[-k-0] * ps[k+1] + coef3[-k-1] * ps[k+2] + coef3[-k-2] * ps[k+3] + coef3[-k-3] * ps[k+4];
-            dst3[i+2] += coef3[-k-0] * ps[k+2] + coef3[-k-1] * ps[k+3] + coef3[-k-2] * ps[k+4] + coef3[-k-3] * ps[k+5];
-            dst3[i+3] += coef3[-k-0] * ps[k+3] + coef3[-k-1] * ps[k+4] + coef3[-k-2] * ps[k+5] + coef3[-k-3] * ps[k+6];
-        }
-    }
-}
-
 // 4 channel planar to interleaved
 static void interleave_4x4(float* src0, float* src1, float* src2, float* src3, float* dst, int numFrames) {
 
@@ -691,6 +684,104 @@ static void interpolate(const float* src0, const float* src1, float* dst, float
 
 #endif
 
+//
+// on ARM64 architecture, NEON is always present
+//
+#if defined(__ARM_NEON) || defined(_M_ARM64)
+
+#include <arm_neon.h>
+
+// 1 channel input, 4 channel output
+static void FIR_1x4_NEON(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+
+    float* coef0 = coef[0] + HRTF_TAPS - 1;     // process backwards
+    float* coef1 = coef[1] + HRTF_TAPS - 1;
+    float* coef2 = coef[2] + HRTF_TAPS - 1;
+    float* coef3 = coef[3] + HRTF_TAPS - 1;
+
+    assert(numFrames % 4 == 0);
+
+    for (int i = 0; i < numFrames; i += 4) {
+
+        float32x4_t acc0 = vdupq_n_f32(0.0f);
+        float32x4_t acc1 = vdupq_n_f32(0.0f);
+        float32x4_t acc2 = vdupq_n_f32(0.0f);
+        float32x4_t acc3 = vdupq_n_f32(0.0f);
+
+        float* ps = &src[i - HRTF_TAPS + 1];    // process forwards
+
+        static_assert(HRTF_TAPS % 4 == 0, "HRTF_TAPS must be a multiple of 4");
+
+        for (int k = 0; k < HRTF_TAPS; k += 4) {
+
+            float32x4_t x0 = vld1q_f32(&ps[k+0]);
+            acc0 = vaddq_f32(acc0, vmulq_n_f32(x0, coef0[-k-0]));
+            acc1 = vaddq_f32(acc1, vmulq_n_f32(x0, coef1[-k-0]));
+            acc2 = vaddq_f32(acc2, vmulq_n_f32(x0, coef2[-k-0]));
+            acc3 = vaddq_f32(acc3, vmulq_n_f32(x0, coef3[-k-0]));
+
+            float32x4_t x1 = vld1q_f32(&ps[k+1]);
+            acc0 = vaddq_f32(acc0, vmulq_n_f32(x1, coef0[-k-1]));
+            acc1 = vaddq_f32(acc1, vmulq_n_f32(x1, coef1[-k-1]));
+            acc2 = vaddq_f32(acc2, vmulq_n_f32(x1, coef2[-k-1]));
+            acc3 = vaddq_f32(acc3, vmulq_n_f32(x1, coef3[-k-1]));
+
+            float32x4_t x2 = vld1q_f32(&ps[k+2]);
+            acc0 = vaddq_f32(acc0, vmulq_n_f32(x2, coef0[-k-2]));
+            acc1 = vaddq_f32(acc1, vmulq_n_f32(x2, coef1[-k-2]));
+            acc2 = vaddq_f32(acc2, vmulq_n_f32(x2, coef2[-k-2]));
+            acc3 = vaddq_f32(acc3, vmulq_n_f32(x2, coef3[-k-2]));
+
+            float32x4_t x3 = vld1q_f32(&ps[k+3]);
+            acc0 = vaddq_f32(acc0, vmulq_n_f32(x3, coef0[-k-3]));
+            acc1 = vaddq_f32(acc1, vmulq_n_f32(x3, coef1[-k-3]));
+            acc2 = vaddq_f32(acc2, vmulq_n_f32(x3, coef2[-k-3]));
+            acc3 = vaddq_f32(acc3, vmulq_n_f32(x3, coef3[-k-3]));
+        }
+
+        vst1q_f32(&dst0[i], acc0);
+        vst1q_f32(&dst1[i], acc1);
+        vst1q_f32(&dst2[i], acc2);
+        vst1q_f32(&dst3[i], acc3);
+    }
+}
+
+#endif
+
+//
+// Kernel table
+//
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+void FIR_1x4_AVX2(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+void FIR_1x4_AVX512(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames);
+#endif
+
+const AudioKernels::Table<AudioKernels::HRTFConvolution>& AudioKernels::hrtfConvolution() {
+    static const Table<HRTFConvolution> table = [] {
+        Table<HRTFConvolution> table;
+        table.variants[SCALAR] = FIR_1x4_ref;
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        table.variants[SSE] = FIR_1x4_SSE;
+        table.variants[AVX2] = FIR_1x4_AVX2;
+#ifndef STACK_PROTECTOR
+        // Enabling -fstack-protector on gcc causes an undefined reference to FIR_1x4_AVX512 here
+        table.variants[AVX512] = FIR_1x4_AVX512;
+#endif
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+        table.variants[NEON] = FIR_1x4_NEON;
+#endif
+        return table;
+    }();
+    return table;
+}
+
+// 1 channel input, 4 channel output
+static void FIR_1x4(float* src, float* dst0, float* dst1, float* dst2, float* dst3, float coef[4][HRTF_TAPS], int numFrames) {
+    static auto f = AudioKernels::hrtfConvolution().select();
+    (*f)(src, dst0, dst1, dst2, dst3, coef, numFrames); // dispatch
+}
+
 // apply gain crossfade with accumulation (interleaved)
 static void gainfade_1x2(int16_t* src, float* dst, const float* win, float gain0, float gain1, int numFrames) {
 
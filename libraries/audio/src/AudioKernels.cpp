@@ -0,0 +1,57 @@
+//
+//  AudioKernels.cpp
+//  libraries/audio/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioKernels.h"
+
+#include "CPUDetect.h"
+
+const char* AudioKernels::isaName(int isa) {
+    switch (isa) {
+        case SCALAR:
+            return "scalar";
+        case SSE:
+            return "SSE";
+        case AVX2:
+            return "AVX2";
+        case AVX512:
+            return "AVX-512";
+        case NEON:
+            return "NEON";
+        default:
+            return "unknown";
+    }
+}
+
+bool AudioKernels::isSupported(int isa) {
+    switch (isa) {
+        case SCALAR:
+            return true;
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+        // on x86 architecture, assume that SSE2 is present
+        case SSE:
+            return true;
+        case AVX2: {
+            static const bool supported = cpuSupportsAVX2();
+            return supported;
+        }
+        case AVX512: {
+            static const bool supported = cpuSupportsAVX512();
+            return supported;
+        }
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+        // on ARM64 architecture, NEON is always present
+        case NEON:
+            return true;
+#endif
+        default:
+            return false;
+    }
+}
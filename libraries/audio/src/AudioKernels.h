@@ -0,0 +1,73 @@
+//
+//  AudioKernels.h
+//  libraries/audio/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AudioKernels_h
+#define overte_AudioKernels_h
+
+#include "AudioHRTF.h"
+
+//
+// Runtime dispatch of the vectorized audio kernels.
+//
+// Each kernel has a table of variants indexed by instruction set. The portable scalar variant is always present, and
+// select() returns the variant for the best instruction set that this CPU supports. The whole table is exposed so that
+// every variant can be tested and benchmarked against the scalar one.
+//
+// AudioSRC is not in a table. It already picks AVX2 at runtime on x86 and is built with NEON on ARM, and its
+// polyphase filters are only padded to a multiple of 8 taps, which an AVX-512 variant could not use without masking.
+//
+namespace AudioKernels {
+
+enum ISA {
+    SCALAR = 0,
+    SSE,
+    AVX2,
+    AVX512,
+    NEON,
+    NUM_ISAS
+};
+
+const char* isaName(int isa);
+
+// true if the instruction set is built in and supported by this CPU
+bool isSupported(int isa);
+
+template <typename Function>
+struct Table {
+    Function variants[NUM_ISAS] {};
+
+    Function select() const {
+        for (int isa = NUM_ISAS - 1; isa > SCALAR; isa--) {
+            if (variants[isa] && isSupported(isa)) {
+                return variants[isa];
+            }
+        }
+        return variants[SCALAR];
+    }
+};
+
+// AudioHRTF: 1 channel input, 4 channel FIR output
+using HRTFConvolution = void (*)(float* src, float* dst0, float* dst1, float* dst2, float* dst3,
+                                 float coef[4][HRTF_TAPS], int numFrames);
+const Table<HRTFConvolution>& hrtfConvolution();
+
+// AudioFOA: rotate 4 channels in place, crossfading from matrix m1 to m0
+using FOARotation = void (*)(float* buf[4], const float m0[4][4], const float m1[4][4], const float* win, int numFrames);
+const Table<FOARotation>& foaRotation();
+
+// AudioFOA: binaural decode, complex multiply-accumulate of one spectrum with two filters
+using FOAConvolution = void (*)(const float src[512], const float coef0[512], const float coef1[512],
+                                float dst0[512], float dst1[512]);
+const Table<FOAConvolution>& foaConvolution();
+
+}
+
+#endif // overte_AudioKernels_h
@@ -431,6 +431,8 @@ int AudioSRC::multirateFilter4_ref(const float* input0, const float* input1, con
 //
 // Runtime CPU dispatch
 //
+// No AVX-512 variant: the taps are only padded to a multiple of 8 (see AudioKernels.h)
+//
 
 #include "CPUDetect.h"
 
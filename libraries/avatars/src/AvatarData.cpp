@@ -51,6 +51,7 @@
 #include "AvatarLogging.h"
 #include "AvatarTraits.h"
 #include "ClientTraitsHandler.h"
+#include "JointPacking.h"
 #include "ResourceRequestObserver.h"
 #include "WarningsSuppression.h"
 
@@ -294,6 +295,129 @@ float AvatarData::getDistanceBasedMinTranslationDistance(glm::vec3 viewerPositio
 }
 
 
+AvatarDataPacket::HasFlags AvatarData::getWantedDataFlags(AvatarDataDetail dataDetail, quint64 lastSentTime,
+                                                       bool dropFaceTracking) const {
+    if (dataDetail == NoData) {
+        return 0;
+    }
+
+    bool sendAll = (dataDetail == SendAllData);
+    bool sendMinimum = (dataDetail == MinimumData);
+    bool sendPALMinimum = (dataDetail == PALMinimum);
+
+    lazyInitHeadData();
+
+    bool hasAvatarGlobalPosition = true; // always include global position
+    bool hasAvatarOrientation = false;
+    bool hasAvatarBoundingBox = false;
+    bool hasAvatarScale = false;
+    bool hasLookAtPosition = false;
+    bool hasAudioLoudness = false;
+    bool hasSensorToWorldMatrix = false;
+    bool hasJointData = false;
+    bool hasJointDefaultPoseFlags = false;
+    bool hasAdditionalFlags = false;
+
+    // local position, and parent info only apply to avatars that are parented. The local position
+    // and the parent info can change independently though, so we track their "changed since"
+    // separately
+    bool hasParentInfo = false;
+    bool hasAvatarLocalPosition = false;
+    bool hasHandControllers = false;
+
+    bool hasFaceTrackerInfo = false;
+
+    if (sendPALMinimum) {
+        hasAudioLoudness = true;
+    } else {
+        hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
+        hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
+        hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
+        hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
+        hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
+        hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
+        hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
+        hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
+        hasAvatarLocalPosition = hasParent() && (sendAll ||
+            tranlationChangedSince(lastSentTime) ||
+            parentInfoChangedSince(lastSentTime));
+        hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
+        hasFaceTrackerInfo = !dropFaceTracking && (getHasScriptedBlendshapes() || _headData->_hasInputDrivenBlendshapes) &&
+            (sendAll || faceTrackerInfoChangedSince(lastSentTime));
+        hasJointData = !sendMinimum;
+        hasJointDefaultPoseFlags = hasJointData;
+    }
+
+    return
+        (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
+        | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
+        | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
+        | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
+        | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
+        | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
+        | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
+        | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
+        | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
+        | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
+        | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
+        | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
+        | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
+        | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
+}
+
+QByteArray AvatarData::toSharedByteArray(AvatarDataDetail dataDetail, AvatarDataPacket::HasFlags flags) const {
+    AvatarDataPacket::SendStatus sendStatus;
+    sendStatus.sendUUID = true;
+    sendStatus.itemFlags = flags & ~AvatarDataPacket::PACKET_HAS_ANY_JOINT_DATA;
+    QVector<JointData> noSentJoints { getJointCount() };
+    // without joint records the level of detail makes no difference, other than NoData sending nothing
+    return toByteArray(dataDetail == NoData ? MinimumData : dataDetail, 0, noSentJoints, sendStatus, false, false,
+                       glm::vec3(0), nullptr);
+}
+
+bool AvatarData::appendToSharedByteArray(const QByteArray& sharedBytes, AvatarDataDetail dataDetail,
+                                         quint64 lastSentTime, QVector<JointData>& lastSentJoints,
+                                         AvatarDataPacket::HasFlags jointFlags, AvatarDataPacket::SendStatus& sendStatus,
+                                         bool dropFaceTracking, glm::vec3 viewerPosition, int maxDataSize,
+                                         QByteArray& bytes) const {
+    jointFlags &= AvatarDataPacket::PACKET_HAS_ANY_JOINT_DATA;
+
+    // the joint records are encoded with their own flags, which are dropped when they're appended
+    const int FLAGS_SIZE = (int)AvatarDataPacket::AVATAR_HAS_FLAGS_SIZE;
+    int jointDataSize = maxDataSize - sharedBytes.size() + FLAGS_SIZE;
+    if (sharedBytes.size() > maxDataSize || (jointFlags && jointDataSize < (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE)) {
+        return false;
+    }
+
+    bytes = sharedBytes;
+    sendStatus.itemFlags = 0;
+
+    if (jointFlags) {
+        AvatarDataPacket::SendStatus jointStatus;
+        jointStatus.itemFlags = jointFlags;
+        const bool distanceAdjust = true;
+        QByteArray jointBytes = toByteArray(dataDetail, lastSentTime, lastSentJoints, jointStatus, dropFaceTracking,
+                                            distanceAdjust, viewerPosition, &lastSentJoints, jointDataSize);
+
+        AvatarDataPacket::HasFlags includedFlags;
+        AvatarDataPacket::HasFlags includedJointFlags;
+        memcpy(&includedFlags, bytes.constData() + NUM_BYTES_RFC4122_UUID, FLAGS_SIZE);
+        memcpy(&includedJointFlags, jointBytes.constData(), FLAGS_SIZE);
+        includedFlags |= includedJointFlags;
+
+        bytes.append(jointBytes.constData() + FLAGS_SIZE, jointBytes.size() - FLAGS_SIZE);
+        memcpy(bytes.data() + NUM_BYTES_RFC4122_UUID, &includedFlags, FLAGS_SIZE);
+
+        // anything that didn't fit is sent by the caller in the following chunks
+        sendStatus.itemFlags = jointStatus.itemFlags;
+        sendStatus.rotationsSent = jointStatus.rotationsSent;
+        sendStatus.translationsSent = jointStatus.translationsSent;
+    }
+
+    return true;
+}
+
 // we want to track outbound data in this case...
 QByteArray AvatarData::toByteArrayStateful(AvatarDataDetail dataDetail, bool dropFaceTracking) {
     auto lastSentTime = _lastToByteArray;
@@ -312,8 +436,6 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     bool cullSmallChanges = (dataDetail == CullSmallData);
     bool sendAll = (dataDetail == SendAllData);
-    bool sendMinimum = (dataDetail == MinimumData);
-    bool sendPALMinimum = (dataDetail == PALMinimum);
 
     lazyInitHeadData();
     ASSERT(maxDataSize == 0 || (size_t)maxDataSize >= AvatarDataPacket::MIN_BULK_PACKET_SIZE);
@@ -363,67 +485,11 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
 
     if (sendStatus.itemFlags == 0) {
         // New avatar ...
-        bool hasAvatarGlobalPosition = true; // always include global position
-        bool hasAvatarOrientation = false;
-        bool hasAvatarBoundingBox = false;
-        bool hasAvatarScale = false;
-        bool hasLookAtPosition = false;
-        bool hasAudioLoudness = false;
-        bool hasSensorToWorldMatrix = false;
-        bool hasJointData = false;
-        bool hasJointDefaultPoseFlags = false;
-        bool hasAdditionalFlags = false;
-
-        // local position, and parent info only apply to avatars that are parented. The local position
-        // and the parent info can change independently though, so we track their "changed since"
-        // separately
-        bool hasParentInfo = false;
-        bool hasAvatarLocalPosition = false;
-        bool hasHandControllers = false;
-
-        bool hasFaceTrackerInfo = false;
-
-        if (sendPALMinimum) {
-            hasAudioLoudness = true;
-        } else {
-            hasAvatarOrientation = sendAll || rotationChangedSince(lastSentTime);
-            hasAvatarBoundingBox = sendAll || avatarBoundingBoxChangedSince(lastSentTime);
-            hasAvatarScale = sendAll || avatarScaleChangedSince(lastSentTime);
-            hasLookAtPosition = sendAll || lookAtPositionChangedSince(lastSentTime);
-            hasAudioLoudness = sendAll || audioLoudnessChangedSince(lastSentTime);
-            hasSensorToWorldMatrix = sendAll || sensorToWorldMatrixChangedSince(lastSentTime);
-            hasAdditionalFlags = sendAll || additionalFlagsChangedSince(lastSentTime);
-            hasParentInfo = sendAll || parentInfoChangedSince(lastSentTime);
-            hasAvatarLocalPosition = hasParent() && (sendAll ||
-                tranlationChangedSince(lastSentTime) ||
-                parentInfoChangedSince(lastSentTime));
-            hasHandControllers = _controllerLeftHandMatrixCache.isValid() || _controllerRightHandMatrixCache.isValid();
-            hasFaceTrackerInfo = !dropFaceTracking && (getHasScriptedBlendshapes() || _headData->_hasInputDrivenBlendshapes) &&
-                (sendAll || faceTrackerInfoChangedSince(lastSentTime));
-            hasJointData = !sendMinimum;
-            hasJointDefaultPoseFlags = hasJointData;
-        }
-
-        wantedFlags =
-            (hasAvatarGlobalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_GLOBAL_POSITION : 0)
-            | (hasAvatarBoundingBox ? AvatarDataPacket::PACKET_HAS_AVATAR_BOUNDING_BOX : 0)
-            | (hasAvatarOrientation ? AvatarDataPacket::PACKET_HAS_AVATAR_ORIENTATION : 0)
-            | (hasAvatarScale ? AvatarDataPacket::PACKET_HAS_AVATAR_SCALE : 0)
-            | (hasLookAtPosition ? AvatarDataPacket::PACKET_HAS_LOOK_AT_POSITION : 0)
-            | (hasAudioLoudness ? AvatarDataPacket::PACKET_HAS_AUDIO_LOUDNESS : 0)
-            | (hasSensorToWorldMatrix ? AvatarDataPacket::PACKET_HAS_SENSOR_TO_WORLD_MATRIX : 0)
-            | (hasAdditionalFlags ? AvatarDataPacket::PACKET_HAS_ADDITIONAL_FLAGS : 0)
-            | (hasParentInfo ? AvatarDataPacket::PACKET_HAS_PARENT_INFO : 0)
-            | (hasAvatarLocalPosition ? AvatarDataPacket::PACKET_HAS_AVATAR_LOCAL_POSITION : 0)
-            | (hasHandControllers ? AvatarDataPacket::PACKET_HAS_HAND_CONTROLLERS : 0)
-            | (hasFaceTrackerInfo ? AvatarDataPacket::PACKET_HAS_FACE_TRACKER_INFO : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_JOINT_DATA : 0)
-            | (hasJointDefaultPoseFlags ? AvatarDataPacket::PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS : 0)
-            | (hasJointData ? AvatarDataPacket::PACKET_HAS_GRAB_JOINTS : 0);
-
-            sendStatus.itemFlags = wantedFlags;
-            sendStatus.rotationsSent = 0;
-            sendStatus.translationsSent = 0;
+        wantedFlags = getWantedDataFlags(dataDetail, lastSentTime, dropFaceTracking);
+
+        sendStatus.itemFlags = wantedFlags;
+        sendStatus.rotationsSent = 0;
+        sendStatus.translationsSent = 0;
     } else {  // Continuing avatar ...
         wantedFlags = sendStatus.itemFlags;
         if (wantedFlags & AvatarDataPacket::PACKET_HAS_GRAB_JOINTS) {
@@ -751,35 +817,84 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         float minRotationDOT = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinRotationDOT(viewerPosition) : AVATAR_MIN_ROTATION_DOT;
 
         int i = sendStatus.rotationsSent;
-        for (; i < numJoints; ++i) {
-            const JointData& data = joints[i];
-            const JointData& last = lastSentJointData[i];
+        const ptrdiff_t jointSize = sizeof(AvatarDataPacket::SixByteQuat);
+        // the batched packing works on fixed size arrays, larger skeletons take the per-joint path
+        const bool canPackJoints = numJoints <= JointPacking::MAX_JOINTS;
+        if (canPackJoints && packetEnd - destinationBuffer >= (numJoints - i) * jointSize + minSizeForJoint) {
+            // There's room for every remaining rotation, so cull and quantize them all at once.
+            JointPacking::Rotations rotations;
+            JointPacking::Rotations lastRotations;
+            JointPacking::PackedRotations packedRotations;
+            for (int j = i; j < numJoints; ++j) {
+                rotations.x[j] = joints[j].rotation.x;
+                rotations.y[j] = joints[j].rotation.y;
+                rotations.z[j] = joints[j].rotation.z;
+                rotations.w[j] = joints[j].rotation.w;
+                lastRotations.x[j] = lastSentJointData[j].rotation.x;
+                lastRotations.y[j] = lastSentJointData[j].rotation.y;
+                lastRotations.z[j] = lastSentJointData[j].rotation.z;
+                lastRotations.w[j] = lastSentJointData[j].rotation.w;
+            }
+            JointPacking::cullAndPackRotations(rotations, lastRotations, i, numJoints, cullSmallChanges, minRotationDOT,
+                                               packedRotations);
 
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
-                if (!data.rotationIsDefaultPose) {
-                    // The dot product for larger rotations is a lower number,
-                    // so if the dot() is less than the value, then the rotation is a larger angle of rotation
-                    if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
-                        || (cullSmallChanges && fabsf(glm::dot(last.rotation, data.rotation)) < minRotationDOT)) {
-                        validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
+            for (; i < numJoints; ++i) {
+                const JointData& data = joints[i];
+                const JointData& last = lastSentJointData[i];
+
+                if (!data.rotationIsDefaultPose && (sendAll || last.rotationIsDefaultPose || packedRotations.changed[i])) {
+                    validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
+#ifdef WANT_DEBUG
+                    rotationSentCount++;
+#endif
+                    destinationBuffer[0] = (uint8_t)(packedRotations.c0[i] >> 8);
+                    destinationBuffer[1] = (uint8_t)packedRotations.c0[i];
+                    destinationBuffer[2] = (uint8_t)(packedRotations.c1[i] >> 8);
+                    destinationBuffer[3] = (uint8_t)packedRotations.c1[i];
+                    destinationBuffer[4] = (uint8_t)(packedRotations.c2[i] >> 8);
+                    destinationBuffer[5] = (uint8_t)packedRotations.c2[i];
+                    destinationBuffer += jointSize;
+
+                    if (sentJoints) {
+                        sentJoints[i].rotation = data.rotation;
+                    }
+                }
+
+                if (sentJoints) {
+                    sentJoints[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
+                }
+            }
+        } else {
+            for (; i < numJoints; ++i) {
+                const JointData& data = joints[i];
+                const JointData& last = lastSentJointData[i];
+
+                if (packetEnd - destinationBuffer >= minSizeForJoint) {
+                    if (!data.rotationIsDefaultPose) {
+                        // The dot product for larger rotations is a lower number,
+                        // so if the dot() is less than the value, then the rotation is a larger angle of rotation
+                        if (sendAll || last.rotationIsDefaultPose || (!cullSmallChanges && last.rotation != data.rotation)
+                            || (cullSmallChanges && fabsf(glm::dot(last.rotation, data.rotation)) < minRotationDOT)) {
+                            validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
-                        rotationSentCount++;
+                            rotationSentCount++;
 #endif
-                        destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
+                            destinationBuffer += packOrientationQuatToSixBytes(destinationBuffer, data.rotation);
 
-                        if (sentJoints) {
-                            sentJoints[i].rotation = data.rotation;
+                            if (sentJoints) {
+                                sentJoints[i].rotation = data.rotation;
+                            }
                         }
                     }
+                } else {
+                    break;
                 }
-            } else {
-                break;
-            }
 
-            if (sentJoints) {
-                sentJoints[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
-            }
+                if (sentJoints) {
+                    sentJoints[i].rotationIsDefaultPose = data.rotationIsDefaultPose;
+                }
 
+            }
         }
         sendStatus.rotationsSent = i;
 
@@ -800,35 +915,78 @@ QByteArray AvatarData::toByteArray(AvatarDataDetail dataDetail, quint64 lastSent
         float minTranslation = (distanceAdjust && cullSmallChanges) ? getDistanceBasedMinTranslationDistance(viewerPosition) : AVATAR_MIN_TRANSLATION;
 
         i = sendStatus.translationsSent;
-        for (; i < numJoints; ++i) {
-            const JointData& data = joints[i];
-            const JointData& last = lastSentJointData[i];
+        if (canPackJoints && packetEnd - destinationBuffer >= (numJoints - i) * jointSize + minSizeForJoint) {
+            // There's room for every remaining translation, so cull and quantize them all at once.
+            JointPacking::Translations translations;
+            JointPacking::Translations lastTranslations;
+            JointPacking::PackedTranslations packedTranslations;
+            for (int j = i; j < numJoints; ++j) {
+                translations.x[j] = joints[j].translation.x;
+                translations.y[j] = joints[j].translation.y;
+                translations.z[j] = joints[j].translation.z;
+                lastTranslations.x[j] = lastSentJointData[j].translation.x;
+                lastTranslations.y[j] = lastSentJointData[j].translation.y;
+                lastTranslations.z[j] = lastSentJointData[j].translation.z;
+            }
+            JointPacking::cullAndPackTranslations(translations, lastTranslations, i, numJoints, cullSmallChanges,
+                                                  minTranslation, maxTranslationDimension, TRANSLATION_COMPRESSION_RADIX,
+                                                  packedTranslations);
 
-            // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
-            if (packetEnd - destinationBuffer >= minSizeForJoint) {
-                if (!data.translationIsDefaultPose) {
-                    if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
-                        || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
-                        validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
+            for (; i < numJoints; ++i) {
+                const JointData& data = joints[i];
+                const JointData& last = lastSentJointData[i];
+
+                if (!data.translationIsDefaultPose &&
+                    (sendAll || last.translationIsDefaultPose || packedTranslations.changed[i])) {
+                    validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
 #ifdef WANT_DEBUG
-                        translationSentCount++;
+                    translationSentCount++;
 #endif
-                        destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
-                                                                               TRANSLATION_COMPRESSION_RADIX);
+                    memcpy(destinationBuffer, &packedTranslations.x[i], sizeof(int16_t));
+                    memcpy(destinationBuffer + sizeof(int16_t), &packedTranslations.y[i], sizeof(int16_t));
+                    memcpy(destinationBuffer + 2 * sizeof(int16_t), &packedTranslations.z[i], sizeof(int16_t));
+                    destinationBuffer += jointSize;
 
-                        if (sentJoints) {
-                            sentJoints[i].translation = data.translation;
-                        }
+                    if (sentJoints) {
+                        sentJoints[i].translation = data.translation;
                     }
                 }
-            } else {
-                break;
-            }
 
-            if (sentJoints) {
-                sentJoints[i].translationIsDefaultPose = data.translationIsDefaultPose;
+                if (sentJoints) {
+                    sentJoints[i].translationIsDefaultPose = data.translationIsDefaultPose;
+                }
             }
+        } else {
+            for (; i < numJoints; ++i) {
+                const JointData& data = joints[i];
+                const JointData& last = lastSentJointData[i];
+
+                // Note minSizeForJoint is conservative since there isn't a following bit-vector + scale.
+                if (packetEnd - destinationBuffer >= minSizeForJoint) {
+                    if (!data.translationIsDefaultPose) {
+                        if (sendAll || last.translationIsDefaultPose || (!cullSmallChanges && last.translation != data.translation)
+                            || (cullSmallChanges && glm::distance(data.translation, lastSentJointData[i].translation) > minTranslation)) {
+                            validityPosition[i / BITS_IN_BYTE] |= 1 << (i % BITS_IN_BYTE);
+#ifdef WANT_DEBUG
+                            translationSentCount++;
+#endif
+                            destinationBuffer += packFloatVec3ToSignedTwoByteFixed(destinationBuffer, data.translation / maxTranslationDimension,
+                                                                                   TRANSLATION_COMPRESSION_RADIX);
 
+                            if (sentJoints) {
+                                sentJoints[i].translation = data.translation;
+                            }
+                        }
+                    }
+                } else {
+                    break;
+                }
+
+                if (sentJoints) {
+                    sentJoints[i].translationIsDefaultPose = data.translationIsDefaultPose;
+                }
+
+            }
         }
         sendStatus.translationsSent = i;
 
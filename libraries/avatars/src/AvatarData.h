@@ -210,6 +210,9 @@ namespace AvatarDataPacket {
     const HasFlags PACKET_HAS_JOINT_DATA               = 1U << 12;
     const HasFlags PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS = 1U << 13;
     const HasFlags PACKET_HAS_GRAB_JOINTS              = 1U << 14;
+    // the joint records are always written last, after every other record
+    const HasFlags PACKET_HAS_ANY_JOINT_DATA = PACKET_HAS_JOINT_DATA | PACKET_HAS_JOINT_DEFAULT_POSE_FLAGS |
+        PACKET_HAS_GRAB_JOINTS;
     const size_t AVATAR_HAS_FLAGS_SIZE = 2;
 
     using SixByteQuat = uint8_t[6];
@@ -632,6 +635,22 @@ public:
         AvatarDataPacket::SendStatus& sendStatus, bool dropFaceTracking, bool distanceAdjust, glm::vec3 viewerPosition,
         QVector<JointData>* sentJointDataOut, int maxDataSize = 0, AvatarDataRate* outboundDataRateOut = nullptr) const;
 
+    // the flags toByteArray will try to include for a new avatar at the given level of detail
+    AvatarDataPacket::HasFlags getWantedDataFlags(AvatarDataDetail dataDetail, quint64 lastSentTime,
+        bool dropFaceTracking) const;
+
+    // Encodes what toByteArray would for a new avatar with these flags, UUID included, but without the joint records -
+    // none of it depends on the listener, so it can be encoded once and shared by every listener.
+    QByteArray toSharedByteArray(AvatarDataDetail dataDetail, AvatarDataPacket::HasFlags flags) const;
+
+    // Encodes the joint records in jointFlags for a listener and splices them onto sharedBytes from toSharedByteArray,
+    // which gives the same bytes and sendStatus as toByteArray for a new avatar. Returns false without touching
+    // sendStatus if sharedBytes leaves no room for the joints in maxDataSize.
+    bool appendToSharedByteArray(const QByteArray& sharedBytes, AvatarDataDetail dataDetail, quint64 lastSentTime,
+        QVector<JointData>& lastSentJoints, AvatarDataPacket::HasFlags jointFlags,
+        AvatarDataPacket::SendStatus& sendStatus, bool dropFaceTracking, glm::vec3 viewerPosition, int maxDataSize,
+        QByteArray& bytes) const;
+
     virtual void doneEncoding(bool cullSmallChanges);
 
     /// \return true if an error should be logged
@@ -0,0 +1,265 @@
+//
+//  JointPacking.cpp
+//  libraries/avatars/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JointPacking.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include <GLMHelpers.h>
+
+#if defined(__GNUC__) && !defined(__clang__)
+// the SIMD versions must match this code bit for bit, so don't let the compiler fuse multiplies and adds
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace JointPacking {
+
+void cullAndPackRotations_ref(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                              bool cullSmallChanges, float minRotationDOT, PackedRotations& packed) {
+    for (int i = begin; i < end; ++i) {
+        glm::quat rotation(rotations.w[i], rotations.x[i], rotations.y[i], rotations.z[i]);
+        glm::quat lastRotation(lastRotations.w[i], lastRotations.x[i], lastRotations.y[i], lastRotations.z[i]);
+
+        // The dot product for larger rotations is a lower number,
+        // so if the dot() is less than the value, then the rotation is a larger angle of rotation
+        if (cullSmallChanges) {
+            packed.changed[i] = fabsf(glm::dot(lastRotation, rotation)) < minRotationDOT;
+        } else {
+            packed.changed[i] = lastRotation != rotation;
+        }
+
+        unsigned char buffer[6];
+        packOrientationQuatToSixBytes(buffer, rotation);
+        packed.c0[i] = (uint16_t)(buffer[0] << 8 | buffer[1]);
+        packed.c1[i] = (uint16_t)(buffer[2] << 8 | buffer[3]);
+        packed.c2[i] = (uint16_t)(buffer[4] << 8 | buffer[5]);
+    }
+}
+
+void cullAndPackTranslations_ref(const Translations& translations, const Translations& lastTranslations, int begin,
+                                 int end, bool cullSmallChanges, float minTranslation, float maxTranslationDimension,
+                                 int radix, PackedTranslations& packed) {
+    for (int i = begin; i < end; ++i) {
+        glm::vec3 translation(translations.x[i], translations.y[i], translations.z[i]);
+        glm::vec3 lastTranslation(lastTranslations.x[i], lastTranslations.y[i], lastTranslations.z[i]);
+
+        if (cullSmallChanges) {
+            packed.changed[i] = glm::distance(translation, lastTranslation) > minTranslation;
+        } else {
+            packed.changed[i] = lastTranslation != translation;
+        }
+
+        int16_t buffer[3];
+        packFloatVec3ToSignedTwoByteFixed(reinterpret_cast<unsigned char*>(buffer), translation / maxTranslationDimension,
+                                          radix);
+        packed.x[i] = buffer[0];
+        packed.y[i] = buffer[1];
+        packed.z[i] = buffer[2];
+    }
+}
+
+}
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+
+#include <emmintrin.h>
+
+#include <CPUDetect.h>
+
+namespace JointPacking {
+
+// mask ? a : b
+static inline __m128 select(__m128 mask, __m128 a, __m128 b) {
+    return _mm_or_ps(_mm_and_ps(mask, a), _mm_andnot_ps(mask, b));
+}
+
+static inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+    return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+// keep the low 16 bits of each lane, like a cast to int16_t or uint16_t
+static inline void store16(void* dst, __m128i x) {
+    x = _mm_srai_epi32(_mm_slli_epi32(x, 16), 16);
+    _mm_storel_epi64((__m128i*)dst, _mm_packs_epi32(x, x));
+}
+
+static void cullAndPackRotations_SSE(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                                     bool cullSmallChanges, float minRotationDOT, PackedRotations& packed) {
+    const __m128 SIGN = _mm_set1_ps(-0.0f);
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const __m128 OFFSET = _mm_set1_ps(MAGNITUDE);
+    const __m128 SCALE = _mm_set1_ps(2.0f * MAGNITUDE);
+    const __m128 RANGE = _mm_set1_ps((float)((1 << 15) - 1));
+    const __m128i LOW_BITS = _mm_set1_epi32(0x7fff);
+
+    int i = begin;
+    for (; i < end - 3; i += 4) {
+        __m128 q0 = _mm_loadu_ps(&rotations.x[i]);
+        __m128 q1 = _mm_loadu_ps(&rotations.y[i]);
+        __m128 q2 = _mm_loadu_ps(&rotations.z[i]);
+        __m128 q3 = _mm_loadu_ps(&rotations.w[i]);
+        __m128 l0 = _mm_loadu_ps(&lastRotations.x[i]);
+        __m128 l1 = _mm_loadu_ps(&lastRotations.y[i]);
+        __m128 l2 = _mm_loadu_ps(&lastRotations.z[i]);
+        __m128 l3 = _mm_loadu_ps(&lastRotations.w[i]);
+
+        // cull, summing the dot product in the same order as glm
+        __m128 changed;
+        if (cullSmallChanges) {
+            __m128 dot = _mm_add_ps(_mm_add_ps(_mm_mul_ps(l3, q3), _mm_mul_ps(l0, q0)),
+                                    _mm_add_ps(_mm_mul_ps(l1, q1), _mm_mul_ps(l2, q2)));
+            changed = _mm_cmplt_ps(_mm_andnot_ps(SIGN, dot), _mm_set1_ps(minRotationDOT));
+        } else {
+            changed = _mm_or_ps(_mm_or_ps(_mm_cmpneq_ps(l0, q0), _mm_cmpneq_ps(l1, q1)),
+                                _mm_or_ps(_mm_cmpneq_ps(l2, q2), _mm_cmpneq_ps(l3, q3)));
+        }
+        int changedBits = _mm_movemask_ps(changed);
+        for (int j = 0; j < 4; ++j) {
+            packed.changed[i + j] = (changedBits >> j) & 1;
+        }
+
+        // find the largest component, the first one on ties
+        __m128 largestAbs = _mm_andnot_ps(SIGN, q0);
+        __m128 largest = q0;
+        __m128i index = _mm_setzero_si128();
+        __m128 mask = _mm_cmpgt_ps(_mm_andnot_ps(SIGN, q1), largestAbs);
+        largestAbs = select(mask, _mm_andnot_ps(SIGN, q1), largestAbs);
+        largest = select(mask, q1, largest);
+        index = select(_mm_castps_si128(mask), _mm_set1_epi32(1), index);
+        mask = _mm_cmpgt_ps(_mm_andnot_ps(SIGN, q2), largestAbs);
+        largestAbs = select(mask, _mm_andnot_ps(SIGN, q2), largestAbs);
+        largest = select(mask, q2, largest);
+        index = select(_mm_castps_si128(mask), _mm_set1_epi32(2), index);
+        mask = _mm_cmpgt_ps(_mm_andnot_ps(SIGN, q3), largestAbs);
+        largest = select(mask, q3, largest);
+        index = select(_mm_castps_si128(mask), _mm_set1_epi32(3), index);
+
+        // ensure that the sign of the dropped component is always negative
+        __m128 flip = _mm_and_ps(_mm_cmpgt_ps(largest, _mm_setzero_ps()), SIGN);
+        q0 = _mm_xor_ps(q0, flip);
+        q1 = _mm_xor_ps(q1, flip);
+        q2 = _mm_xor_ps(q2, flip);
+        q3 = _mm_xor_ps(q3, flip);
+
+        // quantize into 0..range
+        __m128i v0 = _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(_mm_add_ps(q0, OFFSET), SCALE), RANGE));
+        __m128i v1 = _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(_mm_add_ps(q1, OFFSET), SCALE), RANGE));
+        __m128i v2 = _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(_mm_add_ps(q2, OFFSET), SCALE), RANGE));
+        __m128i v3 = _mm_cvttps_epi32(_mm_mul_ps(_mm_div_ps(_mm_add_ps(q3, OFFSET), SCALE), RANGE));
+
+        // keep the smallest three and encode the largest into the high bits of the first two
+        __m128i c0 = select(_mm_cmpeq_epi32(index, _mm_setzero_si128()), v1, v0);
+        __m128i c1 = select(_mm_cmplt_epi32(index, _mm_set1_epi32(2)), v2, v1);
+        __m128i c2 = select(_mm_cmplt_epi32(index, _mm_set1_epi32(3)), v3, v2);
+        c0 = _mm_or_si128(_mm_and_si128(c0, LOW_BITS), _mm_slli_epi32(_mm_and_si128(index, _mm_set1_epi32(1)), 15));
+        c1 = _mm_or_si128(_mm_and_si128(c1, LOW_BITS), _mm_slli_epi32(_mm_and_si128(index, _mm_set1_epi32(2)), 14));
+
+        store16(&packed.c0[i], c0);
+        store16(&packed.c1[i], c1);
+        store16(&packed.c2[i], c2);
+    }
+
+    cullAndPackRotations_ref(rotations, lastRotations, i, end, cullSmallChanges, minRotationDOT, packed);
+}
+
+static void cullAndPackTranslations_SSE(const Translations& translations, const Translations& lastTranslations,
+                                        int begin, int end, bool cullSmallChanges, float minTranslation,
+                                        float maxTranslationDimension, int radix, PackedTranslations& packed) {
+    const __m128 DIMENSION = _mm_set1_ps(maxTranslationDimension);
+    const __m128 SCALE = _mm_set1_ps((float)(1 << radix));
+    const __m128 MIN_FIXED = _mm_set1_ps((float)std::numeric_limits<int16_t>::min());
+    const __m128 MAX_FIXED = _mm_set1_ps((float)std::numeric_limits<int16_t>::max());
+
+    int i = begin;
+    for (; i < end - 3; i += 4) {
+        __m128 t0 = _mm_loadu_ps(&translations.x[i]);
+        __m128 t1 = _mm_loadu_ps(&translations.y[i]);
+        __m128 t2 = _mm_loadu_ps(&translations.z[i]);
+        __m128 l0 = _mm_loadu_ps(&lastTranslations.x[i]);
+        __m128 l1 = _mm_loadu_ps(&lastTranslations.y[i]);
+        __m128 l2 = _mm_loadu_ps(&lastTranslations.z[i]);
+
+        __m128 changed;
+        if (cullSmallChanges) {
+            __m128 d0 = _mm_sub_ps(l0, t0);
+            __m128 d1 = _mm_sub_ps(l1, t1);
+            __m128 d2 = _mm_sub_ps(l2, t2);
+            __m128 distance2 = _mm_add_ps(_mm_add_ps(_mm_mul_ps(d0, d0), _mm_mul_ps(d1, d1)), _mm_mul_ps(d2, d2));
+            changed = _mm_cmpgt_ps(_mm_sqrt_ps(distance2), _mm_set1_ps(minTranslation));
+        } else {
+            changed = _mm_or_ps(_mm_or_ps(_mm_cmpneq_ps(l0, t0), _mm_cmpneq_ps(l1, t1)), _mm_cmpneq_ps(l2, t2));
+        }
+        int changedBits = _mm_movemask_ps(changed);
+        for (int j = 0; j < 4; ++j) {
+            packed.changed[i + j] = (changedBits >> j) & 1;
+        }
+
+        // operand order matches glm::clamp when the value is NaN
+        t0 = _mm_min_ps(MAX_FIXED, _mm_max_ps(MIN_FIXED, _mm_mul_ps(_mm_div_ps(t0, DIMENSION), SCALE)));
+        t1 = _mm_min_ps(MAX_FIXED, _mm_max_ps(MIN_FIXED, _mm_mul_ps(_mm_div_ps(t1, DIMENSION), SCALE)));
+        t2 = _mm_min_ps(MAX_FIXED, _mm_max_ps(MIN_FIXED, _mm_mul_ps(_mm_div_ps(t2, DIMENSION), SCALE)));
+
+        store16(&packed.x[i], _mm_cvttps_epi32(t0));
+        store16(&packed.y[i], _mm_cvttps_epi32(t1));
+        store16(&packed.z[i], _mm_cvttps_epi32(t2));
+    }
+
+    cullAndPackTranslations_ref(translations, lastTranslations, i, end, cullSmallChanges, minTranslation,
+                                maxTranslationDimension, radix, packed);
+}
+
+//
+// Runtime CPU dispatch
+//
+
+void cullAndPackRotations_AVX2(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                               bool cullSmallChanges, float minRotationDOT, PackedRotations& packed);
+void cullAndPackTranslations_AVX2(const Translations& translations, const Translations& lastTranslations, int begin,
+                                  int end, bool cullSmallChanges, float minTranslation, float maxTranslationDimension,
+                                  int radix, PackedTranslations& packed);
+
+void cullAndPackRotations(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                          bool cullSmallChanges, float minRotationDOT, PackedRotations& packed) {
+    static auto f = cpuSupportsAVX2() ? cullAndPackRotations_AVX2 : cullAndPackRotations_SSE;
+    (*f)(rotations, lastRotations, begin, end, cullSmallChanges, minRotationDOT, packed);
+}
+
+void cullAndPackTranslations(const Translations& translations, const Translations& lastTranslations, int begin, int end,
+                             bool cullSmallChanges, float minTranslation, float maxTranslationDimension, int radix,
+                             PackedTranslations& packed) {
+    static auto f = cpuSupportsAVX2() ? cullAndPackTranslations_AVX2 : cullAndPackTranslations_SSE;
+    (*f)(translations, lastTranslations, begin, end, cullSmallChanges, minTranslation, maxTranslationDimension, radix,
+         packed);
+}
+
+}
+
+#else   // portable reference code
+
+namespace JointPacking {
+
+void cullAndPackRotations(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                          bool cullSmallChanges, float minRotationDOT, PackedRotations& packed) {
+    cullAndPackRotations_ref(rotations, lastRotations, begin, end, cullSmallChanges, minRotationDOT, packed);
+}
+
+void cullAndPackTranslations(const Translations& translations, const Translations& lastTranslations, int begin, int end,
+                             bool cullSmallChanges, float minTranslation, float maxTranslationDimension, int radix,
+                             PackedTranslations& packed) {
+    cullAndPackTranslations_ref(translations, lastTranslations, begin, end, cullSmallChanges, minTranslation,
+                                maxTranslationDimension, radix, packed);
+}
+
+}
+
+#endif
@@ -0,0 +1,77 @@
+//
+//  JointPacking.h
+//  libraries/avatars/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_JointPacking_h
+#define overte_JointPacking_h
+
+#include <stdint.h>
+
+// Bulk culling and quantization of joint data for AvatarData::toByteArray.
+//
+// The joints are copied into structure-of-arrays form so that several joints can be culled against the last sent
+// state and quantized at once. The results are bit-identical to the per-joint encoder: changed[i] matches the
+// per-joint cull test and the packed components match packOrientationQuatToSixBytes and
+// packFloatVec3ToSignedTwoByteFixed.
+
+namespace JointPacking {
+
+const int MAX_JOINTS = 256;
+
+struct Rotations {
+    alignas(32) float x[MAX_JOINTS];
+    alignas(32) float y[MAX_JOINTS];
+    alignas(32) float z[MAX_JOINTS];
+    alignas(32) float w[MAX_JOINTS];
+};
+
+struct Translations {
+    alignas(32) float x[MAX_JOINTS];
+    alignas(32) float y[MAX_JOINTS];
+    alignas(32) float z[MAX_JOINTS];
+};
+
+// the three 16 bit words of packOrientationQuatToSixBytes, to be written big-endian
+struct PackedRotations {
+    alignas(32) uint16_t c0[MAX_JOINTS];
+    alignas(32) uint16_t c1[MAX_JOINTS];
+    alignas(32) uint16_t c2[MAX_JOINTS];
+    uint8_t changed[MAX_JOINTS];
+};
+
+// the fixed point components of packFloatVec3ToSignedTwoByteFixed, to be written in host order
+struct PackedTranslations {
+    alignas(32) int16_t x[MAX_JOINTS];
+    alignas(32) int16_t y[MAX_JOINTS];
+    alignas(32) int16_t z[MAX_JOINTS];
+    uint8_t changed[MAX_JOINTS];
+};
+
+// Culls and packs rotations [begin, end). A rotation has changed if its dot product with the last sent rotation is
+// below minRotationDOT when cullSmallChanges is set, or if it differs at all otherwise.
+void cullAndPackRotations(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                          bool cullSmallChanges, float minRotationDOT, PackedRotations& packed);
+
+// Culls and packs translations [begin, end) scaled by 1 / maxTranslationDimension. A translation has changed if it
+// moved further than minTranslation when cullSmallChanges is set, or if it differs at all otherwise.
+void cullAndPackTranslations(const Translations& translations, const Translations& lastTranslations, int begin, int end,
+                             bool cullSmallChanges, float minTranslation, float maxTranslationDimension, int radix,
+                             PackedTranslations& packed);
+
+// the portable per-joint versions, exposed for testing
+void cullAndPackRotations_ref(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                              bool cullSmallChanges, float minRotationDOT, PackedRotations& packed);
+void cullAndPackTranslations_ref(const Translations& translations, const Translations& lastTranslations, int begin,
+                                 int end, bool cullSmallChanges, float minTranslation, float maxTranslationDimension,
+                                 int radix, PackedTranslations& packed);
+
+}
+
+#endif // overte_JointPacking_h
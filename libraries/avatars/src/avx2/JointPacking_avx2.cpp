@@ -0,0 +1,165 @@
+//
+//  JointPacking_avx2.cpp
+//  libraries/avatars/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifdef __AVX2__
+
+#include <cmath>
+#include <limits>
+#include <immintrin.h>
+
+#include "../JointPacking.h"
+
+#if defined(__GNUC__) && !defined(__clang__)
+// this is built with -mfma, but the results must match the reference code bit for bit
+#pragma GCC optimize("fp-contract=off")
+#endif
+
+namespace JointPacking {
+
+// keep the low 16 bits of each lane, like a cast to int16_t or uint16_t
+static inline void store16(void* dst, __m256i x) {
+    x = _mm256_srai_epi32(_mm256_slli_epi32(x, 16), 16);
+    x = _mm256_permute4x64_epi64(_mm256_packs_epi32(x, x), 0x08);
+    _mm_storeu_si128((__m128i*)dst, _mm256_castsi256_si128(x));
+}
+
+void cullAndPackRotations_AVX2(const Rotations& rotations, const Rotations& lastRotations, int begin, int end,
+                               bool cullSmallChanges, float minRotationDOT, PackedRotations& packed) {
+    const __m256 SIGN = _mm256_set1_ps(-0.0f);
+    const float MAGNITUDE = 1.0f / sqrtf(2.0f);
+    const __m256 OFFSET = _mm256_set1_ps(MAGNITUDE);
+    const __m256 SCALE = _mm256_set1_ps(2.0f * MAGNITUDE);
+    const __m256 RANGE = _mm256_set1_ps((float)((1 << 15) - 1));
+    const __m256i LOW_BITS = _mm256_set1_epi32(0x7fff);
+
+    int i = begin;
+    for (; i < end - 7; i += 8) {
+        __m256 q0 = _mm256_loadu_ps(&rotations.x[i]);
+        __m256 q1 = _mm256_loadu_ps(&rotations.y[i]);
+        __m256 q2 = _mm256_loadu_ps(&rotations.z[i]);
+        __m256 q3 = _mm256_loadu_ps(&rotations.w[i]);
+        __m256 l0 = _mm256_loadu_ps(&lastRotations.x[i]);
+        __m256 l1 = _mm256_loadu_ps(&lastRotations.y[i]);
+        __m256 l2 = _mm256_loadu_ps(&lastRotations.z[i]);
+        __m256 l3 = _mm256_loadu_ps(&lastRotations.w[i]);
+
+        // cull, summing the dot product in the same order as glm
+        __m256 changed;
+        if (cullSmallChanges) {
+            __m256 dot = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(l3, q3), _mm256_mul_ps(l0, q0)),
+                                       _mm256_add_ps(_mm256_mul_ps(l1, q1), _mm256_mul_ps(l2, q2)));
+            changed = _mm256_cmp_ps(_mm256_andnot_ps(SIGN, dot), _mm256_set1_ps(minRotationDOT), _CMP_LT_OQ);
+        } else {
+            changed = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(l0, q0, _CMP_NEQ_UQ), _mm256_cmp_ps(l1, q1, _CMP_NEQ_UQ)),
+                                   _mm256_or_ps(_mm256_cmp_ps(l2, q2, _CMP_NEQ_UQ), _mm256_cmp_ps(l3, q3, _CMP_NEQ_UQ)));
+        }
+        int changedBits = _mm256_movemask_ps(changed);
+        for (int j = 0; j < 8; ++j) {
+            packed.changed[i + j] = (changedBits >> j) & 1;
+        }
+
+        // find the largest component, the first one on ties
+        __m256 largestAbs = _mm256_andnot_ps(SIGN, q0);
+        __m256 largest = q0;
+        __m256i index = _mm256_setzero_si256();
+        __m256 mask = _mm256_cmp_ps(_mm256_andnot_ps(SIGN, q1), largestAbs, _CMP_GT_OQ);
+        largestAbs = _mm256_blendv_ps(largestAbs, _mm256_andnot_ps(SIGN, q1), mask);
+        largest = _mm256_blendv_ps(largest, q1, mask);
+        index = _mm256_blendv_epi8(index, _mm256_set1_epi32(1), _mm256_castps_si256(mask));
+        mask = _mm256_cmp_ps(_mm256_andnot_ps(SIGN, q2), largestAbs, _CMP_GT_OQ);
+        largestAbs = _mm256_blendv_ps(largestAbs, _mm256_andnot_ps(SIGN, q2), mask);
+        largest = _mm256_blendv_ps(largest, q2, mask);
+        index = _mm256_blendv_epi8(index, _mm256_set1_epi32(2), _mm256_castps_si256(mask));
+        mask = _mm256_cmp_ps(_mm256_andnot_ps(SIGN, q3), largestAbs, _CMP_GT_OQ);
+        largest = _mm256_blendv_ps(largest, q3, mask);
+        index = _mm256_blendv_epi8(index, _mm256_set1_epi32(3), _mm256_castps_si256(mask));
+
+        // ensure that the sign of the dropped component is always negative
+        __m256 flip = _mm256_and_ps(_mm256_cmp_ps(largest, _mm256_setzero_ps(), _CMP_GT_OQ), SIGN);
+        q0 = _mm256_xor_ps(q0, flip);
+        q1 = _mm256_xor_ps(q1, flip);
+        q2 = _mm256_xor_ps(q2, flip);
+        q3 = _mm256_xor_ps(q3, flip);
+
+        // quantize into 0..range
+        __m256i v0 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_div_ps(_mm256_add_ps(q0, OFFSET), SCALE), RANGE));
+        __m256i v1 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_div_ps(_mm256_add_ps(q1, OFFSET), SCALE), RANGE));
+        __m256i v2 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_div_ps(_mm256_add_ps(q2, OFFSET), SCALE), RANGE));
+        __m256i v3 = _mm256_cvttps_epi32(_mm256_mul_ps(_mm256_div_ps(_mm256_add_ps(q3, OFFSET), SCALE), RANGE));
+
+        // keep the smallest three and encode the largest into the high bits of the first two
+        __m256i c0 = _mm256_blendv_epi8(v0, v1, _mm256_cmpeq_epi32(index, _mm256_setzero_si256()));
+        __m256i c1 = _mm256_blendv_epi8(v1, v2, _mm256_cmpgt_epi32(_mm256_set1_epi32(2), index));
+        __m256i c2 = _mm256_blendv_epi8(v2, v3, _mm256_cmpgt_epi32(_mm256_set1_epi32(3), index));
+        c0 = _mm256_or_si256(_mm256_and_si256(c0, LOW_BITS),
+                             _mm256_slli_epi32(_mm256_and_si256(index, _mm256_set1_epi32(1)), 15));
+        c1 = _mm256_or_si256(_mm256_and_si256(c1, LOW_BITS),
+                             _mm256_slli_epi32(_mm256_and_si256(index, _mm256_set1_epi32(2)), 14));
+
+        store16(&packed.c0[i], c0);
+        store16(&packed.c1[i], c1);
+        store16(&packed.c2[i], c2);
+    }
+
+    cullAndPackRotations_ref(rotations, lastRotations, i, end, cullSmallChanges, minRotationDOT, packed);
+}
+
+void cullAndPackTranslations_AVX2(const Translations& translations, const Translations& lastTranslations, int begin,
+                                  int end, bool cullSmallChanges, float minTranslation, float maxTranslationDimension,
+                                  int radix, PackedTranslations& packed) {
+    const __m256 DIMENSION = _mm256_set1_ps(maxTranslationDimension);
+    const __m256 SCALE = _mm256_set1_ps((float)(1 << radix));
+    const __m256 MIN_FIXED = _mm256_set1_ps((float)std::numeric_limits<int16_t>::min());
+    const __m256 MAX_FIXED = _mm256_set1_ps((float)std::numeric_limits<int16_t>::max());
+
+    int i = begin;
+    for (; i < end - 7; i += 8) {
+        __m256 t0 = _mm256_loadu_ps(&translations.x[i]);
+        __m256 t1 = _mm256_loadu_ps(&translations.y[i]);
+        __m256 t2 = _mm256_loadu_ps(&translations.z[i]);
+        __m256 l0 = _mm256_loadu_ps(&lastTranslations.x[i]);
+        __m256 l1 = _mm256_loadu_ps(&lastTranslations.y[i]);
+        __m256 l2 = _mm256_loadu_ps(&lastTranslations.z[i]);
+
+        __m256 changed;
+        if (cullSmallChanges) {
+            __m256 d0 = _mm256_sub_ps(l0, t0);
+            __m256 d1 = _mm256_sub_ps(l1, t1);
+            __m256 d2 = _mm256_sub_ps(l2, t2);
+            __m256 distance2 = _mm256_add_ps(_mm256_add_ps(_mm256_mul_ps(d0, d0), _mm256_mul_ps(d1, d1)),
+                                             _mm256_mul_ps(d2, d2));
+            changed = _mm256_cmp_ps(_mm256_sqrt_ps(distance2), _mm256_set1_ps(minTranslation), _CMP_GT_OQ);
+        } else {
+            changed = _mm256_or_ps(_mm256_or_ps(_mm256_cmp_ps(l0, t0, _CMP_NEQ_UQ), _mm256_cmp_ps(l1, t1, _CMP_NEQ_UQ)),
+                                   _mm256_cmp_ps(l2, t2, _CMP_NEQ_UQ));
+        }
+        int changedBits = _mm256_movemask_ps(changed);
+        for (int j = 0; j < 8; ++j) {
+            packed.changed[i + j] = (changedBits >> j) & 1;
+        }
+
+        // operand order matches glm::clamp when the value is NaN
+        t0 = _mm256_min_ps(MAX_FIXED, _mm256_max_ps(MIN_FIXED, _mm256_mul_ps(_mm256_div_ps(t0, DIMENSION), SCALE)));
+        t1 = _mm256_min_ps(MAX_FIXED, _mm256_max_ps(MIN_FIXED, _mm256_mul_ps(_mm256_div_ps(t1, DIMENSION), SCALE)));
+        t2 = _mm256_min_ps(MAX_FIXED, _mm256_max_ps(MIN_FIXED, _mm256_mul_ps(_mm256_div_ps(t2, DIMENSION), SCALE)));
+
+        store16(&packed.x[i], _mm256_cvttps_epi32(t0));
+        store16(&packed.y[i], _mm256_cvttps_epi32(t1));
+        store16(&packed.z[i], _mm256_cvttps_epi32(t2));
+    }
+
+    cullAndPackTranslations_ref(translations, lastTranslations, i, end, cullSmallChanges, minTranslation,
+                                maxTranslationDimension, radix, packed);
+}
+
+}
+
+#endif
@@ -186,12 +186,7 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
 
 
     EntityPropertyFlags propertyFlags(PROP_LAST_ITEM);
-    EntityPropertyFlags requestedProperties = getEntityProperties(params);
-
-    // these properties are not sent over the wire
-    requestedProperties -= PROP_ENTITY_HOST_TYPE;
-    requestedProperties -= PROP_OWNING_AVATAR_ID;
-    requestedProperties -= PROP_VISIBLE_IN_SECONDARY_CAMERA;
+    EntityPropertyFlags requestedProperties = getRequestedPropertiesToEncode(params);
 
     // If we are being called for a subsequent pass at appendEntityData() that failed to completely encode this item,
     // then our entityTreeElementExtraEncodeData should include data about which properties we need to append.
@@ -399,6 +394,77 @@ OctreeElement::AppendState EntityItem::appendEntityData(OctreePacketData* packet
     return appendState;
 }
 
+OctreeElement::AppendState EntityItem::appendCachedEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
+                                            EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
+                                            const bool destinationNodeCanGetAndSetPrivateUserData) const {
+    // the rest of an entity that didn't fit last time isn't a complete encoding
+    if (entityTreeElementExtraEncodeData && entityTreeElementExtraEncodeData->entities.contains(getEntityItemID())) {
+        return appendEntityData(packetData, params, entityTreeElementExtraEncodeData, destinationNodeCanGetAndSetPrivateUserData);
+    }
+
+    EncodedDataKey key = getEncodedDataKey(params, destinationNodeCanGetAndSetPrivateUserData);
+
+    QByteArray encodedData;
+    {
+        std::lock_guard<std::mutex> lock(_encodedDataMutex);
+        if (!_encodedData.isEmpty() && _encodedDataKey == key) {
+            encodedData = _encodedData;
+        }
+    }
+    if (!encodedData.isEmpty() && packetData->appendRawData(encodedData)) {
+        params.trackSend(getID(), key.lastEdited);
+        return OctreeElement::COMPLETED;
+    }
+
+    // encode it, as much of it as fits
+    int startOfEntityData = packetData->getUncompressedByteOffset();
+    OctreeElement::AppendState appendState = appendEntityData(packetData, params, entityTreeElementExtraEncodeData,
+                                                              destinationNodeCanGetAndSetPrivateUserData);
+
+    // only keep it if the entity didn't change while it was being encoded
+    if (appendState == OctreeElement::COMPLETED && encodedData.isEmpty() &&
+            getEncodedDataKey(params, destinationNodeCanGetAndSetPrivateUserData) == key) {
+        int endOfEntityData = packetData->getUncompressedByteOffset();
+        QByteArray newEncodedData((const char*)packetData->getUncompressedData(startOfEntityData),
+                                  endOfEntityData - startOfEntityData);
+
+        std::lock_guard<std::mutex> lock(_encodedDataMutex);
+        _encodedDataKey = key;
+        _encodedData = newEncodedData;
+    }
+    return appendState;
+}
+
+bool EntityItem::EncodedDataKey::operator==(const EncodedDataKey& other) const {
+    return lastEdited == other.lastEdited && lastUpdated == other.lastUpdated && lastSimulated == other.lastSimulated &&
+        changedOnServer == other.changedOnServer && requestedProperties == other.requestedProperties &&
+        withPrivateUserData == other.withPrivateUserData;
+}
+
+EntityItem::EncodedDataKey EntityItem::getEncodedDataKey(EncodeBitstreamParams& params, bool withPrivateUserData) const {
+    EncodedDataKey key;
+    // every change to what's encoded moves one of these times forward
+    withReadLock([&] {
+        key.lastEdited = _lastEdited;
+        key.lastUpdated = _lastUpdated;
+        key.lastSimulated = _lastSimulated;
+        key.changedOnServer = _changedOnServer;
+    });
+    key.requestedProperties = getRequestedPropertiesToEncode(params);
+    key.withPrivateUserData = withPrivateUserData;
+    return key;
+}
+
+EntityPropertyFlags EntityItem::getRequestedPropertiesToEncode(EncodeBitstreamParams& params) const {
+    EntityPropertyFlags requestedProperties = getEntityProperties(params);
+
+    // these properties are not sent over the wire
+    requestedProperties -= PROP_ENTITY_HOST_TYPE;
+    requestedProperties -= PROP_OWNING_AVATAR_ID;
+    requestedProperties -= PROP_VISIBLE_IN_SECONDARY_CAMERA;
+    return requestedProperties;
+}
+
 // TODO: My goal is to get rid of this concept completely. The old code (and some of the current code) used this
 // result to calculate if a packet being sent to it was potentially bad or corrupt. I've adjusted this to now
 // only consider the minimum header bytes as being required. But it would be preferable to completely eliminate
@@ -13,6 +13,7 @@
 #define hifi_EntityItem_h
 
 #include <memory>
+#include <mutex>
 #include <stdint.h>
 
 #include <glm/glm.hpp>
@@ -139,6 +140,13 @@ public:
                                                         EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                                         const bool destinationNodeCanGetAndSetPrivateUserData = false) const;
 
+    /// Same as appendEntityData(), but the bytes of a complete encoding are kept, and appended again as they are while the
+    /// entity hasn't changed and the same properties are requested. Used by the entity server, which sends the same entity
+    /// to many clients.
+    OctreeElement::AppendState appendCachedEntityData(OctreePacketData* packetData, EncodeBitstreamParams& params,
+                                                      EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
+                                                      const bool destinationNodeCanGetAndSetPrivateUserData = false) const;
+
     virtual void appendSubclassData(OctreePacketData* packetData, EncodeBitstreamParams& params,
                                     EntityTreeElementExtraEncodeDataPointer entityTreeElementExtraEncodeData,
                                     EntityPropertyFlags& requestedProperties,
@@ -741,6 +749,24 @@ protected:
     bool _cullWithParent { false };
 
     mutable bool _needsRenderUpdate { false };
+
+private:
+    struct EncodedDataKey {
+        quint64 lastEdited { 0 };
+        quint64 lastUpdated { 0 };
+        quint64 lastSimulated { 0 };
+        quint64 changedOnServer { 0 };
+        EntityPropertyFlags requestedProperties;
+        bool withPrivateUserData { false };
+
+        bool operator==(const EncodedDataKey& other) const;
+    };
+    EncodedDataKey getEncodedDataKey(EncodeBitstreamParams& params, bool withPrivateUserData) const;
+    EntityPropertyFlags getRequestedPropertiesToEncode(EncodeBitstreamParams& params) const;
+
+    mutable std::mutex _encodedDataMutex;
+    mutable EncodedDataKey _encodedDataKey;
+    mutable QByteArray _encodedData; // last complete encoding by appendCachedEntityData(), for _encodedDataKey
 };
 
 #endif // hifi_EntityItem_h
@@ -3823,6 +3823,39 @@ bool EntityItemProperties::decodeEntityEditPacket(const unsigned char* data, int
     return valid;
 }
 
+// Reads just the entity ID and the property flags of an edit packet, to tell what it will change before it is decoded
+bool EntityItemProperties::decodeEntityEditPacketFlags(const unsigned char* data, int bytesToRead, EntityItemID& entityID,
+                                                       EntityPropertyFlags& propertyFlags) {
+    int octets = numberOfThreeBitSectionsInCode(data, bytesToRead);
+    if (octets < 0) {
+        return false;
+    }
+    int processedBytes = (int)bytesRequiredForCodeLength(octets) + (int)sizeof(quint64); // the octcode and lastEdited
+    if (bytesToRead - processedBytes < NUM_BYTES_RFC4122_UUID) {
+        return false;
+    }
+    entityID = QUuid::fromRfc4122(QByteArray::fromRawData(reinterpret_cast<const char*>(data + processedBytes),
+                                                          NUM_BYTES_RFC4122_UUID));
+    processedBytes += NUM_BYTES_RFC4122_UUID;
+
+    // skip the entity type and the update delta
+    QByteArray encodedType((const char*)data + processedBytes, bytesToRead - processedBytes);
+    ByteCountCoded<quint32> typeCoder = encodedType;
+    encodedType = typeCoder;
+    processedBytes += encodedType.size();
+
+    QByteArray encodedUpdateDelta((const char*)data + processedBytes, bytesToRead - processedBytes);
+    ByteCountCoded<quint64> updateDeltaCoder = encodedUpdateDelta;
+    encodedUpdateDelta = updateDeltaCoder;
+    processedBytes += encodedUpdateDelta.size();
+
+    if (processedBytes >= bytesToRead) {
+        return false;
+    }
+    propertyFlags.decode(data + processedBytes, bytesToRead - processedBytes);
+    return true;
+}
+
 void EntityItemProperties::setPackedNormals(const QByteArray& value) {
     setNormals(unpackNormals(value));
 }
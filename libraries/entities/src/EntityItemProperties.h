@@ -421,6 +421,8 @@ public:
 
     static bool decodeEntityEditPacket(const unsigned char* data, int bytesToRead, int& processedBytes,
                                        EntityItemID& entityID, EntityItemProperties& properties);
+    static bool decodeEntityEditPacketFlags(const unsigned char* data, int bytesToRead, EntityItemID& entityID,
+                                            EntityPropertyFlags& propertyFlags);
 
     void clearID() { _id = UNKNOWN_ENTITY_ID; _idSet = false; }
     void markAllChanged();
@@ -13,8 +13,11 @@
 //
 
 #include "EntityTree.h"
+#include <atomic>
+#include <thread>
 #include <QtCore/QDateTime>
 #include <QtCore/QQueue>
+#include <QtCore/QThread>
 #include <openssl/err.h>
 #include <openssl/pem.h>
 #include <openssl/x509.h>
@@ -26,6 +29,8 @@
 #include <QJsonArray>
 
 #include <Extents.h>
+#include <OctreeJournal.h>
+#include <OctreeSnapshot.h>
 #include <PerfStat.h>
 #include <Profile.h>
 #include <AddressManager.h>
@@ -354,16 +359,22 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
                 tempProperties.setLocked(wantsLocked);
                 tempProperties.setLastEdited(properties.getLastEdited());
 
-                bool success;
-                AACube queryCube = entity->getQueryAACube(success);
-                if (!success) {
-                    qCWarning(entities) << "failed to get query-cube for" << entity->getID();
+                bool isInPlace = canUpdateEntityInPlace(entity, tempProperties.getChangedProperties());
+                if (!isInPlace) {
+                    bool success;
+                    AACube queryCube = entity->getQueryAACube(success);
+                    if (!success) {
+                        qCWarning(entities) << "failed to get query-cube for" << entity->getID();
+                    }
+                    UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, queryCube);
+                    recurseTreeWithOperator(&theOperator);
                 }
-                UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, queryCube);
-                recurseTreeWithOperator(&theOperator);
                 if (entity->setProperties(tempProperties)) {
                     emit editingEntityPointer(entity);
                 }
+                if (isInPlace) {
+                    markEntityChangedInPlace(containingElement);
+                }
                 _isDirty = true;
             }
         }
@@ -450,23 +461,32 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
         quint64 entityScriptTimestampBefore = entity->getScriptTimestamp();
         uint32_t preFlags = entity->getDirtyFlags();
 
-        AACube newQueryAACube;
-        if (properties.queryAACubeChanged()) {
-            newQueryAACube = properties.getQueryAACube();
-        } else {
-            newQueryAACube = entity->getQueryAACube();
+        // an edit that doesn't move the entity leaves its children where they are too
+        bool isInPlace = canUpdateEntityInPlace(entity, properties.getChangedProperties());
+        if (!isInPlace) {
+            AACube newQueryAACube;
+            if (properties.queryAACubeChanged()) {
+                newQueryAACube = properties.getQueryAACube();
+            } else {
+                newQueryAACube = entity->getQueryAACube();
+            }
+            UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
+            recurseTreeWithOperator(&theOperator);
         }
-        UpdateEntityOperator theOperator(getThisPointer(), containingElement, entity, newQueryAACube);
-        recurseTreeWithOperator(&theOperator);
         if (entity->setProperties(properties)) {
             emit editingEntityPointer(entity);
         }
+        if (isInPlace) {
+            markEntityChangedInPlace(containingElement);
+        }
 
         // if the entity has children, run UpdateEntityOperator on them.  If the children have children, recurse
         QQueue<SpatiallyNestablePointer> toProcess;
-        foreach (SpatiallyNestablePointer child, entity->getChildren()) {
-            if (child && child->getNestableType() == NestableType::Entity) {
-                toProcess.enqueue(child);
+        if (!isInPlace) {
+            foreach (SpatiallyNestablePointer child, entity->getChildren()) {
+                if (child && child->getNestableType() == NestableType::Entity) {
+                    toProcess.enqueue(child);
+                }
             }
         }
 
@@ -532,6 +552,46 @@ bool EntityTree::updateEntity(EntityItemPointer entity, const EntityItemProperti
     return true;
 }
 
+static const EntityPropertyList PLACEMENT_PROPERTIES[] = {
+    PROP_POSITION, PROP_ROTATION, PROP_DIMENSIONS, PROP_REGISTRATION_POINT, PROP_QUERY_AA_CUBE, PROP_PARENT_ID,
+    PROP_PARENT_JOINT_INDEX
+};
+
+// An edit that doesn't change where the entity sits in the tree can be applied without UpdateEntityOperator, which may
+// add, move and prune elements - that's what lets it be applied under the read lock.
+bool EntityTree::canUpdateEntityInPlace(const EntityItemPointer& entity, const EntityPropertyFlags& changedProperties) const {
+    for (auto property : PLACEMENT_PROPERTIES) {
+        if (changedProperties.getHasProperty(property)) {
+            return false;
+        }
+    }
+    EntityTreeElementPointer containingElement = entity->getElement();
+    AABox queryBox = entity->getQueryAACube().clamp((float)-HALF_TREE_SCALE, (float)HALF_TREE_SCALE);
+    return containingElement && containingElement->bestFitBounds(queryBox);
+}
+
+// Marks the element and the path to it as changed, as UpdateEntityOperator does for an entity that stays put. Called once
+// the entity is updated, so that a traversal under the read lock that sees the element changed also sees the entity changed.
+void EntityTree::markEntityChangedInPlace(const EntityTreeElementPointer& containingElement) {
+    containingElement->bumpChangedContent();
+    const AACube& containingCube = containingElement->getAACube();
+    OctreeElementPointer element = _rootElement;
+    while (element) {
+        element->markWithChangedTime();
+        if (element == containingElement) {
+            break;
+        }
+        OctreeElementPointer nextElement;
+        for (int i = 0; i < NUMBER_OF_CHILDREN && !nextElement; i++) {
+            OctreeElementPointer child = element->getChildAtIndex(i);
+            if (child && child->getAACube().contains(containingCube)) {
+                nextElement = child;
+            }
+        }
+        element = nextElement;
+    }
+}
+
 EntityItemPointer EntityTree::addEntity(const EntityItemID& entityID, const EntityItemProperties& properties, bool isClone, const bool isImport) {
     EntityItemProperties props = properties;
 
@@ -760,6 +820,9 @@ void EntityTree::processRemovedEntities(const DeleteEntityOperator& theOperator)
             // set up the deleted entities ID
             QWriteLocker recentlyDeletedEntitiesLocker(&_recentlyDeletedEntitiesLock);
             _recentlyDeletedEntityItemIDs.insert(deletedAt, theEntity->getEntityItemID());
+            if (_isJournaled) {
+                _journaledDeletes.insert(deletedAt, theEntity->getEntityItemID());
+            }
         } else {
             theEntity->forEachDescendant([&](SpatiallyNestablePointer child) {
                 if (child->getNestableType() == NestableType::Avatar) {
@@ -1468,8 +1531,6 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             bool suppressDisallowedPrivateUserData = false;
             bool isPhysics = message.getType() == PacketType::EntityPhysics;
 
-            _totalEditMessages++;
-
             EntityItemID entityItemID;
             EntityItemProperties properties;
             startDecode = usecTimestampNow();
@@ -1595,24 +1656,44 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             // an existing entity... handle appropriately
             if (validEditPacket) {
                 startFilter = usecTimestampNow();
-                bool wasChanged = false;
-                // Having (un)lock rights bypasses the filter, unless it's a physics result.
-                FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
-                bool allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
-                if (!allowed) {
-                    // the update failed and we need to convey that fact to the sender
-                    // our method is to re-assert the current properties and bump the lastEdited timestamp
-                    auto timestamp = properties.getLastEdited();
-                    properties = EntityItemProperties();
-                    properties.setLastEdited(timestamp);
-                }
-                if (!allowed || wasChanged) {
-                    bumpTimestamp(properties);
-                    // For now, free ownership on any modification.
-                    properties.clearSimulationOwner();
+                bool allowed;
+                if (_hasFilteredEdit && _filteredEditID == entityItemID) {
+                    // the edit was filtered when tried in place, the filter isn't run twice
+                    allowed = _filteredEditAllowed;
+                    properties = _filteredEditProperties;
+                } else {
+                    bool wasChanged = false;
+                    // Having (un)lock rights bypasses the filter, unless it's a physics result.
+                    FilterType filterType = isPhysics ? FilterType::Physics : (isAdd ? FilterType::Add : FilterType::Edit);
+                    allowed = (!isPhysics && senderNode->isAllowedEditor()) || filterProperties(existingEntity, properties, properties, wasChanged, filterType);
+                    if (!allowed) {
+                        // the update failed and we need to convey that fact to the sender
+                        // our method is to re-assert the current properties and bump the lastEdited timestamp
+                        auto timestamp = properties.getLastEdited();
+                        properties = EntityItemProperties();
+                        properties.setLastEdited(timestamp);
+                    }
+                    if (!allowed || wasChanged) {
+                        bumpTimestamp(properties);
+                        // For now, free ownership on any modification.
+                        properties.clearSimulationOwner();
+                    }
                 }
+                _hasFilteredEdit = false;
                 endFilter = usecTimestampNow();
 
+                if (_isProcessingEditInPlace && existingEntity &&
+                    !canUpdateEntityInPlace(existingEntity, properties.getChangedProperties())) {
+                    // the filter moved the entity, which has to be done under the write lock - keep what it made of the
+                    // edit for then
+                    _hasFilteredEdit = true;
+                    _filteredEditID = entityItemID;
+                    _filteredEditAllowed = allowed;
+                    _filteredEditProperties = properties;
+                    _editNeedsWriteLock = true;
+                    return 0;
+                }
+
                 if (existingEntity && !isAdd) {
 
                     if (suppressDisallowedClientScript) {
@@ -1719,6 +1800,7 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
             }
 
 
+            _totalEditMessages++;
             _totalDecodeTime += endDecode - startDecode;
             _totalLookupTime += endLookup - startLookup;
             _totalUpdateTime += endUpdate - startUpdate;
@@ -1736,6 +1818,31 @@ int EntityTree::processEditPacketData(ReceivedMessage& message, const unsigned c
     return processedBytes;
 }
 
+bool EntityTree::processEditPacketDataInPlace(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                              const SharedNodePointer& senderNode, int& processedBytes) {
+    // adds, clones and erases change the tree, and physics edits nearly always move the entity
+    if (!getIsServer() || message.getType() != PacketType::EntityEdit) {
+        return false;
+    }
+
+    EntityItemID entityID;
+    EntityPropertyFlags propertyFlags;
+    if (!EntityItemProperties::decodeEntityEditPacketFlags(editData, maxLength, entityID, propertyFlags)) {
+        return false;
+    }
+    EntityItemPointer entity = findEntityByEntityItemID(entityID);
+    if (!entity || !canUpdateEntityInPlace(entity, propertyFlags)) {
+        return false;
+    }
+
+    // the edit is checked again once decoded and filtered, in case the filter moved the entity
+    _isProcessingEditInPlace = true;
+    _editNeedsWriteLock = false;
+    _hasFilteredEdit = false;
+    processedBytes = processEditPacketData(message, editData, maxLength, senderNode);
+    _isProcessingEditInPlace = false;
+    return !_editNeedsWriteLock;
+}
 
 void EntityTree::notifyNewlyCreatedEntity(const EntityItem& newEntity, const SharedNodePointer& senderNode) {
     _newlyCreatedHooksLock.lockForRead();
@@ -1940,9 +2047,15 @@ void EntityTree::update(bool simulate) {
     PROFILE_RANGE(simulation_physics, "UpdateTree");
     PerformanceTimer perfTimer("updateTree");
     if (simulate && _simulation) {
+        bool changedTree = false;
         withWriteLock([&] {
+            quint64 lastChanged = _rootElement ? _rootElement->getLastChanged() : 0;
             _simulation->updateEntities();
+            changedTree = _rootElement && _rootElement->getLastChanged() != lastChanged;
         });
+        if (changedTree) {
+            emit simulationChangedEntities();
+        }
     }
 }
 
@@ -2891,6 +3004,214 @@ bool EntityTree::writeToJSON(QString& jsonString, const OctreeElementPointer& el
     return true;
 }
 
+// an entity is encoded into a packet of this size to begin with, doubled for as long as it doesn't fit
+static const int SNAPSHOT_ENTITY_INITIAL_SIZE = 64 * 1024;
+static const int SNAPSHOT_ENTITY_MAX_SIZE = 64 * 1024 * 1024;
+
+// encodes the whole of the entity, growing the packet for as long as it doesn't fit
+static bool encodeEntityForPersistence(const EntityItemPointer& entity, OctreePacketData& packetData,
+                                       EncodeBitstreamParams& params, const EntityTreeElementExtraEncodeDataPointer& extraEncodeData) {
+    while (true) {
+        packetData.reset();
+        extraEncodeData->entities.clear();
+
+        // the snapshot and journal are for the server, they keep the private user data
+        auto appendState = entity->appendEntityData(&packetData, params, extraEncodeData, true);
+        if (appendState == OctreeElement::COMPLETED) {
+            return true;
+        }
+        if ((int)packetData.getTargetSize() >= SNAPSHOT_ENTITY_MAX_SIZE) {
+            qCWarning(entities) << "Entity" << entity->getEntityItemID() << "is too large to persist";
+            return false;
+        }
+        packetData.changeSettings(false, packetData.getTargetSize() * 2);
+    }
+}
+
+bool EntityTree::writeToSnapshot(OctreeSnapshotWriter& snapshot) {
+    OctreePacketData packetData(false, SNAPSHOT_ENTITY_INITIAL_SIZE);
+    EncodeBitstreamParams params;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+    bool success = true;
+
+    // the entities are written in tree order, so that the entities of a section are close together
+    withReadLock([&] {
+        recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+            entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) {
+                if (encodeEntityForPersistence(entity, packetData, params, extraEncodeData)) {
+                    snapshot.appendRecord(entity->getType(), packetData.getUncompressedData(),
+                                          packetData.getUncompressedSize());
+                } else {
+                    success = false;
+                }
+            });
+            return true;
+        });
+    });
+
+    return success;
+}
+
+bool EntityTree::writeToJournal(OctreeJournalWriter& journal, quint64 sinceTime) {
+    OctreePacketData packetData(false, SNAPSHOT_ENTITY_INITIAL_SIZE);
+    EncodeBitstreamParams params;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+    bool success = true;
+
+    // the deletes go first, so that an entity that was deleted and then added back (as an undo does) is kept
+    {
+        QWriteLocker locker(&_recentlyDeletedEntitiesLock);
+        auto iterator = _journaledDeletes.begin();
+        while (iterator != _journaledDeletes.end() && iterator.key() <= sinceTime) {
+            iterator = _journaledDeletes.erase(iterator);
+        }
+        for (; iterator != _journaledDeletes.end(); ++iterator) {
+            journal.appendRemoval(iterator.value());
+        }
+    }
+
+    // as for the entity server's sends, the elements are marked up to the root when something below them changes, so
+    // only the changed part of the tree is visited
+    withReadLock([&] {
+        recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            if (element->getLastChanged() <= sinceTime) {
+                return false;
+            }
+            auto entityTreeElement = std::static_pointer_cast<EntityTreeElement>(element);
+            entityTreeElement->forEachEntity([&](const EntityItemPointer& entity) {
+                if (entity->getLastChangedOnServer() <= sinceTime) {
+                    return;
+                }
+                if (encodeEntityForPersistence(entity, packetData, params, extraEncodeData)) {
+                    journal.appendUpdate(packetData.getUncompressedData(), packetData.getUncompressedSize());
+                } else {
+                    success = false;
+                }
+            });
+            return true;
+        });
+    });
+
+    return success;
+}
+
+bool EntityTree::readFromSnapshot(const OctreeSnapshotReader& snapshot, const OctreeJournalReader* journal) {
+    // The sections are decoded in parallel, without the tree, and the journal is replayed over them. The entities are
+    // then added to the tree in the order they were written.
+    int numSections = snapshot.getNumSections();
+    std::vector<std::vector<EntityItemPointer>> sectionEntities(numSections);
+    std::atomic<int> nextSection { 0 };
+    std::atomic<bool> success { true };
+
+    auto decodeSections = [&] {
+        ReadBitstreamToTreeParams args;
+        for (int section = nextSection++; section < numSections; section = nextSection++) {
+            auto& entities = sectionEntities[section];
+            entities.reserve(snapshot.getSection(section).numRecords);
+            bool sectionRead = snapshot.forEachRecord(section, [&](const unsigned char* data, int size) {
+                EntityItemPointer entity = EntityTypes::constructEntityItem(data, size);
+                if (!entity || entity->readEntityDataFromBuffer(data, size, args) <= 0) {
+                    return false;
+                }
+                entities.push_back(entity);
+                return true;
+            });
+            if (!sectionRead) {
+                success = false;
+            }
+        }
+    };
+
+    std::vector<std::thread> threads;
+    int numThreads = std::min(QThread::idealThreadCount(), numSections);
+    for (int i = 1; i < numThreads; ++i) {
+        threads.emplace_back(decodeSections);
+    }
+    decodeSections();
+    for (auto& thread : threads) {
+        thread.join();
+    }
+
+    if (!success) {
+        qCWarning(entities) << "EntityTree::readFromSnapshot: the snapshot has an entity that can't be read";
+        return false;
+    }
+
+    // the last change to an entity wins, a deleted entity is left null
+    QHash<EntityItemID, EntityItemPointer> journaledEntities;
+    QVector<EntityItemID> journaledEntityIDs;
+    if (journal) {
+        ReadBitstreamToTreeParams args;
+        bool journalRead = journal->forEachRecord([&](OctreeJournalRecordType type, const unsigned char* data, int size) {
+            if (type == OctreeJournalRecordType::Removal) {
+                if (size != NUM_BYTES_RFC4122_UUID) {
+                    return false;
+                }
+                journaledEntities[QUuid::fromRfc4122(QByteArray::fromRawData((const char*)data, size))] = nullptr;
+                return true;
+            }
+
+            EntityItemPointer entity = EntityTypes::constructEntityItem(data, size);
+            if (!entity || entity->readEntityDataFromBuffer(data, size, args) <= 0) {
+                return false;
+            }
+            if (!journaledEntities.contains(entity->getEntityItemID())) {
+                journaledEntityIDs.push_back(entity->getEntityItemID());
+            }
+            journaledEntities[entity->getEntityItemID()] = entity;
+            return true;
+        });
+        if (!journalRead) {
+            qCWarning(entities) << "EntityTree::readFromSnapshot: the journal has an entity that can't be read";
+            return false;
+        }
+    }
+
+    QMap<QUuid, QVector<QUuid>> cloneIDs;
+    auto addLoadedEntity = [&](const EntityItemPointer& entity) {
+        if (getContainingElement(entity->getEntityItemID())) {
+            qCWarning(entities) << "EntityTree::readFromSnapshot: entity" << entity->getEntityItemID() << "is already in the tree";
+            return;
+        }
+
+        // simulation ownership doesn't outlive the session it was given in
+        entity->clearSimulationOwnership();
+
+        AddEntityOperator theOperator(getThisPointer(), entity);
+        recurseTreeWithOperator(&theOperator);
+        postAddEntity(entity);
+
+        const QUuid& cloneOriginID = entity->getCloneOriginID();
+        if (!cloneOriginID.isNull()) {
+            cloneIDs[cloneOriginID].push_back(entity->getEntityItemID());
+        }
+    };
+
+    for (const auto& entities : sectionEntities) {
+        for (const auto& entity : entities) {
+            if (!journaledEntities.contains(entity->getEntityItemID())) {
+                addLoadedEntity(entity);
+            }
+        }
+    }
+    for (const auto& entityID : journaledEntityIDs) {
+        auto entity = journaledEntities.value(entityID);
+        if (entity) {
+            addLoadedEntity(entity);
+        }
+    }
+
+    for (const auto& entityID : cloneIDs.keys()) {
+        auto entity = findEntityByID(entityID);
+        if (entity) {
+            entity->setCloneIDs(cloneIDs.value(entityID));
+        }
+    }
+
+    return true;
+}
+
 void EntityTree::resetClientEditStats() {
     _treeResetTime = usecTimestampNow();
     _maxEditDelta = 0;
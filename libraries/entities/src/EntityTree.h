@@ -19,6 +19,7 @@
 #include <SpatialParentFinder.h>
 
 #include "AddEntityOperator.h"
+#include "EntityItemProperties.h"
 #include "EntityTreeElement.h"
 #include "DeleteEntityOperator.h"
 #include "MovingEntitiesOperator.h"
@@ -90,6 +91,8 @@ public:
     void fixupTerseEditLogging(EntityItemProperties& properties, QList<QString>& changedProperties);
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& senderNode) override;
+    virtual bool processEditPacketDataInPlace(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                              const SharedNodePointer& senderNode, int& processedBytes) override;
 
     virtual EntityItemID evalRayIntersection(const glm::vec3& origin, const glm::vec3& direction,
         QVector<EntityItemID> entityIdsToInclude, QVector<EntityItemID> entityIdsToDiscard,
@@ -195,6 +198,9 @@ public:
                             bool skipThoseWithBadParents) override;
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) override;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) override;
+    virtual bool writeToSnapshot(OctreeSnapshotWriter& snapshot) override;
+    virtual bool writeToJournal(OctreeJournalWriter& journal, quint64 sinceTime) override;
+    virtual bool readFromSnapshot(const OctreeSnapshotReader& snapshot, const OctreeJournalReader* journal) override;
 
 
     glm::vec3 getContentsDimensions();
@@ -282,6 +288,7 @@ signals:
     void addingEntity(const EntityItemID& entityID);
     void addingEntityPointer(EntityItem* entityID);
     void editingEntityPointer(const EntityItemPointer& entityID);
+    void simulationChangedEntities(); // entities were moved, expired or otherwise changed by the simulation
     void entityScriptChanging(const EntityItemID& entityItemID, const bool reload);
     void entityServerScriptChanging(const EntityItemID& entityItemID, const bool reload);
     void newCollisionSoundURL(const QUrl& url, const EntityItemID& entityID);
@@ -306,6 +313,7 @@ protected:
 
     mutable QReadWriteLock _recentlyDeletedEntitiesLock; /// lock of server side recent deletes
     QMultiMap<quint64, QUuid> _recentlyDeletedEntityItemIDs; /// server side recent deletes
+    QMultiMap<quint64, QUuid> _journaledDeletes; /// server side deletes not yet known to be in the journal
 
     mutable QReadWriteLock _deletedEntitiesLock; /// lock of client side recent deletes
     QSet<QUuid> _deletedEntityItemIDs; /// client side recent deletes
@@ -361,6 +369,16 @@ protected:
     float _maxTmpEntityLifetime { DEFAULT_MAX_TMP_ENTITY_LIFETIME };
 
     bool filterProperties(const EntityItemPointer& existingEntity, EntityItemProperties& propertiesIn, EntityItemProperties& propertiesOut, bool& wasChanged, FilterType filterType) const;
+
+    bool canUpdateEntityInPlace(const EntityItemPointer& entity, const EntityPropertyFlags& changedProperties) const;
+    void markEntityChangedInPlace(const EntityTreeElementPointer& containingElement);
+    bool _isProcessingEditInPlace { false }; // only touched by the thread that processes edit packets
+    bool _editNeedsWriteLock { false };
+    bool _hasFilteredEdit { false }; // the edit that needs the write lock, as filtered when tried in place
+    EntityItemID _filteredEditID;
+    bool _filteredEditAllowed { false };
+    EntityItemProperties _filteredEditProperties;
+
     bool _hasEntityEditFilter{ false };
     QStringList _entityScriptSourceWhitelist;
 
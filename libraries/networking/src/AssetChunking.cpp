@@ -0,0 +1,73 @@
+//
+//  AssetChunking.cpp
+//  libraries/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunking.h"
+
+#include <algorithm>
+#include <array>
+
+#include <QtCore/QCryptographicHash>
+
+namespace AssetUtils {
+
+// the top 16 bits of the gear hash depend on the last 64 bytes, a boundary is found every 64 KiB on average
+static const uint64_t CHUNK_BOUNDARY_MASK = 0xFFFFull << 48;
+
+using GearTable = std::array<uint64_t, 256>;
+
+// random values for each byte, generated with splitmix64 from a fixed seed so that every build has the same table
+static GearTable createGearTable() {
+    GearTable table;
+    uint64_t state = 0x6f76657274650000ull;
+    for (auto& value : table) {
+        state += 0x9e3779b97f4a7c15ull;
+        uint64_t z = state;
+        z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+        z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+        value = z ^ (z >> 31);
+    }
+    return table;
+}
+
+static DataOffset findChunkEnd(const GearTable& gear, const uint8_t* data, DataOffset size) {
+    if (size <= MIN_CONTENT_CHUNK_SIZE) {
+        return size;
+    }
+
+    // no chunk is cut short of the minimum size, so the bytes before it aren't hashed at all
+    auto end = std::min(size, MAX_CONTENT_CHUNK_SIZE);
+    uint64_t hash = 0;
+    for (DataOffset i = MIN_CONTENT_CHUNK_SIZE; i < end; ++i) {
+        hash = (hash << 1) + gear[data[i]];
+        if ((hash & CHUNK_BOUNDARY_MASK) == 0) {
+            return i + 1;
+        }
+    }
+    return end;
+}
+
+ContentChunks chunkContent(const char* data, DataOffset size) {
+    static const GearTable GEAR = createGearTable();
+
+    ContentChunks chunks;
+    chunks.reserve((size_t)(size / MIN_CONTENT_CHUNK_SIZE / 4 + 1));
+
+    DataOffset offset = 0;
+    while (offset < size) {
+        auto chunkSize = findChunkEnd(GEAR, reinterpret_cast<const uint8_t*>(data) + offset, size - offset);
+        auto chunkData = QByteArray::fromRawData(data + offset, (int)chunkSize);
+        chunks.push_back({ offset, chunkSize, QCryptographicHash::hash(chunkData, QCryptographicHash::Sha256) });
+        offset += chunkSize;
+    }
+    return chunks;
+}
+
+} // namespace AssetUtils
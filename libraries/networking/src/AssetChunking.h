@@ -0,0 +1,41 @@
+//
+//  AssetChunking.h
+//  libraries/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AssetChunking_h
+#define overte_AssetChunking_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+
+#include "AssetUtils.h"
+
+namespace AssetUtils {
+
+// Content-defined chunks are cut where a rolling hash of the preceding bytes hits a boundary pattern, so an edit only
+// changes the chunks around it and the rest of the asset still chunks and hashes the same. Both ends of an upload must
+// chunk the same way, so changing any of these changes the protocol.
+const DataOffset MIN_CONTENT_CHUNK_SIZE = 16 * 1024;
+const DataOffset MAX_CONTENT_CHUNK_SIZE = 256 * 1024;
+
+struct ContentChunk {
+    DataOffset offset;
+    DataOffset size;
+    QByteArray hash; // SHA-256 of the chunk
+};
+
+using ContentChunks = std::vector<ContentChunk>;
+
+ContentChunks chunkContent(const char* data, DataOffset size);
+
+} // namespace AssetUtils
+
+#endif // overte_AssetChunking_h
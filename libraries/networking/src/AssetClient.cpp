@@ -16,8 +16,10 @@
 #include <cstdint>
 
 #include <QtCore/QBuffer>
+#include <QtCore/QDir>
 #include <QtCore/QStandardPaths>
 #include <QtCore/QThread>
+#include <QtCore/QTimer>
 #include <QtNetwork/QNetworkDiskCache>
 
 #include <shared/GlobalAppProperties.h>
@@ -35,6 +37,11 @@
 
 MessageID AssetClient::_currentID = 0;
 
+// below this an upload isn't worth the extra round trip to find out which of its chunks are already stored
+static const int MIN_DELTA_UPLOAD_SIZE = 4 * AssetUtils::MAX_CONTENT_CHUNK_SIZE;
+// an asset server that doesn't answer which chunks it has in time is sent the whole asset instead
+static const int CHUNK_QUERY_TIMEOUT_MSECS = 10 * 1000;
+
 AssetClient::AssetClient() {
     _cacheDir = qApp->property(hifi::properties::APP_LOCAL_DATA_PATH).toString();
     setCustomDeleter([](Dependency* dependency){
@@ -52,6 +59,8 @@ AssetClient::AssetClient() {
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetGetReply), true);
     packetReceiver.registerListener(PacketType::AssetUploadReply,
         PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetUploadReply));
+    packetReceiver.registerListener(PacketType::AssetChunkQueryReply,
+        PacketReceiver::makeSourcedListenerReference<AssetClient>(this, &AssetClient::handleAssetChunkQueryReply));
 
     connect(nodeList.data(), &LimitedNodeList::nodeKilled, this, &AssetClient::handleNodeKilled);
     connect(nodeList.data(), &LimitedNodeList::clientConnectionToNodeReset,
@@ -88,6 +97,11 @@ void AssetClient::initCaching() {
 
 }
 
+QString AssetClient::getPartialDownloadsDirectory() const {
+    static const QString PARTIAL_DOWNLOADS_SUBDIR = "atpPartial";
+    return _cacheDir.isEmpty() ? QString() : QDir(_cacheDir).filePath(PARTIAL_DOWNLOADS_SUBDIR);
+}
+
 namespace {
     const QString& CACHE_ERROR_MESSAGE{ "AssetClient::Error: %1 %2" };
 }
@@ -897,6 +911,11 @@ bool AssetClient::cancelUploadAssetRequest(MessageID id) {
             return true;
         }
     }
+    for (auto& kv : _pendingDeltaUploads) {
+        if (kv.second.erase(id)) {
+            return true;
+        }
+    }
     return false;
 }
 
@@ -907,19 +926,38 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     SharedNodePointer assetServer = nodeList->soloNodeOfType(NodeType::AssetServer);
 
     if (assetServer) {
-        auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
-
         auto messageID = ++_currentID;
-        packetList->writePrimitive(messageID);
 
-        uint64_t size = data.length();
-        packetList->writePrimitive(size);
-        packetList->write(data.constData(), size);
+        if (data.size() < MIN_DELTA_UPLOAD_SIZE) {
+            if (sendAssetUpload(assetServer, messageID, data, callback)) {
+                return messageID;
+            }
+        } else {
+            DeltaUploadData upload { data, AssetUtils::hashData(data), AssetUtils::chunkContent(data.constData(), data.size()),
+                                     callback };
 
-        if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
-            _pendingUploads[assetServer][messageID] = callback;
+            auto packetList = NLPacketList::create(PacketType::AssetChunkQuery, QByteArray(), true, true);
+            packetList->writePrimitive(messageID);
 
-            return messageID;
+            uint64_t size = data.length();
+            packetList->writePrimitive(size);
+
+            uint32_t numChunks = (uint32_t)upload.chunks.size();
+            packetList->writePrimitive(numChunks);
+            for (const auto& chunk : upload.chunks) {
+                packetList->write(chunk.hash);
+            }
+
+            if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+                _pendingDeltaUploads[assetServer][messageID] = std::move(upload);
+
+                QWeakPointer<Node> weakAssetServer = assetServer;
+                QTimer::singleShot(CHUNK_QUERY_TIMEOUT_MSECS, this, [this, weakAssetServer, messageID] {
+                    handleChunkQueryTimeout(weakAssetServer, messageID);
+                });
+
+                return messageID;
+            }
         }
     }
 
@@ -927,6 +965,129 @@ MessageID AssetClient::uploadAsset(const QByteArray& data, UploadResultCallback
     return INVALID_MESSAGE_ID;
 }
 
+bool AssetClient::sendAssetUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data,
+                                  UploadResultCallback callback) {
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+
+    auto packetList = NLPacketList::create(PacketType::AssetUpload, QByteArray(), true, true);
+    packetList->writePrimitive(messageID);
+
+    uint64_t size = data.length();
+    packetList->writePrimitive(size);
+    packetList->write(data.constData(), size);
+
+    if (nodeList->sendPacketList(std::move(packetList), *assetServer) != -1) {
+        _pendingUploads[assetServer][messageID] = callback;
+
+        return true;
+    }
+    return false;
+}
+
+void AssetClient::handleAssetChunkQueryReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    MessageID messageID;
+    message->readPrimitive(&messageID);
+
+    AssetUtils::AssetServerError error;
+    message->readPrimitive(&error);
+
+    auto messageMapIt = _pendingDeltaUploads.find(senderNode);
+    if (messageMapIt == _pendingDeltaUploads.end()) {
+        return;
+    }
+    auto requestIt = messageMapIt->second.find(messageID);
+    if (requestIt == messageMapIt->second.end()) {
+        return;
+    }
+    auto& upload = requestIt->second;
+    if (upload.hasChunkQueryReply) {
+        return;
+    }
+    upload.hasChunkQueryReply = true;
+
+    if (error) {
+        qCWarning(asset_client) << "Error uploading file to asset server";
+        auto callback = upload.callback;
+        messageMapIt->second.erase(requestIt);
+        callback(true, error, QString());
+        return;
+    }
+
+    if (message->getBytesLeftToRead() < (qint64)upload.chunks.size()) {
+        qCWarning(asset_client) << "Bad chunk query reply from asset server, uploading all of the asset";
+        auto data = upload.data;
+        auto callback = upload.callback;
+        messageMapIt->second.erase(requestIt);
+        if (!sendAssetUpload(senderNode, messageID, data, callback)) {
+            callback(false, AssetUtils::AssetServerError::NoError, QString());
+        }
+        return;
+    }
+
+    auto packetList = NLPacketList::create(PacketType::AssetDeltaUpload, QByteArray(), true, true);
+    packetList->writePrimitive(messageID);
+
+    uint64_t size = upload.data.length();
+    packetList->writePrimitive(size);
+    packetList->write(upload.hash);
+
+    uint32_t numChunks = (uint32_t)upload.chunks.size();
+    packetList->writePrimitive(numChunks);
+
+    qint64 bytesSkipped = 0;
+    for (const auto& chunk : upload.chunks) {
+        uint8_t isStored;
+        message->readPrimitive(&isStored);
+
+        uint32_t chunkSize = (uint32_t)chunk.size;
+        uint8_t isIncluded = isStored ? 0 : 1;
+        packetList->writePrimitive(chunkSize);
+        packetList->writePrimitive(isIncluded);
+        if (isIncluded) {
+            packetList->write(upload.data.constData() + chunk.offset, chunk.size);
+        } else {
+            packetList->write(chunk.hash);
+            bytesSkipped += chunk.size;
+        }
+    }
+
+    qCDebug(asset_client) << "Uploading" << size - bytesSkipped << "of" << size << "bytes, the asset server has the rest";
+
+    auto nodeList = DependencyManager::get<LimitedNodeList>();
+    if (nodeList->sendPacketList(std::move(packetList), *senderNode) == -1) {
+        auto callback = upload.callback;
+        messageMapIt->second.erase(requestIt);
+        callback(false, AssetUtils::AssetServerError::NoError, QString());
+    }
+}
+
+void AssetClient::handleChunkQueryTimeout(const QWeakPointer<Node>& node, MessageID messageID) {
+    Q_ASSERT(QThread::currentThread() == thread());
+
+    auto assetServer = node.lock();
+    if (!assetServer) {
+        return;
+    }
+    auto messageMapIt = _pendingDeltaUploads.find(assetServer);
+    if (messageMapIt == _pendingDeltaUploads.end()) {
+        return;
+    }
+    auto requestIt = messageMapIt->second.find(messageID);
+    if (requestIt == messageMapIt->second.end() || requestIt->second.hasChunkQueryReply) {
+        return;
+    }
+
+    qCWarning(asset_client) << "Asset server didn't answer the chunk query, uploading all of the asset";
+    auto data = requestIt->second.data;
+    auto callback = requestIt->second.callback;
+    messageMapIt->second.erase(requestIt);
+    if (!sendAssetUpload(assetServer, messageID, data, callback)) {
+        callback(false, AssetUtils::AssetServerError::NoError, QString());
+    }
+}
+
 void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode) {
     Q_ASSERT(QThread::currentThread() == thread());
 
@@ -947,6 +1108,27 @@ void AssetClient::handleAssetUploadReply(QSharedPointer<ReceivedMessage> message
         qCDebug(asset_client) << "Successfully uploaded asset to asset-server - SHA256 hash is " << hashString;
     }
 
+    // A delta upload the asset server couldn't put together is sent again in full
+    auto deltaMapIt = _pendingDeltaUploads.find(senderNode);
+    if (deltaMapIt != _pendingDeltaUploads.end()) {
+        auto requestIt = deltaMapIt->second.find(messageID);
+        if (requestIt != deltaMapIt->second.end()) {
+            auto data = requestIt->second.data;
+            auto callback = requestIt->second.callback;
+            deltaMapIt->second.erase(requestIt);
+
+            if (error == AssetUtils::AssetServerError::ChunkNotFound) {
+                qCDebug(asset_client) << "Asset server is missing chunks of the upload, uploading all of the asset";
+                if (!sendAssetUpload(senderNode, messageID, data, callback)) {
+                    callback(false, AssetUtils::AssetServerError::NoError, QString());
+                }
+            } else {
+                callback(true, error, hashString);
+            }
+            return;
+        }
+    }
+
     // Check if we have any pending requests for this node
     auto messageMapIt = _pendingUploads.find(senderNode);
     if (messageMapIt != _pendingUploads.end()) {
@@ -985,6 +1167,16 @@ void AssetClient::handleNodeKilled(SharedNodePointer node) {
             messageMapIt->second.clear();
         }
     }
+
+    {
+        auto messageMapIt = _pendingDeltaUploads.find(node);
+        if (messageMapIt != _pendingDeltaUploads.end()) {
+            for (const auto& value : messageMapIt->second) {
+                value.second.callback(false, AssetUtils::AssetServerError::NoError, "");
+            }
+            messageMapIt->second.clear();
+        }
+    }
 }
 
 void AssetClient::handleNodeClientConnectionReset(SharedNodePointer node) {
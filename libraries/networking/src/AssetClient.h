@@ -22,6 +22,7 @@
 #include <DependencyManager.h>
 #include <shared/MiniPromises.h>
 
+#include "AssetChunking.h"
 #include "AssetUtils.h"
 #include "ByteRange.h"
 #include "ClientServerUtils.h"
@@ -79,6 +80,7 @@ private slots:
     void handleAssetGetInfoReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetGetReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
     void handleAssetUploadReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
+    void handleAssetChunkQueryReply(QSharedPointer<ReceivedMessage> message, SharedNodePointer senderNode);
 
     void handleNodeKilled(SharedNodePointer node);
     void handleNodeClientConnectionReset(SharedNodePointer node);
@@ -95,6 +97,8 @@ private:
     MessageID getAsset(const QString& hash, AssetUtils::DataOffset start, AssetUtils::DataOffset end,
                   ReceivedAssetCallback callback, ProgressCallback progressCallback);
     MessageID uploadAsset(const QByteArray& data, UploadResultCallback callback);
+    bool sendAssetUpload(const SharedNodePointer& assetServer, MessageID messageID, const QByteArray& data,
+                         UploadResultCallback callback);
 
     bool cancelMappingRequest(MessageID id);
     bool cancelGetAssetInfoRequest(MessageID id);
@@ -104,19 +108,35 @@ private:
     void handleProgressCallback(const QWeakPointer<Node>& node, MessageID messageID, qint64 size, AssetUtils::DataOffset length);
     void handleCompleteCallback(const QWeakPointer<Node>& node, MessageID messageID, AssetUtils::DataOffset length);
 
+    // Falls back to a full upload if the asset server hasn't answered the chunk query of a delta upload
+    void handleChunkQueryTimeout(const QWeakPointer<Node>& node, MessageID messageID);
+
     void forceFailureOfPendingRequests(SharedNodePointer node);
 
+    // where downloads in progress are kept so that they can resume, empty if there is no cache directory
+    QString getPartialDownloadsDirectory() const;
+
     struct GetAssetRequestData {
         QSharedPointer<ReceivedMessage> message;
         ReceivedAssetCallback completeCallback;
         ProgressCallback progressCallback;
     };
 
+    // A large upload first asks which of its chunks the asset server already has, then sends only the others
+    struct DeltaUploadData {
+        QByteArray data;
+        QByteArray hash;
+        AssetUtils::ContentChunks chunks;
+        UploadResultCallback callback;
+        bool hasChunkQueryReply { false };
+    };
+
     static MessageID _currentID;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, MappingOperationCallback>> _pendingMappingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetAssetRequestData>> _pendingRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, GetInfoCallback>> _pendingInfoRequests;
     std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, UploadResultCallback>> _pendingUploads;
+    std::unordered_map<SharedNodePointer, std::unordered_map<MessageID, DeltaUploadData>> _pendingDeltaUploads;
 
     QString _cacheDir;
 
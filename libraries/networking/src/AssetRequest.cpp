@@ -12,6 +12,8 @@
 #include "AssetRequest.h"
 
 #include <algorithm>
+#include <cstring>
+#include <limits>
 
 #include <QtCore/QThread>
 
@@ -25,6 +27,10 @@
 
 static int requestID = 0;
 
+// whole assets larger than a chunk are downloaded a few chunks at a time
+static const AssetUtils::DataOffset DOWNLOAD_CHUNK_SIZE = 1024 * 1024;
+static const int MAX_CONCURRENT_CHUNK_REQUESTS = 4;
+
 AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
     _requestID(++requestID),
     _hash(hash),
@@ -34,10 +40,7 @@ AssetRequest::AssetRequest(const QString& hash, const ByteRange& byteRange) :
 }
 
 AssetRequest::~AssetRequest() {
-    auto assetClient = DependencyManager::get<AssetClient>();
-    if (_assetRequestID) {
-        assetClient->cancelGetAssetRequest(_assetRequestID);
-    }
+    cancelPendingRequests();
 }
 
 void AssetRequest::start() {
@@ -75,6 +78,24 @@ void AssetRequest::start() {
 
     _state = WaitingForData;
 
+    if (_byteRange.isSet()) {
+        requestRange();
+        return;
+    }
+
+    // pick up where an earlier download of the asset left off
+    auto assetClient = DependencyManager::get<AssetClient>();
+    _partialFile.reset(new PartialAssetFile(assetClient->getPartialDownloadsDirectory(), _hash));
+    if (_partialFile->load()) {
+        qCDebug(asset_client) << "Resuming download of" << _hash << "with" << _partialFile->getNumCompleteChunks()
+            << "of" << _partialFile->getNumChunks() << "chunks already received";
+        startChunkedDownload(_partialFile->getSize());
+    } else {
+        requestLastChunk();
+    }
+}
+
+void AssetRequest::requestRange() {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
     auto hash = _hash;
@@ -89,43 +110,55 @@ void AssetRequest::start() {
         }
         _assetRequestID = INVALID_MESSAGE_ID;
 
-        if (!responseReceived) {
-            _error = NetworkError;
-        } else if (serverError != AssetUtils::AssetServerError::NoError) {
-            switch (serverError) {
-                case AssetUtils::AssetServerError::AssetNotFound:
-                    _error = NotFound;
-                    break;
-                case AssetUtils::AssetServerError::InvalidByteRange:
-                    _error = InvalidByteRange;
-                    break;
-                default:
-                    _error = UnknownError;
-                    break;
-            }
+        if (setErrorFromReply(responseReceived, serverError)) {
+            finishWithData(data);
         } else {
-            if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
-                // the hash of the received data does not match what we expect, so we return an error
-                _error = HashVerificationFailed;
-            }
+            finishWithError();
+        }
+    }, [this, that](qint64 totalReceived, qint64 total) {
+        if (!that) {
+            // If the request is dead, return
+            return;
+        }
+        emit progress(totalReceived, total);
+    });
+}
+
+void AssetRequest::requestLastChunk() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+    auto hash = _hash;
 
-            if (_error == NoError) {
-                _data = data;
-                _totalReceived += data.size();
-                emit progress(_totalReceived, data.size());
+    // a negative range is read back from the end of the asset, and is all of it when the asset is smaller
+    _assetRequestID = assetClient->getAsset(_hash, -DOWNLOAD_CHUNK_SIZE, 0,
+        [this, that, hash](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
 
-                if (!_byteRange.isSet()) {
-                    AssetUtils::saveToCache(getUrl(), data);
-                }
-            }
+        if (!that) {
+            qCWarning(asset_client) << "Got reply for dead asset request " << hash << "- error code" << _error;
+            // If the request is dead, return
+            return;
         }
-        
-        if (_error != NoError) {
-            qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+        _assetRequestID = INVALID_MESSAGE_ID;
+
+        if (_state == Finished) {
+            return;
+        }
+
+        if (!setErrorFromReply(responseReceived, serverError)) {
+            finishWithError();
+        } else if (data.size() < DOWNLOAD_CHUNK_SIZE) {
+            // that was the whole asset
+            finishWithData(data);
+        } else {
+            _lastChunk = data;
+            if (_size >= 0) {
+                startChunkedDownload(_size);
+            } else if (_assetInfoRequestID == INVALID_MESSAGE_ID) {
+                // the size request failed
+                _error = NetworkError;
+                finishWithError();
+            }
         }
-        
-        _state = Finished;
-        emit finished(this);
     }, [this, that](qint64 totalReceived, qint64 total) {
         if (!that) {
             // If the request is dead, return
@@ -133,8 +166,238 @@ void AssetRequest::start() {
         }
         emit progress(totalReceived, total);
     });
+
+    if (_state == Finished) {
+        return;
+    }
+
+    // the size is only needed when the asset is larger than a chunk, but asking now saves a round trip when it is
+    _assetInfoRequestID = assetClient->getAssetInfo(_hash,
+        [this, that](bool responseReceived, AssetUtils::AssetServerError serverError, AssetInfo info) {
+
+        if (!that || _state == Finished) {
+            return;
+        }
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+
+        if (!responseReceived || serverError != AssetUtils::AssetServerError::NoError) {
+            // the request for the last chunk gets the same error, unless it already has its reply
+            if (_assetRequestID == INVALID_MESSAGE_ID) {
+                setErrorFromReply(responseReceived, serverError);
+                finishWithError();
+            }
+            return;
+        }
+
+        _size = info.size;
+        if (!_lastChunk.isNull()) {
+            startChunkedDownload(_size);
+        }
+    });
 }
 
+void AssetRequest::startChunkedDownload(AssetUtils::DataOffset size) {
+    if (size > std::numeric_limits<int>::max()) {
+        qCWarning(asset_client) << "Asset" << _hash << "is too large to download at" << size << "bytes";
+        _error = SizeVerificationFailed;
+        finishWithError();
+        return;
+    }
+
+    if (_partialFile->getNumChunks() == 0 || _partialFile->getSize() != size) {
+        // a new download, it can still go ahead if it can't be kept on disk
+        _partialFile->create(size, DOWNLOAD_CHUNK_SIZE);
+    }
+
+    _data.resize((int)size);
+    _totalReceived = 0;
+
+    // put the chunks of an earlier download back together
+    for (int chunk = 0; chunk < _partialFile->getNumChunks(); ++chunk) {
+        if (!_partialFile->isChunkComplete(chunk)) {
+            continue;
+        }
+
+        auto range = _partialFile->getChunkRange(chunk);
+        QByteArray data = _partialFile->readChunk(chunk);
+        if (data.size() != range.size()) {
+            qCWarning(asset_client) << "Could not read back the partial download of" << _hash << "- starting over";
+            _partialFile->create(size, DOWNLOAD_CHUNK_SIZE);
+            _totalReceived = 0;
+            break;
+        }
+
+        memcpy(_data.data() + range.fromInclusive, data.constData(), data.size());
+        _totalReceived += data.size();
+    }
+
+    if (!_lastChunk.isNull()) {
+        int lastChunk = _partialFile->getNumChunks() - 1;
+        if (lastChunk < 0 || _lastChunk.size() != _partialFile->getChunkRange(lastChunk).size()) {
+            _error = SizeVerificationFailed;
+            finishWithError();
+            return;
+        }
+
+        storeChunk(lastChunk, _lastChunk);
+        _lastChunk = QByteArray();
+    }
+
+    _nextChunk = 0;
+    requestChunks();
+}
+
+void AssetRequest::requestChunks() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    auto that = QPointer<AssetRequest>(this); // Used to track the request's lifetime
+
+    while ((int)_chunkRequests.size() < MAX_CONCURRENT_CHUNK_REQUESTS && _nextChunk < _partialFile->getNumChunks()) {
+        int chunk = _nextChunk++;
+        if (_partialFile->isChunkComplete(chunk)) {
+            continue;
+        }
+
+        auto range = _partialFile->getChunkRange(chunk);
+        auto requestID = assetClient->getAsset(_hash, range.fromInclusive, range.toExclusive,
+            [this, that, chunk](bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data) {
+            if (!that) {
+                return;
+            }
+            handleChunk(chunk, responseReceived, serverError, data);
+        }, [this, that, chunk](qint64 totalReceived, qint64 total) {
+            if (!that) {
+                return;
+            }
+            _chunkBytesReceived[chunk] = totalReceived;
+            emitChunkedProgress();
+        });
+
+        if (_state == Finished) {
+            // the request failed straight away
+            return;
+        }
+        _chunkRequests[chunk] = requestID;
+    }
+
+    if (_chunkRequests.empty() && _nextChunk >= _partialFile->getNumChunks()) {
+        // every chunk is in, the whole asset is checked against its hash
+        finishWithData(_data);
+    }
+}
+
+void AssetRequest::handleChunk(int chunk, bool responseReceived, AssetUtils::AssetServerError serverError,
+                               const QByteArray& data) {
+    _chunkRequests.erase(chunk);
+    _chunkBytesReceived.erase(chunk);
+
+    if (_state == Finished) {
+        return;
+    }
+
+    if (!setErrorFromReply(responseReceived, serverError)) {
+        finishWithError();
+    } else if (data.size() != _partialFile->getChunkRange(chunk).size()) {
+        _error = SizeVerificationFailed;
+        finishWithError();
+    } else {
+        storeChunk(chunk, data);
+        requestChunks();
+    }
+}
+
+void AssetRequest::storeChunk(int chunk, const QByteArray& data) {
+    auto range = _partialFile->getChunkRange(chunk);
+    memcpy(_data.data() + range.fromInclusive, data.constData(), data.size());
+    _partialFile->writeChunk(chunk, data);
+
+    _totalReceived += data.size();
+    emitChunkedProgress();
+}
+
+void AssetRequest::emitChunkedProgress() {
+    qint64 totalReceived = _totalReceived;
+    for (const auto& chunkBytesReceived : _chunkBytesReceived) {
+        totalReceived += chunkBytesReceived.second;
+    }
+    emit progress(totalReceived, _partialFile->getSize());
+}
+
+bool AssetRequest::setErrorFromReply(bool responseReceived, AssetUtils::AssetServerError serverError) {
+    if (!responseReceived) {
+        _error = NetworkError;
+    } else if (serverError != AssetUtils::AssetServerError::NoError) {
+        switch (serverError) {
+            case AssetUtils::AssetServerError::AssetNotFound:
+                _error = NotFound;
+                break;
+            case AssetUtils::AssetServerError::InvalidByteRange:
+                _error = InvalidByteRange;
+                break;
+            default:
+                _error = UnknownError;
+                break;
+        }
+    } else {
+        return true;
+    }
+    return false;
+}
+
+void AssetRequest::finishWithData(const QByteArray& data) {
+    cancelPendingRequests();
+
+    if (!_byteRange.isSet() && AssetUtils::hashData(data).toHex() != _hash) {
+        // the hash of the received data does not match what we expect, so we return an error
+        _error = HashVerificationFailed;
+        finishWithError();
+        return;
+    }
+
+    _data = data;
+    _totalReceived = data.size();
+    emit progress(_totalReceived, data.size());
+
+    if (!_byteRange.isSet()) {
+        AssetUtils::saveToCache(getUrl(), data);
+        if (_partialFile) {
+            _partialFile->remove();
+        }
+    }
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::finishWithError() {
+    cancelPendingRequests();
+
+    // only a download cut short by the network is worth resuming
+    if (_partialFile && _error != NetworkError) {
+        _partialFile->remove();
+    }
+
+    qCWarning(asset_client) << "Got error retrieving asset" << _hash << "- error code" << _error;
+
+    _state = Finished;
+    emit finished(this);
+}
+
+void AssetRequest::cancelPendingRequests() {
+    auto assetClient = DependencyManager::get<AssetClient>();
+    if (_assetRequestID) {
+        assetClient->cancelGetAssetRequest(_assetRequestID);
+        _assetRequestID = INVALID_MESSAGE_ID;
+    }
+    if (_assetInfoRequestID) {
+        assetClient->cancelGetAssetInfoRequest(_assetInfoRequestID);
+        _assetInfoRequestID = INVALID_MESSAGE_ID;
+    }
+    for (const auto& chunkRequest : _chunkRequests) {
+        assetClient->cancelGetAssetRequest(chunkRequest.second);
+    }
+    _chunkRequests.clear();
+    _chunkBytesReceived.clear();
+}
 
 const QString AssetRequest::getErrorString() const {
     QString result;
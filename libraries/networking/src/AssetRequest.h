@@ -12,6 +12,9 @@
 #ifndef hifi_AssetRequest_h
 #define hifi_AssetRequest_h
 
+#include <memory>
+#include <unordered_map>
+
 #include <QByteArray>
 #include <QObject>
 #include <QString>
@@ -20,6 +23,7 @@
 #include "AssetUtils.h"
 
 #include "ByteRange.h"
+#include "PartialAssetFile.h"
 
 const QString ATP_SCHEME { "atp:" };
 
@@ -62,6 +66,20 @@ signals:
     void progress(qint64 totalReceived, qint64 total);
 
 private:
+    // a whole asset is first requested as its last chunk, which is all of it unless the asset is larger than a chunk
+    void requestLastChunk();
+    void requestRange();
+    void startChunkedDownload(AssetUtils::DataOffset size);
+    void requestChunks();
+    void handleChunk(int chunk, bool responseReceived, AssetUtils::AssetServerError serverError, const QByteArray& data);
+    void storeChunk(int chunk, const QByteArray& data);
+    void emitChunkedProgress();
+
+    bool setErrorFromReply(bool responseReceived, AssetUtils::AssetServerError serverError);
+    void finishWithData(const QByteArray& data);
+    void finishWithError();
+    void cancelPendingRequests();
+
     int _requestID;
     State _state = NotStarted;
     Error _error = NoError;
@@ -70,8 +88,17 @@ private:
     QByteArray _data;
     int _numPendingRequests { 0 };
     MessageID _assetRequestID { INVALID_MESSAGE_ID };
+    MessageID _assetInfoRequestID { INVALID_MESSAGE_ID };
     const ByteRange _byteRange;
     bool _loadedFromCache { false };
+
+    // a whole asset larger than a chunk is downloaded as several chunks at once
+    std::unique_ptr<PartialAssetFile> _partialFile;
+    QByteArray _lastChunk;
+    AssetUtils::DataOffset _size { -1 };
+    int _nextChunk { 0 };
+    std::unordered_map<int, MessageID> _chunkRequests;
+    std::unordered_map<int, qint64> _chunkBytesReceived;
 };
 
 #endif
@@ -46,7 +46,8 @@ enum AssetServerError : uint8_t {
     MappingOperationFailed,
     FileOperationFailed,
     NoAssetServer,
-    LostConnection
+    LostConnection,
+    ChunkNotFound
 };
 
 enum AssetMappingOperationType : uint8_t {
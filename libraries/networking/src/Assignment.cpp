@@ -18,6 +18,7 @@
 #include <QtCore/QDir>
 #include <QJsonObject>
 #include "crash-handler/CrashHandler.h"
+#include "NodeList.h"
 
 
 #include "udt/PacketHeaders.h"
@@ -25,6 +26,7 @@
 #include "UUID.h"
 
 static const QString CRASH_REPORTING_GROUP_KEY = "crash_reporting";
+static const QString TRANSPORT_GROUP_KEY = "transport";
 
 
 Assignment::Type Assignment::typeForNodeType(NodeType_t nodeType) {
@@ -178,6 +180,22 @@ void Assignment::commonParseSettingsObject(const QJsonObject &settingsObject) {
         ch.setAnnotation("assignment-client", "audio-mixer");
     }
 
+    if (settingsObject.contains(TRANSPORT_GROUP_KEY)) {
+        auto nodeList = DependencyManager::get<NodeList>();
+        QJsonObject transportGroupObject = settingsObject[TRANSPORT_GROUP_KEY].toObject();
+
+        const QString ENABLE_UDP_SEGMENTATION_OFFLOAD = "enable_udp_segmentation_offload";
+        nodeList->setSegmentationOffloadEnabled(transportGroupObject[ENABLE_UDP_SEGMENTATION_OFFLOAD].toBool());
+
+        const QString CONNECTION_WORKER_THREADS = "connection_worker_threads";
+        nodeList->setConnectionWorkerCount(transportGroupObject[CONNECTION_WORKER_THREADS].toVariant().toInt());
+
+        const QString VERIFICATION_WORKER_THREADS = "verification_worker_threads";
+        nodeList->setVerificationWorkerCount(transportGroupObject[VERIFICATION_WORKER_THREADS].toVariant().toInt());
+
+        const QString CONGESTION_CONTROL = "congestion_control";
+        nodeList->setCongestionControl(transportGroupObject[CONGESTION_CONTROL].toString());
+    }
 }
 
 QDebug operator<<(QDebug debug, const Assignment &assignment) {
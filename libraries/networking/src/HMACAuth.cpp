@@ -14,44 +14,200 @@
 #include <openssl/opensslv.h>
 #include <openssl/hmac.h>
 
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <QtEndian>
 #include <QUuid>
 #include "NetworkLogging.h"
 #include <cassert>
 #include "WarningsSuppression.h"
 
+static const int SIPHASH_KEY_SIZE = 16;
+static const int SIPHASH128_SIZE = 16;
+
+struct HMACAuth::Key {
+    uint64_t id; // unique for the life of the process, so a thread's context for a replaced key is never reused
+    AuthMethod authMethod;
+    const EVP_MD* sslStruct;
+    std::vector<char> value;
+    uint64_t sipHashKey[2];
+};
+
+static std::atomic<uint64_t> nextKeyID { 1 };
+
+static inline uint64_t rotateLeft(uint64_t value, int bits) {
+    return (value << bits) | (value >> (64 - bits));
+}
+
+static inline uint64_t readLittleEndian64(const unsigned char* data) {
+    return qFromLittleEndian<quint64>(data);
+}
+
+static inline void writeLittleEndian64(unsigned char* data, uint64_t value) {
+    qToLittleEndian<quint64>(value, data);
+}
+
+// SipHash-2-4 with a 128-bit output, as in the reference implementation by Aumasson and Bernstein
+static void sipHash128(const uint64_t key[2], const unsigned char* data, size_t dataLen,
+                       unsigned char hashResult[SIPHASH128_SIZE]) {
+    uint64_t v0 = 0x736f6d6570736575ULL ^ key[0];
+    uint64_t v1 = 0x646f72616e646f6dULL ^ key[1] ^ 0xee;
+    uint64_t v2 = 0x6c7967656e657261ULL ^ key[0];
+    uint64_t v3 = 0x7465646279746573ULL ^ key[1];
+
+    auto sipRound = [&] {
+        v0 += v1; v1 = rotateLeft(v1, 13); v1 ^= v0; v0 = rotateLeft(v0, 32);
+        v2 += v3; v3 = rotateLeft(v3, 16); v3 ^= v2;
+        v0 += v3; v3 = rotateLeft(v3, 21); v3 ^= v0;
+        v2 += v1; v1 = rotateLeft(v1, 17); v1 ^= v2; v2 = rotateLeft(v2, 32);
+    };
+
+    const unsigned char* end = data + (dataLen - dataLen % 8);
+    for (; data != end; data += 8) {
+        uint64_t m = readLittleEndian64(data);
+        v3 ^= m;
+        sipRound();
+        sipRound();
+        v0 ^= m;
+    }
+
+    uint64_t last = (uint64_t)dataLen << 56;
+    for (int i = (int)(dataLen % 8) - 1; i >= 0; --i) {
+        last |= (uint64_t)data[i] << (8 * i);
+    }
+
+    v3 ^= last;
+    sipRound();
+    sipRound();
+    v0 ^= last;
+
+    v2 ^= 0xee;
+    sipRound();
+    sipRound();
+    sipRound();
+    sipRound();
+    writeLittleEndian64(hashResult, v0 ^ v1 ^ v2 ^ v3);
+
+    v1 ^= 0xdd;
+    sipRound();
+    sipRound();
+    sipRound();
+    sipRound();
+    writeLittleEndian64(hashResult + 8, v0 ^ v1 ^ v2 ^ v3);
+}
 
 OVERTE_IGNORE_DEPRECATED_BEGIN
 // Qt provides HMAC, do we actually need this here?
 // But for the time being, suppress this.
 
 #if OPENSSL_VERSION_NUMBER >= 0x10100000
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(HMAC_CTX_new())
-    , _authMethod(authMethod) { }
+static HMAC_CTX* createHMACContext() {
+    return HMAC_CTX_new();
+}
 
-HMACAuth::~HMACAuth()
-{
-    HMAC_CTX_free(_hmacContext);
+static void destroyHMACContext(HMAC_CTX* hmacContext) {
+    HMAC_CTX_free(hmacContext);
 }
 
 #else
 
-HMACAuth::HMACAuth(AuthMethod authMethod)
-    : _hmacContext(new HMAC_CTX())
-    , _authMethod(authMethod) {
-    HMAC_CTX_init(_hmacContext);
+static HMAC_CTX* createHMACContext() {
+    auto hmacContext = new HMAC_CTX();
+    HMAC_CTX_init(hmacContext);
+    return hmacContext;
 }
 
-HMACAuth::~HMACAuth() {
-    HMAC_CTX_cleanup(_hmacContext);
-    delete _hmacContext;
+static void destroyHMACContext(HMAC_CTX* hmacContext) {
+    HMAC_CTX_cleanup(hmacContext);
+    delete hmacContext;
 }
 #endif
 
+namespace {
+
+// A thread's hashing state for one key. An HMAC context is kept keyed between hashes, so that the key setup isn't
+// repeated for every packet.
+struct ThreadContext {
+    uint64_t keyID { 0 };
+    HMAC_CTX* hmacContext { nullptr };
+    std::vector<char> pendingData; // data added for an incremental SipHash
+    bool isIncremental { false }; // addData() has been called without result()
+};
+
+// The contexts of a thread for the keys it has used most recently - a thread verifying packets from many nodes
+// rotates through their keys.
+class ThreadContexts {
+public:
+    ~ThreadContexts() {
+        for (auto& context : _contexts) {
+            if (context.hmacContext) {
+                destroyHMACContext(context.hmacContext);
+            }
+        }
+    }
+
+    ThreadContext* contextForKey(const HMACAuth::Key& key) {
+        for (auto& context : _contexts) {
+            if (context.keyID == key.id) {
+                return &context;
+            }
+        }
+
+        // replace the oldest context, unless an incremental hash is in progress in it
+        ThreadContext* context = &_contexts[_next];
+        for (size_t i = 0; i < NUM_CONTEXTS && context->isIncremental; ++i) {
+            _next = (_next + 1) % NUM_CONTEXTS;
+            context = &_contexts[_next];
+        }
+        _next = (_next + 1) % NUM_CONTEXTS;
+
+        context->keyID = 0;
+        context->pendingData.clear();
+        context->isIncremental = false;
+
+        if (key.authMethod != HMACAuth::SIPHASH128) {
+            if (!context->hmacContext) {
+                context->hmacContext = createHMACContext();
+            }
+
+            if (!HMAC_Init_ex(context->hmacContext, key.value.data(), (int)key.value.size(), key.sslStruct, nullptr)) {
+                return nullptr;
+            }
+        }
+
+        context->keyID = key.id;
+        return context;
+    }
+
+private:
+    static const size_t NUM_CONTEXTS = 16;
+    std::array<ThreadContext, NUM_CONTEXTS> _contexts;
+    size_t _next { 0 };
+};
+
+thread_local ThreadContexts threadContexts;
+
+}
+
+// Finishes the HMAC in the context and leaves it keyed for the next one.
+static bool finishHMAC(HMAC_CTX* hmacContext, unsigned char* hashResult, unsigned int* hashLen) {
+    auto hmacResult = HMAC_Final(hmacContext, hashResult, hashLen);
+    HMAC_Init_ex(hmacContext, nullptr, 0, nullptr, nullptr);
+    return (bool) hmacResult;
+}
+
+HMACAuth::HMACAuth(AuthMethod authMethod) :
+    _authMethod(authMethod) { }
+
+HMACAuth::~HMACAuth() { }
+
 bool HMACAuth::setKey(const char* keyValue, int keyLen) {
+    auto authMethod = getAuthMethod();
     const EVP_MD* sslStruct = nullptr;
 
-    switch (_authMethod) {
+    switch (authMethod) {
     case MD5:
         sslStruct = EVP_md5();
         break;
@@ -72,12 +228,29 @@ bool HMACAuth::setKey(const char* keyValue, int keyLen) {
         sslStruct = EVP_ripemd160();
         break;
 
+    case SIPHASH128:
+        if (keyLen != SIPHASH_KEY_SIZE) {
+            qCWarning(networking) << "SipHash needs a" << SIPHASH_KEY_SIZE << "byte key, not" << keyLen;
+            return false;
+        }
+        break;
+
     default:
         return false;
     }
 
-    QMutexLocker lock(&_lock);
-    return (bool) HMAC_Init_ex(_hmacContext, keyValue, keyLen, sslStruct, nullptr);
+    auto key = std::make_shared<Key>();
+    key->id = nextKeyID++;
+    key->authMethod = authMethod;
+    key->sslStruct = sslStruct;
+    key->value.assign(keyValue, keyValue + keyLen);
+    if (authMethod == SIPHASH128) {
+        key->sipHashKey[0] = readLittleEndian64(reinterpret_cast<const unsigned char*>(keyValue));
+        key->sipHashKey[1] = readLittleEndian64(reinterpret_cast<const unsigned char*>(keyValue) + 8);
+    }
+
+    std::atomic_store(&_key, std::shared_ptr<const Key>(std::move(key)));
+    return true;
 }
 
 bool HMACAuth::setKey(const QUuid& uidKey) {
@@ -85,17 +258,91 @@ bool HMACAuth::setKey(const QUuid& uidKey) {
     return setKey(rfcBytes.constData(), rfcBytes.length());
 }
 
+bool HMACAuth::setAuthMethod(AuthMethod authMethod) {
+    _authMethod = authMethod;
+
+    auto key = std::atomic_load(&_key);
+    if (key && key->authMethod != authMethod) {
+        return setKey(key->value.data(), (int)key->value.size());
+    }
+    return true;
+}
+
+int HMACAuth::calculateHash(unsigned char* hashResult, int maxHashLen, const char* data, int dataLen) const {
+    auto key = std::atomic_load(&_key);
+    if (!key) {
+        return 0;
+    }
+
+    unsigned char hashValue[EVP_MAX_MD_SIZE];
+    unsigned int hashLen = 0;
+
+    if (key->authMethod == SIPHASH128) {
+        // no context needed
+        sipHash128(key->sipHashKey, reinterpret_cast<const unsigned char*>(data), (size_t)dataLen, hashValue);
+        hashLen = SIPHASH128_SIZE;
+    } else {
+        auto context = threadContexts.contextForKey(*key);
+        if (!context || !HMAC_Update(context->hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen)
+            || !finishHMAC(context->hmacContext, hashValue, &hashLen)) {
+            return 0;
+        }
+    }
+
+    int resultLen = std::min((int)hashLen, maxHashLen);
+    memcpy(hashResult, hashValue, resultLen);
+    return resultLen;
+}
+
+bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) const {
+    hashResult.resize(EVP_MAX_MD_SIZE);
+
+    int hashLen = calculateHash(hashResult.data(), EVP_MAX_MD_SIZE, data, dataLen);
+    hashResult.resize(hashLen);
+
+    if (hashLen == 0) {
+        qCWarning(networking) << "Error occured calculating HMACAuth hash";
+        return false;
+    }
+    return true;
+}
+
 bool HMACAuth::addData(const char* data, int dataLen) {
-    QMutexLocker lock(&_lock);
-    return (bool) HMAC_Update(_hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
+    auto key = std::atomic_load(&_key);
+    auto context = key ? threadContexts.contextForKey(*key) : nullptr;
+    if (!context) {
+        return false;
+    }
+
+    context->isIncremental = true;
+    if (key->authMethod == SIPHASH128) {
+        context->pendingData.insert(context->pendingData.end(), data, data + dataLen);
+        return true;
+    }
+    return (bool) HMAC_Update(context->hmacContext, reinterpret_cast<const unsigned char*>(data), dataLen);
 }
 
 HMACAuth::HMACHash HMACAuth::result() {
     HMACHash hashValue(EVP_MAX_MD_SIZE);
-    unsigned int hashLen;
-    QMutexLocker lock(&_lock);
+    unsigned int hashLen = 0;
 
-    auto hmacResult = HMAC_Final(_hmacContext, &hashValue[0], &hashLen);
+    auto key = std::atomic_load(&_key);
+    auto context = key ? threadContexts.contextForKey(*key) : nullptr;
+
+    bool hmacResult = false;
+    if (context && key->authMethod == SIPHASH128) {
+        sipHash128(key->sipHashKey, reinterpret_cast<const unsigned char*>(context->pendingData.data()),
+                   context->pendingData.size(), &hashValue[0]);
+        hashLen = SIPHASH128_SIZE;
+        context->pendingData.clear();
+        hmacResult = true;
+    } else if (context) {
+        hmacResult = finishHMAC(context->hmacContext, &hashValue[0], &hashLen);
+    }
+
+    if (context) {
+        context->isIncremental = false;
+    }
 
     if (hmacResult) {
         hashValue.resize((size_t)hashLen);
@@ -103,24 +350,10 @@ HMACAuth::HMACHash HMACAuth::result() {
         // the HMAC_FINAL call failed - should not be possible to get into this state
         qCWarning(networking) << "Error occured calling HMAC_Final";
         assert(hmacResult);
+        hashValue.clear();
     }
 
-    // Clear state for possible reuse.
-    HMAC_Init_ex(_hmacContext, nullptr, 0, nullptr, nullptr);
     return hashValue;
 }
 
-bool HMACAuth::calculateHash(HMACHash& hashResult, const char* data, int dataLen) {
-    QMutexLocker lock(&_lock);
-    if (!addData(data, dataLen)) {
-        qCWarning(networking) << "Error occured calling HMACAuth::addData()";
-        assert(false);
-        return false;
-    }
-
-    hashResult = result();
-    return true;
-}
-
 OVERTE_IGNORE_DEPRECATED_END
-
@@ -12,15 +12,19 @@
 #ifndef hifi_HMACAuth_h
 #define hifi_HMACAuth_h
 
+#include <atomic>
 #include <vector>
 #include <memory>
-#include <QtCore/QMutex>
 
 class QUuid;
 
+// Hashes are calculated with a context that belongs to the calling thread, so one HMACAuth can be used to hash
+// (or verify) packets on any number of threads at once without locking. Changing the key or the method is
+// picked up by each thread on its next hash.
 class HMACAuth {
 public:
-    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160 };
+    // SIPHASH128 is keyed SipHash-2-4 with a 128-bit output, rather than an HMAC - it needs a 16 byte key
+    enum AuthMethod { MD5, SHA1, SHA224, SHA256, RIPEMD160, SIPHASH128 };
     using HMACHash = std::vector<unsigned char>;
     
     explicit HMACAuth(AuthMethod authMethod = MD5);
@@ -28,20 +32,30 @@ public:
 
     bool setKey(const char* keyValue, int keyLen);
     bool setKey(const QUuid& uidKey);
+    bool hasKey() const { return (bool)std::atomic_load(&_key); }
+
+    // Changes the method, keeping the current key.
+    bool setAuthMethod(AuthMethod authMethod);
+    AuthMethod getAuthMethod() const { return _authMethod; }
+
     // Calculate complete hash in one.
-    bool calculateHash(HMACHash& hashResult, const char* data, int dataLen);
+    bool calculateHash(HMACHash& hashResult, const char* data, int dataLen) const;
+    // Calculate complete hash in one, without allocating - writes at most maxHashLen bytes of the hash to hashResult.
+    // Returns the number of bytes written, 0 on failure.
+    int calculateHash(unsigned char* hashResult, int maxHashLen, const char* data, int dataLen) const;
 
     // Append to data to be hashed.
     bool addData(const char* data, int dataLen);
     // Get the resulting hash from calls to addData().
     // Note that only one hash may be calculated at a time for each
-    // HMACAuth instance if this interface is used.
+    // HMACAuth instance on each thread if this interface is used.
     HMACHash result();
 
+    struct Key;
+
 private:
-    QRecursiveMutex _lock;
-    struct hmac_ctx_st* _hmacContext;
-    AuthMethod _authMethod;
+    std::shared_ptr<const Key> _key; // only accessed with std::atomic_load and std::atomic_store
+    std::atomic<AuthMethod> _authMethod;
 };
 
 #endif  // hifi_HMACAuth_h
@@ -114,6 +114,7 @@ LimitedNodeList::LimitedNodeList(int socketListenPort, int dtlsListenPort) :
     // set our isPacketVerified method as the verify operator for the udt::Socket
     using std::placeholders::_1;
     _nodeSocket.setPacketFilterOperator(std::bind(&LimitedNodeList::isPacketVerified, this, _1));
+    _nodeSocket.setPacketVerifier(std::bind(&LimitedNodeList::isDeferredPacketVerified, this, _1));
 
     // set our socketBelongsToNode method as the connection creation filter operator for the udt::Socket
     _nodeSocket.setConnectionCreationFilterOperator(std::bind(&LimitedNodeList::sockAddrBelongsToNode, this, _1));
@@ -356,26 +357,19 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
                 && _useAuthentication;
 
             if (verifiedPacket && verificationEnabled) {
-
-                QByteArray packetHeaderHash = NLPacket::verificationHashInHeader(packet);
-                QByteArray expectedHash;
-                auto sourceNodeHMACAuth = sourceNode->getAuthenticateHash();
-                if (sourceNode->getAuthenticateHash()) {
-                    expectedHash = NLPacket::hashForPacketAndHMAC(packet, *sourceNodeHMACAuth);
-                }
-
-                // check if the HMAC-md5 hash in the header matches the hash we would expect
-                if (!sourceNodeHMACAuth || packetHeaderHash != expectedHash) {
-                    static QMultiMap<QUuid, PacketType> hashDebugSuppressMap;
-
-                    if (!hashDebugSuppressMap.contains(sourceID, headerType)) {
-                        qCDebug(networking) << "Packet hash mismatch on" << headerType << "- Sender" << sourceID;
-                        qCDebug(networking) << "Packet len:" << packet.getDataSize() << "Expected hash:" <<
-                            expectedHash.toHex() << "Actual:" << packetHeaderHash.toHex();
-
-                        hashDebugSuppressMap.insert(sourceID, headerType);
+                if (_nodeSocket.getVerificationWorkerCount() > 0) {
+                    // leave the hash check to a verification worker, which marks the node as heard from once it
+                    // passes. A backed up worker shouldn't let the node time out, so a packet from the node's own
+                    // socket marks it now as well.
+                    packet.setVerificationDeferred(true);
+                    auto activeSocket = sourceNode->getActiveSocket();
+                    if (activeSocket && *activeSocket == packet.getSenderSockAddr()) {
+                        sourceNode->setLastHeardMicrostamp(usecTimestampNow());
                     }
+                    return true;
+                }
 
+                if (!packetHashMatches(packet, *sourceNode)) {
                     return false;
                 }
             }
@@ -395,6 +389,47 @@ bool LimitedNodeList::packetSourceAndHashMatchAndTrackBandwidth(const udt::Packe
     return false;
 }
 
+bool LimitedNodeList::packetHashMatches(const udt::Packet& packet, const Node& sourceNode) {
+    // check if the HMAC hash in the header matches the hash we would expect
+    if (NLPacket::verificationHashMatches(packet, *sourceNode.getAuthenticateHash())) {
+        return true;
+    }
+
+    PacketType headerType = NLPacket::typeInHeader(packet);
+    if (sourceNode.isFirstHashMismatch(headerType)) {
+        qCDebug(networking) << "Packet hash mismatch on" << headerType << "- Sender" << sourceNode.getUUID();
+        qCDebug(networking) << "Packet len:" << packet.getDataSize() << "Expected hash:" <<
+            NLPacket::hashForPacketAndHMAC(packet, *sourceNode.getAuthenticateHash()).toHex() << "Actual:" <<
+            NLPacket::verificationHashInHeader(packet).toHex();
+    }
+
+    return false;
+}
+
+bool LimitedNodeList::isDeferredPacketVerified(const udt::Packet& packet) {
+    // the filter found the source node on the socket thread, but it may have been killed since
+    SharedNodePointer sourceNode = nodeWithLocalID(NLPacket::sourceIDInHeader(packet));
+    if (!sourceNode || !packetHashMatches(packet, *sourceNode)) {
+        return false;
+    }
+
+    sourceNode->setLastHeardMicrostamp(usecTimestampNow());
+    return true;
+}
+
+void LimitedNodeList::setAuthenticationMethod(HMACAuth::AuthMethod authMethod) {
+    if (_authenticationMethod == authMethod) {
+        return;
+    }
+
+    qCDebug(networking) << "Packet verification method changed to" << authMethod;
+    _authenticationMethod = authMethod;
+
+    eachNode([authMethod](const SharedNodePointer& node) {
+        node->setConnectionSecret(node->getConnectionSecret(), authMethod);
+    });
+}
+
 void LimitedNodeList::fillPacketHeader(const NLPacket& packet, HMACAuth* hmacAuth) {
     if (!PacketTypeEnum::getNonSourcedPackets().contains(packet.getType())) {
         packet.writeSourceID(getSessionLocalID());
@@ -518,8 +553,15 @@ qint64 LimitedNodeList::sendUnreliableUnorderedPacketList(NLPacketList& packetLi
 }
 
 qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList, const SockAddr& sockAddr) {
-    // close the last packet in the list
-    packetList->closeCurrentPacket();
+    if (packetList->isStreamed()) {
+        // the rest of a streamed list is filled on the send queue's thread, its headers are written there
+        packetList->_streamedPacketWriter = [this](udt::Packet& packet) {
+            fillPacketHeader(static_cast<NLPacket&>(packet));
+        };
+    } else {
+        // close the last packet in the list
+        packetList->closeCurrentPacket();
+    }
 
     for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
         NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
@@ -532,8 +574,17 @@ qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList,
 qint64 LimitedNodeList::sendPacketList(std::unique_ptr<NLPacketList> packetList, const Node& destinationNode) {
     auto activeSocket = destinationNode.getActiveSocket();
     if (activeSocket) {
-        // close the last packet in the list
-        packetList->closeCurrentPacket();
+        if (packetList->isStreamed()) {
+            // the rest of a streamed list is filled on the send queue's thread, hold on to the node so that its
+            // HMAC outlives the stream
+            auto node = nodeWithUUID(destinationNode.getUUID());
+            packetList->_streamedPacketWriter = [this, node](udt::Packet& packet) {
+                fillPacketHeader(static_cast<NLPacket&>(packet), node ? node->getAuthenticateHash() : nullptr);
+            };
+        } else {
+            // close the last packet in the list
+            packetList->closeCurrentPacket();
+        }
 
         for (std::unique_ptr<udt::Packet>& packet : packetList->_packets) {
             NLPacket* nlPacket = static_cast<NLPacket*>(packet.get());
@@ -689,7 +740,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
         matchingNode->setPublicSocket(publicSocket);
         matchingNode->setLocalSocket(localSocket);
         matchingNode->setPermissions(permissions);
-        matchingNode->setConnectionSecret(connectionSecret);
+        matchingNode->setConnectionSecret(connectionSecret, _authenticationMethod);
         matchingNode->setIsReplicated(isReplicated);
         matchingNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
         matchingNode->setLocalID(localID);
@@ -728,7 +779,7 @@ SharedNodePointer LimitedNodeList::addOrUpdateNode(const QUuid& uuid, NodeType_t
     Node* newNode = new Node(uuid, nodeType, publicSocket, localSocket);
     newNode->setIsReplicated(isReplicated);
     newNode->setIsUpstream(isUpstream || NodeType::isUpstream(nodeType));
-    newNode->setConnectionSecret(connectionSecret);
+    newNode->setConnectionSecret(connectionSecret, _authenticationMethod);
     newNode->setPermissions(permissions);
     newNode->setLocalID(localID);
 
@@ -316,6 +316,19 @@ public:
 
     void setConnectionMaxBandwidth(int maxBandwidth) { _nodeSocket.setConnectionMaxBandwidth(maxBandwidth); }
 
+    // coalesces the unreliable packets sent from the calling thread while in scope - see udt::Socket::SendBatch
+    class SendBatch : public udt::Socket::SendBatch {
+    public:
+        SendBatch(LimitedNodeList& nodeList) : udt::Socket::SendBatch(nodeList._nodeSocket) {}
+    };
+
+    void setSegmentationOffloadEnabled(bool enabled) { _nodeSocket.setSegmentationOffloadEnabled(enabled); }
+    void setConnectionWorkerCount(int numWorkers) { _nodeSocket.setConnectionWorkerCount(numWorkers); }
+    bool setCongestionControl(const QString& name) { return _nodeSocket.setCongestionControl(name); }
+    // with verification workers, the hash checks of sourced packets run on them instead of the networking thread
+    void setVerificationWorkerCount(int numWorkers) { _nodeSocket.setVerificationWorkerCount(numWorkers); }
+    udt::Socket::SendBatchStats getSendBatchStats() const { return _nodeSocket.getSendBatchStats(); }
+
     void setPacketFilterOperator(udt::PacketFilterOperator filterOperator) { _nodeSocket.setPacketFilterOperator(filterOperator); }
     bool packetVersionMatch(const udt::Packet& packet);
 
@@ -323,6 +336,9 @@ public:
     bool isPacketVerified(const udt::Packet& packet) { return isPacketVerifiedWithSource(packet); }
     void setAuthenticatePackets(bool useAuthentication) { _useAuthentication = useAuthentication; }
     bool getAuthenticatePackets() const { return _useAuthentication; }
+    // the domain-server picks the method and hands it to its nodes in the domain list
+    void setAuthenticationMethod(HMACAuth::AuthMethod authMethod);
+    HMACAuth::AuthMethod getAuthenticationMethod() const { return _authenticationMethod; }
 
     void setFlagTimeForConnectionStep(bool flag) { _flagTimeForConnectionStep = flag; }
     bool isFlagTimeForConnectionStep() { return _flagTimeForConnectionStep; }
@@ -423,6 +439,8 @@ protected:
     void setLocalSocket(const SockAddr& sockAddr);
 
     bool packetSourceAndHashMatchAndTrackBandwidth(const udt::Packet& packet, Node* sourceNode = nullptr);
+    bool packetHashMatches(const udt::Packet& packet, const Node& sourceNode);
+    bool isDeferredPacketVerified(const udt::Packet& packet); // runs on the socket's verification workers
     void processSTUNResponse(std::unique_ptr<udt::BasePacket> packet);
 
     void handleNodeKill(const SharedNodePointer& node, ConnectionID newConnectionID = NULL_CONNECTION_ID);
@@ -448,6 +466,7 @@ protected:
     SockAddr _stunSockAddr { SocketType::UDP, STUN_SERVER_HOSTNAME, STUN_SERVER_PORT };
     bool _hasTCPCheckedLocalSocket { false };
     bool _useAuthentication { true };
+    HMACAuth::AuthMethod _authenticationMethod { HMACAuth::MD5 };
 
     PacketReceiver* _packetReceiver;
 
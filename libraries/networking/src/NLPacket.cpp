@@ -12,7 +12,12 @@
 
 #include "NLPacket.h"
 
+#include <algorithm>
+
+#include <LogHandler.h>
+
 #include "HMACAuth.h"
+#include "NetworkLogging.h"
 
 int NLPacket::localHeaderSize(PacketType type) {
     bool nonSourced = PacketTypeEnum::getNonSourcedPackets().contains(type);
@@ -35,7 +40,7 @@ std::unique_ptr<NLPacket> NLPacket::create(PacketType type, qint64 size, bool is
     return packet;
 }
 
-std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+std::unique_ptr<NLPacket> NLPacket::fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                        const SockAddr& senderSockAddr) {
     // Fail with null data
     Q_ASSERT(data);
@@ -90,7 +95,7 @@ NLPacket::NLPacket(const NLPacket& other) : Packet(other) {
     _sourceID = other._sourceID;
 }
 
-NLPacket::NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+NLPacket::NLPacket(udt::PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) :
     Packet(std::move(data), size, senderSockAddr)
 {    
     // sanity check before we decrease the payloadSize with the payloadCapacity
@@ -153,7 +158,7 @@ QByteArray NLPacket::verificationHashInHeader(const udt::Packet& packet) {
     return QByteArray(packet.getData() + offset, NUM_BYTES_MD5_HASH);
 }
 
-QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash) {
+QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, const HMACAuth& hash) {
     int offset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
         + NUM_BYTES_LOCALID + NUM_BYTES_MD5_HASH;
     
@@ -162,7 +167,31 @@ QByteArray NLPacket::hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& h
     if (!hash.calculateHash(hashResult, packet.getData() + offset, packet.getDataSize() - offset)) {
         return QByteArray();
     }
-    return QByteArray((const char*) hashResult.data(), (int) hashResult.size());
+    return QByteArray((const char*) hashResult.data(), std::min((int) hashResult.size(), NUM_BYTES_MD5_HASH));
+}
+
+bool NLPacket::verificationHashMatches(const udt::Packet& packet, const HMACAuth& hash) {
+    int hashOffset = Packet::totalHeaderSize(packet.isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
+        + NUM_BYTES_LOCALID;
+    int offset = hashOffset + NUM_BYTES_MD5_HASH;
+
+    if (packet.getDataSize() < offset) {
+        return false;
+    }
+
+    unsigned char expectedHash[NUM_BYTES_MD5_HASH];
+    if (hash.calculateHash(expectedHash, NUM_BYTES_MD5_HASH, packet.getData() + offset,
+                           packet.getDataSize() - offset) != NUM_BYTES_MD5_HASH) {
+        return false;
+    }
+
+    // compare all of it whatever the first mismatch, so the time taken says nothing about the expected hash
+    auto headerHash = reinterpret_cast<const unsigned char*>(packet.getData() + hashOffset);
+    unsigned char difference = 0;
+    for (int i = 0; i < NUM_BYTES_MD5_HASH; ++i) {
+        difference |= headerHash[i] ^ expectedHash[i];
+    }
+    return difference == 0;
 }
 
 void NLPacket::writeTypeAndVersion() {
@@ -217,14 +246,19 @@ void NLPacket::writeSourceID(LocalID sourceID) const {
     _sourceID = sourceID;
 }
 
-void NLPacket::writeVerificationHash(HMACAuth& hmacAuth) const {
+void NLPacket::writeVerificationHash(const HMACAuth& hmacAuth) const {
     Q_ASSERT(!PacketTypeEnum::getNonSourcedPackets().contains(_type) &&
              !PacketTypeEnum::getNonVerifiedPackets().contains(_type));
     
     auto offset = Packet::totalHeaderSize(isPartOfMessage()) + sizeof(PacketType) + sizeof(PacketVersion)
                 + NUM_BYTES_LOCALID;
-
-    QByteArray verificationHash = hashForPacketAndHMAC(*this, hmacAuth);
-    
-    memcpy(_packet.get() + offset, verificationHash.data(), verificationHash.size());
+    auto payloadOffset = offset + NUM_BYTES_MD5_HASH;
+
+    // hash straight into the header - methods with longer hashes are truncated to fit it
+    int hashLen = hmacAuth.calculateHash(reinterpret_cast<unsigned char*>(_packet.get() + offset), NUM_BYTES_MD5_HASH,
+                                         _packet.get() + payloadOffset, (int)getDataSize() - payloadOffset);
+    if (hashLen == 0) {
+        // no key yet, or the hash failed - the receiver will reject the packet
+        HIFI_FCDEBUG(networking(), "Sending packet of type" << _type << "without a verification hash");
+    }
 }
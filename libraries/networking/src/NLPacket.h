@@ -50,7 +50,7 @@ public:
     static std::unique_ptr<NLPacket> create(PacketType type, qint64 size = -1,
                     bool isReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
     
-    static std::unique_ptr<NLPacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<NLPacket> fromReceivedPacket(udt::PacketBuffer data, qint64 size,
                                                         const SockAddr& senderSockAddr);
 
     static std::unique_ptr<NLPacket> fromBase(std::unique_ptr<Packet> packet);
@@ -70,7 +70,9 @@ public:
     
     static LocalID sourceIDInHeader(const udt::Packet& packet);
     static QByteArray verificationHashInHeader(const udt::Packet& packet);
-    static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, HMACAuth& hash);
+    static QByteArray hashForPacketAndHMAC(const udt::Packet& packet, const HMACAuth& hash);
+    // compares the verification hash in the header to the one calculated with the HMAC, without allocating
+    static bool verificationHashMatches(const udt::Packet& packet, const HMACAuth& hash);
     
     PacketType getType() const { return _type; }
     void setType(PacketType type);
@@ -81,12 +83,12 @@ public:
     LocalID getSourceID() const { return _sourceID; }
     
     void writeSourceID(LocalID sourceID) const;
-    void writeVerificationHash(HMACAuth& hmacAuth) const;
+    void writeVerificationHash(const HMACAuth& hmacAuth) const;
 
 protected:
     
     NLPacket(PacketType type, qint64 size = -1, bool forceReliable = false, bool isPartOfMessage = false, PacketVersion version = 0);
-    NLPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    NLPacket(udt::PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     NLPacket(const NLPacket& other);
     NLPacket(NLPacket&& other);
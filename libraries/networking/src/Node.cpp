@@ -234,17 +234,27 @@ QDebug operator<<(QDebug debug, const Node& node) {
     return debug.nospace();
 }
 
-void Node::setConnectionSecret(const QUuid& connectionSecret) {
-    if (_connectionSecret == connectionSecret) {
+void Node::setConnectionSecret(const QUuid& connectionSecret, HMACAuth::AuthMethod authMethod) {
+    if (_connectionSecret == connectionSecret && _authenticateHash->getAuthMethod() == authMethod) {
         return;
     }
 
-    if (!_authenticateHash) {
-        _authenticateHash.reset(new HMACAuth());
+    // changing the method keeps the key
+    _authenticateHash->setAuthMethod(authMethod);
+
+    if (_connectionSecret != connectionSecret) {
+        _connectionSecret = connectionSecret;
+        _authenticateHash->setKey(_connectionSecret);
     }
+}
 
-    _connectionSecret = connectionSecret;
-    _authenticateHash->setKey(_connectionSecret);
+bool Node::isFirstHashMismatch(PacketType packetType) const {
+    QMutexLocker locker(&_hashMismatchTypesMutex);
+    if (_hashMismatchTypes.contains(packetType)) {
+        return false;
+    }
+    _hashMismatchTypes.insert(packetType);
+    return true;
 }
 
 void Node::updateStats(Stats stats) {
@@ -37,6 +37,7 @@
 #include "NodePermissions.h"
 #include "HMACAuth.h"
 #include "udt/ConnectionStats.h"
+#include "udt/PacketHeaders.h"
 #include "NumericalConstants.h"
 
 class Node : public NetworkPeer {
@@ -61,8 +62,11 @@ public:
     void setIsUpstream(bool isUpstream) { _isUpstream = isUpstream; }
 
     const QUuid& getConnectionSecret() const { return _connectionSecret; }
-    void setConnectionSecret(const QUuid& connectionSecret);
+    void setConnectionSecret(const QUuid& connectionSecret, HMACAuth::AuthMethod authMethod = HMACAuth::MD5);
+    // never changes for the life of the node, so it can be used on the packet verification workers
     HMACAuth* getAuthenticateHash() const { return _authenticateHash.get(); }
+    // true the first time a packet of this type fails its hash check, so that each mismatch is only logged once
+    bool isFirstHashMismatch(PacketType packetType) const;
 
     NodeData* getLinkedData() const { return _linkedData.get(); }
     void setLinkedData(std::unique_ptr<NodeData> linkedData) { _linkedData = std::move(linkedData); }
@@ -112,7 +116,9 @@ private:
     NodeType_t _type;
 
     QUuid _connectionSecret;
-    std::unique_ptr<HMACAuth> _authenticateHash { nullptr };
+    std::unique_ptr<HMACAuth> _authenticateHash { new HMACAuth() }; // no key until there is a connection secret
+    mutable QSet<PacketType> _hashMismatchTypes;
+    mutable QMutex _hashMismatchTypesMutex; // hashes are checked on the packet verification workers
     std::unique_ptr<NodeData> _linkedData;
     bool _isReplicated { false };
     int _pingMs;
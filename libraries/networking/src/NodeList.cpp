@@ -752,6 +752,10 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
     bool isAuthenticated;
     packetStream >> isAuthenticated;
 
+    // and which method does the domain want its packets verified with?
+    quint8 authenticationMethod;
+    packetStream >> authenticationMethod;
+
     qint64 now = qint64(duration_cast<microseconds>(system_clock::now().time_since_epoch()).count());
 
     quint64 connectRequestTimestamp;
@@ -861,6 +865,12 @@ void NodeList::processDomainList(QSharedPointer<ReceivedMessage> message) {
 
     setPermissions(newPermissions);
     setAuthenticatePackets(isAuthenticated);
+    if (authenticationMethod > HMACAuth::SIPHASH128) {
+        qCWarning(networking) << "Domain server asked for unknown packet authentication method" << authenticationMethod
+                              << "- using MD5";
+        authenticationMethod = HMACAuth::MD5;
+    }
+    setAuthenticationMethod((HMACAuth::AuthMethod)authenticationMethod);
 
     // pull each node in the packet
     while (packetStream.device()->pos() < message->getSize()) {
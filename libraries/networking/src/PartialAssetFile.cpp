@@ -0,0 +1,138 @@
+//
+//  PartialAssetFile.cpp
+//  libraries/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PartialAssetFile.h"
+
+#include <algorithm>
+
+#include <QtCore/QDir>
+#include <QtCore/QFileInfo>
+
+#include "NetworkLogging.h"
+
+static const quint32 CHUNKS_FILE_MAGIC = 0x50505441; // "ATPP"
+static const quint32 CHUNKS_FILE_VERSION = 1;
+
+struct ChunksFileHeader {
+    quint32 magic;
+    quint32 version;
+    AssetUtils::DataOffset size;
+    AssetUtils::DataOffset chunkSize;
+};
+
+PartialAssetFile::PartialAssetFile(const QString& directory, const AssetUtils::AssetHash& hash) {
+    if (!directory.isEmpty()) {
+        QDir dir(directory);
+        _dataFile.setFileName(dir.filePath(hash + ".part"));
+        _chunksFile.setFileName(dir.filePath(hash + ".chunks"));
+    }
+}
+
+bool PartialAssetFile::load() {
+    if (_dataFile.fileName().isEmpty() || !_chunksFile.exists() || !_dataFile.exists()) {
+        return false;
+    }
+
+    ChunksFileHeader header;
+    if (!_chunksFile.open(QIODevice::ReadWrite) || !_dataFile.open(QIODevice::ReadWrite) ||
+        _chunksFile.read(reinterpret_cast<char*>(&header), sizeof(header)) != (qint64)sizeof(header) ||
+        header.magic != CHUNKS_FILE_MAGIC || header.version != CHUNKS_FILE_VERSION ||
+        header.size < 0 || header.chunkSize <= 0 || _dataFile.size() != header.size) {
+        remove();
+        return false;
+    }
+
+    auto numChunks = (header.size + header.chunkSize - 1) / header.chunkSize;
+    QByteArray chunks = _chunksFile.read(numChunks);
+    if (chunks.size() != numChunks) {
+        remove();
+        return false;
+    }
+
+    _size = header.size;
+    _chunkSize = header.chunkSize;
+    _isChunkComplete.resize((size_t)numChunks);
+    for (int i = 0; i < (int)numChunks; ++i) {
+        _isChunkComplete[i] = chunks[i] != 0;
+    }
+    return true;
+}
+
+bool PartialAssetFile::create(AssetUtils::DataOffset size, AssetUtils::DataOffset chunkSize) {
+    _size = size;
+    _chunkSize = chunkSize;
+    _isChunkComplete.assign((size_t)((size + chunkSize - 1) / chunkSize), false);
+
+    if (_dataFile.fileName().isEmpty()) {
+        return false;
+    }
+
+    _dataFile.close();
+    _chunksFile.close();
+    QDir().mkpath(QFileInfo(_dataFile).absolutePath());
+
+    ChunksFileHeader header { CHUNKS_FILE_MAGIC, CHUNKS_FILE_VERSION, _size, _chunkSize };
+    QByteArray chunks(getNumChunks(), 0);
+    if (!_dataFile.open(QIODevice::ReadWrite | QIODevice::Truncate) || !_dataFile.resize(_size) ||
+        !_chunksFile.open(QIODevice::ReadWrite | QIODevice::Truncate) ||
+        _chunksFile.write(reinterpret_cast<const char*>(&header), sizeof(header)) != (qint64)sizeof(header) ||
+        _chunksFile.write(chunks) != chunks.size() || !_chunksFile.flush()) {
+        qCWarning(asset_client) << "Could not keep the download of" << _dataFile.fileName() << "on disk -"
+            << _dataFile.errorString() << _chunksFile.errorString();
+        remove();
+        return false;
+    }
+    return true;
+}
+
+int PartialAssetFile::getNumCompleteChunks() const {
+    return (int)std::count(_isChunkComplete.begin(), _isChunkComplete.end(), true);
+}
+
+ByteRange PartialAssetFile::getChunkRange(int chunk) const {
+    ByteRange range;
+    range.toExclusive = _size - (getNumChunks() - 1 - chunk) * _chunkSize;
+    range.fromInclusive = std::max(range.toExclusive - _chunkSize, (AssetUtils::DataOffset)0);
+    return range;
+}
+
+QByteArray PartialAssetFile::readChunk(int chunk) {
+    auto range = getChunkRange(chunk);
+    if (!isOnDisk() || !_dataFile.seek(range.fromInclusive)) {
+        return QByteArray();
+    }
+    return _dataFile.read(range.size());
+}
+
+void PartialAssetFile::writeChunk(int chunk, const QByteArray& data) {
+    _isChunkComplete[chunk] = true;
+
+    if (isOnDisk()) {
+        // the data goes out before the chunk is marked as complete
+        const char COMPLETE = 1;
+        auto range = getChunkRange(chunk);
+        if (!_dataFile.seek(range.fromInclusive) || _dataFile.write(data) != data.size() || !_dataFile.flush() ||
+            !_chunksFile.seek(sizeof(ChunksFileHeader) + chunk) || _chunksFile.write(&COMPLETE, 1) != 1 ||
+            !_chunksFile.flush()) {
+            qCWarning(asset_client) << "Could not write to" << _dataFile.fileName() << "- the download can't be resumed";
+            remove();
+        }
+    }
+}
+
+void PartialAssetFile::remove() {
+    _dataFile.close();
+    _chunksFile.close();
+    if (!_dataFile.fileName().isEmpty()) {
+        _dataFile.remove();
+        _chunksFile.remove();
+    }
+}
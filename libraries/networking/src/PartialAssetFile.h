@@ -0,0 +1,65 @@
+//
+//  PartialAssetFile.h
+//  libraries/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_PartialAssetFile_h
+#define overte_PartialAssetFile_h
+
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QString>
+
+#include "AssetUtils.h"
+#include "ByteRange.h"
+
+// The chunks of an asset download received so far, kept on disk where possible so that the download can resume after a
+// reconnect.
+//
+// The chunks are written to <hash>.part at their offset in the asset and <hash>.chunks records which of them are
+// complete. The chunks are laid out from the end of the asset, so that the last chunk is always a full one and only the
+// first one can be short.
+class PartialAssetFile {
+public:
+    PartialAssetFile(const QString& directory, const AssetUtils::AssetHash& hash);
+
+    // Picks up an earlier download of the asset, returns false if there is none
+    bool load();
+
+    // Starts the download of an asset of the given size over. Returns false if it can't be kept on disk, the chunks are
+    // then only tracked in memory.
+    bool create(AssetUtils::DataOffset size, AssetUtils::DataOffset chunkSize);
+
+    AssetUtils::DataOffset getSize() const { return _size; }
+    AssetUtils::DataOffset getChunkSize() const { return _chunkSize; }
+    int getNumChunks() const { return (int)_isChunkComplete.size(); }
+    int getNumCompleteChunks() const;
+    bool isChunkComplete(int chunk) const { return _isChunkComplete[chunk]; }
+    ByteRange getChunkRange(int chunk) const;
+
+    QByteArray readChunk(int chunk);
+    // Marks the chunk as complete, writing it out if the download is kept on disk
+    void writeChunk(int chunk, const QByteArray& data);
+
+    // Drops the download, once it is complete or can't be used any more
+    void remove();
+
+private:
+    bool isOnDisk() const { return _dataFile.isOpen() && _chunksFile.isOpen(); }
+
+    QFile _dataFile;
+    QFile _chunksFile;
+    AssetUtils::DataOffset _size { 0 };
+    AssetUtils::DataOffset _chunkSize { 0 };
+    std::vector<bool> _isChunkComplete;
+};
+
+#endif // overte_PartialAssetFile_h
@@ -119,8 +119,30 @@ void ThreadedAssignment::addPacketStatsAndSendStatsPacket(QJsonObject statsObjec
     ioStats["outbound_kbps"] = nodeList->getOutboundKbps();
     ioStats["outbound_pps"] = nodeList->getOutboundPPS();
 
+    // how many datagrams each batched send system call carried since the last stats packet
+    auto sendBatchStats = nodeList->getSendBatchStats();
+    auto numSendCalls = sendBatchStats.numSendCalls - _lastSendBatchStats.numSendCalls;
+    auto numBatchedDatagrams = sendBatchStats.numDatagrams - _lastSendBatchStats.numDatagrams;
+    _lastSendBatchStats = sendBatchStats;
+    ioStats["batched_send_calls"] = (qint64)numSendCalls;
+    ioStats["batched_send_datagrams"] = (qint64)numBatchedDatagrams;
+    ioStats["datagrams_per_send_call"] = numSendCalls > 0 ? (double)numBatchedDatagrams / (double)numSendCalls : 0.0;
+
     statsObject["io_stats"] = ioStats;
 
+    // how often packet buffers were recycled rather than allocated since the last stats packet
+    auto packetPoolStats = udt::PacketBufferPool::getStats();
+    auto numPoolHits = packetPoolStats.hits - _lastPacketPoolStats.hits;
+    auto numPoolMisses = packetPoolStats.misses - _lastPacketPoolStats.misses;
+    _lastPacketPoolStats = packetPoolStats;
+
+    QJsonObject packetPoolStatsObject;
+    packetPoolStatsObject["hits"] = (qint64)numPoolHits;
+    packetPoolStatsObject["misses"] = (qint64)numPoolMisses;
+    packetPoolStatsObject["hit_rate"] = (numPoolHits + numPoolMisses) > 0
+        ? (double)numPoolHits / (double)(numPoolHits + numPoolMisses) : 0.0;
+    statsObject["packet_pool"] = packetPoolStatsObject;
+
     QJsonObject assignmentStats;
     assignmentStats["numQueuedCheckIns"] = _numQueuedCheckIns;
 
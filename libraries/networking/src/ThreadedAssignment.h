@@ -15,6 +15,8 @@
 #include <QtCore/QSharedPointer>
 
 #include "ReceivedMessage.h"
+#include "udt/PacketBufferPool.h"
+#include "udt/Socket.h"
 
 #include "Assignment.h"
 
@@ -48,6 +50,8 @@ protected:
     QTimer _domainServerTimer;
     QTimer _statsTimer;
     int _numQueuedCheckIns { 0 };
+    udt::Socket::SendBatchStats _lastSendBatchStats;
+    udt::PacketBufferPool::Stats _lastPacketPoolStats;
 
 protected slots:
     void domainSettingsRequestFailed();
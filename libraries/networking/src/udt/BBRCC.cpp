@@ -0,0 +1,402 @@
+//
+//  BBRCC.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BBRCC.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include <QtCore/QtGlobal>
+
+using namespace udt;
+using namespace std::chrono;
+
+static const double USECS_PER_SECOND = 1000000.0;
+
+// 2 / ln(2) - the smallest gain that doubles the delivery rate every round trip in startup
+static const double HIGH_GAIN = 2.885;
+static const double DRAIN_GAIN = 1.0 / HIGH_GAIN;
+// lower than the pacing gain in startup (as in later BBR versions), since a startup overshoot costs us a lot - see onLoss
+static const double STARTUP_WINDOW_GAIN = 2.0;
+static const double PROBE_BANDWIDTH_WINDOW_GAIN = 2.0;
+static const double PROBE_BANDWIDTH_PACING_GAINS[] = { 1.25, 0.75, 1.0, 1.0, 1.0, 1.0, 1.0, 1.0 };
+
+// the bandwidth estimate has to grow by this much in a round trip for startup to keep going
+static const double FULL_BANDWIDTH_GROWTH = 1.25;
+static const int FULL_BANDWIDTH_ROUNDS = 3;
+
+static const int INITIAL_CONGESTION_WINDOW = 16;
+static const int MIN_CONGESTION_WINDOW = 4;
+static const int ACK_AGGREGATION_ALLOWANCE = 3; // extra packets in the window to cover ACKs arriving in bursts
+
+static const auto MIN_RTT_WINDOW = seconds(10);
+static const auto PROBE_RTT_DURATION = milliseconds(200);
+
+// a send this long after the previous one, with room left in the congestion window, means the sender ran out of data
+static const auto MIN_APP_LIMITED_GAP = microseconds(1000);
+
+BBRCC::BBRCC() :
+    _pacingGain(HIGH_GAIN),
+    _congestionWindowGain(STARTUP_WINDOW_GAIN)
+{
+    // unpaced until the first delivery rate sample
+    _packetSendPeriod = 0.0;
+    _congestionWindowSize = INITIAL_CONGESTION_WINDOW;
+}
+
+double BBRCC::getBottleneckBandwidth() const {
+    double bandwidth = 0.0;
+    for (int i = 0; i < BANDWIDTH_FILTER_ROUNDS; ++i) {
+        if (_bandwidthSampleRounds[i] > _roundCount - BANDWIDTH_FILTER_ROUNDS) {
+            bandwidth = std::max(bandwidth, _bandwidthSamples[i]);
+        }
+    }
+    return bandwidth;
+}
+
+int BBRCC::getBandwidthDelayProduct(double gain) const {
+    double bandwidth = getBottleneckBandwidth();
+    if (_minRTT < 0 || bandwidth <= 0.0) {
+        return INITIAL_CONGESTION_WINDOW;
+    }
+    return (int)std::ceil(gain * bandwidth * _minRTT / USECS_PER_SECOND);
+}
+
+int BBRCC::getPacketsInFlight() const {
+    return (int)_sentPacketDatas.size();
+}
+
+void BBRCC::onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    int packetsInFlight = getPacketsInFlight();
+
+    if (packetsInFlight == 0) {
+        // nothing is in flight, so delivery rate samples start now rather than at the last (old) delivery
+        _deliveredTime = timePoint;
+        _firstSentTime = timePoint;
+    }
+
+    auto appLimitedGap = std::max(MIN_APP_LIMITED_GAP, microseconds((int64_t)(2 * _packetSendPeriod)));
+    bool isAppLimited = _lastSendTime != p_high_resolution_clock::time_point()
+        && timePoint - _lastSendTime > appLimitedGap
+        && packetsInFlight < _congestionWindowSize;
+
+    _sentPacketDatas.push_back({ seqNum, timePoint, _delivered, _deliveredTime, _firstSentTime, isAppLimited, false });
+    _lastSendTime = timePoint;
+}
+
+void BBRCC::onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) {
+    auto it = std::find_if(_sentPacketDatas.begin(), _sentPacketDatas.end(), [seqNum](SentPacketData& sentPacketInfo){
+        return sentPacketInfo.sequenceNumber == seqNum;
+    });
+
+    // if we found information for this packet (it hasn't been erased because it hasn't yet been ACKed)
+    // then mark it as re-sent so we know it cannot be used for RTT calculations, and give the re-sent packet a whole
+    // timeout before it is fast re-transmitted again
+    if (it != _sentPacketDatas.end()) {
+        it->timePoint = timePoint;
+        it->wasResent = true;
+    }
+}
+
+bool BBRCC::onACK(SequenceNumber ack, p_high_resolution_clock::time_point receiveTime) {
+    auto previousAck = _lastACK;
+    _lastACK = ack;
+
+    bool wasDuplicateACK = (ack == previousAck);
+    bool hasMinRTTExpired = _minRTT >= 0 && receiveTime - _minRTTTimestamp > MIN_RTT_WINDOW;
+
+    int numDelivered = 0;
+    _isRoundStart = false;
+
+    if (!wasDuplicateACK) {
+        // an RTT sample is only unambiguous if none of the packets this ACK covers were re-sent
+        bool canBeUsedForRTT = true;
+        SentPacketData newestDelivered {};
+
+        while (!_sentPacketDatas.empty() && _sentPacketDatas.front().sequenceNumber <= ack) {
+            newestDelivered = _sentPacketDatas.front();
+            canBeUsedForRTT = canBeUsedForRTT && !newestDelivered.wasResent;
+
+            _sentPacketDatas.pop_front();
+            ++numDelivered;
+        }
+
+        if (numDelivered > 0) {
+            _delivered += numDelivered;
+            _deliveredTime = receiveTime;
+
+            if (canBeUsedForRTT && newestDelivered.sequenceNumber == ack) {
+                updateRTT((int)duration_cast<microseconds>(receiveTime - newestDelivered.timePoint).count(),
+                          receiveTime, hasMinRTTExpired);
+            }
+
+            updateBandwidth(newestDelivered, receiveTime);
+            _firstSentTime = newestDelivered.timePoint;
+        }
+    }
+
+    updateMode(receiveTime, hasMinRTTExpired);
+    updateControlParameters(numDelivered);
+
+    ++_numACKSinceFastRetransmit;
+
+    // perform the fast re-transmit check if this is a duplicate ACK or if this is the first or second ACK
+    // after a previous fast re-transmit
+    if (wasDuplicateACK || _numACKSinceFastRetransmit < 3) {
+        if (needsFastRetransmit(ack, wasDuplicateACK)) {
+            onLoss();
+            return true;
+        }
+    } else {
+        _duplicateACKCount = 0;
+    }
+
+    return false;
+}
+
+void BBRCC::onTimeout() {
+    onLoss();
+
+    // everything in flight is presumed lost - start again from a small window, which grows back to the
+    // bandwidth-delay product as the re-sent packets are delivered
+    _congestionWindowSize = MIN_CONGESTION_WINDOW;
+}
+
+void BBRCC::onLoss() {
+    // without selective ACKs only one hole is filled per round trip, so the burst of losses from overshooting the
+    // queue in startup takes far longer to recover from than in TCP - take the first loss to mean the pipe is full
+    if (_mode == Mode::Startup && _minRTT >= 0) {
+        _isFullPipe = true;
+    }
+}
+
+void BBRCC::updateRTT(int rtt, p_high_resolution_clock::time_point now, bool hasMinRTTExpired) {
+    const int MAX_RTT_SAMPLE_MICROSECONDS = 10000000;
+
+    if (rtt < 0) {
+        Q_ASSERT_X(false, __FUNCTION__, "calculated an RTT that is not > 0");
+        return;
+    }
+    rtt = std::max(1, std::min(rtt, MAX_RTT_SAMPLE_MICROSECONDS));
+
+    if (_ewmaRTT == -1) {
+        _ewmaRTT = rtt;
+        _rttVariance = rtt / 2;
+    } else {
+        // Jacobson's RTT estimation, as in TCPVegasCC - only used for the estimated timeout
+        static const int RTT_ESTIMATION_ALPHA = 8;
+        static const int RTT_ESTIMATION_VARIANCE_ALPHA = 4;
+
+        _ewmaRTT = (_ewmaRTT * (RTT_ESTIMATION_ALPHA - 1) + rtt) / RTT_ESTIMATION_ALPHA;
+        _rttVariance = (_rttVariance * (RTT_ESTIMATION_VARIANCE_ALPHA - 1)
+                        + abs(rtt - _ewmaRTT)) / RTT_ESTIMATION_VARIANCE_ALPHA;
+    }
+
+    if (_minRTT < 0 || rtt <= _minRTT || hasMinRTTExpired) {
+        _minRTT = rtt;
+        _minRTTTimestamp = now;
+    }
+}
+
+void BBRCC::updateBandwidth(const SentPacketData& packet, p_high_resolution_clock::time_point now) {
+    if (packet.delivered >= _nextRoundDelivered) {
+        // this packet was sent after the current round started, so that round is over
+        _nextRoundDelivered = _delivered;
+        ++_roundCount;
+        _isRoundStart = true;
+    }
+
+    // the delivery rate is measured over the longer of the send and ACK intervals, so that neither packets sent in a
+    // burst nor ACKs arriving in a burst inflate it
+    auto sendInterval = duration_cast<microseconds>(packet.timePoint - packet.firstSentTime).count();
+    auto ackInterval = duration_cast<microseconds>(now - packet.deliveredTime).count();
+    auto interval = std::max(sendInterval, ackInterval);
+    if (interval <= 0) {
+        return;
+    }
+
+    double deliveryRate = (double)(_delivered - packet.delivered) * USECS_PER_SECOND / interval;
+
+    // application limited samples say more about how much the sender had to send than about the path
+    if (packet.isAppLimited && deliveryRate < getBottleneckBandwidth()) {
+        return;
+    }
+
+    int slot = (int)(_roundCount % BANDWIDTH_FILTER_ROUNDS);
+    if (_bandwidthSampleRounds[slot] != _roundCount) {
+        _bandwidthSampleRounds[slot] = _roundCount;
+        _bandwidthSamples[slot] = 0.0;
+    }
+    _bandwidthSamples[slot] = std::max(_bandwidthSamples[slot], deliveryRate);
+}
+
+void BBRCC::enterProbeBandwidth(p_high_resolution_clock::time_point now) {
+    _mode = Mode::ProbeBandwidth;
+    _congestionWindowGain = PROBE_BANDWIDTH_WINDOW_GAIN;
+
+    // start on a cruising phase, so that we don't probe straight after draining
+    _cycleIndex = 2;
+    _cycleTimestamp = now;
+    _pacingGain = PROBE_BANDWIDTH_PACING_GAINS[_cycleIndex];
+}
+
+void BBRCC::advanceCyclePhase(p_high_resolution_clock::time_point now) {
+    auto phaseLength = now - _cycleTimestamp;
+    bool isFullLength = _minRTT >= 0 && phaseLength > microseconds(_minRTT);
+
+    bool shouldAdvance;
+    if (_pacingGain > 1.0) {
+        // keep probing until the extra packets are actually in flight (or it's clear they can't be)
+        shouldAdvance = isFullLength
+            && (getPacketsInFlight() >= getBandwidthDelayProduct(_pacingGain) || phaseLength > 4 * microseconds(_minRTT));
+    } else if (_pacingGain < 1.0) {
+        // stop draining as soon as the queue the probe built is gone
+        shouldAdvance = isFullLength || getPacketsInFlight() <= getBandwidthDelayProduct(1.0);
+    } else {
+        shouldAdvance = isFullLength;
+    }
+
+    if (shouldAdvance) {
+        _cycleIndex = (_cycleIndex + 1) % PROBE_BANDWIDTH_PHASES;
+        _cycleTimestamp = now;
+        _pacingGain = PROBE_BANDWIDTH_PACING_GAINS[_cycleIndex];
+    }
+}
+
+void BBRCC::updateMode(p_high_resolution_clock::time_point now, bool hasMinRTTExpired) {
+    if (!_isFullPipe && _isRoundStart) {
+        double bandwidth = getBottleneckBandwidth();
+        if (bandwidth >= _fullBandwidth * FULL_BANDWIDTH_GROWTH) {
+            _fullBandwidth = bandwidth;
+            _fullBandwidthCount = 0;
+        } else if (++_fullBandwidthCount >= FULL_BANDWIDTH_ROUNDS) {
+            _isFullPipe = true;
+        }
+    }
+
+    if (_mode == Mode::Startup && _isFullPipe) {
+        // drain the queue startup built up at the bottleneck
+        _mode = Mode::Drain;
+        _pacingGain = DRAIN_GAIN;
+        _congestionWindowGain = STARTUP_WINDOW_GAIN;
+    }
+
+    if (_mode == Mode::Drain && getPacketsInFlight() <= getBandwidthDelayProduct(1.0)) {
+        enterProbeBandwidth(now);
+    }
+
+    if (_mode == Mode::ProbeBandwidth) {
+        advanceCyclePhase(now);
+    }
+
+    if (hasMinRTTExpired && _mode != Mode::ProbeRTT) {
+        // we haven't seen the minimum RTT for a while - cut the window so any queue drains and we can measure it
+        _mode = Mode::ProbeRTT;
+        _pacingGain = 1.0;
+        _congestionWindowGain = 1.0;
+        _priorCongestionWindowSize = _congestionWindowSize;
+        _probeRTTDoneTime = p_high_resolution_clock::time_point();
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        if (_probeRTTDoneTime == p_high_resolution_clock::time_point()) {
+            if (getPacketsInFlight() <= MIN_CONGESTION_WINDOW) {
+                // the queue is gone - stay here for a while and at least one round trip
+                _probeRTTDoneTime = now + PROBE_RTT_DURATION;
+                _isProbeRTTRoundDone = false;
+                _nextRoundDelivered = _delivered;
+            }
+        } else {
+            if (_isRoundStart) {
+                _isProbeRTTRoundDone = true;
+            }
+
+            if (_isProbeRTTRoundDone && now > _probeRTTDoneTime) {
+                _minRTTTimestamp = now;
+                _congestionWindowSize = std::max(_congestionWindowSize, _priorCongestionWindowSize);
+
+                if (_isFullPipe) {
+                    enterProbeBandwidth(now);
+                } else {
+                    _mode = Mode::Startup;
+                    _pacingGain = HIGH_GAIN;
+                    _congestionWindowGain = STARTUP_WINDOW_GAIN;
+                }
+            }
+        }
+    }
+}
+
+void BBRCC::updateControlParameters(int numDelivered) {
+    double bandwidth = getBottleneckBandwidth();
+
+    if (!_isFullPipe && _minRTT > 0) {
+        // the first samples of a connection are low - during startup pace at least at the rate the initial window
+        // would go out at
+        bandwidth = std::max(bandwidth, INITIAL_CONGESTION_WINDOW * USECS_PER_SECOND / _minRTT);
+    }
+
+    if (bandwidth > 0.0) {
+        double packetSendPeriod = USECS_PER_SECOND / (_pacingGain * bandwidth);
+
+        // during startup the rate only goes up
+        if (_isFullPipe || _packetSendPeriod <= 0.0 || packetSendPeriod < _packetSendPeriod) {
+            setPacketSendPeriod(packetSendPeriod);
+        }
+    }
+
+    int targetWindowSize = getBandwidthDelayProduct(_congestionWindowGain) + ACK_AGGREGATION_ALLOWANCE;
+
+    if (_isFullPipe) {
+        _congestionWindowSize = std::min(_congestionWindowSize + numDelivered, targetWindowSize);
+    } else if (_congestionWindowSize < targetWindowSize || _delivered < INITIAL_CONGESTION_WINDOW) {
+        _congestionWindowSize += numDelivered;
+    }
+
+    if (_mode == Mode::ProbeRTT) {
+        _congestionWindowSize = std::min(_congestionWindowSize, MIN_CONGESTION_WINDOW);
+    }
+
+    _congestionWindowSize = std::max(MIN_CONGESTION_WINDOW, std::min(_congestionWindowSize, udt::MAX_PACKETS_IN_FLIGHT));
+}
+
+bool BBRCC::needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK) {
+    // we may need to re-send ackNum + 1 if it has been more than our estimated timeout since it was sent
+    if (!_sentPacketDatas.empty() && _sentPacketDatas.front().sequenceNumber == ack + 1) {
+        auto sinceSend = duration_cast<microseconds>(p_high_resolution_clock::now()
+                                                     - _sentPacketDatas.front().timePoint).count();
+
+        if (sinceSend >= estimatedTimeout()) {
+            _numACKSinceFastRetransmit = 0;
+            return true;
+        }
+    }
+
+    // if this is the 3rd duplicate ACK, we fallback to Reno's fast re-transmit
+    static const int RENO_FAST_RETRANSMIT_DUPLICATE_COUNT = 3;
+
+    ++_duplicateACKCount;
+
+    if (wasDuplicateACK && _duplicateACKCount == RENO_FAST_RETRANSMIT_DUPLICATE_COUNT) {
+        _numACKSinceFastRetransmit = 0;
+        _duplicateACKCount = 0;
+        return true;
+    }
+
+    return false;
+}
+
+int BBRCC::estimatedTimeout() const {
+    // before the first RTT sample, wait as long as TCP does (RFC 6298) rather than re-send the first window
+    // every sync interval on a long path
+    static const int INITIAL_TIMEOUT = 1000000;
+    return _ewmaRTT == -1 ? INITIAL_TIMEOUT : _ewmaRTT + _rttVariance * 4;
+}
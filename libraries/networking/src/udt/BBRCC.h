@@ -0,0 +1,137 @@
+//
+//  BBRCC.h
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_BBRCC_h
+#define overte_BBRCC_h
+
+#include <array>
+#include <cstdint>
+#include <deque>
+
+#include "CongestionControl.h"
+#include "Constants.h"
+
+/// @addtogroup Networking
+/// @{
+
+namespace udt {
+
+/// @brief A model-based congestion control in the style of BBR.
+/// @details Rather than backing off on loss (Reno) or on RTT growth (Vegas), it keeps a model of the path - the
+/// bottleneck bandwidth, as the windowed maximum of measured delivery rates, and the round-trip propagation time, as
+/// the windowed minimum RTT - and paces packets at that bandwidth, with a congestion window of a small multiple of
+/// the bandwidth-delay product. Random loss on lossy links doesn't shrink the model, so transfers keep their rate.
+/// <p>The connection goes through the BBR modes: <code>Startup</code> doubles the sending rate every round trip until
+/// the bandwidth stops growing, <code>Drain</code> empties the queue that built up, <code>ProbeBandwidth</code> cycles
+/// the pacing rate around the bandwidth estimate to find more of it, and <code>ProbeRTT</code> briefly cuts the window
+/// to re-measure the minimum RTT if it hasn't been seen for a while.</p>
+class BBRCC : public CongestionControl {
+public:
+    enum class Mode { Startup, Drain, ProbeBandwidth, ProbeRTT };
+
+    BBRCC();
+
+    virtual bool onACK(SequenceNumber ackNum, p_high_resolution_clock::time_point receiveTime) override;
+    virtual void onTimeout() override;
+
+    virtual void onPacketSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+    virtual void onPacketReSent(int wireSize, SequenceNumber seqNum, p_high_resolution_clock::time_point timePoint) override;
+
+    virtual int estimatedTimeout() const override;
+
+    /// @brief Gets the current mode.
+    Mode getMode() const { return _mode; }
+
+    /// @brief Gets the bottleneck bandwidth estimate.
+    /// @return The estimate in packets per second, or <code>0</code> before the first delivery rate sample.
+    double getBottleneckBandwidth() const;
+
+    /// @brief Gets the minimum RTT seen in the current window.
+    /// @return The minimum RTT in microseconds, or <code>-1</code> before the first RTT sample.
+    int getMinRTT() const { return _minRTT; }
+
+protected:
+    virtual void setInitialSendSequenceNumber(SequenceNumber seqNum) override { _lastACK = seqNum - 1; }
+
+private:
+    struct SentPacketData {
+        SequenceNumber sequenceNumber;
+        p_high_resolution_clock::time_point timePoint;
+        int64_t delivered; // packets delivered when this one was sent
+        p_high_resolution_clock::time_point deliveredTime; // when the last of those was delivered
+        p_high_resolution_clock::time_point firstSentTime; // when the last of those was sent
+        bool isAppLimited;
+        bool wasResent;
+    };
+
+    void updateRTT(int rtt, p_high_resolution_clock::time_point now, bool hasMinRTTExpired);
+    void updateBandwidth(const SentPacketData& packet, p_high_resolution_clock::time_point now);
+    void updateMode(p_high_resolution_clock::time_point now, bool hasMinRTTExpired);
+    void updateControlParameters(int numDelivered);
+    bool needsFastRetransmit(SequenceNumber ack, bool wasDuplicateACK);
+    void onLoss();
+
+    void enterProbeBandwidth(p_high_resolution_clock::time_point now);
+    void advanceCyclePhase(p_high_resolution_clock::time_point now);
+    int getBandwidthDelayProduct(double gain) const; // in packets
+    int getPacketsInFlight() const;
+
+    static const int BANDWIDTH_FILTER_ROUNDS = 10;
+    static const int PROBE_BANDWIDTH_PHASES = 8;
+
+    Mode _mode { Mode::Startup };
+    double _pacingGain;
+    double _congestionWindowGain;
+
+    std::deque<SentPacketData> _sentPacketDatas; // sent packets waiting for ACK, in sequence number order
+
+    SequenceNumber _lastACK; // Sequence number of last packet that was ACKed
+    p_high_resolution_clock::time_point _lastSendTime;
+
+    int64_t _delivered { 0 }; // total packets delivered
+    p_high_resolution_clock::time_point _deliveredTime; // when _delivered was last increased
+    p_high_resolution_clock::time_point _firstSentTime; // when the most recently delivered packet was sent
+
+    // round trips are counted by delivery - a round ends when a packet sent after the start of it is ACKed
+    int64_t _roundCount { 0 };
+    int64_t _nextRoundDelivered { 0 };
+    bool _isRoundStart { false };
+
+    // windowed max of the delivery rate samples, one slot per round trip
+    std::array<double, BANDWIDTH_FILTER_ROUNDS> _bandwidthSamples {};
+    std::array<int64_t, BANDWIDTH_FILTER_ROUNDS> _bandwidthSampleRounds {};
+
+    // startup exit: the bandwidth estimate didn't grow by 25% for three round trips
+    double _fullBandwidth { 0.0 };
+    int _fullBandwidthCount { 0 };
+    bool _isFullPipe { false };
+
+    int _minRTT { -1 }; // in microseconds
+    p_high_resolution_clock::time_point _minRTTTimestamp;
+    int _ewmaRTT { -1 }; // Exponential weighted moving average RTT, for the timeout
+    int _rttVariance { 0 }; // Variance in collected RTT values
+
+    int _cycleIndex { 0 };
+    p_high_resolution_clock::time_point _cycleTimestamp;
+
+    p_high_resolution_clock::time_point _probeRTTDoneTime;
+    bool _isProbeRTTRoundDone { false };
+    int _priorCongestionWindowSize { 0 };
+
+    int _numACKSinceFastRetransmit { 3 }; // Number of ACKs received since fast re-transmit, default avoids immediate re-transmit
+    int _duplicateACKCount { 0 }; // Counter for duplicate ACKs received
+};
+
+}
+
+/// @}
+
+#endif // overte_BBRCC_h
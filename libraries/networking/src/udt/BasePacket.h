@@ -21,6 +21,7 @@
 
 #include "../SockAddr.h"
 #include "Constants.h"
+#include "PacketBufferPool.h"
 #include "../ExtendedIODevice.h"
 
 namespace udt {
@@ -31,7 +32,7 @@ public:
     static const qint64 PACKET_WRITE_ERROR;
     
     static std::unique_ptr<BasePacket> create(qint64 size = -1);
-    static std::unique_ptr<BasePacket> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size,
+    static std::unique_ptr<BasePacket> fromReceivedPacket(PacketBuffer data, qint64 size,
                                                           const SockAddr& senderSockAddr);
     
     // Current level's header size
@@ -88,7 +89,7 @@ public:
     
 protected:
     BasePacket(qint64 size);
-    BasePacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    BasePacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     BasePacket(const BasePacket& other) : ExtendedIODevice() { *this = other; }
     BasePacket& operator=(const BasePacket& other);
     BasePacket(BasePacket&& other);
@@ -101,7 +102,7 @@ protected:
     void adjustPayloadStartAndCapacity(qint64 headerSize, bool shouldDecreasePayloadSize = false);
     
     qint64 _packetSize = 0;        // Total size of the allocated memory
-    std::unique_ptr<char[]> _packet; // Allocated memory
+    PacketBuffer _packet; // Allocated memory, drawn from the PacketBufferPool
     
     char* _payloadStart = nullptr; // Start of the payload
     qint64 _payloadCapacity = 0;          // Total capacity of the payload
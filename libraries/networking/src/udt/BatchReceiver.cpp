@@ -0,0 +1,126 @@
+//
+//  BatchReceiver.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchReceiver.h"
+
+#if defined(UDT_BATCHED_RECEIVE)
+#include <errno.h>
+#include <netinet/in.h>
+#endif
+
+#include "../NetworkLogging.h"
+
+using namespace udt;
+
+BatchReceiver::BatchReceiver() {
+#if defined(UDT_BATCHED_RECEIVE)
+    _isSupported = true;
+    refillBuffers();
+#endif
+}
+
+void BatchReceiver::refillBuffers() {
+#if defined(UDT_BATCHED_RECEIVE)
+    for (int i = 0; i < MAX_BATCH_SIZE; ++i) {
+        if (!_buffers[i]) {
+            _buffers[i] = PacketBufferPool::acquire(BUFFER_SIZE);
+        }
+
+        _iovecs[i].iov_base = _buffers[i].get();
+        _iovecs[i].iov_len = BUFFER_SIZE;
+
+        auto& header = _headers[i].msg_hdr;
+        header.msg_name = &_addresses[i];
+        header.msg_namelen = sizeof(sockaddr_storage);
+        header.msg_iov = &_iovecs[i];
+        header.msg_iovlen = 1;
+        header.msg_control = nullptr;
+        header.msg_controllen = 0;
+        header.msg_flags = 0;
+        _headers[i].msg_len = 0;
+    }
+#endif
+}
+
+int BatchReceiver::receive(qintptr socketDescriptor) {
+#if defined(UDT_BATCHED_RECEIVE)
+    // only the slots handed out by the previous batch need a new buffer, but the headers are reset for all of them
+    refillBuffers();
+
+    int numReceived = recvmmsg((int)socketDescriptor, _headers.data(), MAX_BATCH_SIZE, MSG_DONTWAIT, nullptr);
+    if (numReceived < 0) {
+        _lastBatchSize = 0;
+        if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR) {
+            return 0;
+        }
+
+        if (errno == ENOSYS) {
+            qCWarning(networking) << "recvmmsg is not available - falling back to unbatched receive";
+            _isSupported = false;
+        }
+        return -1;
+    }
+
+    _lastBatchSize = numReceived;
+    if (numReceived > 0) {
+        ++_numBatches;
+        _numDatagrams += numReceived;
+    }
+    return numReceived;
+#else
+    Q_UNUSED(socketDescriptor);
+    return -1;
+#endif
+}
+
+qint64 BatchReceiver::getSize(int index) const {
+    Q_ASSERT(index >= 0 && index < _lastBatchSize);
+#if defined(UDT_BATCHED_RECEIVE)
+    if (_headers[index].msg_hdr.msg_flags & MSG_TRUNC) {
+        return -1;
+    }
+    return _headers[index].msg_len;
+#else
+    return -1;
+#endif
+}
+
+SockAddr BatchReceiver::getSenderSockAddr(int index) const {
+    Q_ASSERT(index >= 0 && index < _lastBatchSize);
+#if defined(UDT_BATCHED_RECEIVE)
+    const auto& address = _addresses[index];
+    quint16 port = 0;
+    if (address.ss_family == AF_INET) {
+        port = ntohs(reinterpret_cast<const sockaddr_in*>(&address)->sin_port);
+    } else if (address.ss_family == AF_INET6) {
+        port = ntohs(reinterpret_cast<const sockaddr_in6*>(&address)->sin6_port);
+    }
+
+    QHostAddress hostAddress(reinterpret_cast<const sockaddr*>(&address));
+    if (hostAddress.protocol() == QAbstractSocket::IPv6Protocol) {
+        // match QUdpSocket, which reports IPv4-mapped senders as plain IPv4 addresses
+        bool isIPv4 = false;
+        quint32 ipv4Address = hostAddress.toIPv4Address(&isIPv4);
+        if (isIPv4) {
+            hostAddress.setAddress(ipv4Address);
+        }
+    }
+
+    return SockAddr(SocketType::UDP, hostAddress, port);
+#else
+    return SockAddr();
+#endif
+}
+
+PacketBuffer BatchReceiver::takeBuffer(int index) {
+    Q_ASSERT(index >= 0 && index < _lastBatchSize);
+    return std::move(_buffers[index]);
+}
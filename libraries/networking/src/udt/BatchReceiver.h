@@ -0,0 +1,106 @@
+//
+//  BatchReceiver.h
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_BatchReceiver_h
+#define overte_BatchReceiver_h
+
+#include <array>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+#include "../SockAddr.h"
+#include "Constants.h"
+#include "PacketBufferPool.h"
+
+#if defined(Q_OS_LINUX)
+#include <sys/socket.h>
+#define UDT_BATCHED_RECEIVE
+#endif
+
+/// @addtogroup Networking
+/// @{
+
+namespace udt {
+
+/// @brief Drains a UDP socket descriptor in batches of datagrams with a single <code>recvmmsg</code> call.
+/// @details Datagrams are read into a ring of preallocated buffers. Ownership of a buffer is handed to the caller with
+/// <code>takeBuffer</code> so that it can be wrapped by a <code>udt::Packet</code> without copying, and the ring slot is
+/// refilled from the <code>PacketBufferPool</code> before the next batch is read.
+/// <p>On platforms without <code>recvmmsg</code>, <code>isSupported()</code> is <code>false</code> and callers should
+/// fall back to reading through <code>NetworkSocket</code>.</p>
+class BatchReceiver {
+public:
+
+    /// @brief The maximum number of datagrams pulled by a single call to <code>receive</code>.
+    static const int MAX_BATCH_SIZE = 64;
+
+    /// @brief The size of each receive buffer, the largest packet we send. Datagrams larger than this are truncated by
+    /// the kernel and dropped.
+    static const int BUFFER_SIZE = MAX_PACKET_SIZE;
+
+    /// @brief Constructs a new BatchReceiver with all ring buffers allocated.
+    BatchReceiver();
+
+    /// @brief Gets whether batched receive is available on this platform.
+    /// @return <code>true</code> if batched receive is compiled in and has not been disabled after a failed read.
+    bool isSupported() const { return _isSupported; }
+
+    /// @brief Reads as many pending datagrams as are available, up to <code>MAX_BATCH_SIZE</code>, without blocking.
+    /// @param socketDescriptor The native descriptor of a bound UDP socket.
+    /// @return The number of datagrams read, <code>0</code> if none were pending, or <code>-1</code> on error.
+    int receive(qintptr socketDescriptor);
+
+    /// @brief Gets the size of a datagram read by the most recent <code>receive</code> call.
+    /// @param index The index of the datagram in the batch.
+    /// @return The size of the datagram in bytes, or <code>-1</code> if it was truncated.
+    qint64 getSize(int index) const;
+
+    /// @brief Gets the sender address of a datagram read by the most recent <code>receive</code> call.
+    /// @param index The index of the datagram in the batch.
+    /// @return The sender's address.
+    SockAddr getSenderSockAddr(int index) const;
+
+    /// @brief Takes ownership of the buffer holding a datagram read by the most recent <code>receive</code> call.
+    /// @details The ring slot is refilled with a fresh buffer before the next batch.
+    /// @param index The index of the datagram in the batch.
+    /// @return The buffer, at least <code>getSize(index)</code> bytes long.
+    PacketBuffer takeBuffer(int index);
+
+    /// @brief Gets the total number of <code>receive</code> calls that returned datagrams.
+    quint64 getNumBatches() const { return _numBatches; }
+
+    /// @brief Gets the total number of datagrams read.
+    quint64 getNumDatagrams() const { return _numDatagrams; }
+
+private:
+    void refillBuffers();
+
+    bool _isSupported { false };
+    int _lastBatchSize { 0 };
+
+    quint64 _numBatches { 0 };
+    quint64 _numDatagrams { 0 };
+
+    std::array<PacketBuffer, MAX_BATCH_SIZE> _buffers;
+
+#if defined(UDT_BATCHED_RECEIVE)
+    std::array<sockaddr_storage, MAX_BATCH_SIZE> _addresses;
+    std::array<iovec, MAX_BATCH_SIZE> _iovecs;
+    std::array<mmsghdr, MAX_BATCH_SIZE> _headers;
+#endif
+};
+
+} // namespace udt
+
+/// @}
+
+#endif // overte_BatchReceiver_h
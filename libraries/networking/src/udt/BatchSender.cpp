@@ -0,0 +1,227 @@
+//
+//  BatchSender.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchSender.h"
+
+#include <atomic>
+#include <cstring>
+
+#if defined(UDT_BATCHED_SEND)
+#include <errno.h>
+#include <netinet/udp.h>
+#endif
+
+#include <LogHandler.h>
+
+#include "../NetworkLogging.h"
+
+#if defined(UDT_BATCHED_SEND) && !defined(UDP_SEGMENT)
+#define UDP_SEGMENT 103
+#endif
+
+using namespace udt;
+
+#if defined(UDT_BATCHED_SEND)
+// a GSO message must fit in a single IP datagram
+static const qint64 MAX_SEGMENTATION_OFFLOAD_BYTES = 65000;
+
+// set once if the kernel refuses UDP_SEGMENT, so that we don't keep trying
+static std::atomic<bool> segmentationOffloadUnavailable { false };
+#endif
+
+BatchSender::BatchSender() {
+#if defined(UDT_BATCHED_SEND)
+    _isSupported = true;
+    _buffer.reset(new char[MAX_BATCH_SIZE * BUFFER_SIZE]);
+#endif
+}
+
+bool BatchSender::canQueue(qint64 size, const SockAddr& sockAddr) {
+    if (size <= 0 || size > BUFFER_SIZE || sockAddr.getType() != SocketType::UDP) {
+        return false;
+    }
+
+    // the batch only holds sockaddr_in destinations, IPv4-mapped IPv6 addresses included
+    bool isIPv4 = false;
+    sockAddr.getAddress().toIPv4Address(&isIPv4);
+    return isIPv4;
+}
+
+bool BatchSender::queue(const char* data, qint64 size, const SockAddr& sockAddr) {
+#if defined(UDT_BATCHED_SEND)
+    if (isFull() || !canQueue(size, sockAddr)) {
+        return false;
+    }
+
+    quint32 ipv4Address = sockAddr.getAddress().toIPv4Address();
+
+    auto& address = _addresses[_numQueued];
+    memset(&address, 0, sizeof(address));
+    address.sin_family = AF_INET;
+    address.sin_addr.s_addr = htonl(ipv4Address);
+    address.sin_port = htons(sockAddr.getPort());
+
+    memcpy(_buffer.get() + _numQueued * BUFFER_SIZE, data, size);
+    _sizes[_numQueued] = size;
+    ++_numQueued;
+
+    return true;
+#else
+    Q_UNUSED(data);
+    Q_UNUSED(size);
+    Q_UNUSED(sockAddr);
+    return false;
+#endif
+}
+
+int BatchSender::flush(qintptr socketDescriptor, const UnsentDatagramWriter& writeUnsent) {
+#if defined(UDT_BATCHED_SEND)
+    int numSent = 0;
+
+    while (numSent < _numQueued) {
+        bool useSegmentationOffload = _isSegmentationOffloadEnabled && !segmentationOffloadUnavailable;
+        int numMessages = prepareMessages(numSent, useSegmentationOffload);
+
+        int result = sendMessages((int)socketDescriptor, numMessages);
+        if (result >= 0) {
+            numSent += result;
+            break;
+        } else if (useSegmentationOffload && (errno == EIO || errno == EINVAL || errno == ENOPROTOOPT)) {
+            // the kernel or the NIC doesn't support UDP GSO, fall back to one message per datagram
+            qCWarning(networking) << "UDP segmentation offload is not available - sending datagrams individually";
+            segmentationOffloadUnavailable = true;
+        } else {
+            break;
+        }
+    }
+
+    int numUnsent = _numQueued - numSent;
+    if (numUnsent > 0) {
+        // sendmmsg stops at the first datagram it can't send - a full send buffer or an unreachable destination -
+        // so the rest get a write of their own
+        int error = errno;
+        HIFI_FCDEBUG(networking(), "sendmmsg refused" << numUnsent << "of" << _numQueued << "datagrams -"
+                     << strerror(error) << (writeUnsent ? "- writing them individually" : "- dropping them"));
+
+        if (writeUnsent) {
+            for (int i = numSent; i < _numQueued; ++i) {
+                const auto& address = _addresses[i];
+                QHostAddress hostAddress(ntohl(address.sin_addr.s_addr));
+                writeUnsent(_buffer.get() + i * BUFFER_SIZE, _sizes[i],
+                            SockAddr(SocketType::UDP, hostAddress, ntohs(address.sin_port)));
+            }
+        }
+    }
+
+    _numDatagramsSent += numSent;
+    _numDatagramsUnsent += numUnsent;
+    _numQueued = 0;
+    return numSent;
+#else
+    Q_UNUSED(socketDescriptor);
+    Q_UNUSED(writeUnsent);
+    _numQueued = 0;
+    return 0;
+#endif
+}
+
+#if defined(UDT_BATCHED_SEND)
+int BatchSender::prepareMessages(int firstDatagram, bool useSegmentationOffload) {
+    int numMessages = 0;
+    int i = firstDatagram;
+
+    while (i < _numQueued) {
+        int start = i;
+        qint64 segmentSize = _sizes[start];
+        qint64 totalSize = segmentSize;
+
+        _iovecs[i].iov_base = _buffer.get() + i * BUFFER_SIZE;
+        _iovecs[i].iov_len = _sizes[i];
+        ++i;
+
+        if (useSegmentationOffload) {
+            // extend the message while the next datagram has the same destination and fits the segment size - only the
+            // last segment of a GSO message may be shorter than the others
+            while (i < _numQueued
+                   && _addresses[i].sin_addr.s_addr == _addresses[start].sin_addr.s_addr
+                   && _addresses[i].sin_port == _addresses[start].sin_port
+                   && _sizes[i] <= segmentSize
+                   && totalSize + _sizes[i] <= MAX_SEGMENTATION_OFFLOAD_BYTES) {
+                _iovecs[i].iov_base = _buffer.get() + i * BUFFER_SIZE;
+                _iovecs[i].iov_len = _sizes[i];
+                totalSize += _sizes[i];
+                ++i;
+
+                if (_sizes[i - 1] < segmentSize) {
+                    break;
+                }
+            }
+        }
+
+        auto& header = _headers[numMessages].msg_hdr;
+        header.msg_name = &_addresses[start];
+        header.msg_namelen = sizeof(sockaddr_in);
+        header.msg_iov = &_iovecs[start];
+        header.msg_iovlen = i - start;
+        header.msg_flags = 0;
+
+        if (i - start > 1) {
+            auto& control = _controls[numMessages];
+            header.msg_control = control.data();
+            header.msg_controllen = control.size();
+
+            auto controlHeader = CMSG_FIRSTHDR(&header);
+            controlHeader->cmsg_level = SOL_UDP;
+            controlHeader->cmsg_type = UDP_SEGMENT;
+            controlHeader->cmsg_len = CMSG_LEN(sizeof(uint16_t));
+            uint16_t gsoSize = (uint16_t)segmentSize;
+            memcpy(CMSG_DATA(controlHeader), &gsoSize, sizeof(gsoSize));
+        } else {
+            header.msg_control = nullptr;
+            header.msg_controllen = 0;
+        }
+
+        _headers[numMessages].msg_len = 0;
+        _messageDatagramCounts[numMessages] = i - start;
+        ++numMessages;
+    }
+
+    return numMessages;
+}
+
+int BatchSender::sendMessages(int socketDescriptor, int numMessages) {
+    int numDatagramsSent = 0;
+    int messageOffset = 0;
+
+    while (messageOffset < numMessages) {
+        int result = sendmmsg(socketDescriptor, _headers.data() + messageOffset, numMessages - messageOffset, MSG_DONTWAIT);
+        ++_numSendCalls;
+
+        if (result < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return numDatagramsSent > 0 ? numDatagramsSent : -1;
+        }
+
+        if (result == 0) {
+            break;
+        }
+
+        for (int i = messageOffset; i < messageOffset + result; ++i) {
+            numDatagramsSent += _messageDatagramCounts[i];
+        }
+        messageOffset += result;
+    }
+
+    return numDatagramsSent;
+}
+#endif
@@ -0,0 +1,131 @@
+//
+//  BatchSender.h
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_BatchSender_h
+#define overte_BatchSender_h
+
+#include <array>
+#include <functional>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+#include "../SockAddr.h"
+
+#if defined(Q_OS_LINUX)
+#include <netinet/in.h>
+#include <sys/socket.h>
+#define UDT_BATCHED_SEND
+#endif
+
+/// @addtogroup Networking
+/// @{
+
+namespace udt {
+
+/// @brief Gathers outgoing UDP datagrams and writes them with as few <code>sendmmsg</code> calls as possible.
+/// @details Datagrams are copied into a fixed set of slots when queued, so callers may free their packets straight away.
+/// When segmentation offload is enabled, runs of equally sized datagrams to the same destination are handed to the
+/// kernel as a single UDP GSO message.
+/// <p>On platforms without <code>sendmmsg</code>, <code>isSupported()</code> is <code>false</code> and callers should
+/// write each datagram through <code>NetworkSocket</code>.</p>
+class BatchSender {
+public:
+
+    /// @brief The maximum number of datagrams held before the batch must be flushed.
+    static const int MAX_BATCH_SIZE = 64;
+
+    /// @brief The largest datagram that can be queued. Larger datagrams must be written directly.
+    static const int BUFFER_SIZE = 1500;
+
+    BatchSender();
+
+    /// @brief Gets whether batched send is available on this platform.
+    bool isSupported() const { return _isSupported; }
+
+    /// @brief Sets whether runs of equally sized datagrams to one destination are sent with UDP GSO.
+    /// @details Has no effect if the kernel rejects GSO; it is then turned off for the rest of the process.
+    void setSegmentationOffloadEnabled(bool enabled) { _isSegmentationOffloadEnabled = enabled; }
+
+    /// @brief Gets whether there is room for another datagram.
+    bool isFull() const { return _numQueued == MAX_BATCH_SIZE; }
+
+    /// @brief Gets whether any datagrams are waiting to be flushed.
+    bool isEmpty() const { return _numQueued == 0; }
+
+    /// @brief Gets whether a datagram can be batched at all.
+    /// @details Only UDP datagrams to IPv4 destinations of up to <code>BUFFER_SIZE</code> bytes can be. Other address
+    /// families and larger datagrams must be written directly, after flushing the batch to keep them in order.
+    static bool canQueue(qint64 size, const SockAddr& sockAddr);
+
+    /// @brief Copies a datagram into the batch.
+    /// @param data The datagram.
+    /// @param size The size of the datagram. Must be no larger than <code>BUFFER_SIZE</code>.
+    /// @param sockAddr The UDP destination.
+    /// @return <code>true</code> if the datagram was queued, <code>false</code> if the batch is full or
+    /// <code>canQueue</code> is <code>false</code>.
+    bool queue(const char* data, qint64 size, const SockAddr& sockAddr);
+
+    /// @brief Drops all queued datagrams without writing them.
+    void clear() { _numQueued = 0; }
+
+    /// @brief Writes a datagram that <code>sendmmsg</code> refused.
+    using UnsentDatagramWriter = std::function<qint64(const char* data, qint64 size, const SockAddr& sockAddr)>;
+
+    /// @brief Writes all queued datagrams to a socket and empties the batch.
+    /// @param socketDescriptor The native descriptor of a bound UDP socket.
+    /// @param writeUnsent Called for each datagram that <code>sendmmsg</code> refused, for example because the send
+    /// buffer filled up part way through the batch or one destination was unreachable. Without it those datagrams are
+    /// dropped.
+    /// @return The number of datagrams that were written by <code>sendmmsg</code>.
+    int flush(qintptr socketDescriptor, const UnsentDatagramWriter& writeUnsent = UnsentDatagramWriter());
+
+    /// @brief Gets the number of send system calls made by <code>flush</code> over the lifetime of this object.
+    quint64 getNumSendCalls() const { return _numSendCalls; }
+
+    /// @brief Gets the number of datagrams written by <code>flush</code> over the lifetime of this object.
+    quint64 getNumDatagramsSent() const { return _numDatagramsSent; }
+
+    /// @brief Gets the number of datagrams <code>sendmmsg</code> refused over the lifetime of this object.
+    quint64 getNumDatagramsUnsent() const { return _numDatagramsUnsent; }
+
+private:
+#if defined(UDT_BATCHED_SEND)
+    int prepareMessages(int firstDatagram, bool useSegmentationOffload);
+    int sendMessages(int socketDescriptor, int numMessages);
+#endif
+
+    bool _isSupported { false };
+    bool _isSegmentationOffloadEnabled { false };
+
+    int _numQueued { 0 };
+
+    quint64 _numSendCalls { 0 };
+    quint64 _numDatagramsSent { 0 };
+    quint64 _numDatagramsUnsent { 0 };
+
+    std::unique_ptr<char[]> _buffer;
+    std::array<qint64, MAX_BATCH_SIZE> _sizes;
+
+#if defined(UDT_BATCHED_SEND)
+    std::array<sockaddr_in, MAX_BATCH_SIZE> _addresses;
+    std::array<iovec, MAX_BATCH_SIZE> _iovecs;
+    std::array<mmsghdr, MAX_BATCH_SIZE> _headers;
+    std::array<int, MAX_BATCH_SIZE> _messageDatagramCounts;
+    std::array<std::array<char, CMSG_SPACE(sizeof(uint16_t))>, MAX_BATCH_SIZE> _controls;
+#endif
+};
+
+} // namespace udt
+
+/// @}
+
+#endif // overte_BatchSender_h
@@ -21,6 +21,8 @@
 #include "LossList.h"
 #include "SequenceNumber.h"
 
+class LinkSimulation;
+
 namespace udt {
     
 static const int32_t DEFAULT_SYN_INTERVAL = 10000; // 10 ms
@@ -30,6 +32,7 @@ class Packet;
 
 class CongestionControl {
     friend class Connection;
+    friend class ::LinkSimulation; // tools/udt-test drives congestion control without a Connection
 public:
 
     CongestionControl() = default;
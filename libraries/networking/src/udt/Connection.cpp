@@ -14,7 +14,6 @@
 
 #include <random>
 
-#include <QtCore/QThread>
 
 #include <NumericalConstants.h>
 
@@ -68,21 +67,11 @@ Connection::~Connection() {
 }
 
 void Connection::stopSendQueue() {
-    if (auto sendQueue = _sendQueue.release()) {
-        // grab the send queue thread so we can wait on it
-        QThread* sendQueueThread = sendQueue->thread();
-        
-        // tell the send queue to stop and be deleted
-        
+    if (auto sendQueue = std::move(_sendQueue)) {
+        // tell the send queue to stop - once this returns the scheduler is done with it and it can be deleted
         sendQueue->stop();
 
         _lastMessageNumber = sendQueue->getCurrentMessageNumber();
-
-        sendQueue->deleteLater();
-        
-        // wait on the send queue thread so we know the send queue is gone
-        sendQueueThread->quit();
-        sendQueueThread->wait();
     }
 }
 
@@ -115,7 +104,9 @@ SendQueue& Connection::getSendQueue() {
         QObject::connect(_sendQueue.get(), &SendQueue::packetRetransmitted, this, &Connection::recordRetransmission);
         QObject::connect(_sendQueue.get(), &SendQueue::queueInactive, this, &Connection::queueInactive);
         QObject::connect(_sendQueue.get(), &SendQueue::timeout, this, &Connection::queueTimeout);
-        QObject::connect(this, &Connection::destinationAddressChange, _sendQueue.get(), &SendQueue::updateDestinationAddress);
+        // the send queue has no thread of its own to queue this to (and the connection can move between threads)
+        QObject::connect(this, &Connection::destinationAddressChange, _sendQueue.get(), &SendQueue::updateDestinationAddress,
+                         Qt::DirectConnection);
 
         
         // set defaults on the send queue from our congestion control object and estimatedTimeout()
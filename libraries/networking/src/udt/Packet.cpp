@@ -62,7 +62,7 @@ std::unique_ptr<Packet> Packet::create(qint64 size, bool isReliable, bool isPart
     return packet;
 }
 
-std::unique_ptr<Packet> Packet::fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) {
+std::unique_ptr<Packet> Packet::fromReceivedPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) {
     // Fail with invalid size
     Q_ASSERT(size >= 0);
 
@@ -88,7 +88,7 @@ Packet::Packet(qint64 size, bool isReliable, bool isPartOfMessage) :
     writeHeader();
 }
 
-Packet::Packet(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr) :
+Packet::Packet(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr) :
     BasePacket(std::move(data), size, senderSockAddr)
 {
     readHeader();
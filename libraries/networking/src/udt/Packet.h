@@ -70,7 +70,7 @@ public:
     };
 
     static std::unique_ptr<Packet> create(qint64 size = -1, bool isReliable = false, bool isPartOfMessage = false);
-    static std::unique_ptr<Packet> fromReceivedPacket(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    static std::unique_ptr<Packet> fromReceivedPacket(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     // Provided for convenience, try to limit use
     static std::unique_ptr<Packet> createCopy(const Packet& other);
@@ -96,9 +96,13 @@ public:
     void writeSequenceNumber(SequenceNumber sequenceNumber) const;
     void obfuscate(ObfuscationLevel level);
 
+    // set by the socket's packet filter when it leaves the rest of its checks to the socket's verification workers
+    void setVerificationDeferred(bool isVerificationDeferred) const { _isVerificationDeferred = isVerificationDeferred; }
+    bool isVerificationDeferred() const { return _isVerificationDeferred; }
+
 protected:
     Packet(qint64 size, bool isReliable = false, bool isPartOfMessage = false);
-    Packet(std::unique_ptr<char[]> data, qint64 size, const SockAddr& senderSockAddr);
+    Packet(PacketBuffer data, qint64 size, const SockAddr& senderSockAddr);
     
     Packet(const Packet& other);
     Packet(Packet&& other);
@@ -121,6 +125,7 @@ private:
     mutable MessageNumber _messageNumber { 0 };
     mutable PacketPosition _packetPosition { PacketPosition::ONLY };
     mutable MessagePartNumber _messagePartNumber { 0 };
+    mutable bool _isVerificationDeferred { false };
 };
 
 } // namespace udt
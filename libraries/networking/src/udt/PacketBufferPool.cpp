@@ -0,0 +1,257 @@
+//
+//  PacketBufferPool.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketBufferPool.h"
+
+#include <atomic>
+#include <cstring>
+#include <vector>
+
+#include "Constants.h"
+
+using namespace udt;
+
+const std::array<qint64, PacketBufferPool::NUM_SIZE_CLASSES> PacketBufferPool::SIZE_CLASSES {{
+    128, 256, 512, 1024, MAX_PACKET_SIZE
+}};
+
+// per-thread hit/miss counts are published to these every STATS_PUBLISH_INTERVAL acquisitions
+static const quint64 STATS_PUBLISH_INTERVAL = 1024;
+static std::atomic<quint64> publishedHits { 0 };
+static std::atomic<quint64> publishedMisses { 0 };
+
+namespace udt {
+
+// One thread's free lists. Buffers taken from it keep it alive, so a buffer released after its thread has exited still
+// has somewhere to check in.
+class PacketBufferCache {
+public:
+    PacketBufferCache();
+
+    void ref() { _refCount.fetch_add(1, std::memory_order_relaxed); }
+    void unref();
+
+    // called when the owning thread exits
+    void shutDown();
+
+    // on the owning thread
+    char* take(int sizeClass);
+    void give(char* buffer, int sizeClass);
+    void publishStats();
+
+    // on any other thread
+    void giveBack(char* buffer, int sizeClass);
+
+private:
+    void takeReturnedBuffers(int sizeClass);
+    void deleteReturnedBuffers();
+
+    std::array<std::vector<char*>, PacketBufferPool::NUM_SIZE_CLASSES> _freeLists;
+
+    // buffers released on other threads, linked through their first bytes. Other threads only push and the owning thread
+    // only takes the whole list, so there's no ABA problem.
+    std::array<std::atomic<char*>, PacketBufferPool::NUM_SIZE_CLASSES> _returnedBuffers;
+
+    std::atomic<bool> _isOwnerAlive { true };
+    std::atomic<int> _refCount { 1 }; // the owning thread and every buffer taken from it
+
+    quint64 _hits { 0 };
+    quint64 _misses { 0 };
+};
+
+}
+
+// the smallest size class leaves plenty of room for the link
+static char*& nextReturnedBuffer(char* buffer) {
+    return *reinterpret_cast<char**>(buffer);
+}
+
+PacketBufferCache::PacketBufferCache() {
+    for (auto& returnedBuffers : _returnedBuffers) {
+        returnedBuffers.store(nullptr, std::memory_order_relaxed);
+    }
+}
+
+void PacketBufferCache::unref() {
+    if (_refCount.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+        delete this;
+    }
+}
+
+void PacketBufferCache::shutDown() {
+    _isOwnerAlive = false;
+    for (auto& freeList : _freeLists) {
+        for (auto buffer : freeList) {
+            delete[] buffer;
+        }
+        freeList.clear();
+    }
+    deleteReturnedBuffers();
+    publishStats();
+    unref();
+}
+
+char* PacketBufferCache::take(int sizeClass) {
+    auto& freeList = _freeLists[sizeClass];
+    if (freeList.empty()) {
+        takeReturnedBuffers(sizeClass);
+    }
+
+    char* buffer = nullptr;
+    if (!freeList.empty()) {
+        buffer = freeList.back();
+        freeList.pop_back();
+        ++_hits;
+    } else {
+        buffer = new char[PacketBufferPool::SIZE_CLASSES[sizeClass]];
+        ++_misses;
+    }
+
+    if ((_hits + _misses) >= STATS_PUBLISH_INTERVAL) {
+        publishStats();
+    }
+
+    ref();
+    return buffer;
+}
+
+void PacketBufferCache::give(char* buffer, int sizeClass) {
+    auto& freeList = _freeLists[sizeClass];
+    if (freeList.size() < (size_t)PacketBufferPool::MAX_FREE_BUFFERS_PER_CLASS) {
+        freeList.push_back(buffer);
+    } else {
+        delete[] buffer;
+    }
+}
+
+void PacketBufferCache::giveBack(char* buffer, int sizeClass) {
+    if (!_isOwnerAlive) {
+        delete[] buffer;
+        return;
+    }
+
+    auto& returnedBuffers = _returnedBuffers[sizeClass];
+    char* head = returnedBuffers.load(std::memory_order_relaxed);
+    do {
+        nextReturnedBuffer(buffer) = head;
+    } while (!returnedBuffers.compare_exchange_weak(head, buffer));
+
+    // the owner may have exited while we were pushing, in which case nobody else will pick this up - the push and the
+    // check are sequentially consistent with the owner's shutdown, so one of us always sees the buffer
+    if (!_isOwnerAlive) {
+        deleteReturnedBuffers();
+    }
+}
+
+void PacketBufferCache::publishStats() {
+    publishedHits += _hits;
+    publishedMisses += _misses;
+    _hits = _misses = 0;
+}
+
+void PacketBufferCache::takeReturnedBuffers(int sizeClass) {
+    char* buffer = _returnedBuffers[sizeClass].exchange(nullptr, std::memory_order_acquire);
+    while (buffer) {
+        char* next = nextReturnedBuffer(buffer);
+        give(buffer, sizeClass);
+        buffer = next;
+    }
+}
+
+void PacketBufferCache::deleteReturnedBuffers() {
+    for (auto& returnedBuffers : _returnedBuffers) {
+        char* buffer = returnedBuffers.exchange(nullptr);
+        while (buffer) {
+            char* next = nextReturnedBuffer(buffer);
+            delete[] buffer;
+            buffer = next;
+        }
+    }
+}
+
+namespace {
+
+// set once this thread's cache has been shut down, so that buffers released during thread exit are handed back
+// without recreating it
+static thread_local bool threadCacheDestroyed { false };
+
+struct ThreadCacheHolder {
+    ~ThreadCacheHolder() {
+        cache->shutDown();
+        threadCacheDestroyed = true;
+    }
+
+    PacketBufferCache* cache { new PacketBufferCache() };
+};
+
+PacketBufferCache* getThreadCache() {
+    if (threadCacheDestroyed) {
+        return nullptr;
+    }
+    static thread_local ThreadCacheHolder threadCacheHolder;
+    return threadCacheHolder.cache;
+}
+
+int sizeClassForSize(qint64 size) {
+    for (size_t i = 0; i < PacketBufferPool::SIZE_CLASSES.size(); ++i) {
+        if (size <= PacketBufferPool::SIZE_CLASSES[i]) {
+            return (int)i;
+        }
+    }
+    return PacketBufferDeleter::UNPOOLED;
+}
+
+}
+
+void PacketBufferDeleter::operator()(char* buffer) const {
+    if (_sizeClass == UNPOOLED) {
+        delete[] buffer;
+    } else {
+        PacketBufferPool::release(buffer, _sizeClass, _cache);
+    }
+}
+
+PacketBuffer PacketBufferPool::acquire(qint64 size, bool zeroFill) {
+    int sizeClass = sizeClassForSize(size);
+    auto threadCache = getThreadCache();
+
+    char* buffer = nullptr;
+    if (sizeClass == PacketBufferDeleter::UNPOOLED || !threadCache) {
+        buffer = new char[size];
+        sizeClass = PacketBufferDeleter::UNPOOLED;
+        threadCache = nullptr;
+    } else {
+        buffer = threadCache->take(sizeClass);
+    }
+
+    if (zeroFill && size > 0) {
+        memset(buffer, 0, size);
+    }
+
+    return PacketBuffer(buffer, PacketBufferDeleter(sizeClass, threadCache));
+}
+
+void PacketBufferPool::release(char* buffer, int sizeClass, PacketBufferCache* cache) {
+    if (cache == getThreadCache()) {
+        cache->give(buffer, sizeClass);
+    } else {
+        // taken on another thread, that thread gets it back
+        cache->giveBack(buffer, sizeClass);
+    }
+    cache->unref();
+}
+
+PacketBufferPool::Stats PacketBufferPool::getStats() {
+    Stats stats;
+    stats.hits = publishedHits;
+    stats.misses = publishedMisses;
+    return stats;
+}
@@ -0,0 +1,93 @@
+//
+//  PacketBufferPool.h
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_PacketBufferPool_h
+#define overte_PacketBufferPool_h
+
+#include <array>
+#include <memory>
+
+#include <QtCore/QtGlobal>
+
+/// @addtogroup Networking
+/// @{
+
+namespace udt {
+
+class PacketBufferCache;
+
+/// @brief Returns a packet buffer to the <code>PacketBufferPool</code> it was taken from, or deletes it if it was not
+/// taken from the pool.
+/// @details Implicitly constructible from <code>std::default_delete&lt;char[]&gt;</code> so that a plain
+/// <code>std::unique_ptr&lt;char[]&gt;</code> converts to a <code>PacketBuffer</code>.
+class PacketBufferDeleter {
+public:
+    static const int UNPOOLED = -1;
+
+    PacketBufferDeleter() {}
+    PacketBufferDeleter(std::default_delete<char[]>) {}
+    PacketBufferDeleter(int sizeClass, PacketBufferCache* cache) : _sizeClass(sizeClass), _cache(cache) {}
+
+    void operator()(char* buffer) const;
+
+    int getSizeClass() const { return _sizeClass; }
+
+private:
+    int _sizeClass { UNPOOLED };
+    PacketBufferCache* _cache { nullptr }; // the free lists of the thread the buffer was taken on
+};
+
+/// @brief The storage behind every <code>udt::BasePacket</code>.
+using PacketBuffer = std::unique_ptr<char[], PacketBufferDeleter>;
+
+/// @brief A size-classed pool of packet buffers with one free list per thread, so that creating and destroying packets
+/// on a hot path doesn't touch the heap.
+/// @details Buffers go back to the pool of the thread that took them, so that a thread that receives packets gets back
+/// the buffers freed by the threads processing them. Buffers released on another thread are pushed onto a lock-free
+/// list that the owning thread picks up once its own free list runs out. Each free list is capped; buffers beyond the
+/// cap are deleted.
+class PacketBufferPool {
+public:
+    static const int NUM_SIZE_CLASSES = 5;
+
+    /// @brief Per-size-class buffer sizes. The largest is <code>udt::MAX_PACKET_SIZE</code>, covering any datagram the UDT
+    /// socket sends or receives.
+    static const std::array<qint64, NUM_SIZE_CLASSES> SIZE_CLASSES;
+
+    /// @brief The maximum number of free buffers each thread keeps per size class.
+    static const int MAX_FREE_BUFFERS_PER_CLASS = 256;
+
+    struct Stats {
+        quint64 hits { 0 };
+        quint64 misses { 0 };
+    };
+
+    /// @brief Takes a buffer of at least <code>size</code> bytes from the calling thread's pool.
+    /// @param size The number of bytes needed.
+    /// @param zeroFill Whether the first <code>size</code> bytes should be zeroed.
+    /// @return The buffer. Buffers larger than the largest size class are allocated directly and are not pooled.
+    static PacketBuffer acquire(qint64 size, bool zeroFill = false);
+
+    /// @brief Gets the number of acquisitions served from, and not served from, a free list over the lifetime of the
+    /// process.
+    /// @details Counts are accumulated per thread and published periodically, so they may lag slightly.
+    static Stats getStats();
+
+private:
+    friend class PacketBufferDeleter;
+    static void release(char* buffer, int sizeClass, PacketBufferCache* cache);
+};
+
+} // namespace udt
+
+/// @}
+
+#endif // overte_PacketBufferPool_h
@@ -27,7 +27,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::DomainConnectRequestPending: // keeping the old version to maintain the protocol hash
             return 17;
         case PacketType::DomainList:
-            return static_cast<PacketVersion>(DomainListVersion::SocketTypes);
+            return static_cast<PacketVersion>(DomainListVersion::HasAuthenticationMethod);
         case PacketType::EntityAdd:
         case PacketType::EntityClone:
         case PacketType::EntityEdit:
@@ -43,7 +43,7 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::KillAvatar:
             return static_cast<PacketVersion>(AvatarMixerPacketVersion::ARKitBlendshapes);
         case PacketType::MessagesData:
-            return static_cast<PacketVersion>(MessageDataVersion::TextOrBinaryData);
+            return static_cast<PacketVersion>(MessageDataVersion::BatchedMessages);
         // ICE packets
         case PacketType::ICEServerPeerInformation:
             return 17;
@@ -64,7 +64,9 @@ PacketVersion versionForPacketType(PacketType packetType) {
         case PacketType::AssetGetInfo:
         case PacketType::AssetGet:
         case PacketType::AssetUpload:
-            return static_cast<PacketVersion>(AssetServerPacketVersion::BakingTextureMeta);
+        case PacketType::AssetChunkQuery:
+        case PacketType::AssetDeltaUpload:
+            return static_cast<PacketVersion>(AssetServerPacketVersion::DeltaUpload);
         case PacketType::NodeIgnoreRequest:
             return 18; // Introduction of node ignore request (which replaced an unused packet tpye)
 
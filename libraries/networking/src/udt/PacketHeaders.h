@@ -140,6 +140,9 @@ public:
         StopInjector,
         AvatarZonePresence,
         WebRTCSignaling,
+        AssetChunkQuery,
+        AssetChunkQueryReply,
+        AssetDeltaUpload,
         NUM_PACKET_TYPE
     };
 
@@ -199,7 +202,9 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_SOURCED_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperation
             << PacketTypeEnum::Value::AssetGet
-            << PacketTypeEnum::Value::AssetUpload;
+            << PacketTypeEnum::Value::AssetUpload
+            << PacketTypeEnum::Value::AssetChunkQuery
+            << PacketTypeEnum::Value::AssetDeltaUpload;
         return DOMAIN_SOURCED_PACKETS;
     }
 
@@ -207,7 +212,8 @@ public:
         const static QSet<PacketTypeEnum::Value> DOMAIN_IGNORED_VERIFICATION_PACKETS = QSet<PacketTypeEnum::Value>()
             << PacketTypeEnum::Value::AssetMappingOperationReply
             << PacketTypeEnum::Value::AssetGetReply
-            << PacketTypeEnum::Value::AssetUploadReply;
+            << PacketTypeEnum::Value::AssetUploadReply
+            << PacketTypeEnum::Value::AssetChunkQueryReply;
         return DOMAIN_IGNORED_VERIFICATION_PACKETS;
     }
 };
@@ -314,7 +320,8 @@ enum class AssetServerPacketVersion: PacketVersion {
     VegasCongestionControl = 19,
     RangeRequestSupport,
     RedirectedMappings,
-    BakingTextureMeta
+    BakingTextureMeta,
+    DeltaUpload
 };
 
 enum class AvatarMixerPacketVersion : PacketVersion {
@@ -397,7 +404,8 @@ enum class DomainListVersion : PacketVersion {
     AuthenticationOptional,
     HasTimestamp,
     HasConnectReason,
-    SocketTypes
+    SocketTypes,
+    HasAuthenticationMethod
 };
 
 enum class AudioVersion : PacketVersion {
@@ -412,7 +420,8 @@ enum class AudioVersion : PacketVersion {
 };
 
 enum class MessageDataVersion : PacketVersion {
-    TextOrBinaryData = 18
+    TextOrBinaryData = 18,
+    BatchedMessages
 };
 
 enum class IcePingVersion : PacketVersion {
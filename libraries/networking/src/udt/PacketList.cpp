@@ -14,6 +14,7 @@
 
 #include "../NetworkLogging.h"
 
+#include <algorithm>
 #include <chrono>
 #include <QDebug>
 
@@ -142,7 +143,72 @@ QByteArray PacketList::getMessage() const {
     return data;
 }
 
+void PacketList::setStreamSource(qint64 streamSize, StreamSource source) {
+    Q_ASSERT_X(_isReliable && _isOrdered, "PacketList::setStreamSource", "Streamed PacketLists must be reliable and ordered");
+    _streamSource = std::move(source);
+    _streamSizeRemaining = std::max(streamSize, (qint64)0);
+}
+
+void PacketList::fillStreamedPacket() {
+    if (!_currentPacket) {
+        _currentPacket = createPacketWithExtendedHeader();
+    }
+
+    auto size = std::min(_streamSizeRemaining, _currentPacket->bytesAvailableForWrite());
+    if (size > 0) {
+        // read straight into the packet
+        auto pos = _currentPacket->pos();
+        auto bytesRead = _streamSource(_currentPacket->getPayload() + pos, size);
+
+        if (bytesRead < size) {
+            // the rest of the message can't be read, end it here and let the receiver find it short
+            qCWarning(networking) << "PacketList::fillStreamedPacket could only read" << std::max(bytesRead, (qint64)0)
+                << "of" << size << "bytes, ending the message" << _streamSizeRemaining - size << "bytes early";
+            bytesRead = std::max(bytesRead, (qint64)0);
+            _streamSizeRemaining = 0;
+        } else {
+            _streamSizeRemaining -= bytesRead;
+        }
+
+        _currentPacket->setPayloadSize(pos + bytesRead);
+        _currentPacket->seek(pos + bytesRead);
+    }
+
+    if (_streamedPacketWriter) {
+        _streamedPacketWriter(*_currentPacket);
+    }
+    _packets.push_back(std::move(_currentPacket));
+}
+
+std::unique_ptr<Packet> PacketList::takeStreamedPacket() {
+    // an empty streamed list still sends one empty packet
+    if (_packets.empty()) {
+        fillStreamedPacket();
+    }
+
+    auto packet = std::move(_packets.front());
+    _packets.pop_front();
+
+    // parts are numbered as they are taken, the message ends with the packet that exhausts the stream
+    bool isLast = !hasStreamedPackets();
+    Packet::PacketPosition position;
+    if (_streamPartNumber == 0) {
+        position = isLast ? Packet::PacketPosition::ONLY : Packet::PacketPosition::FIRST;
+    } else {
+        position = isLast ? Packet::PacketPosition::LAST : Packet::PacketPosition::MIDDLE;
+    }
+    packet->writeMessageNumber(_messageNumber, position, _streamPartNumber++);
+
+    return packet;
+}
+
 void PacketList::preparePackets(MessageNumber messageNumber) {
+    if (isStreamed()) {
+        // streamed packets are numbered as they are taken
+        _messageNumber = messageNumber;
+        return;
+    }
+
     Q_ASSERT(_packets.size() > 0);
     
     if (_packets.size() == 1) {
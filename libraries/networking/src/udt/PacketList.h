@@ -13,6 +13,7 @@
 #ifndef hifi_PacketList_h
 #define hifi_PacketList_h
 
+#include <functional>
 #include <memory>
 
 #include "../ExtendedIODevice.h"
@@ -30,6 +31,9 @@ class PacketList : public ExtendedIODevice {
 public:
     using MessageNumber = uint32_t;
     using PacketPointer = std::unique_ptr<Packet>;
+
+    // Copies up to maxSize bytes of a streamed message to data, returns the number of bytes copied
+    using StreamSource = std::function<qint64(char* data, qint64 maxSize)>;
     
     static std::unique_ptr<PacketList> create(PacketType packetType, QByteArray extendedHeader = QByteArray(),
                                               bool isReliable = false, bool isOrdered = false);
@@ -55,6 +59,12 @@ public:
     
     void closeCurrentPacket(bool shouldSendEmpty = false);
 
+    // Appends streamSize bytes read from source to the message, after anything already written. The packets holding
+    // them are only filled as the send queue takes them, so a large message never has to be held in memory at once.
+    // Streamed lists must be reliable and ordered.
+    void setStreamSource(qint64 streamSize, StreamSource source);
+    bool isStreamed() const { return (bool)_streamSource; }
+
     // QIODevice virtual functions
     virtual bool isSequential() const override { return false; }
     virtual qint64 size() const override { return getDataSize(); }
@@ -89,6 +99,11 @@ private:
     
     // Takes the first packet of the list and returns it.
     template<typename T> std::unique_ptr<T> takeFront();
+
+    // Takes the next packet of a streamed list, numbered as part of the message
+    std::unique_ptr<Packet> takeStreamedPacket();
+    bool hasStreamedPackets() const { return !_packets.empty() || _currentPacket || _streamSizeRemaining > 0; }
+    void fillStreamedPacket();
     
     // Creates a new packet, can be overriden to change return underlying type
     virtual std::unique_ptr<Packet> createPacket();
@@ -102,6 +117,11 @@ private:
     int _segmentStartIndex = -1;
     
     QByteArray _extendedHeader;
+
+    StreamSource _streamSource;
+    qint64 _streamSizeRemaining { 0 };
+    Packet::MessagePartNumber _streamPartNumber { 0 };
+    std::function<void(Packet&)> _streamedPacketWriter; // fills in the headers of packets filled by the send queue
 };
 
 template<typename T> std::unique_ptr<T> PacketList::takeFront() {
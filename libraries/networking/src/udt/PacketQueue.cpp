@@ -16,7 +16,7 @@
 using namespace udt;
 
 PacketQueue::PacketQueue(MessageNumber messageNumber) : _currentMessageNumber(messageNumber) {
-    _channels.emplace_front(new std::list<PacketPointer>());
+    _channels.emplace_front(new RawChannel());
     _currentChannel = _channels.begin();
 }
 
@@ -34,7 +34,7 @@ bool PacketQueue::isEmpty() const {
 }
 
 PacketQueue::PacketPointer PacketQueue::takePacket() {
-    LockGuard locker(_packetsLock);
+    std::unique_lock<Mutex> locker(_packetsLock);
 
     if (isEmpty()) {
         return PacketPointer();
@@ -52,9 +52,25 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
 
     Q_ASSERT(!channel->empty());
 
-    // Take front packet
-    auto packet = std::move(channel->front());
-    channel->pop_front();
+    // Take front packet, or have a streamed list fill its next one
+    PacketPointer packet;
+    if (!channel->packets.empty()) {
+        packet = std::move(channel->packets.front());
+        channel->packets.pop_front();
+    } else {
+        // filling reads from the stream, so it is done without holding up the threads queueing packets.
+        // Only the send queue thread takes packets, and channels are only erased here,
+        // so the channel and its list stay put while the lock is released.
+        auto& streamedList = channel->streamedList;
+        locker.unlock();
+        packet = streamedList->takeStreamedPacket();
+        bool isExhausted = !streamedList->hasStreamedPackets();
+        locker.lock();
+
+        if (isExhausted) {
+            streamedList.reset();
+        }
+    }
 
     // Remove now empty channel (Don't remove the main channel)
     if (channel->empty() && _currentChannel != _channels.begin()) {
@@ -81,7 +97,7 @@ PacketQueue::PacketPointer PacketQueue::takePacket() {
 
 void PacketQueue::queuePacket(PacketPointer packet) {
     LockGuard locker(_packetsLock);
-    _channels.front()->push_back(std::move(packet));
+    _channels.front()->packets.push_back(std::move(packet));
 }
 
 void PacketQueue::queuePacketList(PacketListPointer packetList) {
@@ -90,6 +106,11 @@ void PacketQueue::queuePacketList(PacketListPointer packetList) {
     }
 
     LockGuard locker(_packetsLock);
-    _channels.emplace_back(new std::list<PacketPointer>());
-    _channels.back()->swap(packetList->_packets);
+    _channels.emplace_back(new RawChannel());
+    if (packetList->isStreamed()) {
+        // the list hands out its packets as they are taken
+        _channels.back()->streamedList = std::move(packetList);
+    } else {
+        _channels.back()->packets.swap(packetList->_packets);
+    }
 }
@@ -30,7 +30,12 @@ class PacketQueue {
     using LockGuard = std::lock_guard<Mutex>;
     using PacketPointer = std::unique_ptr<Packet>;
     using PacketListPointer = std::unique_ptr<PacketList>;
-    using RawChannel = std::list<PacketPointer>;
+    struct RawChannel {
+        std::list<PacketPointer> packets;
+        PacketListPointer streamedList; // a streamed list that still has packets to give
+
+        bool empty() const { return packets.empty() && !streamedList; }
+    };
     using Channel = std::unique_ptr<RawChannel>;
     using Channels = std::list<Channel>;
     
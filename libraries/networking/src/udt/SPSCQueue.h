@@ -0,0 +1,81 @@
+//
+//  SPSCQueue.h
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_SPSCQueue_h
+#define overte_SPSCQueue_h
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+
+/// @addtogroup Networking
+/// @{
+
+namespace udt {
+
+/// @brief A fixed-capacity, lock-free queue between exactly one producer thread and one consumer thread.
+/// @details The producer and consumer may change over time, as long as no two threads push (or pop) concurrently.
+/// @tparam T The item type. Must be copy-assignable.
+/// @tparam Capacity The maximum number of queued items. Must be a power of two.
+template <typename T, size_t Capacity>
+class SPSCQueue {
+    static_assert(Capacity > 0 && (Capacity & (Capacity - 1)) == 0, "SPSCQueue capacity must be a power of two");
+
+public:
+    /// @brief Adds an item to the back of the queue. Must only be called by the producer.
+    /// @param item The item to add.
+    /// @return <code>true</code> if the item was added, <code>false</code> if the queue is full.
+    bool push(const T& item) {
+        auto tail = _tail.load(std::memory_order_relaxed);
+        if (tail - _head.load(std::memory_order_acquire) == Capacity) {
+            return false;
+        }
+
+        _items[tail & MASK] = item;
+        _tail.store(tail + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Removes the item at the front of the queue. Must only be called by the consumer.
+    /// @param item Receives the item.
+    /// @return <code>true</code> if an item was removed, <code>false</code> if the queue is empty.
+    bool pop(T& item) {
+        auto head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+            return false;
+        }
+
+        item = _items[head & MASK];
+        _head.store(head + 1, std::memory_order_release);
+        return true;
+    }
+
+    /// @brief Gets whether the queue is empty. May be called from either side.
+    bool isEmpty() const { return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire); }
+
+private:
+    static const size_t MASK = Capacity - 1;
+    static const size_t CACHE_LINE_SIZE = 64;
+
+    std::array<T, Capacity> _items;
+
+    // keep the two indices on separate cache lines so that the producer and consumer don't false-share
+    std::atomic<size_t> _head { 0 };
+    char _headPadding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+    std::atomic<size_t> _tail { 0 };
+    char _tailPadding[CACHE_LINE_SIZE - sizeof(std::atomic<size_t>)];
+};
+
+} // namespace udt
+
+/// @}
+
+#endif // overte_SPSCQueue_h
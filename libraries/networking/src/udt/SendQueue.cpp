@@ -13,12 +13,6 @@
 #include "SendQueue.h"
 
 #include <algorithm>
-#include <thread>
-
-#include <QtCore/QCoreApplication>
-#include <QtCore/QDateTime>
-#include <QtCore/QJsonObject>
-#include <QtCore/QThread>
 
 #include <LogHandler.h>
 #include <NumericalConstants.h>
@@ -28,40 +22,21 @@
 #include "ControlPacket.h"
 #include "Packet.h"
 #include "PacketList.h"
-#include "../UserActivityLogger.h"
+#include "BatchSender.h"
 #include "Socket.h"
 #include <Trace.h>
 #include <Profile.h>
-#include <ThreadHelpers.h>
 
 #include "../NetworkLogging.h"
 
 using namespace udt;
 using namespace std::chrono;
 
-template <typename Mutex1, typename Mutex2>
-class DoubleLock {
-public:
-    using Lock = std::unique_lock<DoubleLock<Mutex1, Mutex2>>;
-    
-    DoubleLock(Mutex1& mutex1, Mutex2& mutex2) : _mutex1(mutex1), _mutex2(mutex2) { }
-    
-    DoubleLock(const DoubleLock&) = delete;
-    DoubleLock& operator=(const DoubleLock&) = delete;
-    
-    // Either locks all the mutexes or none of them
-    bool try_lock() { return (std::try_lock(_mutex1, _mutex2) == -1); }
-    
-    // Locks all the mutexes
-    void lock() { std::lock(_mutex1, _mutex2); }
-    
-     // Undefined behavior if not locked
-    void unlock() { _mutex1.unlock(); _mutex2.unlock(); }
-    
-private:
-    Mutex1& _mutex1;
-    Mutex2& _mutex2;
-};
+// the most packets a single service will send when catching up to its pacing schedule
+static const int MAX_PACKETS_PER_SEND_BATCH = BatchSender::MAX_BATCH_SIZE;
+
+static const auto HANDSHAKE_RESEND_INTERVAL = milliseconds(100);
+static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = seconds(5);
 
 const microseconds SendQueue::MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
 const microseconds SendQueue::MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
@@ -73,21 +48,8 @@ std::unique_ptr<SendQueue> SendQueue::create(Socket* socket, SockAddr destinatio
     auto queue = std::unique_ptr<SendQueue>(new SendQueue(socket, destination, currentSequenceNumber,
                                                           currentMessageNumber, hasReceivedHandshakeACK));
 
-    // Setup queue private thread
-    QThread* thread = new QThread();
-    QString name = "Networking: SendQueue " + destination.objectName();
-    thread->setObjectName(name); // Name thread for easier debug
-
-    connect(thread, &QThread::started, [name] { setThreadName(name.toStdString()); });
-    connect(thread, &QThread::started, queue.get(), &SendQueue::run);
-
-    connect(queue.get(), &QObject::destroyed, thread, &QThread::quit); // Thread auto cleanup
-    connect(thread, &QThread::finished, thread, &QThread::deleteLater); // Thread auto cleanup
-
-    // Move queue to private thread and start it
-    queue->moveToThread(thread);
-
-    thread->start();
+    // the first service sends the handshake (if required) and starts the queue
+    SendQueueScheduler::getInstance().add(queue.get());
 
     return queue;
 }
@@ -96,7 +58,8 @@ SendQueue::SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequen
                      MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK) :
     _packets(currentMessageNumber),
     _socket(socket),
-    _destination(dest)
+    _destination(dest),
+    _sendDestination(dest)
 {
     // set our member variables from current sequence number
     _currentSequenceNumber = currentSequenceNumber;
@@ -107,106 +70,105 @@ SendQueue::SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequen
 }
 
 SendQueue::~SendQueue() {
+    // make sure no scheduler worker is, or will be, in service
+    SendQueueScheduler::getInstance().remove(this);
 }
 
 void SendQueue::queuePacket(std::unique_ptr<Packet> packet) {
     _packets.queuePacket(std::move(packet));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // have the scheduler service us now in case we're waiting for packets
+    wakeIfWaiting();
 }
 
 void SendQueue::queuePacketList(std::unique_ptr<PacketList> packetList) {
     _packets.queuePacketList(std::move(packetList));
     
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for packets
-    _emptyCondition.notify_one();
-    
-    if (!thread()->isRunning() && _state == State::NotStarted) {
-        thread()->start();
-    }
+    // have the scheduler service us now in case we're waiting for packets
+    wakeIfWaiting();
 }
 
 void SendQueue::stop() {
-    
     _state = State::Stopped;
-    
-    // Notify all conditions in case we're waiting somewhere
-    _handshakeACKCondition.notify_one();
-    _emptyCondition.notify_one();
+
+    // once this returns, the scheduler won't service us again
+    SendQueueScheduler::getInstance().remove(this);
+}
+
+void SendQueue::wakeIfWaiting() {
+    // a queue with packets in flight and a pacing schedule is serviced on time anyway - only wake the idle ones
+    if (_isWaitingForWork.exchange(false)) {
+        SendQueueScheduler::getInstance().wake(this);
+    }
 }
     
 int SendQueue::sendPacket(const Packet& packet) {
-    _lastPacketSentAt = std::chrono::high_resolution_clock::now();
-    return _socket->writeDatagram(packet.getData(), packet.getDataSize(), _destination);
+    _lastPacketSentAt = Clock::now();
+    return _socket->writeDatagram(packet.getData(), packet.getDataSize(), _sendDestination);
 }
     
 void SendQueue::ack(SequenceNumber ack) {
     if (_lastACKSequenceNumber == (uint32_t) ack) {
         return;
     }
-    
-    {
-        // remove any ACKed packets from the map of sent packets
-        QWriteLocker locker(&_sentLock);
-        for (auto seq = SequenceNumber { (uint32_t) _lastACKSequenceNumber }; seq <= ack; ++seq) {
-            _sentPackets.erase(seq);
-        }
-    }
-    
-    {   // remove any sequence numbers equal to or lower than this ACK in the loss list
-        std::lock_guard<std::mutex> nakLocker(_naksLock);
-        
-        if (!_naks.isEmpty() && _naks.getFirstSequenceNumber() <= ack) {
-            _naks.remove(_naks.getFirstSequenceNumber(), ack);
-        }
-    }
-    
+
+    // the next service releases the ACKed packets and trims the loss list
     _lastACKSequenceNumber = (uint32_t) ack;
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping with a full congestion window
-    _emptyCondition.notify_one();
+    // have the scheduler service us now in case we're waiting with a full congestion window
+    wakeIfWaiting();
 }
 
 void SendQueue::fastRetransmit(udt::SequenceNumber ack) {
-    {
-        std::lock_guard<std::mutex> nakLocker(_naksLock);
-        _naks.insert(ack, ack);
+    if (!_receivedNAKs.push(ack)) {
+        // the queue is full, have the next service re-send everything that hasn't been ACKed instead
+        _hasDroppedNAKs = true;
     }
 
-    // call notify_one on the condition_variable_any in case the send thread is sleeping waiting for losses to re-send
-    _emptyCondition.notify_one();
+    // have the scheduler service us now in case we're waiting for losses to re-send
+    wakeIfWaiting();
 }
 
-void SendQueue::sendHandshake() {
-    std::unique_lock<std::mutex> handshakeLock { _handshakeMutex };
-    if (!_hasReceivedHandshakeACK) {
-        // we haven't received a handshake ACK from the client, send another now
-        // if the handshake hasn't been completed, then the initial sequence number
-        // should be the current sequence number + 1
-        SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
-        auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
-        handshakePacket->writePrimitive(initialSequenceNumber);
-        _socket->writeBasePacket(*handshakePacket, _destination);
-        
-        // we wait for the ACK or the re-send interval to expire
-        static const auto HANDSHAKE_RESEND_INTERVAL = std::chrono::milliseconds(100);
-        _handshakeACKCondition.wait_for(handshakeLock, HANDSHAKE_RESEND_INTERVAL);
+void SendQueue::processACKsAndNAKs() {
+    SequenceNumber ack { (uint32_t) _lastACKSequenceNumber };
+
+    // remove any ACKed packets from the sent packets
+    _sentPackets.releaseUpTo(ack);
+
+    SequenceNumber nak;
+    while (_receivedNAKs.pop(nak)) {
+        if (nak > ack) {
+            _naks.insert(nak, nak);
+        }
+    }
+
+    // a NAK that didn't fit in the queue could be for any packet not yet ACKed, so they're all considered lost
+    if (_hasDroppedNAKs.exchange(false) && ack < _currentSequenceNumber) {
+        _naks.clear();
+        _naks.append(ack + 1, _currentSequenceNumber);
+    }
+
+    // remove any sequence numbers equal to or lower than the last ACK in the loss list
+    if (!_naks.isEmpty() && _naks.getFirstSequenceNumber() <= ack) {
+        _naks.remove(_naks.getFirstSequenceNumber(), ack);
     }
 }
 
+void SendQueue::sendHandshake() {
+    // we haven't received a handshake ACK from the client, send another now
+    // if the handshake hasn't been completed, then the initial sequence number
+    // should be the current sequence number + 1
+    SequenceNumber initialSequenceNumber = _currentSequenceNumber + 1;
+    auto handshakePacket = ControlPacket::create(ControlPacket::Handshake, sizeof(SequenceNumber));
+    handshakePacket->writePrimitive(initialSequenceNumber);
+    _socket->writeBasePacket(*handshakePacket, _sendDestination);
+}
+
 void SendQueue::handshakeACK() {
-    {
-        std::lock_guard<std::mutex> locker { _handshakeMutex };
-        _hasReceivedHandshakeACK = true;
-    }
+    _hasReceivedHandshakeACK = true;
 
-    // Notify on the handshake ACK condition
-    _handshakeACKCondition.notify_one();
+    // have the scheduler service us now instead of at the next handshake re-send
+    SendQueueScheduler::getInstance().wake(this);
 }
 
 SequenceNumber SendQueue::getNextSequenceNumber() {
@@ -226,23 +188,15 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
 
     emit packetSent(packetSize, payloadSize, sequenceNumber, p_high_resolution_clock::now());
 
-    {
-        // Insert the packet we have just sent in the sent list
-        QWriteLocker locker(&_sentLock);
-        auto& entry = _sentPackets[newPacket->getSequenceNumber()];
-        entry.first = 0; // No resend
-        entry.second.swap(newPacket);
-    }
-    Q_ASSERT_X(!newPacket, "SendQueue::sendNewPacketAndAddToSentList()", "Overriden packet in sent list");
+    // Insert the packet we have just sent in the sent list
+    bool wasInserted = _sentPackets.insert(sequenceNumber, std::move(newPacket));
+    Q_ASSERT_X(wasInserted, "SendQueue::sendNewPacketAndAddToSentList()", "Sent list is full");
+    Q_UNUSED(wasInserted);
 
     if (bytesWritten < 0) {
         // this is a short-circuit loss - we failed to put this packet on the wire
         // so immediately add it to the loss list
-
-        {
-            std::lock_guard<std::mutex> nakLocker(_naksLock);
-            _naks.append(sequenceNumber);
-        }
+        _naks.append(sequenceNumber);
 
         return false;
     } else {
@@ -250,113 +204,105 @@ bool SendQueue::sendNewPacketAndAddToSentList(std::unique_ptr<Packet> newPacket,
     }
 }
 
-void SendQueue::run() {
-    if (_state == State::Stopped) {
-        // we've already been asked to stop before we even got a chance to start
-        // don't start now
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run after being told to stop. Will not run.";
-#endif
-        return;
-    } else if (_state == State::Running) {
-#ifdef UDT_CONNECTION_DEBUG
-        qCDebug(networking) << "SendQueue asked to run but is already running (according to state). Will not re-run.";
-#endif
-        return;
-    }
-    
-    _state = State::Running;
-    
-    // Wait for handshake to be complete
-    while (_state == State::Running && !_hasReceivedHandshakeACK) {
-        sendHandshake();
+SendQueue::Clock::time_point SendQueue::service(Clock::time_point now) {
+    // anything we do here is about to pick up what the connection handed over, so there is no need to wake us for it
+    _isWaitingForWork = false;
 
-        // Keep processing events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // Once we're here we've either received the handshake ACK or it's going to be time to re-send a handshake.
-        // Either way let's continue processing - no packets will be sent if no handshake ACK has been received.
+    State notStarted = State::NotStarted;
+    _state.compare_exchange_strong(notStarted, State::Running);
+
+    if (_state != State::Running) {
+        // we've been told to stop, possibly before we even got a chance to start
+        return Clock::time_point::max();
     }
 
-    // Keep an HRC to know when the next packet should have been
-    auto nextPacketTimestamp = p_high_resolution_clock::now();
+    if (_hasDestinationChanged.exchange(false)) {
+        std::lock_guard<std::mutex> lock(_destinationMutex);
+        _sendDestination = _destination;
+    }
 
-    while (_state == State::Running) {
-        bool attemptedToSendPacket = maybeResendPacket();
-        
-        // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
-        // (this is according to the current flow window size) then we send out a new packet
-        auto newPacketCount = 0;
-        if (!attemptedToSendPacket) {
-            newPacketCount = maybeSendNewPacket();
-            attemptedToSendPacket = (newPacketCount > 0);
-        }
-        
-        // since we're a while loop, give the thread a chance to process events
-        QCoreApplication::sendPostedEvents(this);
-        
-        // we just processed events so check now if we were just told to stop
-        // If the send queue has been innactive, skip the sleep for
-        // Either _isRunning will have been set to false and we'll break
-        // Or something happened and we'll keep going
-        if (_state != State::Running || isInactive(attemptedToSendPacket)) {
-            return;
+    if (!_hasReceivedHandshakeACK) {
+        // no packets will be sent until the handshake is complete - re-send it every interval until it is ACKed
+        if (now >= _nextHandshakeTimestamp) {
+            sendHandshake();
+            _nextHandshakeTimestamp = now + HANDSHAKE_RESEND_INTERVAL;
         }
 
-        if (_packetSendPeriod > 0) {
-            // push the next packet timestamp forwards by the current packet send period
-            auto nextPacketDelta = (newPacketCount == 2 ? 2 : 1) * _packetSendPeriod;
-            nextPacketTimestamp += std::chrono::microseconds(nextPacketDelta);
+        _nextPacketTimestamp = now;
+        return _nextHandshakeTimestamp;
+    }
+
+    if (now < _nextPacketTimestamp) {
+        // we were woken before the next packet is due - the ACKs and NAKs will be picked up when it is
+        return _nextPacketTimestamp;
+    }
+
+    bool attemptedToSendPacket = false;
 
-            // sleep as long as we need for next packet send, if we can
-            auto now = p_high_resolution_clock::now();
+    {
+        // if we've fallen behind the pacing schedule, the packets we owe go out together in one batched write
+        // (packets the kernel refuses in a batch are not short-circuit losses, they are recovered through NAKs)
+        Socket::SendBatch sendBatch(*_socket);
+        int numPacketsSent = 0;
 
-            auto timeToSleep = duration_cast<microseconds>(nextPacketTimestamp - now);
+        while (true) {
+            processACKsAndNAKs();
 
-            // we use nextPacketTimestamp so that we don't fall behind, not to force long sleeps
-            // we'll never allow nextPacketTimestamp to force us to sleep for more than nextPacketDelta
-            // so cap it to that value
-            if (timeToSleep > std::chrono::microseconds(nextPacketDelta)) {
-                // reset the nextPacketTimestamp so that it is correct next time we come around
-                nextPacketTimestamp = now + std::chrono::microseconds(nextPacketDelta);
+            bool sentPacket = maybeResendPacket();
 
-                timeToSleep = std::chrono::microseconds(nextPacketDelta);
+            // if we didn't find a packet to re-send AND we think we can fit a new packet on the wire
+            // (this is according to the current flow window size) then we send out a new packet
+            if (!sentPacket) {
+                sentPacket = (maybeSendNewPacket() > 0);
             }
 
-            // we're seeing SendQueues sleep for a long period of time here,
-            // which can lock the NodeList if it's attempting to clear connections
-            // for now we guard this by capping the time this thread and sleep for
-
-            const microseconds MAX_SEND_QUEUE_SLEEP_USECS { 2000000 };
-            if (timeToSleep > MAX_SEND_QUEUE_SLEEP_USECS) {
-                qWarning() << "udt::SendQueue wanted to sleep for" << timeToSleep.count() << "microseconds";
-                qWarning() << "Capping sleep to" << MAX_SEND_QUEUE_SLEEP_USECS.count();
-                qWarning() << "PSP:" << _packetSendPeriod << "NPD:" << nextPacketDelta
-                << "NPT:" << nextPacketTimestamp.time_since_epoch().count()
-                << "NOW:" << now.time_since_epoch().count();
-
-                // alright, we're in a weird state
-                // we want to know why this is happening so we can implement a better fix than this guard
-                // send some details up to the API (if the user allows us) that indicate how we could such a large timeToSleep
-                static const QString SEND_QUEUE_LONG_SLEEP_ACTION = "sendqueue-sleep";
-
-                // setup a json object with the details we want
-                QJsonObject longSleepObject;
-                longSleepObject["timeToSleep"] = qint64(timeToSleep.count());
-                longSleepObject["packetSendPeriod"] = _packetSendPeriod.load();
-                longSleepObject["nextPacketDelta"] = nextPacketDelta;
-                longSleepObject["nextPacketTimestamp"] = qint64(nextPacketTimestamp.time_since_epoch().count());
-                longSleepObject["then"] = qint64(now.time_since_epoch().count());
-
-                // hopefully send this event using the user activity logger
-                UserActivityLogger::getInstance().logAction(SEND_QUEUE_LONG_SLEEP_ACTION, longSleepObject);
-                
-                timeToSleep = MAX_SEND_QUEUE_SLEEP_USECS;
+            if (!sentPacket) {
+                break;
+            }
+
+            attemptedToSendPacket = true;
+            if (++numPacketsSent >= MAX_PACKETS_PER_SEND_BATCH) {
+                break;
+            }
+
+            // only keep going if the next packet is already due
+            auto nextPacketDelta = microseconds(_packetSendPeriod.load());
+            if (_packetSendPeriod > 0) {
+                if (_nextPacketTimestamp + nextPacketDelta > Clock::now()) {
+                    break;
+                }
+                _nextPacketTimestamp += nextPacketDelta;
             }
-            
-            std::this_thread::sleep_for(timeToSleep);
         }
     }
+
+    if (_state != State::Running) {
+        return Clock::time_point::max();
+    }
+
+    if (!attemptedToSendPacket) {
+        return nextServiceTimeWhenIdle(now);
+    }
+
+    _inactiveTimestamp = Clock::time_point::max();
+    _stuckTimestamp = Clock::time_point::max();
+
+    if (_packetSendPeriod <= 0) {
+        // no pacing - come straight back for more, after the other queues that are due have had their turn
+        return now;
+    }
+
+    // push the next packet timestamp forwards by the current packet send period
+    auto nextPacketDelta = microseconds(_packetSendPeriod.load());
+    _nextPacketTimestamp += nextPacketDelta;
+
+    // we use _nextPacketTimestamp so that we don't fall behind, not to force long waits
+    // we'll never allow it to make us wait for more than nextPacketDelta
+    if (_nextPacketTimestamp - now > nextPacketDelta) {
+        _nextPacketTimestamp = now + nextPacketDelta;
+    }
+
+    return _nextPacketTimestamp;
 }
 
 int SendQueue::maybeSendNewPacket() {
@@ -388,31 +334,24 @@ bool SendQueue::maybeResendPacket() {
     // the following while makes sure that we find a packet to re-send, if there is one
     while (true) {
         
-        std::unique_lock<std::mutex> naksLocker(_naksLock);
-        
         if (!_naks.isEmpty()) {
             // pull the sequence number we need to re-send
             SequenceNumber resendNumber = _naks.popFirstSequenceNumber();
-            naksLocker.unlock();
             
-            // pull the packet to re-send from the sent packets list
-            QReadLocker sentLocker(&_sentLock);
-            
-            // see if we can find the packet to re-send
-            auto it = _sentPackets.find(resendNumber);
+            // see if we can find the packet to re-send in the sent packets list
+            auto entry = _sentPackets.find(resendNumber);
 
-            if (it != _sentPackets.end()) {
+            if (entry) {
 
-                auto& entry = it->second;
                 // we found the packet - grab it
-                auto& resendPacket = *(entry.second);
-                ++entry.first; // Add 1 resend
+                auto& resendPacket = *(entry->packet);
+                ++entry->numResends; // Add 1 resend
 
-                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry.first < 2 ? 0 : (entry.first - 2) % 4);
+                Packet::ObfuscationLevel level = (Packet::ObfuscationLevel)(entry->numResends < 2 ? 0 : (entry->numResends - 2) % 4);
 
                 auto wireSize = resendPacket.getWireSize();
                 auto payloadSize = resendPacket.getPayloadSize();
-                auto sequenceNumber = it->first;
+                auto sequenceNumber = entry->sequenceNumber;
 
                 if (level != Packet::NoObfuscation) {
 #ifdef UDT_CONNECTION_DEBUG
@@ -431,9 +370,6 @@ bool SendQueue::maybeResendPacket() {
                     // Create copy of the packet
                     auto packet = Packet::createCopy(resendPacket);
 
-                    // unlock the sent packets
-                    sentLocker.unlock();
-
                     // Obfuscate packet
                     packet->obfuscate(level);
 
@@ -442,9 +378,6 @@ bool SendQueue::maybeResendPacket() {
                 } else {
                     // send it off
                     sendPacket(resendPacket);
-
-                    // unlock the sent packets
-                    sentLocker.unlock();
                 }
                 
                 emit packetRetransmitted(wireSize, payloadSize, sequenceNumber,
@@ -467,88 +400,89 @@ bool SendQueue::maybeResendPacket() {
     return false;
 }
 
-bool SendQueue::isInactive(bool attemptedToSendPacket) {
-    // check for connection timeout first
+SendQueue::Clock::time_point SendQueue::nextServiceTimeWhenIdle(Clock::time_point now) {
+    // whatever we send next starts a fresh pacing schedule, rather than catching up on the time we spent waiting
+    _nextPacketTimestamp = now;
 
-    if (!attemptedToSendPacket) {
-        // During our processing above we didn't send any packets
-        
-        // If that is still the case we should use a condition_variable_any to sleep until we have data to handle.
-        // To confirm that the queue of packets and the NAKs list are still both empty we'll need to use the DoubleLock
-        using DoubleLock = DoubleLock<std::recursive_mutex, std::mutex>;
-        DoubleLock doubleLock(_packets.getLock(), _naksLock);
-        DoubleLock::Lock locker(doubleLock, std::try_to_lock);
-        
-        if (locker.owns_lock() && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
-            // The packets queue and loss list mutexes are now both locked and they're both empty
-            
-            if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
-                // we've sent the client as much data as we have (and they've ACKed it)
-                // either wait for new data to send or 5 seconds before cleaning up the queue
-                static const auto EMPTY_QUEUES_INACTIVE_TIMEOUT = std::chrono::seconds(5);
-                
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, EMPTY_QUEUES_INACTIVE_TIMEOUT);
-                
-                if (cvStatus == std::cv_status::timeout && (_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty()) {
+    // To confirm that the queue of packets is still empty we'll need to hold its lock - the loss list belongs to
+    // us, so only the NAKs the connection has handed over but we haven't picked up yet need checking
+    std::unique_lock<std::recursive_mutex> locker(_packets.getLock(), std::try_to_lock);
+    if (!locker.owns_lock()) {
+        // packets are being queued right now, come back for them
+        return now;
+    }
 
+    // anything queued, ACKed or NAKed from here on wakes us up - this is set before we look for the last time, so
+    // that we either see what the connection hands over or the connection sees that we need a wake
+    _isWaitingForWork = true;
+    processACKsAndNAKs();
+
+    if (!((_packets.isEmpty() || isFlowWindowFull()) && _naks.isEmpty() && _receivedNAKs.isEmpty())) {
+        _isWaitingForWork = false;
+        return now;
+    }
+
+    // The packets queue mutex is now locked and both the packets queue and the loss list are empty
+
+    if (uint32_t(_lastACKSequenceNumber) == uint32_t(_currentSequenceNumber)) {
+        // we've sent the client as much data as we have (and they've ACKed it)
+        // either wait for new data to send or 5 seconds before cleaning up the queue
+        _stuckTimestamp = Clock::time_point::max();
+
+        if (_inactiveTimestamp == Clock::time_point::max()) {
+            _inactiveTimestamp = now + EMPTY_QUEUES_INACTIVE_TIMEOUT;
+        } else if (now >= _inactiveTimestamp) {
 #ifdef UDT_CONNECTION_DEBUG
-                    qCDebug(networking) << "SendQueue to" << _destination << "has been empty for"
-                        << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
-                        << "seconds and receiver has ACKed all packets."
-                        << "The queue is now inactive and will be stopped.";
+            qCDebug(networking) << "SendQueue to" << _sendDestination << "has been empty for"
+                << EMPTY_QUEUES_INACTIVE_TIMEOUT.count()
+                << "seconds and receiver has ACKed all packets."
+                << "The queue is now inactive and will be stopped.";
 #endif
 
-                    // we have the lock again - Make sure to unlock it
-                    locker.unlock();
-                    
-                    // Deactivate queue
-                    deactivate();
-                    return true;
-                }
+            locker.unlock();
 
-            } else {
-                // We think the client is still waiting for data (based on the sequence number gap)
-                // Let's wait either for a response from the client or until the estimated timeout
-                // (plus the sync interval to allow the client to respond) has elapsed
-
-                auto estimatedTimeout = std::chrono::microseconds(_estimatedTimeout);
-
-                // Clamp timeout beween 10 ms and 5 s
-                estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
-
-                // use our condition_variable_any to wait
-                auto cvStatus = _emptyCondition.wait_for(locker, estimatedTimeout);
-
-                // when we wake-up check if we're "stuck" either if we've slept for the estimated timeout
-                // or it has been that long since the last time we sent a packet
-
-                // we are stuck if all of the following are true
-                // - there are no new packets to send or the flow window is full and we can't send any new packets
-                // - there are no packets to resend
-                // - the client has yet to ACK some sent packets
-                auto now = std::chrono::high_resolution_clock::now();
-
-                if ((cvStatus == std::cv_status::timeout || (now - _lastPacketSentAt > estimatedTimeout))
-                    && (_packets.isEmpty() || isFlowWindowFull())
-                    && _naks.isEmpty()
-                    && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
-                    // after a timeout if we still have sent packets that the client hasn't ACKed we
-                    // add them to the loss list
-                    
-                    // Note that thanks to the DoubleLock we have the _naksLock right now
-                    _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
-
-                    // we have the lock again - time to unlock it
-                    locker.unlock();
-                    
-                    emit timeout();
-                }
-            }
+            // Deactivate queue
+            deactivate();
+            return Clock::time_point::max();
         }
+
+        return _inactiveTimestamp;
     }
-    
-    return false;
+
+    // We think the client is still waiting for data (based on the sequence number gap)
+    // Let's wait either for a response from the client or until the estimated timeout
+    // (plus the sync interval to allow the client to respond) has elapsed
+    _inactiveTimestamp = Clock::time_point::max();
+
+    auto estimatedTimeout = microseconds(_estimatedTimeout);
+
+    // Clamp timeout beween 10 ms and 5 s
+    estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT, std::max(MINIMUM_ESTIMATED_TIMEOUT, estimatedTimeout));
+
+    if (_stuckTimestamp == Clock::time_point::max()) {
+        _stuckTimestamp = now + estimatedTimeout;
+        return _stuckTimestamp;
+    }
+
+    // we're "stuck" if we've waited for the estimated timeout, or it has been that long since the last time we
+    // sent a packet, and the client has yet to ACK some sent packets
+    if ((now >= _stuckTimestamp || now - _lastPacketSentAt > estimatedTimeout)
+        && SequenceNumber(_lastACKSequenceNumber) < _currentSequenceNumber) {
+        // after a timeout if we still have sent packets that the client hasn't ACKed we
+        // add them to the loss list
+        _naks.append(SequenceNumber(_lastACKSequenceNumber) + 1, _currentSequenceNumber);
+        _stuckTimestamp = Clock::time_point::max();
+        _isWaitingForWork = false;
+
+        locker.unlock();
+
+        emit timeout();
+
+        // come straight back to re-send them
+        return now;
+    }
+
+    return _stuckTimestamp;
 }
 
 void SendQueue::deactivate() {
@@ -559,9 +493,12 @@ void SendQueue::deactivate() {
 }
 
 bool SendQueue::isFlowWindowFull() const {
-    return seqlen(SequenceNumber { (uint32_t) _lastACKSequenceNumber }, _currentSequenceNumber)  > _flowWindowSize;
+    return seqlen(SequenceNumber { (uint32_t) _lastACKSequenceNumber }, _currentSequenceNumber)  > _flowWindowSize
+        || _sentPackets.isFull();
 }
 
 void SendQueue::updateDestinationAddress(SockAddr newAddress) {
+    std::lock_guard<std::mutex> lock(_destinationMutex);
     _destination = newAddress;
+    _hasDestinationChanged = true;
 }
@@ -14,15 +14,12 @@
 #define hifi_SendQueue_h
 
 #include <atomic>
-#include <condition_variable>
 #include <cstdint>
 #include <list>
 #include <memory>
 #include <mutex>
-#include <unordered_map>
 
 #include <QtCore/QObject>
-#include <QtCore/QReadWriteLock>
 
 #include <PortableHighResolutionClock.h>
 
@@ -31,6 +28,9 @@
 #include "Constants.h"
 #include "PacketQueue.h"
 #include "SequenceNumber.h"
+#include "SendQueueScheduler.h"
+#include "SentPacketWindow.h"
+#include "SPSCQueue.h"
 #include "LossList.h"
 
 namespace udt {
@@ -41,7 +41,9 @@ class Packet;
 class PacketList;
 class Socket;
     
-class SendQueue : public QObject {
+// A SendQueue has no thread of its own - it is a task of the shared SendQueueScheduler, which services it whenever its
+// next packet is due (according to the packet send period) or something it was waiting on has happened
+class SendQueue : public QObject, private SendQueueScheduler::Task {
     Q_OBJECT
     
 public:
@@ -86,14 +88,16 @@ signals:
 
     void timeout();
     
-private slots:
-    void run();
-    
 private:
+    using Clock = SendQueueScheduler::Clock;
+
     Q_DISABLE_COPY_MOVE(SendQueue)
     SendQueue(Socket* socket, SockAddr dest, SequenceNumber currentSequenceNumber,
               MessageNumber currentMessageNumber, bool hasReceivedHandshakeACK);
     
+    // sends whatever is due and returns when the queue next wants to be serviced - called on a scheduler worker
+    Clock::time_point service(Clock::time_point now) override;
+
     void sendHandshake();
     
     int sendPacket(const Packet& packet);
@@ -102,8 +106,11 @@ private:
     int maybeSendNewPacket(); // Figures out what packet to send next
     bool maybeResendPacket(); // Determines whether to resend a packet and which one
     
-    bool isInactive(bool attemptedToSendPacket);
+    void processACKsAndNAKs(); // applies ACKs and NAKs handed over by the connection
+    
+    Clock::time_point nextServiceTimeWhenIdle(Clock::time_point now); // decides what to wait for when nothing was sent
     void deactivate(); // makes the queue inactive and cleans it up
+    void wakeIfWaiting(); // has the scheduler service the queue now if it is waiting for packets, ACKs or NAKs
 
     bool isFlowWindowFull() const;
     
@@ -113,7 +120,11 @@ private:
     PacketQueue _packets;
     
     Socket* _socket { nullptr }; // Socket to send packet on
+
+    std::mutex _destinationMutex; // Protects the destination address handed over by the connection
     SockAddr _destination; // Destination addr
+    std::atomic<bool> _hasDestinationChanged { false };
+    SockAddr _sendDestination; // Copy of the destination addr used by the scheduler worker
     
     std::atomic<uint32_t> _lastACKSequenceNumber { 0 }; // Last ACKed sequence number
     
@@ -127,20 +138,24 @@ private:
     
     std::atomic<int> _flowWindowSize { 0 }; // Flow control window size (number of packets that can be on wire) - set from CC
     
-    mutable std::mutex _naksLock; // Protects the naks list.
+    // ACKs are handed to the scheduler worker through _lastACKSequenceNumber and NAKs through this queue, so that the
+    // connection never has to wait on the worker
+    static const size_t NAK_QUEUE_CAPACITY = 1024;
+    SPSCQueue<SequenceNumber, NAK_QUEUE_CAPACITY> _receivedNAKs;
+    std::atomic<bool> _hasDroppedNAKs { false }; // set when a NAK didn't fit in the queue, everything unACKed is re-sent
+
+    // only touched from service
     LossList _naks; // Sequence numbers of packets to resend
+    SentPacketWindow _sentPackets; // Packets waiting for ACK.
+    Clock::time_point _nextPacketTimestamp; // When the next packet should go out according to the send period
+    Clock::time_point _nextHandshakeTimestamp; // When to re-send the handshake if it hasn't been ACKed
+    Clock::time_point _inactiveTimestamp { Clock::time_point::max() }; // When to give up on an empty, ACKed queue
+    Clock::time_point _stuckTimestamp { Clock::time_point::max() }; // When to time out waiting on unACKed packets
     
-    mutable QReadWriteLock _sentLock; // Protects the sent packet list
-    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>; // Number of resend + packet ptr
-    std::unordered_map<SequenceNumber, PacketResendPair> _sentPackets; // Packets waiting for ACK.
-    
-    std::mutex _handshakeMutex; // Protects the handshake ACK condition_variable
     std::atomic<bool> _hasReceivedHandshakeACK { false }; // flag for receipt of handshake ACK from client
-    std::condition_variable _handshakeACKCondition;
-    
-    std::condition_variable_any _emptyCondition;
+    std::atomic<bool> _isWaitingForWork { false }; // set when service had nothing to send and is waiting for a wake
 
-    std::chrono::high_resolution_clock::time_point _lastPacketSentAt;
+    Clock::time_point _lastPacketSentAt;
 
     static const std::chrono::microseconds MAXIMUM_ESTIMATED_TIMEOUT;
     static const std::chrono::microseconds MINIMUM_ESTIMATED_TIMEOUT;
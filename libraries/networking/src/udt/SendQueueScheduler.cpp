@@ -0,0 +1,287 @@
+//
+//  SendQueueScheduler.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueScheduler.h"
+
+#include <algorithm>
+#include <string>
+
+#include <QtCore/QtGlobal>
+
+#if defined(Q_OS_LINUX)
+#include <sys/prctl.h>
+#endif
+
+#include <ThreadHelpers.h>
+
+using namespace udt;
+using namespace std::chrono;
+
+const microseconds SendQueueScheduler::TICK { 32 };
+const microseconds SendQueueScheduler::SPIN_THRESHOLD { 50 };
+const int SendQueueScheduler::NUM_SLOTS;
+const int SendQueueScheduler::MAX_SHARED_WORKERS;
+
+SendQueueScheduler& SendQueueScheduler::getInstance() {
+    static SendQueueScheduler instance(std::max(1, std::min(MAX_SHARED_WORKERS,
+                                                            (int)std::thread::hardware_concurrency() / 2)));
+    return instance;
+}
+
+SendQueueScheduler::SendQueueScheduler(int numWorkers) :
+    _epoch(Clock::now())
+{
+    numWorkers = std::max(1, numWorkers);
+    _workers.reserve(numWorkers);
+    for (int i = 0; i < numWorkers; ++i) {
+        _workers.emplace_back([this, i] { workerLoop(i); });
+    }
+}
+
+SendQueueScheduler::~SendQueueScheduler() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _isStopping = true;
+        _isTimekeeperInterrupted = true;
+    }
+    _workCondition.notify_all();
+    _timekeeperCondition.notify_all();
+
+    for (auto& worker : _workers) {
+        worker.join();
+    }
+}
+
+void SendQueueScheduler::add(Task* task) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (task->_isRegistered) {
+        return;
+    }
+
+    task->_isRegistered = true;
+    scheduleLocked(task, Clock::now());
+}
+
+void SendQueueScheduler::wake(Task* task) {
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (!task->_isRegistered) {
+        return;
+    }
+
+    switch (task->_place) {
+        case Task::Place::Running:
+            // the worker servicing it reschedules it straight away when it's done
+            task->_isWakeRequested = true;
+            break;
+        case Task::Place::Ready:
+            break;
+        default:
+            unscheduleLocked(task);
+            scheduleLocked(task, Clock::now());
+            break;
+    }
+}
+
+void SendQueueScheduler::remove(Task* task) {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (!task->_isRegistered) {
+        return;
+    }
+
+    task->_isRegistered = false;
+    task->_isWakeRequested = false;
+
+    _serviceDoneCondition.wait(lock, [task] { return task->_place != Task::Place::Running; });
+
+    unscheduleLocked(task);
+}
+
+int64_t SendQueueScheduler::tickForTime(Clock::time_point time) const {
+    if (time <= _epoch) {
+        return 0;
+    }
+    return duration_cast<microseconds>(time - _epoch).count() / TICK.count();
+}
+
+void SendQueueScheduler::scheduleLocked(Task* task, Clock::time_point deadline) {
+    Q_ASSERT(task->_place == Task::Place::None);
+
+    if (deadline == Clock::time_point::max()) {
+        // the task waits for a wake
+        return;
+    }
+
+    task->_deadline = deadline;
+
+    if (deadline <= Clock::now()) {
+        task->_place = Task::Place::Ready;
+        _readyTasks.push_back(task);
+        notifyWorkerLocked();
+        return;
+    }
+
+    task->_deadlineTick = std::max(tickForTime(deadline), _currentTick);
+    task->_place = Task::Place::Wheel;
+    _wheel[task->_deadlineTick % NUM_SLOTS].push_back(task);
+
+    if (deadline < _timekeeperDeadline) {
+        // the timekeeper is waiting for something later than this
+        _isTimekeeperInterrupted = true;
+        _timekeeperCondition.notify_one();
+    } else if (!_hasTimekeeper && _numIdleWorkers > 0) {
+        _workCondition.notify_one();
+    }
+}
+
+void SendQueueScheduler::unscheduleLocked(Task* task) {
+    if (task->_place == Task::Place::Wheel) {
+        auto& slot = _wheel[task->_deadlineTick % NUM_SLOTS];
+        auto it = std::find(slot.begin(), slot.end(), task);
+        Q_ASSERT(it != slot.end());
+        *it = slot.back();
+        slot.pop_back();
+    } else if (task->_place == Task::Place::Ready) {
+        auto it = std::find(_readyTasks.begin(), _readyTasks.end(), task);
+        Q_ASSERT(it != _readyTasks.end());
+        _readyTasks.erase(it);
+    }
+
+    task->_place = Task::Place::None;
+}
+
+void SendQueueScheduler::collectDueTasksLocked(Clock::time_point now) {
+    auto nowTick = tickForTime(now);
+
+    // a task with a later service time never sits in a slot behind the current tick, so once we've been around the
+    // whole wheel there is nothing left to look at
+    auto lastTick = std::min(nowTick, _currentTick + NUM_SLOTS - 1);
+
+    for (auto tick = _currentTick; tick <= lastTick; ++tick) {
+        auto& slot = _wheel[tick % NUM_SLOTS];
+        for (size_t i = 0; i < slot.size();) {
+            Task* task = slot[i];
+            if (task->_deadline <= now) {
+                slot[i] = slot.back();
+                slot.pop_back();
+
+                task->_place = Task::Place::Ready;
+                _readyTasks.push_back(task);
+            } else {
+                ++i;
+            }
+        }
+    }
+
+    _currentTick = std::max(_currentTick, nowTick);
+}
+
+SendQueueScheduler::Clock::time_point SendQueueScheduler::nextDeadlineLocked() const {
+    for (auto tick = _currentTick; tick < _currentTick + NUM_SLOTS; ++tick) {
+        const auto& slot = _wheel[tick % NUM_SLOTS];
+
+        bool found = false;
+        auto deadline = Clock::time_point::max();
+        for (Task* task : slot) {
+            // skip the tasks waiting for a later turn of the wheel
+            if (task->_deadlineTick == tick) {
+                found = true;
+                deadline = std::min(deadline, task->_deadline);
+            }
+        }
+
+        if (found) {
+            return deadline;
+        }
+    }
+
+    // nothing is due within one turn of the wheel - come back once it has gone around
+    return _epoch + duration_cast<Clock::duration>(TICK * (_currentTick + NUM_SLOTS));
+}
+
+void SendQueueScheduler::notifyWorkerLocked() {
+    if (_numIdleWorkers > 0) {
+        _workCondition.notify_one();
+    } else if (_hasTimekeeper) {
+        _isTimekeeperInterrupted = true;
+        _timekeeperCondition.notify_one();
+    }
+}
+
+void SendQueueScheduler::workerLoop(int index) {
+    setThreadName("Networking: SendQueue scheduler " + std::to_string(index));
+
+#if defined(Q_OS_LINUX)
+    // the default 50us of timer slack would eat most of the pacing accuracy we sleep on the condition variable for
+    prctl(PR_SET_TIMERSLACK, 1UL, 0UL, 0UL, 0UL);
+#endif
+
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    while (!_isStopping) {
+        auto now = Clock::now();
+        collectDueTasksLocked(now);
+
+        if (!_readyTasks.empty()) {
+            Task* task = _readyTasks.front();
+            _readyTasks.pop_front();
+            task->_place = Task::Place::Running;
+
+            // make sure somebody picks up the rest of the ready tasks and keeps time while we're busy
+            if (_numIdleWorkers > 0 && (!_readyTasks.empty() || !_hasTimekeeper)) {
+                _workCondition.notify_one();
+            }
+
+            lock.unlock();
+            auto nextServiceTime = task->service(Clock::now());
+            lock.lock();
+
+            task->_place = Task::Place::None;
+
+            if (task->_isRegistered) {
+                if (task->_isWakeRequested) {
+                    task->_isWakeRequested = false;
+                    nextServiceTime = Clock::now();
+                }
+                scheduleLocked(task, nextServiceTime);
+            } else {
+                _serviceDoneCondition.notify_all();
+            }
+            continue;
+        }
+
+        if (_hasTimekeeper) {
+            ++_numIdleWorkers;
+            _workCondition.wait(lock);
+            --_numIdleWorkers;
+            continue;
+        }
+
+        // nobody is keeping time, so we do - sleep until just before the next service time and spin for the rest
+        _hasTimekeeper = true;
+        _isTimekeeperInterrupted = false;
+
+        auto deadline = nextDeadlineLocked();
+        _timekeeperDeadline = deadline;
+
+        if (deadline - now > SPIN_THRESHOLD) {
+            _timekeeperCondition.wait_until(lock, deadline - SPIN_THRESHOLD);
+        } else {
+            lock.unlock();
+            while (!_isTimekeeperInterrupted && Clock::now() < deadline) {
+                std::this_thread::yield();
+            }
+            lock.lock();
+        }
+
+        _hasTimekeeper = false;
+        _timekeeperDeadline = Clock::time_point::max();
+    }
+}
@@ -0,0 +1,144 @@
+//
+//  SendQueueScheduler.h
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_SendQueueScheduler_h
+#define overte_SendQueueScheduler_h
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include <PortableHighResolutionClock.h>
+
+/// @addtogroup Networking
+/// @{
+
+namespace udt {
+
+/// @brief Services paced senders (one per <code>udt::SendQueue</code>) from a small, fixed pool of worker threads.
+/// @details Pending service times are kept in a hashed timer wheel. One worker at a time keeps time: it sleeps on a
+/// condition variable until shortly before the earliest service time and spins for the rest, so that a task is
+/// serviced within tens of microseconds of when it asked to be, rather than at the granularity of the OS timer.
+/// The other workers wait for tasks that are due.
+/// <p>A task is never serviced by more than one worker at a time, and each service call happens-after the
+/// previous one, so state touched only from <code>service</code> needs no locking.</p>
+class SendQueueScheduler {
+public:
+    using Clock = p_high_resolution_clock;
+
+    /// @brief Something the scheduler services.
+    class Task {
+    public:
+        virtual ~Task() = default;
+
+        /// @brief Does the work that is due and says when the task next wants to be serviced.
+        /// @details Called on a scheduler worker thread.
+        /// @param now The current time.
+        /// @return The time of the next service, or <code>Clock::time_point::max()</code> to wait for a
+        /// <code>wake</code>.
+        virtual Clock::time_point service(Clock::time_point now) = 0;
+
+    private:
+        friend class SendQueueScheduler;
+
+        // guarded by the scheduler mutex
+        enum class Place { None, Wheel, Ready, Running };
+        Place _place { Place::None };
+        bool _isRegistered { false };
+        bool _isWakeRequested { false };
+        Clock::time_point _deadline;
+        int64_t _deadlineTick { 0 };
+    };
+
+    /// @brief The resolution of the timer wheel.
+    static const std::chrono::microseconds TICK;
+
+    /// @brief How long before a service time the timekeeping worker stops sleeping and starts spinning.
+    static const std::chrono::microseconds SPIN_THRESHOLD;
+
+    /// @brief The number of slots in the timer wheel. Service times further away than one turn of the wheel wait
+    /// in their slot for the later turn.
+    static const int NUM_SLOTS = 4096;
+
+    /// @brief The most worker threads the shared scheduler uses.
+    static const int MAX_SHARED_WORKERS = 4;
+
+    /// @brief Gets the scheduler shared by all send queues in the process.
+    static SendQueueScheduler& getInstance();
+
+    /// @brief Constructs a scheduler and starts its worker threads.
+    /// @param numWorkers The number of worker threads.
+    explicit SendQueueScheduler(int numWorkers);
+
+    /// @brief Stops and joins the worker threads.
+    ~SendQueueScheduler();
+
+    SendQueueScheduler(const SendQueueScheduler&) = delete;
+    SendQueueScheduler& operator=(const SendQueueScheduler&) = delete;
+
+    /// @brief Registers a task and services it as soon as a worker is free.
+    /// @param task The task. It must stay alive until it is removed.
+    void add(Task* task);
+
+    /// @brief Services a registered task as soon as a worker is free, even if its next service time is later.
+    /// @details If the task is being serviced it is serviced again straight afterwards. Does nothing for a task that
+    /// isn't registered.
+    /// @param task The task.
+    void wake(Task* task);
+
+    /// @brief Unregisters a task, waiting for a worker that is servicing it to finish.
+    /// @details Must not be called from the task's own <code>service</code>.
+    /// @param task The task.
+    void remove(Task* task);
+
+    /// @brief Gets the number of worker threads.
+    int getNumWorkers() const { return (int)_workers.size(); }
+
+private:
+    void workerLoop(int index);
+
+    int64_t tickForTime(Clock::time_point time) const;
+    void scheduleLocked(Task* task, Clock::time_point deadline);
+    void unscheduleLocked(Task* task);
+    void collectDueTasksLocked(Clock::time_point now);
+    Clock::time_point nextDeadlineLocked() const;
+    void notifyWorkerLocked();
+
+    std::mutex _mutex;
+    std::condition_variable _workCondition; // idle workers wait here for ready tasks
+    std::condition_variable _timekeeperCondition; // the timekeeping worker waits here for the next service time
+    std::condition_variable _serviceDoneCondition; // remove waits here for a running task to finish its service
+
+    const Clock::time_point _epoch;
+    int64_t _currentTick { 0 };
+    std::array<std::vector<Task*>, NUM_SLOTS> _wheel;
+    std::deque<Task*> _readyTasks;
+
+    int _numIdleWorkers { 0 };
+    bool _hasTimekeeper { false };
+    Clock::time_point _timekeeperDeadline { Clock::time_point::max() };
+    std::atomic<bool> _isTimekeeperInterrupted { false }; // read while the timekeeper spins without the lock
+    bool _isStopping { false };
+
+    std::vector<std::thread> _workers;
+};
+
+} // namespace udt
+
+/// @}
+
+#endif // overte_SendQueueScheduler_h
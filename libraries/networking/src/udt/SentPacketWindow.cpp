@@ -0,0 +1,91 @@
+//
+//  SentPacketWindow.cpp
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindow.h"
+
+#include <QtCore/QtGlobal>
+
+#include "Packet.h"
+
+using namespace udt;
+
+static const int INITIAL_CAPACITY = 64;
+
+// the ring index is the low bits of the sequence number, so the capacity has to divide the sequence number space
+static_assert((SentPacketWindow::MAX_CAPACITY & (SentPacketWindow::MAX_CAPACITY - 1)) == 0,
+              "SentPacketWindow capacity must be a power of two");
+static_assert(SentPacketWindow::MAX_CAPACITY > MAX_PACKETS_IN_FLIGHT,
+              "SentPacketWindow must hold a full congestion window");
+static_assert((SequenceNumber::MAX + 1) % SentPacketWindow::MAX_CAPACITY == 0,
+              "SentPacketWindow capacity must divide the sequence number space");
+
+SentPacketWindow::SentPacketWindow() : _entries(INITIAL_CAPACITY) {
+}
+
+SentPacketWindow::~SentPacketWindow() {
+}
+
+bool SentPacketWindow::insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet) {
+    if (_size == 0) {
+        _firstSequenceNumber = sequenceNumber;
+    }
+    Q_ASSERT_X(seqoff(_firstSequenceNumber, sequenceNumber) == _size, "SentPacketWindow::insert",
+               "Sequence numbers must be inserted in order");
+
+    if (_size == (int)_entries.size()) {
+        if (isFull()) {
+            return false;
+        }
+        grow();
+    }
+
+    auto& entry = _entries[indexOf(sequenceNumber)];
+    entry.sequenceNumber = sequenceNumber;
+    entry.numResends = 0;
+    entry.packet = std::move(packet);
+    ++_size;
+
+    return true;
+}
+
+SentPacketWindow::Entry* SentPacketWindow::find(SequenceNumber sequenceNumber) {
+    if (_size == 0) {
+        return nullptr;
+    }
+
+    auto offset = seqoff(_firstSequenceNumber, sequenceNumber);
+    if (offset < 0 || offset >= _size) {
+        return nullptr;
+    }
+
+    return &_entries[indexOf(sequenceNumber)];
+}
+
+void SentPacketWindow::releaseUpTo(SequenceNumber ack) {
+    while (_size > 0 && _firstSequenceNumber <= ack) {
+        _entries[indexOf(_firstSequenceNumber)].packet.reset();
+        ++_firstSequenceNumber;
+        --_size;
+    }
+}
+
+void SentPacketWindow::grow() {
+    std::vector<Entry> entries(_entries.size() * 2);
+
+    // the new ring uses one more bit of the sequence number as its index, so every entry gets a new slot
+    auto newMask = entries.size() - 1;
+    auto sequenceNumber = _firstSequenceNumber;
+    for (int i = 0; i < _size; ++i, ++sequenceNumber) {
+        entries[(SequenceNumber::UType)sequenceNumber & newMask] = std::move(_entries[indexOf(sequenceNumber)]);
+    }
+
+    _entries.swap(entries);
+}
@@ -0,0 +1,86 @@
+//
+//  SentPacketWindow.h
+//  libraries/networking/src/udt
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_SentPacketWindow_h
+#define overte_SentPacketWindow_h
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "Constants.h"
+#include "SequenceNumber.h"
+
+/// @addtogroup Networking
+/// @{
+
+namespace udt {
+
+class Packet;
+
+/// @brief The reliable packets a <code>SendQueue</code> has sent and is waiting on an ACK for, held in a ring indexed by
+/// sequence number.
+/// @details Sequence numbers are assigned densely, so the unacknowledged packets always occupy one contiguous run of the
+/// ring. The ring starts small and doubles as needed, up to <code>MAX_CAPACITY</code> packets.
+/// <p>Not thread-safe: it is owned by the send thread. ACKs are handed over by publishing the last ACKed sequence number
+/// and having the send thread call <code>releaseUpTo</code>.</p>
+class SentPacketWindow {
+public:
+
+    /// @brief The most packets the window can hold. Larger than the largest congestion window.
+    static const int MAX_CAPACITY = 32768;
+
+    struct Entry {
+        SequenceNumber sequenceNumber;
+        uint8_t numResends { 0 };
+        std::unique_ptr<Packet> packet;
+    };
+
+    SentPacketWindow();
+    ~SentPacketWindow();
+
+    /// @brief Adds a packet that has just been sent.
+    /// @param sequenceNumber The packet's sequence number. Must follow the last inserted one, unless the window is empty.
+    /// @param packet The packet.
+    /// @return <code>false</code> if the window is full and the packet was dropped, otherwise <code>true</code>.
+    bool insert(SequenceNumber sequenceNumber, std::unique_ptr<Packet> packet);
+
+    /// @brief Finds a packet that has not been ACKed yet.
+    /// @param sequenceNumber The packet's sequence number.
+    /// @return The entry for the packet, or <code>nullptr</code> if it has been released or was never inserted.
+    Entry* find(SequenceNumber sequenceNumber);
+
+    /// @brief Releases every packet up to and including an ACKed sequence number.
+    /// @param ack The ACKed sequence number.
+    void releaseUpTo(SequenceNumber ack);
+
+    /// @brief Gets the number of packets waiting on an ACK.
+    int size() const { return _size; }
+
+    bool isEmpty() const { return _size == 0; }
+    bool isFull() const { return _size == MAX_CAPACITY; }
+
+private:
+    size_t indexOf(SequenceNumber sequenceNumber) const {
+        return (SequenceNumber::UType)sequenceNumber & (_entries.size() - 1);
+    }
+    void grow();
+
+    std::vector<Entry> _entries;
+    SequenceNumber _firstSequenceNumber; // oldest packet waiting on an ACK
+    int _size { 0 };
+};
+
+} // namespace udt
+
+/// @}
+
+#endif // overte_SentPacketWindow_h
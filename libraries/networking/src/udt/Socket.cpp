@@ -16,6 +16,8 @@
 #include <sys/socket.h>
 #endif
 
+#include <algorithm>
+
 #include <QtCore/QThread>
 
 #include <shared/QtHelpers.h>
@@ -40,6 +42,38 @@ using namespace udt;
 #endif
 
 
+#if defined(UDT_BATCHED_SEND)
+// the socket a SendBatch is currently open for on this thread, and the thread's reusable batch
+static thread_local Socket* threadSendBatchSocket { nullptr };
+static thread_local std::unique_ptr<BatchSender> threadBatchSender;
+#endif
+
+Socket::SendBatch::SendBatch(Socket& socket) {
+#if defined(UDT_BATCHED_SEND)
+    if (!threadSendBatchSocket) {
+        if (!threadBatchSender) {
+            threadBatchSender.reset(new BatchSender());
+        }
+
+        if (threadBatchSender->isSupported()) {
+            _socket = &socket;
+            threadSendBatchSocket = _socket;
+        }
+    }
+#else
+    Q_UNUSED(socket);
+#endif
+}
+
+Socket::SendBatch::~SendBatch() {
+#if defined(UDT_BATCHED_SEND)
+    if (_socket) {
+        _socket->flushSendBatch();
+        threadSendBatchSocket = nullptr;
+    }
+#endif
+}
+
 Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     QObject(parent),
     _networkSocket(parent),
@@ -56,6 +90,183 @@ Socket::Socket(QObject* parent, bool shouldChangeSocketOptions) :
     const int READY_READ_BACKUP_CHECK_MSECS = 2 * 1000;
     connect(_readyReadBackupTimer, &QTimer::timeout, this, &Socket::checkForReadyReadBackup);
     _readyReadBackupTimer->start(READY_READ_BACKUP_CHECK_MSECS);
+
+    // until connection workers are started, all connection work happens on the socket thread
+    for (auto& shard : _connectionShards) {
+        shard.executor = this;
+    }
+}
+
+Socket::~Socket() {
+    // stop the workers first so that nothing is still using the connections when they are destroyed
+    stopVerificationWorkers(_verificationWorkers);
+    _verificationWorkers.clear();
+
+    // the workers run what was already posted to them before they stop
+    auto& retiring = _retiringConnectionWorkers;
+    retiring.insert(retiring.end(), _connectionWorkers.begin(), _connectionWorkers.end());
+    _connectionWorkers.clear();
+    for (auto& worker : _retiringConnectionWorkers) {
+        QThread* workerThread = worker.thread;
+        QMetaObject::invokeMethod(worker.executor, [workerThread] { workerThread->quit(); }, Qt::QueuedConnection);
+    }
+    for (auto& worker : _retiringConnectionWorkers) {
+        worker.thread->wait();
+        delete worker.executor;
+        delete worker.thread;
+    }
+    _retiringConnectionWorkers.clear();
+
+    for (auto& shard : _connectionShards) {
+        shard.connections.clear();
+    }
+}
+
+void Socket::setConnectionWorkerCount(int numWorkers) {
+    if (QThread::currentThread() != thread()) {
+        QMetaObject::invokeMethod(this, "setConnectionWorkerCount", Qt::QueuedConnection, Q_ARG(int, numWorkers));
+        return;
+    }
+
+    numWorkers = std::max(0, std::min(numWorkers, NUM_CONNECTION_SHARDS));
+    if (numWorkers == (int)_connectionWorkers.size()) {
+        return;
+    }
+
+    std::vector<ConnectionWorker> workers;
+    for (int i = 0; i < numWorkers; ++i) {
+        auto workerThread = new QThread();
+        workerThread->setObjectName(QString("UDT Connection Worker %1").arg(i));
+
+        // the executor is deleted with the thread once it has stopped, so tasks can be posted to it until then
+        auto worker = new QObject();
+        worker->moveToThread(workerThread);
+
+        workerThread->start();
+
+        workers.push_back({ workerThread, worker });
+    }
+
+    std::vector<ConnectionWorker> oldWorkers = _connectionWorkers;
+    _retiringConnectionWorkers.insert(_retiringConnectionWorkers.end(), oldWorkers.begin(), oldWorkers.end());
+    _connectionWorkers = workers;
+
+    // hand each shard and the connections in it over to its new thread - this runs on the thread that currently
+    // owns the shard, since that is the only thread allowed to move its connections, and isn't waited for here
+    auto numShardsToMove = std::make_shared<std::atomic<int>>(NUM_CONNECTION_SHARDS);
+    for (int i = 0; i < NUM_CONNECTION_SHARDS; ++i) {
+        auto& shard = _connectionShards[i];
+        QObject* newExecutor = numWorkers > 0 ? workers[i % numWorkers].executor : this;
+
+        runOnConnectionShard(shard, [this, &shard, newExecutor, numShardsToMove, oldWorkers] {
+            {
+                Lock shardLock(shard.mutex);
+                for (auto& connectionPair : shard.connections) {
+                    connectionPair.second->moveToThread(newExecutor->thread());
+                }
+                shard.executor = newExecutor;
+            }
+
+            if (--(*numShardsToMove) == 0) {
+                QMetaObject::invokeMethod(this, [this, oldWorkers] {
+                    retireConnectionWorkers(oldWorkers);
+                }, Qt::QueuedConnection);
+            }
+        });
+    }
+
+    qCDebug(networking) << "Processing UDT connections on" << numWorkers << "worker threads";
+}
+
+void Socket::retireConnectionWorkers(const std::vector<ConnectionWorker>& workers) {
+    // tasks are posted to a shard's worker under the shard lock, so once every shard has moved on nothing new is posted
+    // to the old workers, and they stop once they have run what was
+    for (auto& worker : workers) {
+        QThread* workerThread = worker.thread;
+        connect(workerThread, &QThread::finished, this, [this, workerThread] {
+            auto it = std::find_if(_retiringConnectionWorkers.begin(), _retiringConnectionWorkers.end(),
+                                   [workerThread](const ConnectionWorker& retiring) {
+                return retiring.thread == workerThread;
+            });
+            if (it != _retiringConnectionWorkers.end()) {
+                QObject* executor = it->executor;
+                _retiringConnectionWorkers.erase(it);
+                workerThread->wait();
+                delete executor;
+                delete workerThread;
+            }
+        }, Qt::QueuedConnection);
+        QMetaObject::invokeMethod(worker.executor, [workerThread] { workerThread->quit(); }, Qt::QueuedConnection);
+    }
+}
+
+void Socket::setVerificationWorkerCount(int numWorkers) {
+    if (QThread::currentThread() != thread()) {
+        BLOCKING_INVOKE_METHOD(this, "setVerificationWorkerCount", Q_ARG(int, numWorkers));
+        return;
+    }
+
+    numWorkers = std::max(0, std::min(numWorkers, MAX_VERIFICATION_WORKERS));
+    if (numWorkers == (int)_verificationWorkers.size()) {
+        return;
+    }
+
+    // packets are only handed to the workers from this thread, so once the old workers are stopped and what was
+    // left with them is verified here, nothing can overtake a packet from the same sender
+    stopVerificationWorkers(_verificationWorkers);
+    for (auto& worker : _verificationWorkers) {
+        verifyPendingPackets(*worker);
+    }
+    _verificationWorkers.clear();
+
+    for (int i = 0; i < numWorkers; ++i) {
+        auto worker = std::unique_ptr<VerificationWorker>(new VerificationWorker());
+        worker->thread = new QThread();
+        worker->thread->setObjectName(QString("UDT Verification Worker %1").arg(i));
+
+        worker->executor = new QObject();
+        worker->executor->moveToThread(worker->thread);
+        connect(worker->thread, &QThread::finished, worker->executor, &QObject::deleteLater);
+
+        worker->thread->start();
+
+        _verificationWorkers.push_back(std::move(worker));
+    }
+    _numVerificationWorkers = numWorkers;
+
+    qCDebug(networking) << "Verifying packets on" << numWorkers << "worker threads";
+}
+
+void Socket::stopVerificationWorkers(std::vector<std::unique_ptr<VerificationWorker>>& workers) {
+    _numVerificationWorkers = 0;
+
+    // the workers may stop with packets still waiting for them - those are left in their queues
+    for (auto& worker : workers) {
+        worker->thread->quit();
+        worker->thread->wait();
+        delete worker->thread;
+        worker->thread = nullptr;
+    }
+}
+
+Socket::ConnectionShard& Socket::shardForSockAddr(const SockAddr& sockAddr) {
+    return _connectionShards[std::hash<SockAddr>()(sockAddr) % NUM_CONNECTION_SHARDS];
+}
+
+void Socket::runOnConnectionShard(ConnectionShard& shard, std::function<void()> task) {
+    {
+        // the shard doesn't move to another worker while a task is posted to it, see retireConnectionWorkers()
+        Lock shardLock(shard.mutex);
+        QObject* executor = shard.executor;
+        if (executor->thread() != QThread::currentThread()) {
+            // check the executor again once the task comes up, in case the shard moved to another worker in the meantime
+            QMetaObject::invokeMethod(executor, [this, &shard, task] {
+                runOnConnectionShard(shard, task);
+            }, Qt::QueuedConnection);
+            return;
+        }
+    }
+    task();
 }
 
 void Socket::bind(SocketType socketType, const QHostAddress& address, quint16 port) {
@@ -152,11 +363,15 @@ qint64 Socket::writePacket(const Packet& packet, const SockAddr& sockAddr) {
         sequenceNumber = ++_unreliableSequenceNumbers[sockAddr];
     }
 
-    auto connection = findOrCreateConnection(sockAddr, true);
-    if (connection) {
-        connection->recordSentUnreliablePackets(packet.getWireSize(),
-                                                packet.getPayloadSize());
-    }
+    // the connection stats are only touched on the thread that owns the connection
+    auto wireSize = packet.getWireSize();
+    auto payloadSize = packet.getPayloadSize();
+    runOnConnectionShard(shardForSockAddr(sockAddr), [this, sockAddr, wireSize, payloadSize] {
+        auto connection = findOrCreateConnection(sockAddr, true);
+        if (connection) {
+            connection->recordSentUnreliablePackets(wireSize, payloadSize);
+        }
+    });
 
     // write the correct sequence number to the Packet here
     packet.writeSequenceNumber(sequenceNumber);
@@ -167,16 +382,12 @@ qint64 Socket::writePacket(const Packet& packet, const SockAddr& sockAddr) {
 qint64 Socket::writePacket(std::unique_ptr<Packet> packet, const SockAddr& sockAddr) {
 
     if (packet->isReliable()) {
-        // hand this packet off to writeReliablePacket
-        // because Qt can't invoke with the unique_ptr we have to release it here and re-construct in writeReliablePacket
-
-        if (QThread::currentThread() != thread()) {
-            QMetaObject::invokeMethod(this, "writeReliablePacket", Qt::QueuedConnection,
-                                      Q_ARG(Packet*, packet.release()),
-                                      Q_ARG(SockAddr, sockAddr));
-        } else {
-            writeReliablePacket(packet.release(), sockAddr);
-        }
+        // hand this packet off to writeReliablePacket on the thread that owns the connection
+        // because the task has to be copyable we have to release it here and re-construct in writeReliablePacket
+        auto rawPacket = packet.release();
+        runOnConnectionShard(shardForSockAddr(sockAddr), [this, rawPacket, sockAddr] {
+            writeReliablePacket(rawPacket, sockAddr);
+        });
 
         return 0;
     }
@@ -186,23 +397,18 @@ qint64 Socket::writePacket(std::unique_ptr<Packet> packet, const SockAddr& sockA
 
 qint64 Socket::writePacketList(std::unique_ptr<PacketList> packetList, const SockAddr& sockAddr) {
 
-    if (packetList->getNumPackets() == 0) {
+    if (packetList->getNumPackets() == 0 && !packetList->isStreamed()) {
         qCWarning(networking) << "Trying to send packet list with 0 packets, bailing.";
         return 0;
     }
 
     if (packetList->isReliable()) {
-        // hand this packetList off to writeReliablePacketList
-        // because Qt can't invoke with the unique_ptr we have to release it here and re-construct in writeReliablePacketList
-
-        if (QThread::currentThread() != thread()) {
-            auto ptr = packetList.release();
-            QMetaObject::invokeMethod(this, "writeReliablePacketList", Qt::AutoConnection,
-                                      Q_ARG(PacketList*, ptr),
-                                      Q_ARG(SockAddr, sockAddr));
-        } else {
-            writeReliablePacketList(packetList.release(), sockAddr);
-        }
+        // hand this packetList off to writeReliablePacketList on the thread that owns the connection
+        // because the task has to be copyable we have to release it here and re-construct in writeReliablePacketList
+        auto rawPacketList = packetList.release();
+        runOnConnectionShard(shardForSockAddr(sockAddr), [this, rawPacketList, sockAddr] {
+            writeReliablePacketList(rawPacketList, sockAddr);
+        });
 
         return 0;
     }
@@ -245,6 +451,12 @@ qint64 Socket::writeDatagram(const char* data, qint64 size, const SockAddr& sock
 }
 
 qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAddr) {
+#if defined(UDT_BATCHED_SEND)
+    if (threadSendBatchSocket == this && queueBatchedDatagram(datagram, sockAddr)) {
+        return datagram.size();
+    }
+#endif
+
     auto socketType = sockAddr.getType();
 
     // don't attempt to write the datagram if we're unbound.  Just drop it.
@@ -282,11 +494,58 @@ qint64 Socket::writeDatagram(const QByteArray& datagram, const SockAddr& sockAdd
     return bytesWritten;
 }
 
+#if defined(UDT_BATCHED_SEND)
+bool Socket::queueBatchedDatagram(const QByteArray& datagram, const SockAddr& sockAddr) {
+    if (sockAddr.getType() != SocketType::UDP) {
+        return false;
+    }
+
+    if (!BatchSender::canQueue(datagram.size(), sockAddr)) {
+        // non-IPv4 destinations and oversized datagrams take the single write path, once the datagrams batched ahead
+        // of them are out
+        flushSendBatch();
+        return false;
+    }
+
+    if (threadBatchSender->isFull()) {
+        flushSendBatch();
+    }
+
+    return threadBatchSender->queue(datagram.constData(), datagram.size(), sockAddr);
+}
+
+void Socket::flushSendBatch() {
+    auto& batchSender = *threadBatchSender;
+    if (batchSender.isEmpty()) {
+        return;
+    }
+
+    if (_networkSocket.state(SocketType::UDP) != QAbstractSocket::BoundState) {
+        qCDebug(networking) << "Attempt to flush send batch when in unbound state - dropping batched datagrams";
+        batchSender.clear();
+        return;
+    }
+
+    batchSender.setSegmentationOffloadEnabled(_isSegmentationOffloadEnabled);
+
+    auto numSendCallsBefore = batchSender.getNumSendCalls();
+    // what sendmmsg refuses gets the same single write as an unbatched datagram, rather than being dropped
+    auto numDatagramsSent = batchSender.flush(_networkSocket.socketDescriptor(SocketType::UDP),
+        [this](const char* data, qint64 size, const SockAddr& sockAddr) {
+            return _networkSocket.writeDatagram(QByteArray::fromRawData(data, size), sockAddr);
+        });
+
+    _numBatchedSendCalls += batchSender.getNumSendCalls() - numSendCallsBefore;
+    _numBatchedDatagrams += numDatagramsSent;
+}
+#endif
+
 Connection* Socket::findOrCreateConnection(const SockAddr& sockAddr, bool filterCreate) {
-    Lock connectionsLock(_connectionsHashMutex);
-    auto it = _connectionsHash.find(sockAddr);
+    auto& shard = shardForSockAddr(sockAddr);
+    Lock connectionsLock(shard.mutex);
+    auto it = shard.connections.find(sockAddr);
 
-    if (it == _connectionsHash.end()) {
+    if (it == shard.connections.end()) {
         // we did not have a matching connection, time to see if we should make one
 
         if (filterCreate && _connectionCreationFilterOperator && !_connectionCreationFilterOperator(sockAddr)) {
@@ -297,12 +556,17 @@ Connection* Socket::findOrCreateConnection(const SockAddr& sockAddr, bool filter
 #endif // UDT_CONNECTION_DEBUG
             return nullptr;
         } else {
-            auto congestionControl = _ccFactory->create();
+            std::unique_ptr<CongestionControl> congestionControl;
+            {
+                Lock ccFactoryLock(_ccFactoryMutex);
+                congestionControl = _ccFactory->create();
+            }
             congestionControl->setMaxBandwidth(_maxBandwidth);
             auto connection = std::unique_ptr<Connection>(new Connection(this, sockAddr, std::move(congestionControl)));
-            if (QThread::currentThread() != thread()) {
-                qCDebug(networking) << "Moving new Connection to NodeList thread";
-                connection->moveToThread(thread());
+            QThread* shardThread = shard.executor.load()->thread();
+            if (QThread::currentThread() != shardThread) {
+                qCDebug(networking) << "Moving new Connection to" << shardThread->objectName();
+                connection->moveToThread(shardThread);
             }
             // allow higher-level classes to find out when connections have completed a handshake
             QObject::connect(connection.get(), &Connection::receiverHandshakeRequestComplete,
@@ -310,7 +574,7 @@ Connection* Socket::findOrCreateConnection(const SockAddr& sockAddr, bool filter
 
             qCDebug(networking) << "Creating new Connection class for" << sockAddr;
 
-            it = _connectionsHash.insert(it, std::make_pair(sockAddr, std::move(connection)));
+            it = shard.connections.insert(it, std::make_pair(sockAddr, std::move(connection)));
         }
     }
 
@@ -323,37 +587,111 @@ void Socket::clearConnections() {
         return;
     }
 
-    Lock connectionsLock(_connectionsHashMutex);
-    if (_connectionsHash.size() > 0) {
+    std::vector<std::unique_ptr<Connection>> connections;
+    for (auto& shard : _connectionShards) {
+        Lock connectionsLock(shard.mutex);
+        for (auto& connectionPair : shard.connections) {
+            connections.push_back(std::move(connectionPair.second));
+        }
+        shard.connections.clear();
+    }
+
+    if (connections.size() > 0) {
         // clear all of the current connections in the socket
         qCDebug(networking) << "Clearing all remaining connections in Socket.";
-        _connectionsHash.clear();
+        for (auto& connection : connections) {
+            destroyConnection(std::move(connection));
+        }
     }
 }
 
 void Socket::cleanupConnection(SockAddr sockAddr) {
-    Lock connectionsLock(_connectionsHashMutex);
-    auto numErased = _connectionsHash.erase(sockAddr);
+    auto& shard = shardForSockAddr(sockAddr);
+    std::unique_ptr<Connection> connection;
+    {
+        Lock connectionsLock(shard.mutex);
+        auto it = shard.connections.find(sockAddr);
+        if (it != shard.connections.end()) {
+            connection = std::move(it->second);
+            shard.connections.erase(it);
+        }
+    }
 
-    if (numErased > 0) {
+    if (connection) {
 #ifdef UDT_CONNECTION_DEBUG
         qCDebug(networking) << "Socket::cleanupConnection called for UDT connection to" << sockAddr;
 #endif
+        destroyConnection(std::move(connection));
+    }
+}
+
+void Socket::destroyConnection(std::unique_ptr<Connection> connection) {
+    if (connection->thread() == QThread::currentThread()) {
+        connection.reset();
+    } else {
+        // the connection's worker may be in the middle of using it - have the worker delete it once it is done
+        connection.release()->deleteLater();
     }
 }
 
 void Socket::messageReceived(std::unique_ptr<Packet> packet) {
-    if (_messageHandler) {
+    if (QThread::currentThread() != thread()) {
+        queuePendingDelivery({ PendingDelivery::MessagePacket, std::move(packet), SockAddr(), 0 });
+    } else if (_messageHandler) {
         _messageHandler(std::move(packet));
     }
 }
 
 void Socket::messageFailed(Connection* connection, Packet::MessageNumber messageNumber) {
-    if (_messageFailureHandler) {
+    if (QThread::currentThread() != thread()) {
+        queuePendingDelivery({ PendingDelivery::MessageFailure, nullptr, connection->getDestination(), messageNumber });
+    } else if (_messageFailureHandler) {
         _messageFailureHandler(connection->getDestination(), messageNumber);
     }
 }
 
+void Socket::queuePendingDelivery(PendingDelivery delivery) {
+    bool wasEmpty = false;
+    {
+        Lock deliveriesLock(_pendingDeliveriesMutex);
+        wasEmpty = _pendingDeliveries.empty();
+        _pendingDeliveries.push_back(std::move(delivery));
+    }
+
+    // one invocation drains everything queued up until the socket thread gets to it
+    if (wasEmpty) {
+        QMetaObject::invokeMethod(this, "deliverPendingPackets", Qt::QueuedConnection);
+    }
+}
+
+void Socket::deliverPendingPackets() {
+    std::vector<PendingDelivery> deliveries;
+    {
+        Lock deliveriesLock(_pendingDeliveriesMutex);
+        deliveries.swap(_pendingDeliveries);
+    }
+
+    for (auto& delivery : deliveries) {
+        switch (delivery.type) {
+            case PendingDelivery::VerifiedPacket:
+                if (_packetHandler) {
+                    _packetHandler(std::move(delivery.packet));
+                }
+                break;
+            case PendingDelivery::MessagePacket:
+                if (_messageHandler) {
+                    _messageHandler(std::move(delivery.packet));
+                }
+                break;
+            case PendingDelivery::MessageFailure:
+                if (_messageFailureHandler) {
+                    _messageFailureHandler(delivery.sender, delivery.messageNumber);
+                }
+                break;
+        }
+    }
+}
+
 void Socket::checkForReadyReadBackup() {
     if (_networkSocket.hasPendingDatagrams()) {
         qCDebug(networking) << "Socket::checkForReadyReadBackup() detected blocked readyRead signal. Flushing pending datagrams.";
@@ -406,7 +744,7 @@ void Socket::readPendingDatagrams() {
         SockAddr senderSockAddr;
 
         // setup a buffer to read the packet into
-        auto buffer = std::unique_ptr<char[]>(new char[packetSizeWithHeader]);
+        auto buffer = PacketBufferPool::acquire(packetSizeWithHeader);
 
         // pull the datagram
         auto sizeRead = _networkSocket.readDatagram(buffer.get(), packetSizeWithHeader, &senderSockAddr);
@@ -421,106 +759,299 @@ void Socket::readPendingDatagrams() {
             continue;
         }
 
-        auto it = _unfilteredHandlers.find(senderSockAddr);
+        processDatagram(std::move(buffer), packetSizeWithHeader, senderSockAddr, receiveTime);
+
+#if defined(UDT_BATCHED_RECEIVE)
+        // QUdpSocket only re-arms its read notifier once a datagram has been read through it, so the first UDP datagram
+        // of each readyRead is read above and whatever else is waiting is drained in batches
+        if (senderSockAddr.getType() == SocketType::UDP && _batchReceiver.isSupported()) {
+            readBatchedDatagrams(abortTime);
+        }
+#endif
+    }
+}
 
-        if (it != _unfilteredHandlers.end()) {
-            // we have a registered unfiltered handler for this SockAddr - call that and return
-            if (it->second) {
-                auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-                basePacket->setReceiveTime(receiveTime);
-                it->second(std::move(basePacket));
+#if defined(UDT_BATCHED_RECEIVE)
+void Socket::readBatchedDatagrams(std::chrono::system_clock::time_point abortTime) {
+    auto socketDescriptor = _networkSocket.socketDescriptor(SocketType::UDP);
+    int numReceived = 0;
+
+    while (std::chrono::system_clock::now() <= abortTime &&
+           (numReceived = _batchReceiver.receive(socketDescriptor)) > 0) {
+        // all of the datagrams in a batch share the same receive time
+        auto receiveTime = p_high_resolution_clock::now();
+
+        for (int i = 0; i < numReceived; ++i) {
+            auto sizeRead = _batchReceiver.getSize(i);
+            auto senderSockAddr = _batchReceiver.getSenderSockAddr(i);
+
+            _lastPacketSizeRead = sizeRead;
+            _lastPacketSockAddr = senderSockAddr;
+
+            if (sizeRead <= 0) {
+                // empty or truncated datagram - drop it and leave its buffer in the ring
+                continue;
             }
 
-            continue;
+            processDatagram(_batchReceiver.takeBuffer(i), sizeRead, senderSockAddr, receiveTime);
         }
 
-        // check if this was a control packet or a data packet
-        bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+        if (numReceived < BatchReceiver::MAX_BATCH_SIZE) {
+            // the socket has been drained
+            break;
+        }
+    }
+}
+#endif
 
-        if (isControlPacket) {
-            // setup a control packet from the data we just read
-            auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            controlPacket->setReceiveTime(receiveTime);
+void Socket::processDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader, const SockAddr& senderSockAddr,
+                             p_high_resolution_clock::time_point receiveTime) {
+    auto it = _unfilteredHandlers.find(senderSockAddr);
 
-            // move this control packet to the matching connection, if there is one
-            auto connection = findOrCreateConnection(senderSockAddr, true);
+    if (it != _unfilteredHandlers.end()) {
+        // we have a registered unfiltered handler for this SockAddr - call that and return
+        if (it->second) {
+            auto basePacket = BasePacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+            basePacket->setReceiveTime(receiveTime);
+            it->second(std::move(basePacket));
+        }
+
+        return;
+    }
+
+    // check if this was a control packet or a data packet
+    bool isControlPacket = *reinterpret_cast<uint32_t*>(buffer.get()) & CONTROL_BIT_MASK;
+
+    if (isControlPacket) {
+        // setup a control packet from the data we just read
+        auto controlPacket = ControlPacket::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        controlPacket->setReceiveTime(receiveTime);
+
+        // move this control packet to the matching connection, if there is one, on the thread that owns it
+        auto rawControlPacket = controlPacket.release();
+        runOnConnectionShard(shardForSockAddr(senderSockAddr), [this, rawControlPacket] {
+            std::unique_ptr<ControlPacket> controlPacket(rawControlPacket);
+            auto connection = findOrCreateConnection(controlPacket->getSenderSockAddr(), true);
 
             if (connection) {
                 connection->processControl(move(controlPacket));
             }
+        });
+
+    } else {
+        // setup a Packet from the data we just read
+        auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
+        packet->setReceiveTime(receiveTime);
+
+        // save the sequence number in case this is the packet that sticks readyRead
+        _lastReceivedSequenceNumber = packet->getSequenceNumber();
+
+        // call our verification operator to see if this packet is verified
+        if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
+            if (packet->isVerificationDeferred() || hasPacketsPendingVerification(senderSockAddr)) {
+                // the filter left the expensive part of its checks for the verification workers, and the packets from a
+                // sender that has some waiting for them wait as well, to stay in order
+                queueForVerification(std::move(packet));
+            } else {
+                processFilteredPacket(std::move(packet));
+            }
+        }
+    }
+}
+
+bool Socket::verifyPacket(const Packet& packet) const {
+    return !packet.isVerificationDeferred() || (_packetVerifier && _packetVerifier(packet));
+}
+
+Socket::VerificationWorker& Socket::verificationWorkerForSockAddr(const SockAddr& sockAddr) {
+    return *_verificationWorkers[std::hash<SockAddr>()(sockAddr) % _verificationWorkers.size()];
+}
+
+bool Socket::hasPacketsPendingVerification(const SockAddr& sockAddr) {
+    return !_verificationWorkers.empty() && *verificationWorkerForSockAddr(sockAddr).numPendingPackets > 0;
+}
+
+void Socket::queueForVerification(std::unique_ptr<Packet> packet) {
+    if (_verificationWorkers.empty()) {
+        if (verifyPacket(*packet)) {
+            processFilteredPacket(std::move(packet));
+        }
+        return;
+    }
+
+    auto& worker = verificationWorkerForSockAddr(packet->getSenderSockAddr());
 
+    bool wasEmpty = false;
+    {
+        Lock pendingPacketsLock(worker.mutex);
+        wasEmpty = worker.pendingPackets.empty();
+        worker.pendingPackets.push_back(std::move(packet));
+        ++(*worker.numPendingPackets);
+    }
+
+    // one invocation verifies everything queued up until the worker gets to it
+    if (wasEmpty) {
+        auto workerPointer = &worker;
+        QMetaObject::invokeMethod(worker.executor, [this, workerPointer] {
+            verifyPendingPackets(*workerPointer);
+        }, Qt::QueuedConnection);
+    }
+}
+
+void Socket::verifyPendingPackets(VerificationWorker& worker) {
+    std::vector<std::unique_ptr<Packet>> packets;
+    {
+        Lock pendingPacketsLock(worker.mutex);
+        packets.swap(worker.pendingPackets);
+    }
+
+    for (auto& packet : packets) {
+        if (verifyPacket(*packet)) {
+            processFilteredPacket(std::move(packet), worker.numPendingPackets);
         } else {
-            // setup a Packet from the data we just read
-            auto packet = Packet::fromReceivedPacket(std::move(buffer), packetSizeWithHeader, senderSockAddr);
-            packet->setReceiveTime(receiveTime);
+            --(*worker.numPendingPackets);
+        }
+    }
+}
 
-            // save the sequence number in case this is the packet that sticks readyRead
-            _lastReceivedSequenceNumber = packet->getSequenceNumber();
+void Socket::processFilteredPacket(std::unique_ptr<Packet> packet, std::shared_ptr<std::atomic<int>> numPendingPackets) {
+    const auto& senderSockAddr = packet->getSenderSockAddr();
+
+    // a packet from a verification worker counts as pending until it is handed on, so that a later one from the same
+    // sender that doesn't need verifying can't overtake it
+    if (packet->isReliable() || packet->isPartOfMessage()) {
+        // reliable and message packets change the state of their connection, so they are processed
+        // on the thread that owns it
+        auto rawPacket = packet.release();
+        runOnConnectionShard(shardForSockAddr(senderSockAddr), [this, rawPacket, numPendingPackets] {
+            processReceivedPacket(std::unique_ptr<Packet>(rawPacket));
+            if (numPendingPackets) {
+                --(*numPendingPackets);
+            }
+        });
+    } else {
+        // the connection stats are only touched on the thread that owns the connection
+        auto wireSize = packet->getWireSize();
+        auto payloadSize = packet->getPayloadSize();
+        runOnConnectionShard(shardForSockAddr(senderSockAddr), [this, senderSockAddr, wireSize, payloadSize] {
+            auto connection = findOrCreateConnection(senderSockAddr, true);
+            if (connection) {
+                connection->recordReceivedUnreliablePackets(wireSize, payloadSize);
+            }
+        });
+
+        deliverVerifiedPacket(std::move(packet));
+        if (numPendingPackets) {
+            --(*numPendingPackets);
+        }
+    }
+}
+
+void Socket::deliverVerifiedPacket(std::unique_ptr<Packet> packet) {
+    bool hasPendingDeliveries = false;
+    if (QThread::currentThread() == thread()) {
+        Lock deliveriesLock(_pendingDeliveriesMutex);
+        hasPendingDeliveries = !_pendingDeliveries.empty();
+    }
 
-            // call our verification operator to see if this packet is verified
-            if (!_packetFilterOperator || _packetFilterOperator(*packet)) {
-                auto connection = findOrCreateConnection(senderSockAddr, true);
+    // packets handed on from other threads, and those that would overtake them, go through the socket thread's queue
+    if (QThread::currentThread() != thread() || hasPendingDeliveries) {
+        queuePendingDelivery({ PendingDelivery::VerifiedPacket, std::move(packet), SockAddr(), 0 });
+    } else if (_packetHandler) {
+        // call the verified packet callback to let it handle this packet
+        _packetHandler(std::move(packet));
+    }
+}
 
-                if (packet->isReliable()) {
-                    // if this was a reliable packet then signal the matching connection with the sequence number
+void Socket::processReceivedPacket(std::unique_ptr<Packet> packet) {
+    auto connection = findOrCreateConnection(packet->getSenderSockAddr(), true);
 
-                    if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
-                                                                                  packet->getDataSize(),
-                                                                                  packet->getPayloadSize())) {
-                        // the connection could not be created or indicated that we should not continue processing this packet
+    if (packet->isReliable()) {
+        // if this was a reliable packet then signal the matching connection with the sequence number
+
+        if (!connection || !connection->processReceivedSequenceNumber(packet->getSequenceNumber(),
+                                                                      packet->getDataSize(),
+                                                                      packet->getPayloadSize())) {
+            // the connection could not be created or indicated that we should not continue processing this packet
 #ifdef UDT_CONNECTION_DEBUG
-                        qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
-                            << ", type" << NLPacket::typeInHeader(*packet);
+            qCDebug(networking) << "Can't process packet: version" << (unsigned int)NLPacket::versionInHeader(*packet)
+                << ", type" << NLPacket::typeInHeader(*packet);
 #endif
-                        continue;
-                    }
-                } else if (connection) {
-                    connection->recordReceivedUnreliablePackets(packet->getWireSize(),
-                                                                packet->getPayloadSize());
-                }
+            return;
+        }
+    } else if (connection) {
+        connection->recordReceivedUnreliablePackets(packet->getWireSize(),
+                                                    packet->getPayloadSize());
+    }
 
-                if (packet->isPartOfMessage()) {
-                    auto connection = findOrCreateConnection(senderSockAddr, true);
-                    if (connection) {
-                        connection->queueReceivedMessagePacket(std::move(packet));
-                    }
-                } else if (_packetHandler) {
-                    // call the verified packet callback to let it handle this packet
-                    _packetHandler(std::move(packet));
-                }
-            }
+    if (packet->isPartOfMessage()) {
+        if (connection) {
+            connection->queueReceivedMessagePacket(std::move(packet));
         }
+    } else {
+        deliverVerifiedPacket(std::move(packet));
     }
 }
 
 void Socket::connectToSendSignal(const SockAddr& destinationAddr, QObject* receiver, const char* slot) {
-    Lock connectionsLock(_connectionsHashMutex);
-    auto it = _connectionsHash.find(destinationAddr);
-    if (it != _connectionsHash.end()) {
+    auto& shard = shardForSockAddr(destinationAddr);
+    Lock connectionsLock(shard.mutex);
+    auto it = shard.connections.find(destinationAddr);
+    if (it != shard.connections.end()) {
         connect(it->second.get(), SIGNAL(packetSent()), receiver, slot);
     }
 }
 
 void Socket::setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory) {
     // swap the current unique_ptr for the new factory
+    Lock ccFactoryLock(_ccFactoryMutex);
     _ccFactory.swap(ccFactory);
 }
 
+std::unique_ptr<CongestionControlVirtualFactory> Socket::createCongestionControlFactory(const QString& name) {
+    if (name.isEmpty() || name == "vegas") {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<TCPVegasCC>());
+    } else if (name == "bbr") {
+        return std::unique_ptr<CongestionControlVirtualFactory>(new CongestionControlFactory<BBRCC>());
+    }
+    return nullptr;
+}
+
+bool Socket::setCongestionControl(const QString& name) {
+    auto ccFactory = createCongestionControlFactory(name);
+    if (!ccFactory) {
+        qCWarning(networking) << "Unknown congestion control" << name << "- keeping the current one";
+        return false;
+    }
+
+    setCongestionControlFactory(std::move(ccFactory));
+    qCDebug(networking) << "New connections use" << (name.isEmpty() ? "vegas" : name) << "congestion control";
+    return true;
+}
+
 
 void Socket::setConnectionMaxBandwidth(int maxBandwidth) {
-    qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
-            << _connectionsHash.size() << "live connections)";
     _maxBandwidth = maxBandwidth;
-    Lock connectionsLock(_connectionsHashMutex);
-    for (auto& pair : _connectionsHash) {
-        auto& connection = pair.second;
-        connection->setMaxBandwidth(_maxBandwidth);
+
+    size_t numConnections = 0;
+    for (auto& shard : _connectionShards) {
+        Lock connectionsLock(shard.mutex);
+        numConnections += shard.connections.size();
+        for (auto& pair : shard.connections) {
+            auto& connection = pair.second;
+            connection->setMaxBandwidth(_maxBandwidth);
+        }
     }
+
+    qInfo() << "Setting socket's maximum bandwith to" << maxBandwidth << "bps. ("
+            << numConnections << "live connections)";
 }
 
 ConnectionStats::Stats Socket::sampleStatsForConnection(const SockAddr& destination) {
-    auto it = _connectionsHash.find(destination);
-    if (it != _connectionsHash.end()) {
+    auto& shard = shardForSockAddr(destination);
+    Lock connectionsLock(shard.mutex);
+    auto it = shard.connections.find(destination);
+    if (it != shard.connections.end()) {
         return it->second->sampleStats();
     } else {
         return ConnectionStats::Stats();
@@ -529,11 +1060,12 @@ ConnectionStats::Stats Socket::sampleStatsForConnection(const SockAddr& destinat
 
 Socket::StatsVector Socket::sampleStatsForAllConnections() {
     StatsVector result;
-    Lock connectionsLock(_connectionsHashMutex);
 
-    result.reserve(_connectionsHash.size());
-    for (const auto& connectionPair : _connectionsHash) {
-        result.emplace_back(connectionPair.first, connectionPair.second->sampleStats());
+    for (auto& shard : _connectionShards) {
+        Lock connectionsLock(shard.mutex);
+        for (const auto& connectionPair : shard.connections) {
+            result.emplace_back(connectionPair.first, connectionPair.second->sampleStats());
+        }
     }
     return result;
 }
@@ -541,12 +1073,12 @@ Socket::StatsVector Socket::sampleStatsForAllConnections() {
 
 std::vector<SockAddr> Socket::getConnectionSockAddrs() {
     std::vector<SockAddr> addr;
-    Lock connectionsLock(_connectionsHashMutex);
-
-    addr.reserve(_connectionsHash.size());
 
-    for (const auto& connectionPair : _connectionsHash) {
-        addr.push_back(connectionPair.first);
+    for (auto& shard : _connectionShards) {
+        Lock connectionsLock(shard.mutex);
+        for (const auto& connectionPair : shard.connections) {
+            addr.push_back(connectionPair.first);
+        }
     }
     return addr;
 }
@@ -581,27 +1113,52 @@ void Socket::handleStateChanged(SocketType socketType, QAbstractSocket::SocketSt
 }
 
 void Socket::handleRemoteAddressChange(SockAddr previousAddress, SockAddr currentAddress) {
+    auto& previousShard = shardForSockAddr(previousAddress);
+    QObject* previousExecutor = previousShard.executor;
+    if (previousExecutor->thread() != QThread::currentThread()) {
+        // the connection can only be handed to another thread by the thread that owns it
+        QMetaObject::invokeMethod(previousExecutor, [this, previousAddress, currentAddress] {
+            handleRemoteAddressChange(previousAddress, currentAddress);
+        }, Qt::QueuedConnection);
+        return;
+    }
+
+    std::unique_ptr<Connection> connection;
     {
-        Lock connectionsLock(_connectionsHashMutex);
+        Lock connectionsLock(previousShard.mutex);
 
-        const auto connectionIter = _connectionsHash.find(previousAddress);
+        const auto connectionIter = previousShard.connections.find(previousAddress);
         // Don't move classes that are unused so far.
-        if (connectionIter != _connectionsHash.end() && connectionIter->second->hasReceivedHandshake()) {
-            auto connection = move(connectionIter->second);
-            _connectionsHash.erase(connectionIter);
-            connection->setDestinationAddress(currentAddress);
-            _connectionsHash[currentAddress] = move(connection);
-            connectionsLock.unlock();
-            qCDebug(networking) << "Moved Connection class from" << previousAddress << "to" << currentAddress;
-
-            Lock sequenceNumbersLock(_unreliableSequenceNumbersMutex);
-            const auto sequenceNumbersIter = _unreliableSequenceNumbers.find(previousAddress);
-            if (sequenceNumbersIter != _unreliableSequenceNumbers.end()) {
-                auto sequenceNumbers = sequenceNumbersIter->second;
-                _unreliableSequenceNumbers.erase(sequenceNumbersIter);
-                _unreliableSequenceNumbers[currentAddress] = sequenceNumbers;
-            }
+        if (connectionIter != previousShard.connections.end() && connectionIter->second->hasReceivedHandshake()) {
+            connection = move(connectionIter->second);
+            previousShard.connections.erase(connectionIter);
+        }
+    }
 
+    if (connection) {
+        connection->setDestinationAddress(currentAddress);
+
+        // the new address may hash to a shard owned by another thread
+        auto& currentShard = shardForSockAddr(currentAddress);
+        std::unique_ptr<Connection> replacedConnection;
+        {
+            Lock connectionsLock(currentShard.mutex);
+            connection->moveToThread(currentShard.executor.load()->thread());
+            auto& slot = currentShard.connections[currentAddress];
+            replacedConnection = move(slot);
+            slot = move(connection);
+        }
+        if (replacedConnection) {
+            destroyConnection(move(replacedConnection));
+        }
+        qCDebug(networking) << "Moved Connection class from" << previousAddress << "to" << currentAddress;
+
+        Lock sequenceNumbersLock(_unreliableSequenceNumbersMutex);
+        const auto sequenceNumbersIter = _unreliableSequenceNumbers.find(previousAddress);
+        if (sequenceNumbersIter != _unreliableSequenceNumbers.end()) {
+            auto sequenceNumbers = sequenceNumbersIter->second;
+            _unreliableSequenceNumbers.erase(sequenceNumbersIter);
+            _unreliableSequenceNumbers[currentAddress] = sequenceNumbers;
         }
     }
 }
@@ -15,18 +15,27 @@
 #ifndef hifi_Socket_h
 #define hifi_Socket_h
 
+#include <array>
+#include <atomic>
+#include <chrono>
 #include <functional>
 #include <unordered_map>
 #include <mutex>
 #include <list>
+#include <memory>
+#include <vector>
 
 #include <QtCore/QObject>
+#include <QtCore/QThread>
 #include <QtCore/QTimer>
 
 #include "../SockAddr.h"
+#include "BBRCC.h"
 #include "TCPVegasCC.h"
 #include "Connection.h"
 #include "NetworkSocket.h"
+#include "BatchReceiver.h"
+#include "BatchSender.h"
 
 //#define UDT_CONNECTION_DEBUG
 
@@ -55,8 +64,34 @@ class Socket : public QObject {
 
 public:
     using StatsVector = std::vector<std::pair<SockAddr, ConnectionStats::Stats>>;
+
+    // While a SendBatch is in scope, UDP datagrams written to the socket from the creating thread are coalesced
+    // and flushed with as few system calls as possible when it goes out of scope (or when the batch fills up).
+    // Nested SendBatches on the same thread are no-ops.
+    class SendBatch {
+    public:
+        SendBatch(Socket& socket);
+        ~SendBatch();
+
+        SendBatch(const SendBatch&) = delete;
+        SendBatch& operator=(const SendBatch&) = delete;
+
+    private:
+        Socket* _socket { nullptr };
+    };
+
+    struct SendBatchStats {
+        quint64 numSendCalls { 0 };
+        quint64 numDatagrams { 0 };
+    };
+
+    // the connection table is split into this many shards by SockAddr hash - each shard has its own lock and all
+    // of the work for the connections in a shard runs on a single thread
+    static const int NUM_CONNECTION_SHARDS = 16;
+    static const int MAX_VERIFICATION_WORKERS = 16;
  
     Socket(QObject* object = 0, bool shouldChangeSocketOptions = true);
+    ~Socket();
     
     quint16 localPort(SocketType socketType) const { return _networkSocket.localPort(socketType); }
     
@@ -73,6 +108,8 @@ public:
     void rebind(SocketType socketType);
 
     void setPacketFilterOperator(PacketFilterOperator filterOperator) { _packetFilterOperator = filterOperator; }
+    // finishes the checks of packets the filter operator deferred - runs on the verification workers
+    void setPacketVerifier(PacketFilterOperator verifier) { _packetVerifier = verifier; }
     void setPacketHandler(PacketHandler handler) { _packetHandler = handler; }
     void setMessageHandler(MessageHandler handler) { _messageHandler = handler; }
     void setMessageFailureHandler(MessageFailureHandler handler) { _messageFailureHandler = handler; }
@@ -83,7 +120,26 @@ public:
         { _unfilteredHandlers[senderSockAddr] = handler; }
     
     void setCongestionControlFactory(std::unique_ptr<CongestionControlVirtualFactory> ccFactory);
+    // picks the congestion control for connections created from now on by name - "vegas" (the default) or "bbr"
+    bool setCongestionControl(const QString& name);
+    static std::unique_ptr<CongestionControlVirtualFactory> createCongestionControlFactory(const QString& name);
     void setConnectionMaxBandwidth(int maxBandwidth);
+    void setSegmentationOffloadEnabled(bool enabled) { _isSegmentationOffloadEnabled = enabled; }
+
+    // hands control packet and reliable/message packet processing for the connection shards off to numWorkers
+    // threads (at most NUM_CONNECTION_SHARDS) - with no workers all of it runs on the socket thread
+    // packet and message handlers are always called on the socket thread
+    Q_INVOKABLE void setConnectionWorkerCount(int numWorkers);
+
+    // hands packets whose filter marked them as verification deferred off to numWorkers threads (at most
+    // MAX_VERIFICATION_WORKERS) to run the packet verifier on - each sender's packets always go to the same worker,
+    // so they stay in order. With no workers the filter operator is expected to not defer anything.
+    Q_INVOKABLE void setVerificationWorkerCount(int numWorkers);
+    int getVerificationWorkerCount() const { return _numVerificationWorkers; }
+
+    // totals for datagrams written through a SendBatch - numDatagrams / numSendCalls is the number of packets
+    // carried by each system call
+    SendBatchStats getSendBatchStats() const { return { _numBatchedSendCalls, _numBatchedDatagrams }; }
 
     void messageReceived(std::unique_ptr<Packet> packet);
     void messageFailed(Connection* connection, Packet::MessageNumber messageNumber);
@@ -108,14 +164,75 @@ public slots:
 
 private slots:
     void readPendingDatagrams();
+    void deliverPendingPackets();
     void checkForReadyReadBackup();
 
     void handleSocketError(SocketType socketType, QAbstractSocket::SocketError socketError);
     void handleStateChanged(SocketType socketType, QAbstractSocket::SocketState socketState);
 
 private:
+    struct ConnectionShard {
+        Mutex mutex;
+        std::unordered_map<SockAddr, std::unique_ptr<Connection>> connections;
+
+        // the object whose thread runs the work for this shard - the socket itself, or a connection worker
+        std::atomic<QObject*> executor { nullptr };
+    };
+
+    // a thread that runs the connection work of some of the shards
+    struct ConnectionWorker {
+        QThread* thread;
+        QObject* executor;
+    };
+
+    // a thread that runs the packet verifier, and the packets waiting for it
+    struct VerificationWorker {
+        QThread* thread { nullptr };
+        QObject* executor { nullptr };
+
+        Mutex mutex;
+        std::vector<std::unique_ptr<Packet>> pendingPackets;
+        // queued, or verified and not yet handed on - shared with the connection tasks that hand packets on
+        std::shared_ptr<std::atomic<int>> numPendingPackets { std::make_shared<std::atomic<int>>(0) };
+    };
+
+    // a packet or message failure produced on a connection worker, waiting to be handed to the socket thread
+    struct PendingDelivery {
+        enum Type { VerifiedPacket, MessagePacket, MessageFailure };
+
+        Type type;
+        std::unique_ptr<Packet> packet;
+        SockAddr sender;
+        Packet::MessageNumber messageNumber { 0 };
+    };
+
     void setSystemBufferSizes(SocketType socketType);
+    void processDatagram(PacketBuffer buffer, qint64 packetSizeWithHeader, const SockAddr& senderSockAddr,
+                         p_high_resolution_clock::time_point receiveTime);
+#if defined(UDT_BATCHED_SEND)
+    bool queueBatchedDatagram(const QByteArray& datagram, const SockAddr& sockAddr);
+    void flushSendBatch();
+#endif
+#if defined(UDT_BATCHED_RECEIVE)
+    void readBatchedDatagrams(std::chrono::system_clock::time_point abortTime);
+#endif
     Connection* findOrCreateConnection(const SockAddr& sockAddr, bool filterCreation = false);
+
+    ConnectionShard& shardForSockAddr(const SockAddr& sockAddr);
+    void runOnConnectionShard(ConnectionShard& shard, std::function<void()> task);
+    void processReceivedPacket(std::unique_ptr<Packet> packet);
+    void processFilteredPacket(std::unique_ptr<Packet> packet,
+                               std::shared_ptr<std::atomic<int>> numPendingPackets = nullptr);
+    void queueForVerification(std::unique_ptr<Packet> packet);
+    bool verifyPacket(const Packet& packet) const;
+    VerificationWorker& verificationWorkerForSockAddr(const SockAddr& sockAddr);
+    bool hasPacketsPendingVerification(const SockAddr& sockAddr);
+    void deliverVerifiedPacket(std::unique_ptr<Packet> packet);
+    void verifyPendingPackets(VerificationWorker& worker);
+    void stopVerificationWorkers(std::vector<std::unique_ptr<VerificationWorker>>& workers);
+    void destroyConnection(std::unique_ptr<Connection> connection);
+    void retireConnectionWorkers(const std::vector<ConnectionWorker>& workers);
+    void queuePendingDelivery(PendingDelivery delivery);
    
     // privatized methods used by UDTTest - they are private since they must be called on the Socket thread
     ConnectionStats::Stats sampleStatsForConnection(const SockAddr& destination);
@@ -123,27 +240,42 @@ private:
     std::vector<SockAddr> getConnectionSockAddrs();
     void connectToSendSignal(const SockAddr& destinationAddr, QObject* receiver, const char* slot);
     
-    Q_INVOKABLE void writeReliablePacket(Packet* packet, const SockAddr& sockAddr);
-    Q_INVOKABLE void writeReliablePacketList(PacketList* packetList, const SockAddr& sockAddr);
+    void writeReliablePacket(Packet* packet, const SockAddr& sockAddr);
+    void writeReliablePacketList(PacketList* packetList, const SockAddr& sockAddr);
     
     NetworkSocket _networkSocket;
+    BatchReceiver _batchReceiver;
     PacketFilterOperator _packetFilterOperator;
+    PacketFilterOperator _packetVerifier;
     PacketHandler _packetHandler;
     MessageHandler _messageHandler;
     MessageFailureHandler _messageFailureHandler;
     ConnectionCreationFilterOperator _connectionCreationFilterOperator;
 
     Mutex _unreliableSequenceNumbersMutex;
-    Mutex _connectionsHashMutex;
 
     std::unordered_map<SockAddr, BasePacketHandler> _unfilteredHandlers;
     std::unordered_map<SockAddr, SequenceNumber> _unreliableSequenceNumbers;
-    std::unordered_map<SockAddr, std::unique_ptr<Connection>> _connectionsHash;
+
+    std::array<ConnectionShard, NUM_CONNECTION_SHARDS> _connectionShards;
+    std::vector<ConnectionWorker> _connectionWorkers; // only used on the socket thread
+    std::vector<ConnectionWorker> _retiringConnectionWorkers; // still running what was posted before their shards moved
+
+    std::vector<std::unique_ptr<VerificationWorker>> _verificationWorkers; // only used on the socket thread
+    std::atomic<int> _numVerificationWorkers { 0 };
+
+    Mutex _pendingDeliveriesMutex;
+    std::vector<PendingDelivery> _pendingDeliveries;
 
     QTimer* _readyReadBackupTimer { nullptr };
 
     int _maxBandwidth { -1 };
 
+    std::atomic<bool> _isSegmentationOffloadEnabled { false };
+    std::atomic<quint64> _numBatchedSendCalls { 0 };
+    std::atomic<quint64> _numBatchedDatagrams { 0 };
+
+    Mutex _ccFactoryMutex; // connections can be created on the connection worker threads
     std::unique_ptr<CongestionControlVirtualFactory> _ccFactory { new CongestionControlFactory<TCPVegasCC>() };
 
     bool _shouldChangeSocketOptions { true };
@@ -47,12 +47,15 @@
 #include <ViewFrustum.h>
 
 #include "OctreeConstants.h"
+#include "OctreeJournal.h"
 #include "OctreeLogging.h"
 #include "OctreeQueryNode.h"
+#include "OctreeSnapshot.h"
 #include "OctreeUtils.h"
 #include "OctreeEntitiesFileParser.h"
 
-QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz"};
+const QString SNAPSHOT_FILE_TYPE = "bin";
+QVector<QString> PERSIST_EXTENSIONS = {"json", "json.gz", SNAPSHOT_FILE_TYPE};
 
 Octree::Octree(bool shouldReaverage) :
     _rootElement(NULL),
@@ -675,6 +678,9 @@ bool Octree::readFromFile(const char* fileName) {
     if (qFileName.endsWith(".json.gz")) {
         return readJSONFromGzippedFile(qFileName);
     }
+    if (qFileName.endsWith("." + SNAPSHOT_FILE_TYPE)) {
+        return readFromSnapshotFile(qFileName);
+    }
 
     QFile file(qFileName);
 
@@ -714,6 +720,26 @@ bool Octree::readJSONFromGzippedFile(QString qFileName) {
     return readJSONFromStream(-1, jsonStream, false, relativeURL);
 }
 
+bool Octree::readFromSnapshotFile(const QString& qFileName, const QString& journalFileName) {
+    OctreeSnapshotReader snapshot;
+    if (!snapshot.open(qFileName, expectedDataPacketType())) {
+        return false;
+    }
+
+    _persistID = snapshot.getID();
+    _persistDataVersion = snapshot.getDataVersion();
+
+    // the changes made since the snapshot are replayed on top of it
+    OctreeJournalReader journal;
+    bool hasJournal = !journalFileName.isEmpty() &&
+        journal.open(journalFileName, expectedDataPacketType(), snapshot.getID(), snapshot.getDataVersion());
+    if (hasJournal) {
+        qCDebug(octree) << "Replaying" << journal.getNumRecords() << "changes from" << journalFileName;
+        _persistDataVersion = journal.getDataVersion();
+    }
+    return readFromSnapshot(snapshot, hasJournal ? &journal : nullptr);
+}
+
 bool Octree::readFromURL(
     const QString& urlString,
     const bool isObservable,
@@ -848,6 +874,8 @@ bool Octree::writeToFile(const char* fileName, const OctreeElementPointer& eleme
         success = writeToJSONFile(cFileName, element);
     } else if (persistAsFileType == "json.gz") {
         success = writeToJSONFile(cFileName, element, true);
+    } else if (persistAsFileType == SNAPSHOT_FILE_TYPE && !element) {
+        success = writeToSnapshotFile(cFileName);
     } else {
         qCDebug(octree) << "unable to write octree to file of type" << persistAsFileType;
     }
@@ -953,6 +981,28 @@ bool Octree::writeToJSONFile(const char* fileName, const OctreeElementPointer& e
     return success;
 }
 
+bool Octree::writeToSnapshotFile(const char* fileName) {
+    qCDebug(octree, "Saving snapshot to file %s...", fileName);
+
+    OctreeSnapshotWriter snapshot;
+    if (!writeToSnapshot(snapshot)) {
+        return false;
+    }
+    return snapshot.writeToFile(fileName, expectedDataPacketType(), _persistID, _persistDataVersion);
+}
+
+bool Octree::createJournalFile(const QString& fileName) {
+    return OctreeJournalWriter::createFile(fileName, expectedDataPacketType(), _persistID, _persistDataVersion);
+}
+
+bool Octree::appendToJournalFile(const QString& fileName, quint64 sinceTime) {
+    OctreeJournalWriter journal;
+    if (!writeToJournal(journal, sinceTime)) {
+        return false;
+    }
+    return journal.appendToFile(fileName, _persistDataVersion);
+}
+
 uint64_t Octree::getOctreeElementsCount() {
     uint64_t nodeCount = 0;
     recurseTreeWithOperation(countOctreeElementsOperation, &nodeCount);
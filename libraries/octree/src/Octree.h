@@ -12,6 +12,7 @@
 #ifndef hifi_Octree_h
 #define hifi_Octree_h
 
+#include <atomic>
 #include <memory>
 #include <set>
 #include <stdint.h>
@@ -33,11 +34,16 @@
 class ReadBitstreamToTreeParams;
 class Octree;
 class OctreeElement;
+class OctreeJournalReader;
+class OctreeJournalWriter;
 class OctreePacketData;
+class OctreeSnapshotReader;
+class OctreeSnapshotWriter;
 class Shape;
 using OctreePointer = std::shared_ptr<Octree>;
 
 extern QVector<QString> PERSIST_EXTENSIONS;
+extern const QString SNAPSHOT_FILE_TYPE;
 
 /// derive from this class to use the Octree::recurseTreeWithOperator() method
 class RecurseOctreeOperator {
@@ -139,6 +145,13 @@ public:
     virtual int processEditPacketData(ReceivedMessage& message, const unsigned char* editData, int maxLength,
                                       const SharedNodePointer& sourceNode) { return 0; }
 
+    // Edits that only change items in place, without adding, removing or moving any between elements, can be applied
+    // while holding just the read lock, so that the tree can be traversed meanwhile. Trees that support it apply such an
+    // edit and return true; for any other edit they change nothing and return false, the edit is then applied by
+    // processEditPacketData() under the write lock.
+    virtual bool processEditPacketDataInPlace(ReceivedMessage& message, const unsigned char* editData, int maxLength,
+                                              const SharedNodePointer& sourceNode, int& processedBytes) { return false; }
+
     virtual bool rootElementHasData() const { return false; }
     virtual void releaseSceneEncodeData(OctreeElementExtraEncodeData* extraEncodeData) const { }
 
@@ -210,6 +223,11 @@ public:
     virtual bool writeToMap(QVariantMap& entityDescription, OctreeElementPointer element, bool skipDefaultValues,
                             bool skipThoseWithBadParents) = 0;
     virtual bool writeToJSON(QString& jsonString, const OctreeElementPointer& element) = 0;
+    bool writeToSnapshotFile(const char* filename);
+    virtual bool writeToSnapshot(OctreeSnapshotWriter& snapshot) { return false; }
+    bool createJournalFile(const QString& fileName);
+    bool appendToJournalFile(const QString& fileName, quint64 sinceTime);
+    virtual bool writeToJournal(OctreeJournalWriter& journal, quint64 sinceTime) { return false; }
 
     // Octree importers
     bool readFromFile(const char* filename);
@@ -219,6 +237,8 @@ public:
     bool readJSONFromStream(uint64_t streamLength, QDataStream& inputStream, const bool isImport = false, const QUrl& urlString = QUrl());
     bool readJSONFromGzippedFile(QString qFileName);
     virtual bool readFromMap(QVariantMap& entityDescription, const bool isImport = false) = 0;
+    bool readFromSnapshotFile(const QString& qFileName, const QString& journalFileName = QString());
+    virtual bool readFromSnapshot(const OctreeSnapshotReader& snapshot, const OctreeJournalReader* journal) { return false; }
 
     uint64_t getOctreeElementsCount();
 
@@ -240,6 +260,9 @@ public:
     bool getIsClient() const { return !_isServer; } /// Is this a client based tree. Allows guards for certain operations
     void setIsClient(bool isClient) { _isServer = !isClient; }
 
+    bool getIsJournaled() const { return _isJournaled; } /// Are the changes to this tree being journaled
+    void setIsJournaled(bool isJournaled) { _isJournaled = isJournaled; }
+
     virtual void dumpTree() { }
     virtual void pruneTree() { }
 
@@ -247,6 +270,8 @@ public:
         _persistID = id;
         _persistDataVersion = dataVersion;
     }
+    QUuid getPersistID() const { return _persistID; }
+    int64_t getPersistDataVersion() const { return _persistDataVersion; }
 
     virtual void resetEditStats() { }
     virtual quint64 getAverageDecodeTime() const { return 0; }
@@ -274,11 +299,12 @@ protected:
     QUuid _persistID { QUuid::createUuid() };
     int _persistDataVersion { 0 };
 
-    bool _isDirty;
+    std::atomic<bool> _isDirty; // also set by edits applied under the read lock
     bool _shouldReaverage;
 
     bool _isViewing;
     bool _isServer;
+    bool _isJournaled { false };
 };
 
 #endif // hifi_Octree_h
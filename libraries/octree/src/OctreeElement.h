@@ -224,8 +224,10 @@ protected:
       unsigned char* pointer;
     } _octalCode;
 
-    quint64 _lastChanged; /// Client and server, timestamp this node was last changed, 8 bytes
-    uint64_t _lastChangedContent { 0 };
+    /// Client and server, timestamp this node was last changed, 8 bytes. Atomic, as are the content's, since edits applied
+    /// in place bump them while the tree is traversed
+    std::atomic<quint64> _lastChanged;
+    std::atomic<uint64_t> _lastChangedContent { 0 };
 
     /// Client and server, pointers to child nodes, various encodings
 #ifdef SIMPLE_CHILD_ARRAY
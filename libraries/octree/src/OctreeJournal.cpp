@@ -0,0 +1,205 @@
+//
+//  OctreeJournal.cpp
+//  libraries/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeJournal.h"
+
+#include <cstring>
+
+#ifdef Q_OS_WIN
+#include <io.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <QtCore/QSaveFile>
+
+#include "OctreeLogging.h"
+
+static const quint32 JOURNAL_FILE_MAGIC = 0x4A50534F; // "OSPJ"
+static const quint32 JOURNAL_FILE_VERSION = 1;
+
+struct JournalHeader {
+    quint32 magic;
+    quint32 fileVersion;
+    quint32 dataPacketType;
+    quint32 dataPacketVersion;
+    char snapshotID[16];
+    qint64 snapshotDataVersion;
+};
+
+using RecordSize = quint32;
+static const int RECORD_HEADER_SIZE = sizeof(OctreeJournalRecordType) + sizeof(RecordSize);
+
+static bool readRecord(const unsigned char*& data, const unsigned char* end, OctreeJournalRecordType& type,
+                       const unsigned char*& recordData, RecordSize& size) {
+    if (end - data < RECORD_HEADER_SIZE) {
+        return false;
+    }
+    memcpy(&type, data, sizeof(type));
+    memcpy(&size, data + sizeof(type), sizeof(size));
+    if ((quint64)(end - data - RECORD_HEADER_SIZE) < size) {
+        return false;
+    }
+    recordData = data + RECORD_HEADER_SIZE;
+    data = recordData + size;
+    return true;
+}
+
+// QFile::flush() only hands the data to the OS, a batch isn't durable until it has been synced to disk
+static bool syncToDisk(QFile& file) {
+#ifdef Q_OS_WIN
+    return _commit(file.handle()) == 0;
+#else
+    return fsync(file.handle()) == 0;
+#endif
+}
+
+bool OctreeJournalWriter::createFile(const QString& fileName, PacketType dataPacketType, const QUuid& id,
+                                     int64_t snapshotDataVersion) {
+    JournalHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = JOURNAL_FILE_MAGIC;
+    header.fileVersion = JOURNAL_FILE_VERSION;
+    header.dataPacketType = (quint32)dataPacketType;
+    header.dataPacketVersion = versionForPacketType(dataPacketType);
+    memcpy(header.snapshotID, id.toRfc4122().constData(), sizeof(header.snapshotID));
+    header.snapshotDataVersion = snapshotDataVersion;
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly) ||
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header)) != (qint64)sizeof(header) || !file.commit()) {
+        qCWarning(octree) << "Could not start journal" << fileName << "-" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+void OctreeJournalWriter::appendUpdate(const unsigned char* data, int size) {
+    appendRecord(OctreeJournalRecordType::Update, reinterpret_cast<const char*>(data), size);
+}
+
+void OctreeJournalWriter::appendRemoval(const QUuid& id) {
+    QByteArray encodedID = id.toRfc4122();
+    appendRecord(OctreeJournalRecordType::Removal, encodedID.constData(), encodedID.size());
+}
+
+void OctreeJournalWriter::appendRecord(OctreeJournalRecordType type, const char* data, int size) {
+    RecordSize recordSize = size;
+    _records.append(reinterpret_cast<const char*>(&type), sizeof(type));
+    _records.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    _records.append(data, size);
+    ++_numRecords;
+}
+
+bool OctreeJournalWriter::appendToFile(const QString& fileName, int64_t dataVersion) const {
+    QByteArray batch = _records;
+    OctreeJournalRecordType commitType = OctreeJournalRecordType::Commit;
+    RecordSize commitSize = sizeof(dataVersion);
+    batch.append(reinterpret_cast<const char*>(&commitType), sizeof(commitType));
+    batch.append(reinterpret_cast<const char*>(&commitSize), sizeof(commitSize));
+    batch.append(reinterpret_cast<const char*>(&dataVersion), sizeof(dataVersion));
+
+    // the journal has to have been started, appending to a new file would leave it without a header
+    QFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly | QIODevice::Append | QIODevice::ExistingOnly) ||
+        file.write(batch) != batch.size() || !file.flush() || !syncToDisk(file)) {
+        qCWarning(octree) << "Could not append to journal" << fileName << "-" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+OctreeJournalReader::~OctreeJournalReader() {
+    if (_data) {
+        _file.unmap(const_cast<unsigned char*>(_data));
+    }
+}
+
+bool OctreeJournalReader::open(const QString& fileName, PacketType dataPacketType, const QUuid& id,
+                               int64_t snapshotDataVersion) {
+    _file.setFileName(fileName);
+    if (!_file.exists()) {
+        return false;
+    }
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(octree) << "Could not open journal" << fileName << "-" << _file.errorString();
+        return false;
+    }
+
+    _size = _file.size();
+    if (_size < (qint64)sizeof(JournalHeader)) {
+        qCWarning(octree) << fileName << "is not a journal";
+        return false;
+    }
+
+    _data = _file.map(0, _size);
+    if (!_data) {
+        qCWarning(octree) << "Could not map journal" << fileName << "-" << _file.errorString();
+        return false;
+    }
+
+    JournalHeader header;
+    memcpy(&header, _data, sizeof(header));
+    if (header.magic != JOURNAL_FILE_MAGIC || header.fileVersion != JOURNAL_FILE_VERSION) {
+        qCWarning(octree) << fileName << "is not a journal";
+        return false;
+    }
+    if (header.dataPacketType != (quint32)dataPacketType ||
+        header.dataPacketVersion != (quint32)versionForPacketType(dataPacketType) ||
+        QUuid::fromRfc4122(QByteArray::fromRawData(header.snapshotID, sizeof(header.snapshotID))) != id ||
+        header.snapshotDataVersion != snapshotDataVersion) {
+        // the snapshot was written after the journal was, it already has the changes
+        qCDebug(octree) << "Journal" << fileName << "doesn't follow the current snapshot - it won't be replayed";
+        return false;
+    }
+
+    // find the end of the last committed batch
+    _committedSize = sizeof(header);
+    _dataVersion = snapshotDataVersion;
+    const unsigned char* data = _data + sizeof(header);
+    const unsigned char* end = _data + _size;
+    int numRecordsInBatch = 0;
+    OctreeJournalRecordType type;
+    const unsigned char* recordData;
+    RecordSize size;
+    while (readRecord(data, end, type, recordData, size)) {
+        if (type == OctreeJournalRecordType::Commit && size == sizeof(_dataVersion)) {
+            memcpy(&_dataVersion, recordData, sizeof(_dataVersion));
+            _committedSize = data - _data;
+            _numRecords += numRecordsInBatch;
+            numRecordsInBatch = 0;
+        } else if (type == OctreeJournalRecordType::Update || type == OctreeJournalRecordType::Removal) {
+            ++numRecordsInBatch;
+        } else {
+            break;
+        }
+    }
+
+    if (hasUncommittedRecords()) {
+        qCWarning(octree) << "Journal" << fileName << "ends with" << _size - _committedSize
+            << "bytes that weren't committed - they won't be replayed";
+    }
+    return true;
+}
+
+bool OctreeJournalReader::forEachRecord(const RecordOperation& operation) const {
+    const unsigned char* data = _data + sizeof(JournalHeader);
+    const unsigned char* end = _data + _committedSize;
+    OctreeJournalRecordType type;
+    const unsigned char* recordData;
+    RecordSize size;
+    while (readRecord(data, end, type, recordData, size)) {
+        if (type != OctreeJournalRecordType::Commit && !operation(type, recordData, (int)size)) {
+            return false;
+        }
+    }
+    return true;
+}
@@ -0,0 +1,85 @@
+//
+//  OctreeJournal.h
+//  libraries/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_OctreeJournal_h
+#define overte_OctreeJournal_h
+
+#include <functional>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+#include <udt/PacketHeaders.h>
+
+// An append-only log of the changes made to an octree since its last snapshot.
+//
+// The file is a header naming the snapshot it follows, then batches of records, one batch per persist. A record is the
+// bitstream encoding of an item of the tree that was added or edited, or the ID of one that was removed. Each batch ends
+// with a commit record holding the data version of the tree after it, a batch that didn't make it to disk in full isn't
+// replayed.
+
+enum class OctreeJournalRecordType : quint8 {
+    Update = 0,
+    Removal,
+    Commit
+};
+
+class OctreeJournalWriter {
+public:
+    // Starts a journal that follows the snapshot of the given ID and data version, replacing any previous one
+    static bool createFile(const QString& fileName, PacketType dataPacketType, const QUuid& id, int64_t snapshotDataVersion);
+
+    void appendUpdate(const unsigned char* data, int size);
+    void appendRemoval(const QUuid& id);
+
+    int getNumRecords() const { return _numRecords; }
+
+    // Appends the records to the journal as one batch, which brings the tree to the given data version
+    bool appendToFile(const QString& fileName, int64_t dataVersion) const;
+
+private:
+    void appendRecord(OctreeJournalRecordType type, const char* data, int size);
+
+    QByteArray _records;
+    int _numRecords { 0 };
+};
+
+class OctreeJournalReader {
+public:
+    using RecordOperation = std::function<bool(OctreeJournalRecordType type, const unsigned char* data, int size)>;
+
+    ~OctreeJournalReader();
+
+    // Maps the journal, returns false if there is none or if it doesn't follow the snapshot of the given ID and data version
+    bool open(const QString& fileName, PacketType dataPacketType, const QUuid& id, int64_t snapshotDataVersion);
+
+    // The data version of the tree after the last committed batch
+    int64_t getDataVersion() const { return _dataVersion; }
+    int getNumRecords() const { return _numRecords; }
+
+    // True if the journal ends with a batch that wasn't committed, it has to be started over before it is appended to
+    bool hasUncommittedRecords() const { return _committedSize < _size; }
+
+    // Calls the operation with the updates and removals of the committed batches in order, returns false if the
+    // operation does
+    bool forEachRecord(const RecordOperation& operation) const;
+
+private:
+    QFile _file;
+    const unsigned char* _data { nullptr };
+    qint64 _size { 0 };
+    qint64 _committedSize { 0 };
+    int64_t _dataVersion { 0 };
+    int _numRecords { 0 };
+};
+
+#endif // overte_OctreeJournal_h
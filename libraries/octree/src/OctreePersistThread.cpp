@@ -33,7 +33,9 @@
 #include <PathUtils.h>
 #include <Gzip.h>
 
+#include "OctreeJournal.h"
 #include "OctreeLogging.h"
+#include "OctreeSnapshot.h"
 #include "OctreeUtils.h"
 #include "OctreeDataUtils.h"
 
@@ -43,6 +45,16 @@ constexpr std::chrono::milliseconds TIME_BETWEEN_PROCESSING { 10 };
 constexpr int MAX_OCTREE_REPLACEMENT_BACKUP_FILES_COUNT { 20 };
 constexpr int64_t MAX_OCTREE_REPLACEMENT_BACKUP_FILES_SIZE_BYTES { 50 * 1000 * 1000 };
 
+// the journal is compacted into a new snapshot once it is half the size of the snapshot, or this large or old
+constexpr int64_t MIN_JOURNAL_SIZE_TO_COMPACT_BYTES { 1024 * 1024 };
+constexpr std::chrono::hours MAX_TIME_BETWEEN_COMPACTIONS { 1 };
+
+// the domain server's copy, which its content backups are made from, is a whole JSON encode of the tree - between
+// compactions it's only sent this often, so that persists stay proportional to the changes
+constexpr std::chrono::minutes MIN_TIME_BETWEEN_DOMAIN_SERVER_UPDATES { 10 };
+
+static const QString JOURNAL_FILE_EXTENSION = "journal";
+
 OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& filename, std::chrono::milliseconds persistInterval,
                                          bool debugTimestampNow, QString persistAsFileType) :
     _tree(tree),
@@ -58,6 +70,7 @@ OctreePersistThread::OctreePersistThread(OctreePointer tree, const QString& file
     // in case the persist filename has an extension that doesn't match the file type
     QString sansExt = fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS);
     _filename = sansExt + "." + _persistAsFileType;
+    _journalFilename = sansExt + "." + JOURNAL_FILE_EXTENSION;
 }
 
 void OctreePersistThread::start() {
@@ -73,28 +86,58 @@ void OctreePersistThread::start() {
     auto packet = NLPacket::create(PacketType::OctreeDataFileRequest, -1, true, false);
 
     OctreeUtils::RawOctreeData data;
-    qCDebug(octree) << "Reading octree data from" << _filename;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
-        QByteArray jsonData(file.readAll());
-        file.close();
-        if (!gunzip(jsonData, _cachedJSONData)) {
-            _cachedJSONData = jsonData;
+    bool hasOctreeData { false };
+
+    // the tree is persisted to a binary snapshot, which is the most recent file unless the JSON file was replaced since
+    QString mostRecentFilename = findMostRecentFileExtension(_filename, PERSIST_EXTENSIONS);
+    if (mostRecentFilename.endsWith("." + SNAPSHOT_FILE_TYPE)) {
+        qCDebug(octree) << "Reading octree data from" << mostRecentFilename;
+        OctreeSnapshotReader snapshot;
+        if (snapshot.open(mostRecentFilename, _tree->expectedDataPacketType())) {
+            _snapshotFilename = mostRecentFilename;
+            data.id = snapshot.getID();
+            data.dataVersion = snapshot.getDataVersion();
+            hasOctreeData = true;
+
+            OctreeJournalReader journal;
+            if (journal.open(_journalFilename, _tree->expectedDataPacketType(), snapshot.getID(), snapshot.getDataVersion())) {
+                data.dataVersion = journal.getDataVersion();
+                // a journal that was cut short is started over, by writing a new snapshot
+                _isJournalCurrent = !journal.hasUncommittedRecords();
+            }
+        } else {
+            qCWarning(octree) << "Can't load snapshot" << mostRecentFilename << "- falling back to" << _filename;
         }
+    }
 
-        if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
-            qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
-            packet->writePrimitive(true);
-            auto id = data.id.toRfc4122();
-            packet->write(id);
-            packet->writePrimitive(data.dataVersion);
+    if (!hasOctreeData) {
+        qCDebug(octree) << "Reading octree data from" << _filename;
+        QFile file(_filename);
+        if (file.open(QIODevice::ReadOnly)) {
+            QByteArray jsonData(file.readAll());
+            file.close();
+            if (!gunzip(jsonData, _cachedJSONData)) {
+                _cachedJSONData = jsonData;
+            }
+
+            if (data.readOctreeDataInfoFromData(_cachedJSONData)) {
+                hasOctreeData = true;
+            } else {
+                _cachedJSONData.clear();
+                qCWarning(octree) << "No octree data found";
+            }
         } else {
-            _cachedJSONData.clear();
-            qCWarning(octree) << "No octree data found";
-            packet->writePrimitive(false);
+            qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
         }
+    }
+
+    if (hasOctreeData) {
+        qCDebug(octree) << "Current octree data: ID(" << data.id << ") DataVersion(" << data.dataVersion << ")";
+        packet->writePrimitive(true);
+        auto id = data.id.toRfc4122();
+        packet->write(id);
+        packet->writePrimitive(data.dataVersion);
     } else {
-        qCWarning(octree) << "Couldn't access file" << _filename << file.errorString();
         packet->writePrimitive(false);
     }
 
@@ -116,10 +159,11 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     if (includesNewData) {
         _cachedJSONData.clear();
         replacementData = message->readAll();
-        replaceData(replacementData);
-        hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        if (replaceData(replacementData)) {
+            hasValidOctreeData = data.readOctreeDataInfoFromFile(_filename);
+        }
         qDebug() << "Got OctreeDataFileReply, new data sent";
-    } else {
+    } else if (_snapshotFilename.isEmpty()) {
         qDebug() << "Got OctreeDataFileReply, current entity data is sufficient";
         
         OctreeUtils::RawEntityData data;
@@ -140,6 +184,8 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
                 }
             }
         }
+    } else {
+        qDebug() << "Got OctreeDataFileReply, current entity snapshot is sufficient";
     }
 
     quint64 loadStarted = usecTimestampNow();
@@ -150,22 +196,32 @@ void OctreePersistThread::handleOctreeDataFileReply(QSharedPointer<ReceivedMessa
     }
 
     bool persistentFileRead;
+    bool loadedFromSnapshot = !_snapshotFilename.isEmpty();
 
     _tree->withWriteLock([&] {
         PerformanceWarning warn(true, "Loading Octree File", true);
 
-        if (_cachedJSONData.isEmpty()) {
+        if (loadedFromSnapshot) {
+            persistentFileRead = _tree->readFromSnapshotFile(_snapshotFilename, _journalFilename);
+        } else if (_cachedJSONData.isEmpty()) {
             persistentFileRead = _tree->readFromFile(_filename.toLocal8Bit().constData());
         } else {
             QDataStream jsonStream(_cachedJSONData);
             persistentFileRead = _tree->readFromStream(-1, jsonStream);
         }
         _tree->pruneTree();
+
+        // the changes made from now on go in the journal, if it follows what was loaded
+        _isJournalCurrent = _isJournalCurrent && loadedFromSnapshot && persistentFileRead;
+        _tree->setIsJournaled(_isJournalCurrent);
     });
 
     _cachedJSONData.clear();
+    _snapshotFilename.clear();
     quint64 loadDone = usecTimestampNow();
     _loadTimeUSecs = loadDone - loadStarted;
+    _lastPersistedAt = loadDone;
+    _lastCompaction = std::chrono::steady_clock::now();
 
     _tree->clearDirtyBit(); // the tree is clean since we just loaded it
 
@@ -211,32 +267,52 @@ QString OctreePersistThread::getPersistFileMimeType() const {
     return "";
 }
 
-void OctreePersistThread::replaceData(QByteArray data) {
-    backupCurrentFile();
+bool OctreePersistThread::replaceData(QByteArray data) {
+    // the current content is kept, rather than lost, if it can't be backed up
+    if (!backupCurrentFile()) {
+        qWarning() << "Not replacing the current models, which couldn't be backed up";
+        return false;
+    }
+
+    // the replacement takes the place of the snapshot and its journal, which were moved to backups
+    _snapshotFilename.clear();
+    _isJournalCurrent = false;
 
     QFile currentFile { _filename };
     if (currentFile.open(QIODevice::WriteOnly)) {
         currentFile.write(data);
         qDebug() << "Wrote replacement data";
+        return true;
     } else {
         qWarning() << "Failed to write replacement data";
+        return false;
     }
 }
 
-// Return true if current file is backed up successfully or doesn't exist.
+// Return true if the current files are backed up successfully or don't exist.
 bool OctreePersistThread::backupCurrentFile() {
-    // first take the current models file and move it to a different filename, appended with the timestamp
-    QFile currentFile { _filename };
-    if (currentFile.exists()) {
-        static const QString FILENAME_TIMESTAMP_FORMAT = "yyyyMMdd-hhmmss";
-        auto backupFileName = _filename + ".backup." + QDateTime::currentDateTime().toString(FILENAME_TIMESTAMP_FORMAT);
-
-        if (currentFile.rename(backupFileName)) {
-            qDebug() << "Moved previous models file to" << backupFileName;
-            return true;
-        } else {
-            qWarning() << "Could not backup previous models file to" << backupFileName << "- removing replacement models file";
-            return false;
+    // first take the current models files and move them to a different filename, appended with the timestamp. The current
+    // models are in the snapshot and its journal, unless the models file was replaced since.
+    static const QString FILENAME_TIMESTAMP_FORMAT = "yyyyMMdd-hhmmss";
+    auto backupSuffix = ".backup." + QDateTime::currentDateTime().toString(FILENAME_TIMESTAMP_FORMAT);
+
+    QStringList movedFilenames;
+    for (const auto& filename : { _filename, getSnapshotFilename(), _journalFilename }) {
+        QFile currentFile { filename };
+        if (currentFile.exists()) {
+            auto backupFileName = filename + backupSuffix;
+            if (currentFile.rename(backupFileName)) {
+                qDebug() << "Moved previous models file to" << backupFileName;
+                movedFilenames << filename;
+            } else {
+                qWarning() << "Could not backup previous models file to" << backupFileName;
+
+                // put back the files already moved, so the current models can still be loaded
+                for (const auto& movedFilename : movedFilenames) {
+                    QFile::rename(movedFilename + backupSuffix, movedFilename);
+                }
+                return false;
+            }
         }
     }
     return true;
@@ -260,15 +336,16 @@ void OctreePersistThread::process() {
 void OctreePersistThread::aboutToFinish() {
     qCDebug(octree) << "Persist thread about to finish...";
     persist();
+    if (_hasChangesNotSentToDS) {
+        sendLatestEntityDataToDS();
+    }
     qCDebug(octree) << "Persist thread done with about to finish...";
 }
 
 QByteArray OctreePersistThread::getPersistFileContents() const {
+    // the tree is persisted to a snapshot, JSON is made from the tree as it is now
     QByteArray fileContents;
-    QFile file(_filename);
-    if (file.open(QIODevice::ReadOnly)) {
-        fileContents = file.readAll();
-    }
+    _tree->toJSON(&fileContents, nullptr, _persistAsFileType == "json.gz");
     return fileContents;
 }
 
@@ -302,31 +379,85 @@ void OctreePersistThread::cleanupOldReplacementBackups() {
     qDebug() << "Found" << count << "backups";
 }
 
+QString OctreePersistThread::getSnapshotFilename() const {
+    return fileNameWithoutExtension(_filename, PERSIST_EXTENSIONS) + "." + SNAPSHOT_FILE_TYPE;
+}
+
+bool OctreePersistThread::shouldCompact() const {
+    if (std::chrono::steady_clock::now() - _lastCompaction > MAX_TIME_BETWEEN_COMPACTIONS) {
+        return true;
+    }
+    qint64 maxJournalSize = std::max<qint64>(MIN_JOURNAL_SIZE_TO_COMPACT_BYTES, QFileInfo(getSnapshotFilename()).size() / 2);
+    return QFileInfo(_journalFilename).size() > maxJournalSize;
+}
+
 void OctreePersistThread::persist() {
     if (_tree->isDirty() && _initialLoadComplete) {
+        // the changes made from here on are left for the next persist
+        quint64 persistStartedAt = usecTimestampNow();
+        _tree->incrementPersistDataVersion();
 
-        _tree->withWriteLock([&] {
-            qCDebug(octree) << "pruning Octree before saving...";
-            _tree->pruneTree();
-            qCDebug(octree) << "DONE pruning Octree before saving...";
-        });
+        // only the changes since the last persist are written, to the journal that follows the snapshot
+        if (_isJournalCurrent && !shouldCompact()) {
+            qCDebug(octree) << "Appending Octree changes to:" << _journalFilename;
+            if (_tree->appendToJournalFile(_journalFilename, _lastPersistedAt)) {
+                _tree->clearDirtyBit(); // tree is clean after saving
+                _lastPersistedAt = persistStartedAt;
+                _hasChangesNotSentToDS = true;
+                if (std::chrono::steady_clock::now() - _lastSentToDS > MIN_TIME_BETWEEN_DOMAIN_SERVER_UPDATES) {
+                    sendLatestEntityDataToDS();
+                }
+                return;
+            }
+            qCWarning(octree) << "Failed to append to" << _journalFilename << "- writing a snapshot instead";
+        }
 
-        _tree->incrementPersistDataVersion();
+        compact(persistStartedAt);
+    }
+}
+
+void OctreePersistThread::compact(quint64 persistStartedAt) {
+    _tree->withWriteLock([&] {
+        qCDebug(octree) << "pruning Octree before saving...";
+        _tree->pruneTree();
+        qCDebug(octree) << "DONE pruning Octree before saving...";
+
+        // the deletes made once the snapshot is written go in the new journal
+        _tree->setIsJournaled(true);
+    });
 
-        qCDebug(octree) << "Saving Octree data to:" << _filename;
+    // trees that can be snapshot are persisted to one, which is much quicker to write and load than JSON
+    QString snapshotFilename = getSnapshotFilename();
+    qCDebug(octree) << "Saving Octree data to:" << snapshotFilename;
+    if (_tree->writeToFile(snapshotFilename.toLocal8Bit().constData(), nullptr, SNAPSHOT_FILE_TYPE)) {
+        _isJournalCurrent = _tree->createJournalFile(_journalFilename);
+        _tree->clearDirtyBit(); // tree is clean after saving
+        qCDebug(octree) << "DONE persisting Octree data to" << snapshotFilename;
+    } else {
+        _isJournalCurrent = false;
         if (_tree->writeToFile(_filename.toLocal8Bit().constData(), nullptr, _persistAsFileType)) {
             _tree->clearDirtyBit(); // tree is clean after saving
             qCDebug(octree) << "DONE persisting Octree data to" << _filename;
         } else {
             qCWarning(octree) << "Failed to persist Octree data to" << _filename;
         }
+    }
 
-        sendLatestEntityDataToDS();
+    if (!_isJournalCurrent) {
+        _tree->withWriteLock([&] {
+            _tree->setIsJournaled(false);
+        });
     }
+    _lastPersistedAt = persistStartedAt;
+    _lastCompaction = std::chrono::steady_clock::now();
+
+    sendLatestEntityDataToDS();
 }
 
 void OctreePersistThread::sendLatestEntityDataToDS() {
     qDebug() << "Sending latest entity data to DS";
+    _lastSentToDS = std::chrono::steady_clock::now();
+    _hasChangesNotSentToDS = false;
     auto nodeList = DependencyManager::get<NodeList>();
     const DomainHandler& domainHandler = nodeList->getDomainHandler();
 
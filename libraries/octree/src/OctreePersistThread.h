@@ -60,10 +60,13 @@ protected slots:
 
 protected:
     void persist();
+    void compact(quint64 persistStartedAt);
+    bool shouldCompact() const;
+    QString getSnapshotFilename() const;
     bool backupCurrentFile();
     void cleanupOldReplacementBackups();
 
-    void replaceData(QByteArray data);
+    bool replaceData(QByteArray data);
     void sendLatestEntityDataToDS();
 
 private:
@@ -80,6 +83,14 @@ private:
 
     QString _persistAsFileType;
     QByteArray _cachedJSONData;
+    QString _snapshotFilename; // set while the tree is to be loaded from a snapshot
+
+    QString _journalFilename;
+    bool _isJournalCurrent { false }; // the journal follows the snapshot the tree was last loaded from or saved to
+    quint64 _lastPersistedAt { 0 }; // the changes made since are written by the next persist
+    std::chrono::steady_clock::time_point _lastCompaction;
+    std::chrono::steady_clock::time_point _lastSentToDS;
+    bool _hasChangesNotSentToDS { false }; // journaled since the domain server was last sent the tree
 };
 
 #endif // hifi_OctreePersistThread_h
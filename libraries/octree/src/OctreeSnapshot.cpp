@@ -0,0 +1,178 @@
+//
+//  OctreeSnapshot.cpp
+//  libraries/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "OctreeSnapshot.h"
+
+#include <cstring>
+
+#include <QtCore/QSaveFile>
+
+#include "OctreeLogging.h"
+
+static const quint32 SNAPSHOT_FILE_MAGIC = 0x5350534F; // "OSPS"
+static const quint32 SNAPSHOT_FILE_VERSION = 1;
+
+struct SnapshotHeader {
+    quint32 magic;
+    quint32 fileVersion;
+    quint32 dataPacketType;
+    quint32 dataPacketVersion;
+    char id[16];
+    qint64 dataVersion;
+    quint32 numSections;
+    quint32 reserved;
+};
+
+using RecordSize = quint32;
+
+OctreeSnapshotWriter::OctreeSnapshotWriter(int maxRecordsPerSection) :
+    _maxRecordsPerSection(maxRecordsPerSection)
+{
+}
+
+void OctreeSnapshotWriter::appendRecord(quint32 key, const unsigned char* data, int size) {
+    auto it = _openSections.find(key);
+    if (it == _openSections.end() || (int)_sections[it->second].numRecords >= _maxRecordsPerSection) {
+        _sections.push_back({ key, 0, QByteArray() });
+        _openSections[key] = _sections.size() - 1;
+        it = _openSections.find(key);
+    }
+
+    auto& section = _sections[it->second];
+    RecordSize recordSize = size;
+    section.data.append(reinterpret_cast<const char*>(&recordSize), sizeof(recordSize));
+    section.data.append(reinterpret_cast<const char*>(data), size);
+    ++section.numRecords;
+    ++_numRecords;
+}
+
+bool OctreeSnapshotWriter::writeToFile(const QString& fileName, PacketType dataPacketType, const QUuid& id,
+                                       int64_t dataVersion) const {
+    SnapshotHeader header;
+    memset(&header, 0, sizeof(header));
+    header.magic = SNAPSHOT_FILE_MAGIC;
+    header.fileVersion = SNAPSHOT_FILE_VERSION;
+    header.dataPacketType = (quint32)dataPacketType;
+    header.dataPacketVersion = versionForPacketType(dataPacketType);
+    memcpy(header.id, id.toRfc4122().constData(), sizeof(header.id));
+    header.dataVersion = dataVersion;
+    header.numSections = (quint32)_sections.size();
+
+    std::vector<OctreeSnapshotSection> index;
+    index.reserve(_sections.size());
+    quint64 offset = sizeof(header) + _sections.size() * sizeof(OctreeSnapshotSection);
+    for (const auto& section : _sections) {
+        index.push_back({ section.key, section.numRecords, offset, (quint64)section.data.size() });
+        offset += section.data.size();
+    }
+
+    QSaveFile file(fileName);
+    if (!file.open(QIODevice::WriteOnly)) {
+        qCWarning(octree) << "Could not open" << fileName << "to write a snapshot -" << file.errorString();
+        return false;
+    }
+
+    bool success = file.write(reinterpret_cast<const char*>(&header), sizeof(header)) == (qint64)sizeof(header);
+    if (success && !index.empty()) {
+        qint64 indexSize = index.size() * sizeof(OctreeSnapshotSection);
+        success = file.write(reinterpret_cast<const char*>(index.data()), indexSize) == indexSize;
+    }
+    for (auto it = _sections.begin(); success && it != _sections.end(); ++it) {
+        success = file.write(it->data) == it->data.size();
+    }
+
+    if (!success || !file.commit()) {
+        qCWarning(octree) << "Could not write snapshot to" << fileName << "-" << file.errorString();
+        return false;
+    }
+    return true;
+}
+
+OctreeSnapshotReader::~OctreeSnapshotReader() {
+    if (_data) {
+        _file.unmap(const_cast<unsigned char*>(_data));
+    }
+}
+
+bool OctreeSnapshotReader::open(const QString& fileName, PacketType dataPacketType) {
+    _file.setFileName(fileName);
+    if (!_file.open(QIODevice::ReadOnly)) {
+        qCWarning(octree) << "Could not open snapshot" << fileName << "-" << _file.errorString();
+        return false;
+    }
+
+    _size = _file.size();
+    if (_size < (qint64)sizeof(SnapshotHeader)) {
+        qCWarning(octree) << fileName << "is not a snapshot";
+        return false;
+    }
+
+    _data = _file.map(0, _size);
+    if (!_data) {
+        qCWarning(octree) << "Could not map snapshot" << fileName << "-" << _file.errorString();
+        return false;
+    }
+
+    SnapshotHeader header;
+    memcpy(&header, _data, sizeof(header));
+    if (header.magic != SNAPSHOT_FILE_MAGIC || header.fileVersion != SNAPSHOT_FILE_VERSION) {
+        qCWarning(octree) << fileName << "is not a snapshot";
+        return false;
+    }
+    if (header.dataPacketType != (quint32)dataPacketType ||
+        header.dataPacketVersion != (quint32)versionForPacketType(dataPacketType)) {
+        qCDebug(octree) << "Snapshot" << fileName << "is of data version" << header.dataPacketVersion << "- it can't be read";
+        return false;
+    }
+
+    quint64 indexEnd = sizeof(header) + (quint64)header.numSections * sizeof(OctreeSnapshotSection);
+    if (indexEnd > (quint64)_size) {
+        qCWarning(octree) << "Snapshot" << fileName << "is cut short";
+        return false;
+    }
+
+    _sections.resize(header.numSections);
+    if (header.numSections > 0) {
+        memcpy(_sections.data(), _data + sizeof(header), header.numSections * sizeof(OctreeSnapshotSection));
+    }
+    for (const auto& section : _sections) {
+        if (section.offset < indexEnd || section.offset > (quint64)_size || section.size > (quint64)_size - section.offset) {
+            qCWarning(octree) << "Snapshot" << fileName << "is cut short";
+            _sections.clear();
+            return false;
+        }
+    }
+
+    _id = QUuid::fromRfc4122(QByteArray::fromRawData(header.id, sizeof(header.id)));
+    _dataVersion = header.dataVersion;
+    return true;
+}
+
+bool OctreeSnapshotReader::forEachRecord(int section, const RecordOperation& operation) const {
+    const auto& info = _sections[section];
+    const unsigned char* data = _data + info.offset;
+    const unsigned char* end = data + info.size;
+
+    for (quint32 i = 0; i < info.numRecords; ++i) {
+        RecordSize size;
+        if (end - data < (qint64)sizeof(size)) {
+            return false;
+        }
+        memcpy(&size, data, sizeof(size));
+        data += sizeof(size);
+
+        if ((quint64)(end - data) < size || !operation(data, (int)size)) {
+            return false;
+        }
+        data += size;
+    }
+    return true;
+}
@@ -0,0 +1,95 @@
+//
+//  OctreeSnapshot.h
+//  libraries/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_OctreeSnapshot_h
+#define overte_OctreeSnapshot_h
+
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+#include <QtCore/QByteArray>
+#include <QtCore/QFile>
+#include <QtCore/QUuid>
+
+#include <udt/PacketHeaders.h>
+
+// A binary snapshot of the data of an octree, which loads without going through JSON.
+//
+// The file is a header, an index of sections and then the sections. A section is a run of records that share a key (for
+// entities, their type), each record being the bitstream encoding of one item of the tree preceded by its size. The
+// records are encoded for the data packet type and version in the header, a snapshot of another version isn't read.
+// The index gives the offset of every section, so that the file can be memory-mapped and its sections decoded in
+// parallel.
+
+struct OctreeSnapshotSection {
+    quint32 key;
+    quint32 numRecords;
+    quint64 offset;
+    quint64 size;
+};
+
+class OctreeSnapshotWriter {
+public:
+    // A section is closed once it has this many records, later records with its key go to a new one
+    static const int DEFAULT_MAX_RECORDS_PER_SECTION = 4096;
+
+    OctreeSnapshotWriter(int maxRecordsPerSection = DEFAULT_MAX_RECORDS_PER_SECTION);
+
+    void appendRecord(quint32 key, const unsigned char* data, int size);
+
+    int getNumRecords() const { return _numRecords; }
+
+    bool writeToFile(const QString& fileName, PacketType dataPacketType, const QUuid& id, int64_t dataVersion) const;
+
+private:
+    struct Section {
+        quint32 key;
+        quint32 numRecords;
+        QByteArray data;
+    };
+
+    int _maxRecordsPerSection;
+    int _numRecords { 0 };
+    std::vector<Section> _sections;
+    std::unordered_map<quint32, size_t> _openSections;
+};
+
+class OctreeSnapshotReader {
+public:
+    using RecordOperation = std::function<bool(const unsigned char* data, int size)>;
+
+    ~OctreeSnapshotReader();
+
+    // Maps the snapshot, returns false if it isn't one or its records aren't encoded for the current version of the
+    // data packet type
+    bool open(const QString& fileName, PacketType dataPacketType);
+
+    const QUuid& getID() const { return _id; }
+    int64_t getDataVersion() const { return _dataVersion; }
+
+    int getNumSections() const { return (int)_sections.size(); }
+    const OctreeSnapshotSection& getSection(int section) const { return _sections[section]; }
+
+    // Calls the operation with each record of the section in turn, returns false if the operation does or if the section
+    // is cut short. Sections can be read from several threads at once.
+    bool forEachRecord(int section, const RecordOperation& operation) const;
+
+private:
+    QFile _file;
+    const unsigned char* _data { nullptr };
+    qint64 _size { 0 };
+    QUuid _id;
+    int64_t _dataVersion { 0 };
+    std::vector<OctreeSnapshotSection> _sections;
+};
+
+#endif // overte_OctreeSnapshot_h
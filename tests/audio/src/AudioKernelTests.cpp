@@ -0,0 +1,176 @@
+//
+//  AudioKernelTests.cpp
+//  tests/audio/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AudioKernelTests.h"
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+
+#include <AudioFOA.h>
+#include <AudioKernels.h>
+
+QTEST_MAIN(AudioKernelTests)
+
+using namespace AudioKernels;
+
+static const int NUM_BENCHMARK_BLOCKS = 20000;
+
+// the variants sum in a different order and may use FMA, so they are not bit-exact with the scalar code
+static const float RELATIVE_TOLERANCE = 1e-5f;
+
+static std::mt19937 generator(1234);
+
+static void randFill(float* buffer, int size, float min = -1.0f, float max = 1.0f) {
+    std::uniform_real_distribution<float> distribution(min, max);
+    for (int i = 0; i < size; i++) {
+        buffer[i] = distribution(generator);
+    }
+}
+
+// compare against the scalar output, relative to the largest magnitude in the block
+static bool matches(const float* expected, const float* actual, int size, const char* isa) {
+    float peak = 0.0f;
+    for (int i = 0; i < size; i++) {
+        peak = std::max(peak, std::abs(expected[i]));
+    }
+    for (int i = 0; i < size; i++) {
+        if (std::abs(expected[i] - actual[i]) > RELATIVE_TOLERANCE * peak) {
+            qWarning() << isa << "differs at" << i << ":" << actual[i] << "!=" << expected[i];
+            return false;
+        }
+    }
+    return true;
+}
+
+static void report(const char* kernel, int isa, qint64 elapsedNSecs, int numSamples) {
+    qDebug() << kernel << isaName(isa) << ":" << (double)numSamples * NUM_BENCHMARK_BLOCKS * 1e9 / elapsedNSecs / 1e6
+        << "Msamples/sec";
+}
+
+void AudioKernelTests::hrtfConvolutionTest() {
+    const auto& table = hrtfConvolution();
+    QVERIFY(table.variants[SCALAR]);
+
+    // the input is preceded by HRTF_TAPS-1 samples of history
+    std::vector<float> input(HRTF_TAPS + HRTF_BLOCK);
+    randFill(input.data(), (int)input.size());
+    float* src = &input[HRTF_TAPS - 1];
+
+    float coef[4][HRTF_TAPS];
+    randFill(&coef[0][0], 4 * HRTF_TAPS, -0.5f, 0.5f);
+
+    float expected[4][HRTF_BLOCK];
+    table.variants[SCALAR](src, expected[0], expected[1], expected[2], expected[3], coef, HRTF_BLOCK);
+
+    for (int isa = SCALAR; isa < NUM_ISAS; isa++) {
+        auto f = table.variants[isa];
+        if (!f || !isSupported(isa)) {
+            continue;
+        }
+
+        float output[4][HRTF_BLOCK];
+        f(src, output[0], output[1], output[2], output[3], coef, HRTF_BLOCK);
+        QVERIFY2(matches(&expected[0][0], &output[0][0], 4 * HRTF_BLOCK, isaName(isa)), isaName(isa));
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_BENCHMARK_BLOCKS; i++) {
+            f(src, output[0], output[1], output[2], output[3], coef, HRTF_BLOCK);
+        }
+        report("HRTF FIR_1x4", isa, timer.nsecsElapsed(), HRTF_BLOCK);
+    }
+}
+
+void AudioKernelTests::foaRotationTest() {
+    const auto& table = foaRotation();
+    QVERIFY(table.variants[SCALAR]);
+
+    float m0[4][4];
+    float m1[4][4];
+    randFill(&m0[0][0], 16);
+    randFill(&m1[0][0], 16);
+
+    float window[FOA_BLOCK];
+    for (int i = 0; i < FOA_BLOCK; i++) {
+        window[i] = (float)i / FOA_BLOCK;
+    }
+
+    float input[4][FOA_BLOCK];
+    randFill(&input[0][0], 4 * FOA_BLOCK);
+
+    float expected[4][FOA_BLOCK];
+    memcpy(expected, input, sizeof(expected));
+    float* expectedChannels[4] = { expected[0], expected[1], expected[2], expected[3] };
+    table.variants[SCALAR](expectedChannels, m0, m1, window, FOA_BLOCK);
+
+    for (int isa = SCALAR; isa < NUM_ISAS; isa++) {
+        auto f = table.variants[isa];
+        if (!f || !isSupported(isa)) {
+            continue;
+        }
+
+        float output[4][FOA_BLOCK];
+        memcpy(output, input, sizeof(output));
+        float* outputChannels[4] = { output[0], output[1], output[2], output[3] };
+        f(outputChannels, m0, m1, window, FOA_BLOCK);
+        QVERIFY2(matches(&expected[0][0], &output[0][0], 4 * FOA_BLOCK, isaName(isa)), isaName(isa));
+
+        // the rotation is in place, so restart from the input each block to keep the values bounded
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_BENCHMARK_BLOCKS; i++) {
+            memcpy(output, input, sizeof(output));
+            f(outputChannels, m0, m1, window, FOA_BLOCK);
+        }
+        report("FOA rotate_4x4", isa, timer.nsecsElapsed(), FOA_BLOCK);
+    }
+}
+
+void AudioKernelTests::foaConvolutionTest() {
+    const auto& table = foaConvolution();
+    QVERIFY(table.variants[SCALAR]);
+
+    float src[FOA_NFFT];
+    float coef0[FOA_NFFT];
+    float coef1[FOA_NFFT];
+    float acc[2][FOA_NFFT];
+    randFill(src, FOA_NFFT);
+    randFill(coef0, FOA_NFFT);
+    randFill(coef1, FOA_NFFT);
+    randFill(&acc[0][0], 2 * FOA_NFFT);
+
+    float expected[2][FOA_NFFT];
+    memcpy(expected, acc, sizeof(expected));
+    table.variants[SCALAR](src, coef0, coef1, expected[0], expected[1]);
+
+    for (int isa = SCALAR; isa < NUM_ISAS; isa++) {
+        auto f = table.variants[isa];
+        if (!f || !isSupported(isa)) {
+            continue;
+        }
+
+        float output[2][FOA_NFFT];
+        memcpy(output, acc, sizeof(output));
+        f(src, coef0, coef1, output[0], output[1]);
+        QVERIFY2(matches(&expected[0][0], &output[0][0], 2 * FOA_NFFT, isaName(isa)), isaName(isa));
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_BENCHMARK_BLOCKS; i++) {
+            memcpy(output, acc, sizeof(output));
+            f(src, coef0, coef1, output[0], output[1]);
+        }
+        report("FOA cmadd_1X2", isa, timer.nsecsElapsed(), FOA_NFFT);
+    }
+}
@@ -0,0 +1,25 @@
+//
+//  AudioKernelTests.h
+//  tests/audio/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AudioKernelTests_h
+#define overte_AudioKernelTests_h
+
+#include <QtTest/QtTest>
+
+class AudioKernelTests : public QObject {
+    Q_OBJECT
+private slots:
+    void hrtfConvolutionTest();
+    void foaRotationTest();
+    void foaConvolutionTest();
+};
+
+#endif // overte_AudioKernelTests_h
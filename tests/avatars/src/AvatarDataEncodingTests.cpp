@@ -0,0 +1,119 @@
+//
+//  AvatarDataEncodingTests.cpp
+//  tests/avatars/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AvatarDataEncodingTests.h"
+
+#include <QtCore/QThread>
+
+#include <AvatarData.h>
+#include <NumericalConstants.h>
+
+QTEST_MAIN(AvatarDataEncodingTests)
+
+static const int NUM_TEST_JOINTS = 80;
+static const int TEST_MAX_DATA_SIZES[] = { 1400, 400, 120 };
+
+static QString describe(AvatarData::AvatarDataDetail detail, quint64 lastSentTime, int maxDataSize, int chunk) {
+    return QString("detail %1, last sent at %2, %3 bytes, chunk %4")
+        .arg(detail).arg(lastSentTime).arg(maxDataSize).arg(chunk);
+}
+
+void AvatarDataEncodingTests::sharedEncodingTest() {
+    AvatarData avatar;
+    avatar.setSessionUUID(QUuid::createUuid());
+    avatar.setWorldPosition(glm::vec3(1.0f, 2.0f, 3.0f));
+    avatar.setWorldOrientation(glm::angleAxis(0.5f, glm::vec3(0.0f, 1.0f, 0.0f)));
+
+    // about half of the joints moved a little since they were last sent
+    QVector<JointData> lastSentJoints(NUM_TEST_JOINTS);
+    for (int i = 0; i < NUM_TEST_JOINTS; ++i) {
+        glm::quat rotation = glm::angleAxis((float)i * 0.1f, glm::normalize(glm::vec3(1.0f, (float)i, 2.0f)));
+        glm::vec3 translation(0.01f * (float)i, 0.1f, -0.05f);
+        avatar.setJointData(i, rotation, translation);
+
+        JointData& last = lastSentJoints[i];
+        glm::quat movedRotation = glm::normalize(rotation * glm::angleAxis(0.05f, glm::vec3(1.0f, 0.0f, 0.0f)));
+        last.rotation = i % 2 ? rotation : movedRotation;
+        last.translation = i % 2 ? translation : translation + glm::vec3(0.001f);
+        last.rotationIsDefaultPose = false;
+        last.translationIsDefaultPose = false;
+    }
+
+    // sent before anything was set, after only the loudness changed, and after nothing changed
+    QThread::msleep(2);
+    quint64 beforeLoudness = usecTimestampNow();
+    QThread::msleep(2);
+    avatar.setAudioLoudness(10.0f);
+    QThread::msleep(2);
+    quint64 unchanged = usecTimestampNow();
+
+    const glm::vec3 viewerPosition(10.0f, 0.0f, 10.0f);
+    const bool dropFaceTracking = false;
+    const bool distanceAdjust = true;
+    int numCompared = 0;
+    int numSplit = 0;
+
+    for (auto detail : { AvatarData::PALMinimum, AvatarData::MinimumData, AvatarData::CullSmallData,
+                         AvatarData::IncludeSmallData, AvatarData::SendAllData }) {
+        for (quint64 lastSentTime : { (quint64)0, beforeLoudness, unchanged }) {
+            for (int maxDataSize : TEST_MAX_DATA_SIZES) {
+                QVector<JointData> expectedSentJoints = lastSentJoints;
+                AvatarDataPacket::SendStatus expectedStatus;
+                expectedStatus.sendUUID = true;
+                QByteArray expected = avatar.toByteArray(detail, lastSentTime, expectedSentJoints, expectedStatus,
+                    dropFaceTracking, distanceAdjust, viewerPosition, &expectedSentJoints, maxDataSize);
+
+                // as the avatar mixer encodes the first chunk for a listener
+                AvatarDataPacket::HasFlags wantedFlags =
+                    avatar.getWantedDataFlags(detail, lastSentTime, dropFaceTracking);
+                QByteArray sharedBytes = avatar.toSharedByteArray(detail, wantedFlags);
+                QVector<JointData> sentJoints = lastSentJoints;
+                AvatarDataPacket::SendStatus status;
+                status.sendUUID = true;
+                QByteArray bytes;
+                if (!avatar.appendToSharedByteArray(sharedBytes, detail, lastSentTime, sentJoints, wantedFlags, status,
+                                                    dropFaceTracking, viewerPosition, maxDataSize, bytes)) {
+                    // the mixer falls back to toByteArray
+                    QVERIFY2(sharedBytes.size() + (int)AvatarDataPacket::MIN_BULK_PACKET_SIZE > maxDataSize,
+                             qPrintable(describe(detail, lastSentTime, maxDataSize, 0)));
+                    continue;
+                }
+
+                int chunk = 0;
+                while (true) {
+                    QVERIFY2(bytes == expected, qPrintable(describe(detail, lastSentTime, maxDataSize, chunk)));
+                    QCOMPARE(status.itemFlags, expectedStatus.itemFlags);
+                    QCOMPARE(status.rotationsSent, expectedStatus.rotationsSent);
+                    QCOMPARE(status.translationsSent, expectedStatus.translationsSent);
+                    for (int i = 0; i < NUM_TEST_JOINTS; ++i) {
+                        QVERIFY(sentJoints[i].rotation == expectedSentJoints[i].rotation);
+                        QVERIFY(sentJoints[i].translation == expectedSentJoints[i].translation);
+                    }
+                    ++numCompared;
+                    if (status.itemFlags == 0) {
+                        break;
+                    }
+
+                    // the joints that didn't fit follow in the next chunks, encoded as before
+                    ++numSplit;
+                    ++chunk;
+                    expected = avatar.toByteArray(detail, lastSentTime, expectedSentJoints, expectedStatus,
+                        dropFaceTracking, distanceAdjust, viewerPosition, &expectedSentJoints, maxDataSize);
+                    bytes = avatar.toByteArray(detail, lastSentTime, sentJoints, status, dropFaceTracking,
+                        distanceAdjust, viewerPosition, &sentJoints, maxDataSize);
+                }
+            }
+        }
+    }
+
+    QVERIFY(numCompared > 0);
+    QVERIFY(numSplit > 0);
+}
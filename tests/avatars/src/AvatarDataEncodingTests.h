@@ -0,0 +1,25 @@
+//
+//  AvatarDataEncodingTests.h
+//  tests/avatars/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AvatarDataEncodingTests_h
+#define overte_AvatarDataEncodingTests_h
+
+#include <QtTest/QtTest>
+
+class AvatarDataEncodingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the avatar mixer's shared encoding - the listener-independent part spliced with the listener's joint
+    // records - gives the same bytes and send status as toByteArray, for each level of detail and set of changes
+    void sharedEncodingTest();
+};
+
+#endif // overte_AvatarDataEncodingTests_h
@@ -0,0 +1,200 @@
+//
+//  JointPackingTests.cpp
+//  tests/avatars/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "JointPackingTests.h"
+
+#include <random>
+
+#include <QtCore/QElapsedTimer>
+
+#include <AvatarData.h>
+#include <JointPacking.h>
+
+QTEST_MAIN(JointPackingTests)
+
+static const int NUM_TEST_ROUNDS = 2000;
+static const int NUM_BENCHMARK_JOINTS = 80; // about the size of a typical avatar skeleton
+static const int NUM_BENCHMARK_ENCODES = 20000;
+static const int TRANSLATION_RADIX = 14;
+
+static std::mt19937 generator(1234);
+
+static float randFloat(float min, float max) {
+    return std::uniform_real_distribution<float>(min, max)(generator);
+}
+
+static glm::quat randRotation() {
+    glm::quat rotation(randFloat(-1.0f, 1.0f), randFloat(-1.0f, 1.0f), randFloat(-1.0f, 1.0f), randFloat(-1.0f, 1.0f));
+    switch (generator() % 8) {
+        case 0:
+            // ties between the largest components
+            rotation.y = rotation.x;
+            rotation.z = -rotation.x;
+            break;
+        case 1:
+            // the encoder doesn't normalize
+            return rotation;
+        default:
+            break;
+    }
+    return glm::normalize(rotation);
+}
+
+// the last sent value is either the same, a small change around the cull thresholds or unrelated
+static float randLastValue(float value, float smallChange) {
+    switch (generator() % 4) {
+        case 0:
+            return value;
+        case 1:
+            return randFloat(-1.0f, 1.0f);
+        default:
+            return value + randFloat(-smallChange, smallChange);
+    }
+}
+
+void JointPackingTests::rotationTest() {
+    JointPacking::Rotations rotations;
+    JointPacking::Rotations lastRotations;
+    JointPacking::PackedRotations expected;
+    JointPacking::PackedRotations packed;
+
+    for (int round = 0; round < NUM_TEST_ROUNDS; ++round) {
+        int numJoints = 1 + round % (JointPacking::MAX_JOINTS - 1);
+        int begin = (round / 2) % 5 < numJoints ? (round / 2) % 5 : 0;
+        bool cullSmallChanges = round % 2 == 0;
+        float minRotationDOT = randFloat(0.99f, 0.99999f);
+
+        for (int i = 0; i < numJoints; ++i) {
+            glm::quat rotation = randRotation();
+            rotations.x[i] = rotation.x;
+            rotations.y[i] = rotation.y;
+            rotations.z[i] = rotation.z;
+            rotations.w[i] = rotation.w;
+            lastRotations.x[i] = randLastValue(rotation.x, 0.01f);
+            lastRotations.y[i] = randLastValue(rotation.y, 0.001f);
+            lastRotations.z[i] = rotation.z;
+            lastRotations.w[i] = randLastValue(rotation.w, 0.0001f);
+        }
+
+        JointPacking::cullAndPackRotations_ref(rotations, lastRotations, begin, numJoints, cullSmallChanges,
+                                               minRotationDOT, expected);
+        JointPacking::cullAndPackRotations(rotations, lastRotations, begin, numJoints, cullSmallChanges,
+                                           minRotationDOT, packed);
+
+        for (int i = begin; i < numJoints; ++i) {
+            QCOMPARE(packed.changed[i], expected.changed[i]);
+            QCOMPARE(packed.c0[i], expected.c0[i]);
+            QCOMPARE(packed.c1[i], expected.c1[i]);
+            QCOMPARE(packed.c2[i], expected.c2[i]);
+        }
+    }
+}
+
+void JointPackingTests::translationTest() {
+    JointPacking::Translations translations;
+    JointPacking::Translations lastTranslations;
+    JointPacking::PackedTranslations expected;
+    JointPacking::PackedTranslations packed;
+
+    for (int round = 0; round < NUM_TEST_ROUNDS; ++round) {
+        int numJoints = 1 + round % (JointPacking::MAX_JOINTS - 1);
+        int begin = (round / 2) % 5 < numJoints ? (round / 2) % 5 : 0;
+        bool cullSmallChanges = round % 2 == 0;
+        float minTranslation = randFloat(0.00001f, 0.001f);
+        float maxTranslationDimension = randFloat(0.001f, 2.0f);
+
+        for (int i = 0; i < numJoints; ++i) {
+            // some translations are out of range to exercise the clamping
+            translations.x[i] = randFloat(-1.0f, 1.0f);
+            translations.y[i] = randFloat(-3.0f, 3.0f);
+            translations.z[i] = randFloat(-0.1f, 0.1f);
+            lastTranslations.x[i] = randLastValue(translations.x[i], 0.001f);
+            lastTranslations.y[i] = randLastValue(translations.y[i], 0.0001f);
+            lastTranslations.z[i] = translations.z[i];
+        }
+
+        JointPacking::cullAndPackTranslations_ref(translations, lastTranslations, begin, numJoints, cullSmallChanges,
+                                                  minTranslation, maxTranslationDimension, TRANSLATION_RADIX, expected);
+        JointPacking::cullAndPackTranslations(translations, lastTranslations, begin, numJoints, cullSmallChanges,
+                                              minTranslation, maxTranslationDimension, TRANSLATION_RADIX, packed);
+
+        for (int i = begin; i < numJoints; ++i) {
+            QCOMPARE(packed.changed[i], expected.changed[i]);
+            QCOMPARE(packed.x[i], expected.x[i]);
+            QCOMPARE(packed.y[i], expected.y[i]);
+            QCOMPARE(packed.z[i], expected.z[i]);
+        }
+    }
+}
+
+void JointPackingTests::encodeBenchmark() {
+    AvatarData avatar;
+    QVector<JointData> lastSentJoints(NUM_BENCHMARK_JOINTS);
+    for (int i = 0; i < NUM_BENCHMARK_JOINTS; ++i) {
+        glm::quat rotation = glm::normalize(randRotation());
+        glm::vec3 translation(randFloat(-0.2f, 0.2f), randFloat(-0.2f, 0.2f), randFloat(-0.2f, 0.2f));
+        avatar.setJointData(i, rotation, translation);
+
+        // about half of the joints moved a little since they were last sent
+        JointData& last = lastSentJoints[i];
+        last.rotation = i % 2 ? rotation : glm::normalize(rotation + glm::quat(0.0f, 0.01f, 0.0f, 0.0f));
+        last.translation = i % 2 ? translation : translation + glm::vec3(0.001f);
+        last.rotationIsDefaultPose = false;
+        last.translationIsDefaultPose = false;
+    }
+
+    for (auto detail : { AvatarData::CullSmallData, AvatarData::SendAllData }) {
+        int numBytes = 0;
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_BENCHMARK_ENCODES; ++i) {
+            AvatarDataPacket::SendStatus sendStatus;
+            sendStatus.sendUUID = true;
+            QByteArray bytes = avatar.toByteArray(detail, 0, lastSentJoints, sendStatus, false, true, glm::vec3(1.0f),
+                                                  nullptr);
+            numBytes += bytes.size();
+        }
+        auto elapsedNSecs = timer.nsecsElapsed();
+
+        qDebug() << (detail == AvatarData::CullSmallData ? "CullSmallData" : "SendAllData") << "encoded"
+            << NUM_BENCHMARK_ENCODES << NUM_BENCHMARK_JOINTS << "joint avatars at"
+            << (double)elapsedNSecs / NUM_BENCHMARK_ENCODES / 1000.0 << "usecs per avatar"
+            << "(" << numBytes / NUM_BENCHMARK_ENCODES << "bytes )";
+    }
+
+    // the bulk kernels on their own, against the per-joint reference
+    JointPacking::Rotations rotations;
+    JointPacking::Rotations lastRotations;
+    JointPacking::PackedRotations packed;
+    for (int i = 0; i < NUM_BENCHMARK_JOINTS; ++i) {
+        rotations.x[i] = lastRotations.x[i] = randFloat(-0.5f, 0.5f);
+        rotations.y[i] = lastRotations.y[i] = randFloat(-0.5f, 0.5f);
+        rotations.z[i] = lastRotations.z[i] = randFloat(-0.5f, 0.5f);
+        rotations.w[i] = lastRotations.w[i] = randFloat(-0.5f, 0.5f);
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+    for (int i = 0; i < NUM_BENCHMARK_ENCODES; ++i) {
+        JointPacking::cullAndPackRotations_ref(rotations, lastRotations, 0, NUM_BENCHMARK_JOINTS, true, 0.9999f, packed);
+    }
+    auto referenceNSecs = timer.nsecsElapsed();
+
+    timer.restart();
+    for (int i = 0; i < NUM_BENCHMARK_ENCODES; ++i) {
+        JointPacking::cullAndPackRotations(rotations, lastRotations, 0, NUM_BENCHMARK_JOINTS, true, 0.9999f, packed);
+    }
+    auto bulkNSecs = timer.nsecsElapsed();
+
+    qDebug() << "Culled and packed" << NUM_BENCHMARK_JOINTS << "rotations in"
+        << (double)referenceNSecs / NUM_BENCHMARK_ENCODES << "nsecs (reference),"
+        << (double)bulkNSecs / NUM_BENCHMARK_ENCODES << "nsecs (bulk)";
+}
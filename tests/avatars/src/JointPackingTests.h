@@ -0,0 +1,25 @@
+//
+//  JointPackingTests.h
+//  tests/avatars/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_JointPackingTests_h
+#define overte_JointPackingTests_h
+
+#include <QtTest/QtTest>
+
+class JointPackingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void rotationTest();
+    void translationTest();
+    void encodeBenchmark();
+};
+
+#endif // overte_JointPackingTests_h
@@ -0,0 +1,119 @@
+//
+//  AssetChunkingTests.cpp
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "AssetChunkingTests.h"
+
+#include <QtCore/QSet>
+
+#include <AssetChunking.h>
+
+QTEST_MAIN(AssetChunkingTests)
+
+using namespace AssetUtils;
+
+static const int BENCHMARK_ASSET_SIZE = 64 * 1024 * 1024;
+
+static QByteArray randomData(int size, quint64 seed) {
+    QByteArray data;
+    data.resize(size);
+    for (int i = 0; i < size; ++i) {
+        seed = seed * 6364136223846793005ull + 1442695040888963407ull;
+        data[i] = (char)(seed >> 56);
+    }
+    return data;
+}
+
+static QSet<QByteArray> chunkHashes(const ContentChunks& chunks) {
+    QSet<QByteArray> hashes;
+    for (const auto& chunk : chunks) {
+        hashes.insert(chunk.hash);
+    }
+    return hashes;
+}
+
+static DataOffset bytesToSend(const ContentChunks& chunks, const QSet<QByteArray>& storedChunks) {
+    DataOffset size = 0;
+    for (const auto& chunk : chunks) {
+        if (!storedChunks.contains(chunk.hash)) {
+            size += chunk.size;
+        }
+    }
+    return size;
+}
+
+void AssetChunkingTests::coverageTest() {
+    QVERIFY(chunkContent(nullptr, 0).empty());
+
+    for (int size : { 1, (int)MIN_CONTENT_CHUNK_SIZE, 3 * (int)MAX_CONTENT_CHUNK_SIZE + 5, 4 * 1024 * 1024 }) {
+        QByteArray data = randomData(size, size);
+        auto chunks = chunkContent(data.constData(), data.size());
+        QVERIFY(!chunks.empty());
+
+        DataOffset offset = 0;
+        for (size_t i = 0; i < chunks.size(); ++i) {
+            const auto& chunk = chunks[i];
+            QCOMPARE(chunk.offset, offset);
+            QVERIFY(chunk.size <= MAX_CONTENT_CHUNK_SIZE);
+            // only the last chunk can be cut short of the minimum
+            QVERIFY(chunk.size >= MIN_CONTENT_CHUNK_SIZE || i == chunks.size() - 1);
+            QCOMPARE(chunk.hash, hashData(data.mid((int)chunk.offset, (int)chunk.size)));
+            offset += chunk.size;
+        }
+        QCOMPARE(offset, (DataOffset)size);
+    }
+
+    // data without any boundary in it is cut at the maximum size
+    QByteArray zeros(4 * (int)MAX_CONTENT_CHUNK_SIZE, 0);
+    auto chunks = chunkContent(zeros.constData(), zeros.size());
+    QCOMPARE((int)chunks.size(), 4);
+    QCOMPARE(chunks[0].hash, chunks[3].hash);
+}
+
+void AssetChunkingTests::editTest() {
+    const int SIZE = 8 * 1024 * 1024;
+    QByteArray original = randomData(SIZE, 1);
+    auto originalChunks = chunkContent(original.constData(), original.size());
+    auto storedChunks = chunkHashes(originalChunks);
+
+    // an unchanged asset has nothing to send
+    QCOMPARE(bytesToSend(chunkContent(original.constData(), original.size()), storedChunks), (DataOffset)0);
+
+    // bytes inserted near the start shift everything after them
+    QByteArray inserted = original;
+    inserted.insert(1000, QByteArray(100, 'x'));
+    auto insertedChunks = chunkContent(inserted.constData(), inserted.size());
+    QVERIFY(bytesToSend(insertedChunks, storedChunks) <= 2 * MAX_CONTENT_CHUNK_SIZE);
+
+    // a byte changed in the middle
+    QByteArray changed = original;
+    changed[SIZE / 2] = ~changed[SIZE / 2];
+    auto changedChunks = chunkContent(changed.constData(), changed.size());
+    QVERIFY(bytesToSend(changedChunks, storedChunks) <= 2 * MAX_CONTENT_CHUNK_SIZE);
+    QCOMPARE(changedChunks.front().hash, originalChunks.front().hash);
+    QCOMPARE(changedChunks.back().hash, originalChunks.back().hash);
+}
+
+void AssetChunkingTests::deltaUploadBenchmark() {
+    QByteArray original = randomData(BENCHMARK_ASSET_SIZE, 2);
+
+    ContentChunks originalChunks;
+    QBENCHMARK_ONCE {
+        originalChunks = chunkContent(original.constData(), original.size());
+    }
+
+    // a few small edits spread through the asset, as a re-exported model would have, only need a fraction of it sent
+    QByteArray edited = original;
+    for (int i = 1; i <= 4; ++i) {
+        edited.insert(i * BENCHMARK_ASSET_SIZE / 5, QByteArray(64, (char)i));
+    }
+    auto editedChunks = chunkContent(edited.constData(), edited.size());
+    QVERIFY(bytesToSend(editedChunks, chunkHashes(originalChunks)) < edited.size() / 10);
+}
@@ -0,0 +1,32 @@
+//
+//  AssetChunkingTests.h
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_AssetChunkingTests_h
+#define overte_AssetChunkingTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class AssetChunkingTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the chunks cover the data in order, within the size limits, with the hash of their contents
+    void coverageTest();
+
+    // Test that an edit in the middle of an asset leaves the chunks away from it unchanged
+    void editTest();
+
+    // Measure chunking a large asset, and test that a delta upload of it after small edits sends little of it
+    void deltaUploadBenchmark();
+};
+
+#endif // overte_AssetChunkingTests_h
@@ -0,0 +1,148 @@
+//
+//  BatchReceiverTests.cpp
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "BatchReceiverTests.h"
+
+#include <QtCore/QElapsedTimer>
+#include <QtNetwork/QUdpSocket>
+
+#include <udt/BatchReceiver.h>
+#include <udt/Constants.h>
+
+QTEST_MAIN(BatchReceiverTests)
+
+// small enough that a full run fits in the receive buffer, so nothing is dropped by the kernel
+static const int NUM_PACKETS_PER_RUN = 512;
+static const int PACKET_SIZE = 256;
+static const int NUM_RUNS = 50;
+
+static bool bindSockets(QUdpSocket& sender, QUdpSocket& receiver) {
+    if (!receiver.bind(QHostAddress::LocalHost, 0)) {
+        return false;
+    }
+    receiver.setSocketOption(QAbstractSocket::ReceiveBufferSizeSocketOption, udt::UDP_RECEIVE_BUFFER_SIZE_BYTES);
+    return sender.bind(QHostAddress::LocalHost, 0);
+}
+
+static void sendPackets(QUdpSocket& sender, const QUdpSocket& receiver) {
+    QByteArray datagram(PACKET_SIZE, 0);
+    for (int i = 0; i < NUM_PACKETS_PER_RUN; ++i) {
+        memcpy(datagram.data(), &i, sizeof(i));
+        sender.writeDatagram(datagram, QHostAddress::LocalHost, receiver.localPort());
+    }
+    // make sure the first datagram has arrived before we start reading
+    receiver.waitForReadyRead(1000);
+}
+
+static void reportRate(const char* name, int numPackets, qint64 elapsedNSecs) {
+    double packetsPerSecond = elapsedNSecs > 0 ? (double)numPackets * 1.0e9 / (double)elapsedNSecs : 0.0;
+    qDebug() << name << "received" << numPackets << "packets at" << (quint64)packetsPerSecond << "packets/sec";
+}
+
+void BatchReceiverTests::batchedReceiveTest() {
+    udt::BatchReceiver batchReceiver;
+    if (!batchReceiver.isSupported()) {
+        QSKIP("Batched receive is not supported on this platform");
+    }
+
+    QUdpSocket sender;
+    QUdpSocket receiver;
+    QVERIFY(bindSockets(sender, receiver));
+    sendPackets(sender, receiver);
+
+    int numReceived = 0;
+    QElapsedTimer timer;
+    timer.start();
+    while (numReceived < NUM_PACKETS_PER_RUN && !timer.hasExpired(1000)) {
+        int batchSize = batchReceiver.receive(receiver.socketDescriptor());
+        QVERIFY(batchSize >= 0);
+        QVERIFY(batchSize <= udt::BatchReceiver::MAX_BATCH_SIZE);
+
+        for (int i = 0; i < batchSize; ++i) {
+            QCOMPARE(batchReceiver.getSize(i), (qint64)PACKET_SIZE);
+
+            auto senderSockAddr = batchReceiver.getSenderSockAddr(i);
+            QCOMPARE(senderSockAddr.getType(), SocketType::UDP);
+            QCOMPARE(senderSockAddr.getAddress(), QHostAddress(QHostAddress::LocalHost));
+            QCOMPARE(senderSockAddr.getPort(), sender.localPort());
+
+            auto buffer = batchReceiver.takeBuffer(i);
+            int index = -1;
+            memcpy(&index, buffer.get(), sizeof(index));
+            QCOMPARE(index, numReceived);
+            ++numReceived;
+        }
+    }
+
+    QCOMPARE(numReceived, NUM_PACKETS_PER_RUN);
+}
+
+void BatchReceiverTests::unbatchedReceiveBenchmark() {
+    QUdpSocket sender;
+    QUdpSocket receiver;
+    QVERIFY(bindSockets(sender, receiver));
+
+    int totalReceived = 0;
+    qint64 totalElapsed = 0;
+    for (int run = 0; run < NUM_RUNS; ++run) {
+        sendPackets(sender, receiver);
+
+        QElapsedTimer timer;
+        timer.start();
+        while (receiver.hasPendingDatagrams()) {
+            // mirror udt::Socket's fallback path: size, allocate, read
+            auto size = receiver.pendingDatagramSize();
+            auto buffer = std::unique_ptr<char[]>(new char[size]);
+            QHostAddress address;
+            quint16 port;
+            if (receiver.readDatagram(buffer.get(), size, &address, &port) > 0) {
+                ++totalReceived;
+            }
+        }
+        totalElapsed += timer.nsecsElapsed();
+    }
+
+    reportRate("QUdpSocket::readDatagram", totalReceived, totalElapsed);
+    QVERIFY(totalReceived > 0);
+}
+
+void BatchReceiverTests::batchedReceiveBenchmark() {
+    udt::BatchReceiver batchReceiver;
+    if (!batchReceiver.isSupported()) {
+        QSKIP("Batched receive is not supported on this platform");
+    }
+
+    QUdpSocket sender;
+    QUdpSocket receiver;
+    QVERIFY(bindSockets(sender, receiver));
+
+    int totalReceived = 0;
+    qint64 totalElapsed = 0;
+    for (int run = 0; run < NUM_RUNS; ++run) {
+        sendPackets(sender, receiver);
+
+        QElapsedTimer timer;
+        timer.start();
+        int batchSize = 0;
+        while ((batchSize = batchReceiver.receive(receiver.socketDescriptor())) > 0) {
+            for (int i = 0; i < batchSize; ++i) {
+                // mirror udt::Socket's batched path: address lookup and buffer hand-off
+                auto senderSockAddr = batchReceiver.getSenderSockAddr(i);
+                auto buffer = batchReceiver.takeBuffer(i);
+                ++totalReceived;
+            }
+        }
+        totalElapsed += timer.nsecsElapsed();
+    }
+
+    reportRate("udt::BatchReceiver", totalReceived, totalElapsed);
+    QVERIFY(totalReceived > 0);
+}
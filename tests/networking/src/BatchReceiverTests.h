@@ -0,0 +1,32 @@
+//
+//  BatchReceiverTests.h
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_BatchReceiverTests_h
+#define overte_BatchReceiverTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class BatchReceiverTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that batched receive returns every datagram intact with the right sender
+    void batchedReceiveTest();
+
+    // Measure packets/sec reading one datagram at a time through QUdpSocket
+    void unbatchedReceiveBenchmark();
+
+    // Measure packets/sec reading through udt::BatchReceiver
+    void batchedReceiveBenchmark();
+};
+
+#endif // overte_BatchReceiverTests_h
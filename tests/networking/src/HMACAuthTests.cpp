@@ -0,0 +1,179 @@
+//
+//  HMACAuthTests.cpp
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "HMACAuthTests.h"
+
+#include <atomic>
+#include <cstring>
+#include <thread>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QUuid>
+
+#include <HMACAuth.h>
+
+QTEST_MAIN(HMACAuthTests)
+
+static const int NUM_BENCHMARK_HASHES = 200000;
+static const int BENCHMARK_PACKET_SIZE = 200; // about the size of an avatar or audio packet
+
+static QByteArray toHex(const HMACAuth::HMACHash& hash) {
+    return QByteArray((const char*)hash.data(), (int)hash.size()).toHex();
+}
+
+static QByteArray sequentialBytes(int size) {
+    QByteArray bytes(size, 0);
+    for (int i = 0; i < size; ++i) {
+        bytes[i] = (char)i;
+    }
+    return bytes;
+}
+
+void HMACAuthTests::knownAnswerTest() {
+    HMACAuth::HMACHash hash;
+
+    // RFC 2202, test case 1
+    HMACAuth md5(HMACAuth::MD5);
+    QByteArray md5Key(16, 0x0b);
+    QVERIFY(md5.setKey(md5Key.constData(), md5Key.size()));
+    QVERIFY(md5.calculateHash(hash, "Hi There", 8));
+    QCOMPARE(toHex(hash), QByteArray("9294727a3638bb1c13f48ef8158bfc9d"));
+
+    // the context is left keyed - a second hash of the same data matches the first
+    QVERIFY(md5.calculateHash(hash, "Hi There", 8));
+    QCOMPARE(toHex(hash), QByteArray("9294727a3638bb1c13f48ef8158bfc9d"));
+
+    // SipHash-2-4 128-bit reference vectors - key 00 01 .. 0f, messages 00 01 .. (n - 1)
+    HMACAuth sipHash(HMACAuth::SIPHASH128);
+    QByteArray sipHashKey = sequentialBytes(16);
+    QVERIFY(!sipHash.setKey(sipHashKey.constData(), 15));
+    QVERIFY(sipHash.setKey(sipHashKey.constData(), sipHashKey.size()));
+
+    QByteArray message = sequentialBytes(64);
+    QVERIFY(sipHash.calculateHash(hash, message.constData(), 0));
+    QCOMPARE(toHex(hash), QByteArray("a3817f04ba25a8e66df67214c7550293"));
+    QVERIFY(sipHash.calculateHash(hash, message.constData(), 1));
+    QCOMPARE(toHex(hash), QByteArray("da87c1d86b99af44347659119b22fc45"));
+
+    // a hash can be truncated to the size of the packet header field
+    unsigned char shortHash[8];
+    QCOMPARE(sipHash.calculateHash(shortHash, sizeof(shortHash), message.constData(), 0), (int)sizeof(shortHash));
+    QCOMPARE(QByteArray((const char*)shortHash, sizeof(shortHash)).toHex(), QByteArray("a3817f04ba25a8e6"));
+
+    // without a key there is no hash
+    HMACAuth keyless;
+    QVERIFY(!keyless.hasKey());
+    QCOMPARE(keyless.calculateHash(shortHash, sizeof(shortHash), message.constData(), message.size()), 0);
+}
+
+void HMACAuthTests::methodAndIncrementalTest() {
+    QUuid secret = QUuid::createUuid();
+    QByteArray message = sequentialBytes(100);
+
+    HMACAuth::HMACHash md5Hash;
+    HMACAuth::HMACHash sipHash;
+    HMACAuth::HMACHash hash;
+
+    HMACAuth auth(HMACAuth::MD5);
+    QVERIFY(auth.setKey(secret));
+    QVERIFY(auth.calculateHash(md5Hash, message.constData(), message.size()));
+    QCOMPARE((int)md5Hash.size(), 16);
+
+    QVERIFY(auth.setAuthMethod(HMACAuth::SIPHASH128));
+    QCOMPARE(auth.getAuthMethod(), HMACAuth::SIPHASH128);
+    QVERIFY(auth.calculateHash(sipHash, message.constData(), message.size()));
+    QCOMPARE((int)sipHash.size(), 16);
+    QVERIFY(sipHash != md5Hash);
+
+    // a fresh HMACAuth with the same key and method agrees
+    HMACAuth other(HMACAuth::SIPHASH128);
+    QVERIFY(other.setKey(secret));
+    QVERIFY(other.calculateHash(hash, message.constData(), message.size()));
+    QVERIFY(hash == sipHash);
+
+    // incremental hashing matches hashing in one, for both methods
+    QVERIFY(auth.addData(message.constData(), 37));
+    QVERIFY(auth.addData(message.constData() + 37, message.size() - 37));
+    QVERIFY(auth.result() == sipHash);
+
+    QVERIFY(auth.setAuthMethod(HMACAuth::MD5));
+    QVERIFY(auth.addData(message.constData(), 37));
+    QVERIFY(auth.addData(message.constData() + 37, message.size() - 37));
+    QVERIFY(auth.result() == md5Hash);
+}
+
+void HMACAuthTests::concurrentHashTest() {
+    const int NUM_THREADS = 8;
+    const int NUM_HASHES_PER_THREAD = 20000;
+
+    for (auto method : { HMACAuth::MD5, HMACAuth::SIPHASH128 }) {
+        // a few nodes, so that each thread rotates through their keys like a verification worker does
+        std::vector<std::unique_ptr<HMACAuth>> auths;
+        std::vector<HMACAuth::HMACHash> expectedHashes;
+        QByteArray message = sequentialBytes(BENCHMARK_PACKET_SIZE);
+
+        for (int i = 0; i < 20; ++i) {
+            auths.emplace_back(new HMACAuth(method));
+            auths.back()->setKey(QUuid::createUuid());
+
+            HMACAuth::HMACHash hash;
+            auths.back()->calculateHash(hash, message.constData(), message.size());
+            expectedHashes.push_back(hash);
+        }
+
+        std::atomic<int> numMismatches { 0 };
+        std::vector<std::thread> threads;
+        for (int t = 0; t < NUM_THREADS; ++t) {
+            threads.emplace_back([&, t] {
+                unsigned char hash[16];
+                for (int i = 0; i < NUM_HASHES_PER_THREAD; ++i) {
+                    int index = (i * 7 + t) % (int)auths.size();
+                    int hashLen = auths[index]->calculateHash(hash, sizeof(hash), message.constData(), message.size());
+                    if (hashLen != (int)expectedHashes[index].size() || memcmp(hash, expectedHashes[index].data(), hashLen) != 0) {
+                        ++numMismatches;
+                    }
+                }
+            });
+        }
+
+        for (auto& thread : threads) {
+            thread.join();
+        }
+
+        QCOMPARE(numMismatches.load(), 0);
+    }
+}
+
+void HMACAuthTests::hashBenchmark() {
+    QByteArray packet = sequentialBytes(BENCHMARK_PACKET_SIZE);
+    QUuid secret = QUuid::createUuid();
+
+    for (auto method : { HMACAuth::MD5, HMACAuth::SIPHASH128 }) {
+        HMACAuth auth(method);
+        auth.setKey(secret);
+
+        unsigned char hash[16];
+        quint64 checksum = 0;
+
+        QElapsedTimer timer;
+        timer.start();
+        for (int i = 0; i < NUM_BENCHMARK_HASHES; ++i) {
+            auth.calculateHash(hash, sizeof(hash), packet.constData(), packet.size());
+            checksum += hash[0];
+        }
+        auto elapsedNSecs = timer.nsecsElapsed();
+
+        double hashesPerSecond = elapsedNSecs > 0 ? (double)NUM_BENCHMARK_HASHES * 1.0e9 / (double)elapsedNSecs : 0.0;
+        qDebug() << (method == HMACAuth::MD5 ? "HMAC-MD5" : "SipHash-2-4") << "hashed" << NUM_BENCHMARK_HASHES
+            << BENCHMARK_PACKET_SIZE << "byte packets at" << (quint64)hashesPerSecond << "hashes/sec" << "(" << checksum << ")";
+    }
+}
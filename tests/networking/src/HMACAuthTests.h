@@ -0,0 +1,35 @@
+//
+//  HMACAuthTests.h
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_HMACAuthTests_h
+#define overte_HMACAuthTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class HMACAuthTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test HMAC-MD5 against RFC 2202 and SipHash-2-4 against the reference test vectors
+    void knownAnswerTest();
+
+    // Test that changing the method keeps the key, and that incremental hashing matches hashing in one
+    void methodAndIncrementalTest();
+
+    // Test that threads hashing with the same HMACAuth at once all get the right hashes
+    void concurrentHashTest();
+
+    // Measure packet-sized hashes per second with HMAC-MD5 and SipHash-2-4
+    void hashBenchmark();
+};
+
+#endif // overte_HMACAuthTests_h
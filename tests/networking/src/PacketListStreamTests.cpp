@@ -0,0 +1,219 @@
+//
+//  PacketListStreamTests.cpp
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PacketListStreamTests.h"
+
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <memory>
+#include <vector>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QTemporaryFile>
+
+#ifdef Q_OS_LINUX
+#include <unistd.h>
+#endif
+
+#include <udt/PacketList.h>
+#include <udt/PacketQueue.h>
+
+QTEST_MAIN(PacketListStreamTests)
+
+using namespace udt;
+
+static const qint64 BENCHMARK_DOWNLOAD_SIZE = 16 * 1024 * 1024;
+static const int BENCHMARK_FLOW_WINDOW = 256; // packets a downloader has in flight before it ACKs the oldest
+static const int BENCHMARK_SAMPLE_INTERVAL = 4096;
+
+static QByteArray testData(qint64 size) {
+    QByteArray data;
+    data.resize((int)size);
+    for (int i = 0; i < data.size(); ++i) {
+        data[i] = (char)(i * 7 + i / 251);
+    }
+    return data;
+}
+
+static PacketList::StreamSource sourceFor(const char* data) {
+    return [data](char* destination, qint64 maxSize) mutable {
+        memcpy(destination, data, maxSize);
+        data += maxSize;
+        return maxSize;
+    };
+}
+
+// resident memory that isn't backed by a file, -1 where that can't be read
+static qint64 privateResidentBytes() {
+#ifdef Q_OS_LINUX
+    QFile statm("/proc/self/statm");
+    if (statm.open(QIODevice::ReadOnly)) {
+        auto fields = QString(statm.readAll()).split(' ');
+        if (fields.size() >= 3) {
+            return (fields[1].toLongLong() - fields[2].toLongLong()) * sysconf(_SC_PAGESIZE);
+        }
+    }
+#endif
+    return -1;
+}
+
+void PacketListStreamTests::streamTest() {
+    const QByteArray HEADER = testData(50);
+    const qint64 CAPACITY = Packet::maxPayloadSize(true);
+
+    for (qint64 size : { (qint64)0, (qint64)1, CAPACITY - HEADER.size(), CAPACITY - HEADER.size() + 1, 3 * CAPACITY,
+                         100 * CAPACITY + 17 }) {
+        QByteArray data = testData(size);
+
+        auto expectedList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+        expectedList->write(HEADER);
+        expectedList->write(data);
+        expectedList->closeCurrentPacket();
+        auto numPackets = expectedList->getNumPackets();
+
+        auto streamedList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+        streamedList->write(HEADER);
+        streamedList->setStreamSource(size, sourceFor(data.constData()));
+        QVERIFY(streamedList->isStreamed());
+
+        PacketQueue expectedQueue;
+        PacketQueue streamedQueue;
+        expectedQueue.queuePacketList(std::move(expectedList));
+        streamedQueue.queuePacketList(std::move(streamedList));
+
+        for (size_t i = 0; i < numPackets; ++i) {
+            QVERIFY(!streamedQueue.isEmpty());
+            auto expected = expectedQueue.takePacket();
+            auto packet = streamedQueue.takePacket();
+            QVERIFY(packet);
+
+            QCOMPARE(packet->getMessageNumber(), expected->getMessageNumber());
+            QCOMPARE((int)packet->getPacketPosition(), (int)expected->getPacketPosition());
+            QCOMPARE(packet->getMessagePartNumber(), expected->getMessagePartNumber());
+            QCOMPARE(packet->getPayloadSize(), expected->getPayloadSize());
+            QVERIFY(memcmp(packet->getPayload(), expected->getPayload(), packet->getPayloadSize()) == 0);
+        }
+        QVERIFY(expectedQueue.isEmpty());
+        QVERIFY(streamedQueue.isEmpty());
+    }
+}
+
+void PacketListStreamTests::shortSourceTest() {
+    const qint64 CAPACITY = Packet::maxPayloadSize(true);
+    const qint64 SIZE = 10 * CAPACITY;
+    const qint64 SOURCE_SIZE = 3 * CAPACITY + 5;
+
+    QByteArray data = testData(SOURCE_SIZE);
+    qint64 remaining = SOURCE_SIZE;
+    const char* position = data.constData();
+
+    auto streamedList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+    streamedList->setStreamSource(SIZE, [&](char* destination, qint64 maxSize) {
+        auto size = std::min(maxSize, remaining);
+        memcpy(destination, position, size);
+        position += size;
+        remaining -= size;
+        return size;
+    });
+
+    PacketQueue queue;
+    queue.queuePacketList(std::move(streamedList));
+
+    QByteArray received;
+    std::unique_ptr<Packet> packet;
+    while (!queue.isEmpty()) {
+        packet = queue.takePacket();
+        received.append(packet->getPayload(), (int)packet->getPayloadSize());
+    }
+
+    QCOMPARE((int)packet->getPacketPosition(), (int)Packet::PacketPosition::LAST);
+    QCOMPARE(received, data);
+}
+
+void PacketListStreamTests::concurrentDownloadBenchmark() {
+    // the asset being downloaded, mapped like the asset server maps it
+    QTemporaryFile file;
+    QVERIFY(file.open());
+    QByteArray chunk = testData(1024 * 1024);
+    for (qint64 written = 0; written < BENCHMARK_DOWNLOAD_SIZE; written += chunk.size()) {
+        QCOMPARE(file.write(chunk), (qint64)chunk.size());
+    }
+    QVERIFY(file.flush());
+    auto mapped = reinterpret_cast<const char*>(file.map(0, BENCHMARK_DOWNLOAD_SIZE));
+    QVERIFY(mapped);
+
+    for (bool isStreamed : { false, true }) {
+        for (int numDownloaders : { 1, 4, 16, 64 }) {
+            if (!isStreamed && numDownloaders > 4) {
+                // lists written up front need the whole download in memory for each downloader
+                continue;
+            }
+
+            auto baseline = privateResidentBytes();
+            auto peak = baseline;
+
+            QElapsedTimer timer;
+            timer.start();
+
+            std::vector<std::unique_ptr<PacketQueue>> queues;
+            for (int i = 0; i < numDownloaders; ++i) {
+                auto packetList = PacketList::create(PacketType::Unknown, QByteArray(), true, true);
+                if (isStreamed) {
+                    packetList->setStreamSource(BENCHMARK_DOWNLOAD_SIZE, sourceFor(mapped));
+                } else {
+                    packetList->write(mapped, BENCHMARK_DOWNLOAD_SIZE);
+                    packetList->closeCurrentPacket();
+                }
+                queues.emplace_back(new PacketQueue());
+                queues.back()->queuePacketList(std::move(packetList));
+            }
+            peak = std::max(peak, privateResidentBytes());
+
+            // the downloaders take turns, each holding a flow window of sent packets until they are ACKed
+            std::vector<std::deque<std::unique_ptr<Packet>>> inFlight(numDownloaders);
+            qint64 bytesSent = 0;
+            int numPacketsSent = 0;
+            bool isSending = true;
+            while (isSending) {
+                isSending = false;
+                for (int i = 0; i < numDownloaders; ++i) {
+                    if (queues[i]->isEmpty()) {
+                        continue;
+                    }
+                    isSending = true;
+
+                    auto packet = queues[i]->takePacket();
+                    bytesSent += packet->getPayloadSize();
+                    inFlight[i].push_back(std::move(packet));
+                    if ((int)inFlight[i].size() > BENCHMARK_FLOW_WINDOW) {
+                        inFlight[i].pop_front();
+                    }
+
+                    if (++numPacketsSent % BENCHMARK_SAMPLE_INTERVAL == 0) {
+                        peak = std::max(peak, privateResidentBytes());
+                    }
+                }
+            }
+            auto elapsedNSecs = timer.nsecsElapsed();
+
+            QCOMPARE(bytesSent, BENCHMARK_DOWNLOAD_SIZE * numDownloaders);
+
+            double megabytesPerSecond = elapsedNSecs > 0 ? (double)bytesSent * 1.0e3 / (double)elapsedNSecs : 0.0;
+            qDebug() << (isStreamed ? "Streamed" : "Written up front") << numDownloaders << "downloads of"
+                << BENCHMARK_DOWNLOAD_SIZE / (1024 * 1024) << "MB at" << (quint64)megabytesPerSecond << "MB/sec,"
+                << "peak private resident memory grew by"
+                << (baseline >= 0 ? QString::number((peak - baseline) / (1024 * 1024)) + " MB" : QString("(unknown)"));
+        }
+    }
+
+    file.unmap(reinterpret_cast<uchar*>(const_cast<char*>(mapped)));
+}
@@ -0,0 +1,32 @@
+//
+//  PacketListStreamTests.h
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_PacketListStreamTests_h
+#define overte_PacketListStreamTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PacketListStreamTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that a streamed list gives the same packets, payloads and message positions as the list written up front
+    void streamTest();
+
+    // Test that a source that runs short ends the message early
+    void shortSourceTest();
+
+    // Stream a memory-mapped file to more and more concurrent downloaders and report the resident memory
+    void concurrentDownloadBenchmark();
+};
+
+#endif // overte_PacketListStreamTests_h
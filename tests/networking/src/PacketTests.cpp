@@ -13,13 +13,15 @@
 #include "PacketTests.h"
 #include <test-utils/QTestExtensions.h>
 
+#include <thread>
+
 #include <NLPacket.h>
 
 QTEST_MAIN(PacketTests)
 
 std::unique_ptr<NLPacket> copyToReadPacket(std::unique_ptr<NLPacket>& packet) {
     auto size = packet->getDataSize();
-    auto data = std::unique_ptr<char[]>(new char[size]);
+    auto data = udt::PacketBufferPool::acquire(size);
     memcpy(data.get(), packet->getData(), size);
     return NLPacket::fromReceivedPacket(std::move(data), size, SockAddr());
 }
@@ -181,3 +183,42 @@ void PacketTests::primitiveTest() {
     QCOMPARE(recvPacket->peekPrimitive(&noValue), 0);
     QCOMPARE(recvPacket->readPrimitive(&noValue), 0);
 }
+
+void PacketTests::bufferPoolTest() {
+    // a released buffer is handed straight back out for any size in the same size class
+    const char* firstBuffer = nullptr;
+    {
+        auto buffer = udt::PacketBufferPool::acquire(100);
+        firstBuffer = buffer.get();
+    }
+    {
+        auto buffer = udt::PacketBufferPool::acquire(120);
+        QCOMPARE(buffer.get(), firstBuffer);
+        QCOMPARE(buffer.get_deleter().getSizeClass(), 0);
+    }
+
+    // a buffer released on another thread goes back to the thread that took it
+    {
+        auto buffer = udt::PacketBufferPool::acquire(1000);
+        const char* takenBuffer = buffer.get();
+        std::thread([&buffer] { buffer.reset(); }).join();
+
+        auto nextBuffer = udt::PacketBufferPool::acquire(1000);
+        QCOMPARE(nextBuffer.get(), takenBuffer);
+    }
+
+    // buffers larger than the largest size class are not pooled
+    auto largestSizeClass = udt::PacketBufferPool::SIZE_CLASSES.back();
+    auto oversizedBuffer = udt::PacketBufferPool::acquire(largestSizeClass + 1);
+    QCOMPARE(oversizedBuffer.get_deleter().getSizeClass(), (int)udt::PacketBufferDeleter::UNPOOLED);
+
+    // a packet built on a recycled buffer doesn't see the previous packet's contents
+    {
+        auto packet = NLPacket::create(PacketType::Unknown);
+        QByteArray garbage(packet->getPayloadCapacity(), 'x');
+        packet->write(garbage);
+    }
+    auto packet = NLPacket::create(PacketType::Unknown);
+    QByteArray payload(packet->getPayload(), packet->getPayloadCapacity());
+    QCOMPARE(payload, QByteArray(packet->getPayloadCapacity(), 0));
+}
@@ -36,6 +36,9 @@ private slots:
 
     // Test set/get packet type
     void packetTypeTest();
+
+    // Test packet buffers are recycled through the PacketBufferPool
+    void bufferPoolTest();
 };
 
 #endif // hifi_PacketTests_h
@@ -0,0 +1,133 @@
+//
+//  PartialAssetFileTests.cpp
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "PartialAssetFileTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <PartialAssetFile.h>
+
+QTEST_MAIN(PartialAssetFileTests)
+
+static const QString TEST_HASH = QString(64, 'a');
+static const AssetUtils::DataOffset TEST_CHUNK_SIZE = 1000;
+static const AssetUtils::DataOffset TEST_SIZE = 4 * TEST_CHUNK_SIZE + 123;
+
+static QByteArray testData(AssetUtils::DataOffset size) {
+    QByteArray data;
+    data.resize((int)size);
+    for (int i = 0; i < data.size(); ++i) {
+        data[i] = (char)(i * 13 + i / 7);
+    }
+    return data;
+}
+
+void PartialAssetFileTests::chunkRangeTest() {
+    QTemporaryDir dir;
+    PartialAssetFile partialFile(dir.path(), TEST_HASH);
+    QVERIFY(partialFile.create(TEST_SIZE, TEST_CHUNK_SIZE));
+    QCOMPARE(partialFile.getNumChunks(), 5);
+
+    QCOMPARE(partialFile.getChunkRange(0).fromInclusive, (AssetUtils::DataOffset)0);
+    QCOMPARE(partialFile.getChunkRange(0).size(), (AssetUtils::DataOffset)123);
+    AssetUtils::DataOffset end = partialFile.getChunkRange(0).toExclusive;
+    for (int chunk = 1; chunk < partialFile.getNumChunks(); ++chunk) {
+        auto range = partialFile.getChunkRange(chunk);
+        QCOMPARE(range.fromInclusive, end);
+        QCOMPARE(range.size(), TEST_CHUNK_SIZE);
+        end = range.toExclusive;
+    }
+    QCOMPARE(end, TEST_SIZE);
+
+    // an asset of a whole number of chunks has no short one
+    QVERIFY(partialFile.create(3 * TEST_CHUNK_SIZE, TEST_CHUNK_SIZE));
+    QCOMPARE(partialFile.getNumChunks(), 3);
+    QCOMPARE(partialFile.getChunkRange(0).fromInclusive, (AssetUtils::DataOffset)0);
+    QCOMPARE(partialFile.getChunkRange(0).size(), TEST_CHUNK_SIZE);
+}
+
+void PartialAssetFileTests::resumeTest() {
+    QTemporaryDir dir;
+    QByteArray data = testData(TEST_SIZE);
+
+    {
+        PartialAssetFile partialFile(dir.path(), TEST_HASH);
+        QVERIFY(!partialFile.load());
+        QVERIFY(partialFile.create(TEST_SIZE, TEST_CHUNK_SIZE));
+
+        // the connection drops with some of the chunks in
+        for (int chunk : { 4, 0, 2 }) {
+            auto range = partialFile.getChunkRange(chunk);
+            partialFile.writeChunk(chunk, data.mid((int)range.fromInclusive, (int)range.size()));
+        }
+        QCOMPARE(partialFile.getNumCompleteChunks(), 3);
+    }
+
+    PartialAssetFile partialFile(dir.path(), TEST_HASH);
+    QVERIFY(partialFile.load());
+    QCOMPARE(partialFile.getSize(), TEST_SIZE);
+    QCOMPARE(partialFile.getChunkSize(), TEST_CHUNK_SIZE);
+    QCOMPARE(partialFile.getNumCompleteChunks(), 3);
+    QVERIFY(partialFile.isChunkComplete(0));
+    QVERIFY(!partialFile.isChunkComplete(1));
+    QVERIFY(partialFile.isChunkComplete(2));
+    QVERIFY(!partialFile.isChunkComplete(3));
+    QVERIFY(partialFile.isChunkComplete(4));
+
+    for (int chunk : { 0, 2, 4 }) {
+        auto range = partialFile.getChunkRange(chunk);
+        QCOMPARE(partialFile.readChunk(chunk), data.mid((int)range.fromInclusive, (int)range.size()));
+    }
+
+    // once the download is complete it is dropped
+    partialFile.remove();
+    QVERIFY(!PartialAssetFile(dir.path(), TEST_HASH).load());
+    QVERIFY(QDir(dir.path()).entryList(QDir::Files).isEmpty());
+}
+
+void PartialAssetFileTests::corruptTest() {
+    QTemporaryDir dir;
+
+    {
+        PartialAssetFile partialFile(dir.path(), TEST_HASH);
+        QVERIFY(partialFile.create(TEST_SIZE, TEST_CHUNK_SIZE));
+    }
+
+    // the data file is cut short
+    QFile dataFile(QDir(dir.path()).filePath(TEST_HASH + ".part"));
+    QVERIFY(dataFile.resize(TEST_SIZE - 1));
+    QVERIFY(!PartialAssetFile(dir.path(), TEST_HASH).load());
+    QVERIFY(QDir(dir.path()).entryList(QDir::Files).isEmpty());
+
+    {
+        PartialAssetFile partialFile(dir.path(), TEST_HASH);
+        QVERIFY(partialFile.create(TEST_SIZE, TEST_CHUNK_SIZE));
+    }
+
+    // the chunks file isn't one
+    QFile chunksFile(QDir(dir.path()).filePath(TEST_HASH + ".chunks"));
+    QVERIFY(chunksFile.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    chunksFile.write("not a chunks file");
+    chunksFile.close();
+    QVERIFY(!PartialAssetFile(dir.path(), TEST_HASH).load());
+    QVERIFY(QDir(dir.path()).entryList(QDir::Files).isEmpty());
+}
+
+void PartialAssetFileTests::inMemoryTest() {
+    PartialAssetFile partialFile(QString(), TEST_HASH);
+    QVERIFY(!partialFile.load());
+    QVERIFY(!partialFile.create(TEST_SIZE, TEST_CHUNK_SIZE));
+    QCOMPARE(partialFile.getNumChunks(), 5);
+
+    partialFile.writeChunk(1, testData(TEST_CHUNK_SIZE));
+    QVERIFY(partialFile.isChunkComplete(1));
+    QCOMPARE(partialFile.getNumCompleteChunks(), 1);
+}
@@ -0,0 +1,35 @@
+//
+//  PartialAssetFileTests.h
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_PartialAssetFileTests_h
+#define overte_PartialAssetFileTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class PartialAssetFileTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that the chunks cover the asset from the end, with only the first one short
+    void chunkRangeTest();
+
+    // Test that the chunks written by one download are picked up by the next one
+    void resumeTest();
+
+    // Test that a download whose files don't match up is dropped rather than resumed
+    void corruptTest();
+
+    // Test that a download without a directory is tracked in memory only
+    void inMemoryTest();
+};
+
+#endif // overte_PartialAssetFileTests_h
@@ -0,0 +1,214 @@
+//
+//  SendQueueSchedulerTests.cpp
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SendQueueSchedulerTests.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdlib>
+#include <functional>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <udt/SendQueueScheduler.h>
+
+QTEST_MAIN(SendQueueSchedulerTests)
+
+using namespace udt;
+using namespace std::chrono;
+
+using Clock = SendQueueScheduler::Clock;
+
+static bool waitFor(std::function<bool()> condition, milliseconds timeout) {
+    auto giveUpAt = Clock::now() + timeout;
+    while (!condition()) {
+        if (Clock::now() > giveUpAt) {
+            return false;
+        }
+        std::this_thread::sleep_for(milliseconds(1));
+    }
+    return true;
+}
+
+class PacedTask : public SendQueueScheduler::Task {
+public:
+    PacedTask(microseconds period, int numServices) : _period(period), _numServices(numServices) {}
+
+    Clock::time_point service(Clock::time_point now) override {
+        if (_numInService.fetch_add(1) != 0) {
+            wasServicedConcurrently = true;
+        }
+
+        serviceTimes.push_back(now);
+        if (_numServiced > 0) {
+            lateness.push_back(duration_cast<microseconds>(now - _nextServiceTime).count());
+            _nextServiceTime += _period;
+        } else {
+            _nextServiceTime = now + _period;
+        }
+
+        bool isDone = (++_numServiced == _numServices);
+        --_numInService;
+
+        if (isDone) {
+            isFinished = true;
+            return Clock::time_point::max();
+        }
+        return _nextServiceTime;
+    }
+
+    microseconds getPeriod() const { return _period; }
+
+    std::vector<Clock::time_point> serviceTimes;
+    std::vector<qint64> lateness;
+    std::atomic<bool> isFinished { false };
+    std::atomic<bool> wasServicedConcurrently { false };
+
+private:
+    microseconds _period;
+    int _numServices;
+    int _numServiced { 0 };
+    Clock::time_point _nextServiceTime;
+    std::atomic<int> _numInService { 0 };
+};
+
+void SendQueueSchedulerTests::pacingTest() {
+    const int NUM_TASKS = 100;
+    const int NUM_SERVICES = 200;
+
+    SendQueueScheduler scheduler(2);
+
+    std::vector<std::unique_ptr<PacedTask>> tasks;
+    for (int i = 0; i < NUM_TASKS; ++i) {
+        tasks.emplace_back(new PacedTask(microseconds(1000 + 10 * i), NUM_SERVICES));
+    }
+    for (auto& task : tasks) {
+        scheduler.add(task.get());
+    }
+
+    bool allFinished = waitFor([&] {
+        return std::all_of(tasks.begin(), tasks.end(), [](const std::unique_ptr<PacedTask>& task) {
+            return (bool)task->isFinished;
+        });
+    }, seconds(30));
+
+    for (auto& task : tasks) {
+        scheduler.remove(task.get());
+    }
+
+    QVERIFY(allFinished);
+
+    std::vector<qint64> lateness;
+    for (auto& task : tasks) {
+        QVERIFY(!task->wasServicedConcurrently);
+        lateness.insert(lateness.end(), task->lateness.begin(), task->lateness.end());
+    }
+    QCOMPARE((int)lateness.size(), NUM_TASKS * (NUM_SERVICES - 1));
+
+    std::sort(lateness.begin(), lateness.end());
+    auto percentile = [&](int p) { return lateness[lateness.size() * p / 100]; };
+    qDebug() << NUM_TASKS << "tasks on" << scheduler.getNumWorkers() << "workers were serviced late by"
+             << percentile(50) << "us (median)," << percentile(99) << "us (99th percentile)";
+
+    // no task is ever serviced early, and a loaded test machine still shouldn't be off by a whole period
+    QVERIFY(lateness.front() >= 0);
+    QVERIFY(percentile(50) < 1000);
+
+    // the services of every task keep to its configured rate - the median spacing is that of the typical packet,
+    // without the catch up after a hiccup of the test machine
+    const double MAX_SPACING_ERROR = 0.05;
+    for (auto& task : tasks) {
+        std::vector<qint64> spacing;
+        for (size_t i = 1; i < task->serviceTimes.size(); ++i) {
+            spacing.push_back(duration_cast<microseconds>(task->serviceTimes[i] - task->serviceTimes[i - 1]).count());
+        }
+        std::nth_element(spacing.begin(), spacing.begin() + spacing.size() / 2, spacing.end());
+        auto medianSpacing = spacing[spacing.size() / 2];
+        auto period = task->getPeriod().count();
+        QVERIFY2(std::abs(medianSpacing - period) <= MAX_SPACING_ERROR * period,
+                 qPrintable(QString("serviced every %1 us, expected %2 us").arg(medianSpacing).arg(period)));
+    }
+}
+
+class WakeTask : public SendQueueScheduler::Task {
+public:
+    WakeTask(SendQueueScheduler& scheduler) : _scheduler(scheduler) {}
+
+    Clock::time_point service(Clock::time_point now) override {
+        if (++numServiced == 2) {
+            // a wake during service is serviced again straight afterwards
+            _scheduler.wake(this);
+        }
+        return Clock::time_point::max();
+    }
+
+    std::atomic<int> numServiced { 0 };
+
+private:
+    SendQueueScheduler& _scheduler;
+};
+
+void SendQueueSchedulerTests::wakeTest() {
+    SendQueueScheduler scheduler(2);
+    WakeTask task(scheduler);
+
+    scheduler.add(&task);
+    QVERIFY(waitFor([&] { return task.numServiced == 1; }, seconds(5)));
+
+    // a task waiting for a wake isn't serviced again until it gets one
+    std::this_thread::sleep_for(milliseconds(20));
+    QCOMPARE((int)task.numServiced, 1);
+
+    scheduler.wake(&task);
+    QVERIFY(waitFor([&] { return task.numServiced == 3; }, seconds(5)));
+
+    std::this_thread::sleep_for(milliseconds(20));
+    QCOMPARE((int)task.numServiced, 3);
+
+    scheduler.remove(&task);
+
+    // waking a removed task does nothing
+    scheduler.wake(&task);
+    std::this_thread::sleep_for(milliseconds(20));
+    QCOMPARE((int)task.numServiced, 3);
+}
+
+class SlowTask : public SendQueueScheduler::Task {
+public:
+    Clock::time_point service(Clock::time_point now) override {
+        isInService = true;
+        std::this_thread::sleep_for(milliseconds(50));
+        ++numServiced;
+        isInService = false;
+
+        // always ready for more
+        return now;
+    }
+
+    std::atomic<bool> isInService { false };
+    std::atomic<int> numServiced { 0 };
+};
+
+void SendQueueSchedulerTests::removeTest() {
+    SendQueueScheduler scheduler(2);
+    SlowTask task;
+
+    scheduler.add(&task);
+    QVERIFY(waitFor([&] { return (bool)task.isInService; }, seconds(5)));
+
+    scheduler.remove(&task);
+    QVERIFY(!task.isInService);
+
+    int numServiced = task.numServiced;
+    std::this_thread::sleep_for(milliseconds(100));
+    QCOMPARE((int)task.numServiced, numServiced);
+}
@@ -0,0 +1,32 @@
+//
+//  SendQueueSchedulerTests.h
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_SendQueueSchedulerTests_h
+#define overte_SendQueueSchedulerTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SendQueueSchedulerTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test that many paced tasks are all serviced, one worker at a time, and report how late their services were
+    void pacingTest();
+
+    // Test that a task waiting for a wake is serviced once woken, and again straight after a wake during its service
+    void wakeTest();
+
+    // Test that remove waits for a running service and that a removed task is never serviced again
+    void removeTest();
+};
+
+#endif // overte_SendQueueSchedulerTests_h
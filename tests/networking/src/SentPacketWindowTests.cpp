@@ -0,0 +1,180 @@
+//
+//  SentPacketWindowTests.cpp
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "SentPacketWindowTests.h"
+
+#include <atomic>
+#include <thread>
+#include <unordered_map>
+
+#include <QtCore/QElapsedTimer>
+#include <QtCore/QReadWriteLock>
+
+#include <udt/Packet.h>
+#include <udt/SentPacketWindow.h>
+#include <udt/SPSCQueue.h>
+
+QTEST_MAIN(SentPacketWindowTests)
+
+using namespace udt;
+
+static const int NUM_BENCHMARK_PACKETS = 1000000;
+static const int BENCHMARK_FLOW_WINDOW = 1024;
+static const int PACKETS_PER_ACK = 16;
+
+static void reportRate(const char* name, int numPackets, qint64 elapsedNSecs) {
+    double packetsPerSecond = elapsedNSecs > 0 ? (double)numPackets * 1.0e9 / (double)elapsedNSecs : 0.0;
+    qDebug() << name << "queued and ACKed" << numPackets << "packets at" << (quint64)packetsPerSecond << "packets/sec";
+}
+
+void SentPacketWindowTests::windowTest() {
+    SentPacketWindow window;
+    QVERIFY(window.isEmpty());
+    QVERIFY(!window.find(SequenceNumber(0)));
+
+    // start close to the end of the sequence number space so that the run wraps around
+    const int NUM_PACKETS = 200;
+    SequenceNumber first { SequenceNumber::MAX - 50 };
+
+    auto sequenceNumber = first;
+    for (int i = 0; i < NUM_PACKETS; ++i, ++sequenceNumber) {
+        QVERIFY(window.insert(sequenceNumber, Packet::create(-1, true)));
+    }
+    QCOMPARE(window.size(), NUM_PACKETS);
+
+    // every packet is still there after the ring has grown
+    sequenceNumber = first;
+    for (int i = 0; i < NUM_PACKETS; ++i, ++sequenceNumber) {
+        auto entry = window.find(sequenceNumber);
+        QVERIFY(entry);
+        QCOMPARE(entry->sequenceNumber, sequenceNumber);
+        QCOMPARE((int)entry->numResends, 0);
+        QVERIFY(entry->packet);
+    }
+    QVERIFY(!window.find(sequenceNumber));
+    QVERIFY(!window.find(first - 1));
+
+    // release past the wrap
+    auto ack = first + 100;
+    window.releaseUpTo(ack);
+    QCOMPARE(window.size(), NUM_PACKETS - 101);
+    QVERIFY(!window.find(first));
+    QVERIFY(!window.find(ack));
+    QVERIFY(window.find(ack + 1));
+
+    // releasing an old ACK again does nothing
+    window.releaseUpTo(first);
+    QCOMPARE(window.size(), NUM_PACKETS - 101);
+
+    window.releaseUpTo(first + NUM_PACKETS - 1);
+    QVERIFY(window.isEmpty());
+}
+
+void SentPacketWindowTests::spscQueueTest() {
+    const int NUM_ITEMS = 100000;
+    static SPSCQueue<int, 64> queue;
+
+    std::thread producer([] {
+        for (int i = 0; i < NUM_ITEMS; ++i) {
+            while (!queue.push(i)) {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    int expected = 0;
+    int item = -1;
+    while (expected < NUM_ITEMS) {
+        if (queue.pop(item)) {
+            QCOMPARE(item, expected);
+            ++expected;
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    producer.join();
+    QVERIFY(queue.isEmpty());
+    QVERIFY(!queue.pop(item));
+}
+
+// the send thread queues packets as fast as the flow window allows, while the ACK thread ACKs whatever has been sent
+template <typename QueueFunction, typename AckFunction>
+static qint64 runQueueAndACKBenchmark(QueueFunction queuePacket, AckFunction ackPacket) {
+    std::atomic<int> numSent { 0 };
+    std::atomic<int> numACKed { 0 };
+
+    QElapsedTimer timer;
+    timer.start();
+
+    std::thread ackThread([&] {
+        while (numACKed < NUM_BENCHMARK_PACKETS) {
+            int sent = numSent;
+            if (sent - numACKed >= PACKETS_PER_ACK || sent == NUM_BENCHMARK_PACKETS) {
+                ackPacket(SequenceNumber(sent - 1));
+                numACKed = sent;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    });
+
+    for (int i = 0; i < NUM_BENCHMARK_PACKETS; ++i) {
+        while (i - numACKed >= BENCHMARK_FLOW_WINDOW) {
+            std::this_thread::yield();
+        }
+        queuePacket(SequenceNumber(i));
+        numSent = i + 1;
+    }
+
+    ackThread.join();
+    return timer.nsecsElapsed();
+}
+
+void SentPacketWindowTests::mapQueueAndACKBenchmark() {
+    QReadWriteLock sentLock;
+    using PacketResendPair = std::pair<uint8_t, std::unique_ptr<Packet>>;
+    std::unordered_map<SequenceNumber, PacketResendPair> sentPackets;
+    SequenceNumber lastACK { 0 }; // the first sequence number that may still need erasing
+
+    auto elapsed = runQueueAndACKBenchmark([&](SequenceNumber sequenceNumber) {
+        auto packet = Packet::create(-1, true);
+        QWriteLocker locker(&sentLock);
+        auto& entry = sentPackets[sequenceNumber];
+        entry.first = 0;
+        entry.second = std::move(packet);
+    }, [&](SequenceNumber ack) {
+        QWriteLocker locker(&sentLock);
+        for (auto seq = lastACK; seq <= ack; ++seq) {
+            sentPackets.erase(seq);
+        }
+        lastACK = ack;
+    });
+
+    reportRate("unordered_map + QReadWriteLock", NUM_BENCHMARK_PACKETS, elapsed);
+    QVERIFY(sentPackets.empty());
+}
+
+void SentPacketWindowTests::windowQueueAndACKBenchmark() {
+    SentPacketWindow window;
+    std::atomic<uint32_t> lastACK { (uint32_t)SequenceNumber::MAX }; // nothing ACKed yet
+
+    auto elapsed = runQueueAndACKBenchmark([&](SequenceNumber sequenceNumber) {
+        window.releaseUpTo(SequenceNumber(lastACK.load()));
+        window.insert(sequenceNumber, Packet::create(-1, true));
+    }, [&](SequenceNumber ack) {
+        lastACK = (uint32_t)ack;
+    });
+
+    reportRate("udt::SentPacketWindow", NUM_BENCHMARK_PACKETS, elapsed);
+    window.releaseUpTo(SequenceNumber(lastACK.load()));
+    QVERIFY(window.isEmpty());
+}
@@ -0,0 +1,35 @@
+//
+//  SentPacketWindowTests.h
+//  tests/networking/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_SentPacketWindowTests_h
+#define overte_SentPacketWindowTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class SentPacketWindowTests : public QObject {
+    Q_OBJECT
+private slots:
+    // Test insert, find and release, including growing the ring and wrapping the sequence number
+    void windowTest();
+
+    // Test that the SPSC queue hands every item over in order between two threads
+    void spscQueueTest();
+
+    // Measure queue+ACK throughput of the sent packet map and lock SendQueue used to have
+    void mapQueueAndACKBenchmark();
+
+    // Measure queue+ACK throughput of udt::SentPacketWindow with the ACK handed over through an atomic
+    void windowQueueAndACKBenchmark();
+};
+
+#endif // overte_SentPacketWindowTests_h
@@ -0,0 +1,174 @@
+//
+//  EntityEditLockingTests.cpp
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEditLockingTests.h"
+
+#include <atomic>
+#include <thread>
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <NLPacket.h>
+#include <Node.h>
+#include <NodePermissions.h>
+#include <ReceivedMessage.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityEditLockingTests)
+
+static const int BENCHMARK_NUM_ENTITIES = 20000;
+static const int BENCHMARK_NUM_EDITS = 2000;
+
+using EntityTestUtils::addBox;
+using EntityTestUtils::createTree;
+
+static SharedNodePointer createEditor() {
+    SharedNodePointer node(new Node(QUuid::createUuid(), NodeType::Agent, SockAddr(), SockAddr()));
+    NodePermissions permissions;
+    permissions.setAll(true);
+    node->setPermissions(permissions);
+    return node;
+}
+
+static QByteArray encodeEdit(const EntityItemID& entityID, EntityItemProperties properties) {
+    properties.setType(EntityTypes::Box);
+    properties.setLastEdited(usecTimestampNow());
+    QByteArray buffer(NLPacket::maxPayloadSize(PacketType::EntityEdit), 0);
+    EntityPropertyFlags didntFitProperties;
+    EntityItemProperties::encodeEntityEditPacket(PacketType::EntityEdit, entityID, properties, buffer,
+                                                 properties.getChangedProperties(), didntFitProperties);
+    return buffer;
+}
+
+static QSharedPointer<ReceivedMessage> createMessage(const QByteArray& edit) {
+    return QSharedPointer<ReceivedMessage>::create(edit, PacketType::EntityEdit, versionForPacketType(PacketType::EntityEdit),
+                                                   SockAddr());
+}
+
+void EntityEditLockingTests::initTestCase() {
+    EntityTestUtils::setUpEntityServer();
+}
+
+void EntityEditLockingTests::inPlaceEditTest() {
+    auto tree = createTree();
+    auto editor = createEditor();
+    auto entity = addBox(tree, glm::vec3(10.0f));
+    QVERIFY(entity);
+    auto element = entity->getElement();
+    QVERIFY(element);
+    quint64 lastChangedContent = element->getLastChangedContent();
+    quint64 rootLastChanged = tree->getRoot()->getLastChanged();
+
+    EntityItemProperties userDataEdit;
+    userDataEdit.setUserData("{\"edited\":true}");
+    QByteArray edit = encodeEdit(entity->getEntityItemID(), userDataEdit);
+    auto userDataMessage = createMessage(edit);
+    bool processedInPlace = false;
+    int processedBytes = 0;
+    tree->withReadLock([&] {
+        processedInPlace = tree->processEditPacketDataInPlace(*userDataMessage,
+            reinterpret_cast<const unsigned char*>(edit.constData()), edit.size(), editor, processedBytes);
+    });
+    QVERIFY(processedInPlace);
+    QCOMPARE(processedBytes, edit.size());
+    QCOMPARE(entity->getUserData(), QString("{\"edited\":true}"));
+    QVERIFY(entity->getElement() == element);
+    QVERIFY(element->getLastChangedContent() > lastChangedContent);
+    QVERIFY(tree->getRoot()->getLastChanged() > rootLastChanged);
+
+    // moving the entity to another element needs the write lock
+    EntityItemProperties positionEdit;
+    positionEdit.setPosition(glm::vec3(-1000.0f));
+    positionEdit.setQueryAACube(AACube(glm::vec3(-1001.0f), 2.0f));
+    edit = encodeEdit(entity->getEntityItemID(), positionEdit);
+    auto positionMessage = createMessage(edit);
+    tree->withReadLock([&] {
+        processedInPlace = tree->processEditPacketDataInPlace(*positionMessage,
+            reinterpret_cast<const unsigned char*>(edit.constData()), edit.size(), editor, processedBytes);
+    });
+    QVERIFY(!processedInPlace);
+    QVERIFY(entity->getWorldPosition() == glm::vec3(10.0f));
+
+    tree->withWriteLock([&] {
+        processedBytes = tree->processEditPacketData(*positionMessage,
+            reinterpret_cast<const unsigned char*>(edit.constData()), edit.size(), editor);
+    });
+    QCOMPARE(processedBytes, edit.size());
+    QVERIFY(entity->getWorldPosition() == glm::vec3(-1000.0f));
+    QVERIFY(entity->getElement() != element);
+}
+
+void EntityEditLockingTests::editContentionBenchmark_data() {
+    QTest::addColumn<bool>("inPlace");
+    QTest::newRow("writeLock") << false;
+    QTest::newRow("inPlace") << true;
+}
+
+void EntityEditLockingTests::editContentionBenchmark() {
+    QFETCH(bool, inPlace);
+    auto tree = createTree();
+    auto editor = createEditor();
+    QVector<EntityItemPointer> entities;
+    for (int i = 0; i < BENCHMARK_NUM_ENTITIES; ++i) {
+        entities.push_back(addBox(tree, glm::vec3((float)(i % 100) * 10.0f, 0.0f, (float)(i / 100) * 10.0f)));
+    }
+
+    QVector<QByteArray> edits;
+    for (int i = 0; i < BENCHMARK_NUM_EDITS; ++i) {
+        EntityItemProperties properties;
+        properties.setUserData(QString("{\"edit\":%1}").arg(i));
+        edits.push_back(encodeEdit(entities[i % entities.size()]->getEntityItemID(), properties));
+    }
+
+    // stands in for the send threads, each traversal visits every entity
+    std::atomic<bool> isTraversing { true };
+    std::thread traversalThread([&] {
+        while (isTraversing) {
+            QString userData;
+            tree->withReadLock([&] {
+                tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+                    std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                        userData = entity->getUserData();
+                    });
+                    return true;
+                });
+            });
+        }
+    });
+
+    int numInPlace = 0;
+    QBENCHMARK_ONCE {
+        for (const auto& edit : edits) {
+            auto message = createMessage(edit);
+            auto editData = reinterpret_cast<const unsigned char*>(edit.constData());
+            if (inPlace) {
+                bool processedInPlace = false;
+                int processedBytes = 0;
+                tree->withReadLock([&] {
+                    processedInPlace =
+                        tree->processEditPacketDataInPlace(*message, editData, edit.size(), editor, processedBytes);
+                });
+                numInPlace += processedInPlace ? 1 : 0;
+            } else {
+                tree->withWriteLock([&] {
+                    tree->processEditPacketData(*message, editData, edit.size(), editor);
+                });
+            }
+        }
+    }
+
+    isTraversing = false;
+    traversalThread.join();
+    QCOMPARE(numInPlace, inPlace ? BENCHMARK_NUM_EDITS : 0);
+    QCOMPARE(entities[0]->getUserData(), QString("{\"edit\":0}"));
+}
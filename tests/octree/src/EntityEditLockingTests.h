@@ -0,0 +1,32 @@
+//
+//  EntityEditLockingTests.h
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_EntityEditLockingTests_h
+#define overte_EntityEditLockingTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class EntityEditLockingTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that an edit which leaves the entity in its element is applied under the read lock, and one that moves it isn't
+    void inPlaceEditTest();
+
+    // Apply edits while another thread traverses the tree, under the write lock and in place
+    void editContentionBenchmark_data();
+    void editContentionBenchmark();
+};
+
+#endif // overte_EntityEditLockingTests_h
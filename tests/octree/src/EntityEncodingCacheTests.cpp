@@ -0,0 +1,142 @@
+//
+//  EntityEncodingCacheTests.cpp
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityEncodingCacheTests.h"
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntityEncodingCacheTests)
+
+static const int BENCHMARK_NUM_ENTITIES = 2000;
+static const int BENCHMARK_NUM_CLIENTS = 50;
+
+using EntityTestUtils::createTree;
+
+static EntityItemPointer addBox(const EntityTreePointer& tree, const glm::vec3& position) {
+    EntityItemProperties properties;
+    properties.setName("box");
+    properties.setUserData("{ \"grabbableKey\": { \"grabbable\": true } }");
+    return EntityTestUtils::addBox(tree, position, properties);
+}
+
+static QByteArray encode(const EntityItemPointer& entity, bool cached, EncodeBitstreamParams& params) {
+    OctreePacketData packetData;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+    OctreeElement::AppendState appendState = cached ?
+        entity->appendCachedEntityData(&packetData, params, extraEncodeData) :
+        entity->appendEntityData(&packetData, params, extraEncodeData);
+    if (appendState != OctreeElement::COMPLETED) {
+        return QByteArray();
+    }
+    return QByteArray((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+}
+
+static QByteArray encode(const EntityItemPointer& entity, bool cached) {
+    EncodeBitstreamParams params;
+    return encode(entity, cached, params);
+}
+
+void EntityEncodingCacheTests::initTestCase() {
+    EntityTestUtils::setUpEntityServer();
+}
+
+void EntityEncodingCacheTests::cachedEncodingTest() {
+    auto tree = createTree();
+    auto entity = addBox(tree, glm::vec3(10.0f));
+    QVERIFY(entity);
+
+    QByteArray encoded = encode(entity, false);
+    QVERIFY(!encoded.isEmpty());
+    QCOMPARE(encode(entity, true), encoded);
+
+    // the second time comes from the cache, and is still tracked as sent
+    EncodeBitstreamParams params;
+    QUuid sentID;
+    quint64 sentLastEdited = 0;
+    params.trackSend = [&](const QUuid& dataID, quint64 itemLastEdited) {
+        sentID = dataID;
+        sentLastEdited = itemLastEdited;
+    };
+    QCOMPARE(encode(entity, true, params), encoded);
+    QCOMPARE(sentID, entity->getID());
+    QCOMPARE(sentLastEdited, entity->getLastEdited());
+
+    EntityItemProperties properties;
+    properties.setName("edited box");
+    properties.setLastEdited(entity->getLastEdited() + 1);
+    entity->setProperties(properties);
+
+    QByteArray edited = encode(entity, false);
+    QVERIFY(edited != encoded);
+    QCOMPARE(encode(entity, true), edited);
+    QCOMPARE(encode(entity, true), edited);
+}
+
+void EntityEncodingCacheTests::requestedPropertiesTest() {
+    auto tree = createTree();
+    auto entity = addBox(tree, glm::vec3(10.0f));
+    QVERIFY(entity);
+
+    QCOMPARE(encode(entity, true), encode(entity, false));
+
+    // without private user data, for a client that can't see it
+    entity->setPrivateUserData("secret");
+    entity->markAsChangedOnServer();
+    OctreePacketData packetData;
+    EncodeBitstreamParams params;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+    QCOMPARE(entity->appendCachedEntityData(&packetData, params, extraEncodeData, true), OctreeElement::COMPLETED);
+    QByteArray withPrivateUserData((const char*)packetData.getUncompressedData(), packetData.getUncompressedSize());
+    QByteArray withoutPrivateUserData = encode(entity, true);
+    QVERIFY(withPrivateUserData != withoutPrivateUserData);
+    QCOMPARE(withoutPrivateUserData, encode(entity, false));
+}
+
+void EntityEncodingCacheTests::encodeBenchmark_data() {
+    QTest::addColumn<bool>("cached");
+    QTest::newRow("encoded") << false;
+    QTest::newRow("cached") << true;
+}
+
+void EntityEncodingCacheTests::encodeBenchmark() {
+    QFETCH(bool, cached);
+    auto tree = createTree();
+    std::vector<EntityItemPointer> entities;
+    for (int i = 0; i < BENCHMARK_NUM_ENTITIES; ++i) {
+        entities.push_back(addBox(tree, glm::vec3((float)(i % 100), (float)(i / 100), 10.0f)));
+    }
+
+    OctreePacketData packetData;
+    EncodeBitstreamParams params;
+    auto extraEncodeData = std::make_shared<EntityTreeElementExtraEncodeData>();
+    int numEncoded = 0;
+    QBENCHMARK {
+        // each entity is sent to every client, as the send threads would
+        for (int client = 0; client < BENCHMARK_NUM_CLIENTS; ++client) {
+            for (auto& entity : entities) {
+                OctreeElement::AppendState appendState = cached ?
+                    entity->appendCachedEntityData(&packetData, params, extraEncodeData) :
+                    entity->appendEntityData(&packetData, params, extraEncodeData);
+                if (appendState == OctreeElement::COMPLETED) {
+                    ++numEncoded;
+                } else {
+                    packetData.reset();
+                    extraEncodeData->entities.clear();
+                }
+            }
+        }
+    }
+    QVERIFY(numEncoded > 0);
+}
@@ -0,0 +1,35 @@
+//
+//  EntityEncodingCacheTests.h
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_EntityEncodingCacheTests_h
+#define overte_EntityEncodingCacheTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class EntityEncodingCacheTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that the cached encoding matches a fresh one, before and after the entity is edited
+    void cachedEncodingTest();
+
+    // Test that a different set of requested properties isn't given the cached encoding
+    void requestedPropertiesTest();
+
+    // Encode the same entities for many clients, with and without the cache
+    void encodeBenchmark_data();
+    void encodeBenchmark();
+};
+
+#endif // overte_EntityEncodingCacheTests_h
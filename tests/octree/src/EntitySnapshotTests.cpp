@@ -0,0 +1,280 @@
+//
+//  EntitySnapshotTests.cpp
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntitySnapshotTests.h"
+
+#include <QtCore/QTemporaryDir>
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+#include <EntityTreeElement.h>
+#include <OctreeJournal.h>
+#include <OctreeSnapshot.h>
+
+#include "EntityTestUtils.h"
+
+QTEST_MAIN(EntitySnapshotTests)
+
+static const int BENCHMARK_NUM_ENTITIES = 50000;
+
+using EntityTestUtils::createTree;
+
+static QVector<EntityItemPointer> getEntities(const EntityTreePointer& tree) {
+    QVector<EntityItemPointer> entities;
+    tree->withReadLock([&] {
+        tree->recurseTreeWithOperation([&](const OctreeElementPointer& element, void* extraData) {
+            std::static_pointer_cast<EntityTreeElement>(element)->forEachEntity([&](const EntityItemPointer& entity) {
+                entities.push_back(entity);
+            });
+            return true;
+        });
+    });
+    return entities;
+}
+
+// a spread of entity types, with the properties that make up most of the size of real content
+static void addTestEntities(const EntityTreePointer& tree, int numEntities) {
+    for (int i = 0; i < numEntities; ++i) {
+        EntityItemProperties properties;
+        switch (i % 3) {
+            case 0:
+                properties.setType(EntityTypes::Box);
+                break;
+            case 1:
+                properties.setType(EntityTypes::Model);
+                properties.setModelURL(QString("atp:/models/model-%1.fbx").arg(i % 100));
+                break;
+            default:
+                properties.setType(EntityTypes::Text);
+                properties.setText(QString("Sign %1").arg(i));
+                break;
+        }
+        properties.setName(QString("Entity %1").arg(i));
+        properties.setPosition(glm::vec3((float)(i % 97) * 10.0f, (float)(i % 13), (float)(i / 97) * 10.0f));
+        properties.setDimensions(glm::vec3(1.0f + (float)(i % 5)));
+        properties.setUserData(QString("{\"index\":%1,\"grabbableKey\":{\"grabbable\":false}}").arg(i));
+        properties.setPrivateUserData(QString("{\"owner\":%1}").arg(i % 7));
+        tree->withWriteLock([&] {
+            tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+        });
+    }
+}
+
+void EntitySnapshotTests::initTestCase() {
+    EntityTestUtils::setUpEntityServer();
+}
+
+void EntitySnapshotTests::roundTripTest() {
+    QTemporaryDir dir;
+    QString fileName = dir.filePath("models." + SNAPSHOT_FILE_TYPE);
+
+    auto tree = createTree();
+    addTestEntities(tree, 100);
+
+    auto parent = getEntities(tree).value(0);
+    QVERIFY(parent);
+    EntityItemProperties childProperties;
+    childProperties.setType(EntityTypes::Box);
+    childProperties.setParentID(parent->getID());
+    childProperties.setLocalPosition(glm::vec3(0.0f, 2.0f, 0.0f));
+    tree->withWriteLock([&] {
+        tree->addEntity(EntityItemID(QUuid::createUuid()), childProperties);
+    });
+
+    tree->setOctreeVersionInfo(QUuid::createUuid(), 42);
+    QVERIFY(tree->writeToSnapshotFile(fileName.toLocal8Bit().constData()));
+
+    auto loadedTree = createTree();
+    bool success = false;
+    loadedTree->withWriteLock([&] {
+        success = loadedTree->readFromSnapshotFile(fileName);
+    });
+    QVERIFY(success);
+    QCOMPARE(loadedTree->getPersistID(), tree->getPersistID());
+    QCOMPARE(loadedTree->getPersistDataVersion(), tree->getPersistDataVersion());
+
+    auto entities = getEntities(tree);
+    QCOMPARE(entities.size(), 101);
+    QCOMPARE(getEntities(loadedTree).size(), entities.size());
+    for (const auto& entity : entities) {
+        auto loadedEntity = loadedTree->findEntityByID(entity->getID());
+        QVERIFY(loadedEntity);
+
+        auto properties = entity->getProperties();
+        auto loadedProperties = loadedEntity->getProperties();
+        QCOMPARE(loadedProperties.getType(), properties.getType());
+        QCOMPARE(loadedProperties.getName(), properties.getName());
+        QCOMPARE(loadedProperties.getPosition(), properties.getPosition());
+        QCOMPARE(loadedProperties.getDimensions(), properties.getDimensions());
+        QCOMPARE(loadedProperties.getUserData(), properties.getUserData());
+        QCOMPARE(loadedProperties.getPrivateUserData(), properties.getPrivateUserData());
+        QCOMPARE(loadedProperties.getModelURL(), properties.getModelURL());
+        QCOMPARE(loadedProperties.getText(), properties.getText());
+        QCOMPARE(loadedProperties.getParentID(), properties.getParentID());
+        QCOMPARE(loadedProperties.getCreated(), properties.getCreated());
+    }
+}
+
+void EntitySnapshotTests::invalidSnapshotTest() {
+    QTemporaryDir dir;
+    QString fileName = dir.filePath("models." + SNAPSHOT_FILE_TYPE);
+
+    auto tree = createTree();
+    addTestEntities(tree, 10);
+    QVERIFY(tree->writeToSnapshotFile(fileName.toLocal8Bit().constData()));
+
+    QFile file(fileName);
+    QVERIFY(file.open(QIODevice::ReadWrite));
+    QByteArray contents = file.readAll();
+
+    // the data packet version follows the magic, file version and data packet type
+    const int DATA_PACKET_VERSION_OFFSET = 12;
+    QByteArray otherVersion = contents;
+    ++otherVersion[DATA_PACKET_VERSION_OFFSET];
+    QVERIFY(file.seek(0));
+    QCOMPARE(file.write(otherVersion), (qint64)otherVersion.size());
+    file.close();
+    QVERIFY(!createTree()->readFromSnapshotFile(fileName));
+
+    QVERIFY(file.open(QIODevice::WriteOnly | QIODevice::Truncate));
+    QCOMPARE(file.write(contents.left(contents.size() - 1)), (qint64)contents.size() - 1);
+    file.close();
+    QVERIFY(!createTree()->readFromSnapshotFile(fileName));
+}
+
+void EntitySnapshotTests::journalReplayTest() {
+    QTemporaryDir dir;
+    QString snapshotFileName = dir.filePath("models." + SNAPSHOT_FILE_TYPE);
+    QString journalFileName = dir.filePath("models.journal");
+
+    auto tree = createTree();
+    addTestEntities(tree, 30);
+    tree->setIsJournaled(true);
+    QVERIFY(tree->writeToSnapshotFile(snapshotFileName.toLocal8Bit().constData()));
+    QVERIFY(tree->createJournalFile(journalFileName));
+    auto snapshotDataVersion = tree->getPersistDataVersion();
+
+    auto entities = getEntities(tree);
+    EntityItemID editedID = entities[0]->getEntityItemID();
+    EntityItemID deletedID = entities[1]->getEntityItemID();
+    EntityItemID addedID(QUuid::createUuid());
+
+    quint64 sinceTime = usecTimestampNow();
+    QTest::qSleep(1);
+
+    // edited as the entity server does
+    EntityItemProperties editProperties;
+    editProperties.setName("Edited");
+    editProperties.setLastEdited(usecTimestampNow());
+    EntityItemProperties addProperties;
+    addProperties.setType(EntityTypes::Sphere);
+    addProperties.setName("Added");
+    bool updated = false;
+    tree->withWriteLock([&] {
+        updated = tree->updateEntity(editedID, editProperties);
+        tree->findEntityByID(editedID)->markAsChangedOnServer();
+        tree->deleteEntity(deletedID, true);
+        tree->addEntity(addedID, addProperties)->markAsChangedOnServer();
+    });
+    QVERIFY(updated);
+
+    tree->incrementPersistDataVersion();
+    QVERIFY(tree->appendToJournalFile(journalFileName, sinceTime));
+
+    {
+        // only what changed is journaled
+        OctreeJournalReader journal;
+        QVERIFY(journal.open(journalFileName, tree->expectedDataPacketType(), tree->getPersistID(), snapshotDataVersion));
+        QCOMPARE(journal.getNumRecords(), 3);
+        QCOMPARE(journal.getDataVersion(), tree->getPersistDataVersion());
+        QVERIFY(!journal.hasUncommittedRecords());
+    }
+
+    auto loadAndCheck = [&] {
+        auto loadedTree = createTree();
+        bool loaded = false;
+        loadedTree->withWriteLock([&] {
+            loaded = loadedTree->readFromSnapshotFile(snapshotFileName, journalFileName);
+        });
+        QVERIFY(loaded);
+        QCOMPARE(loadedTree->getPersistDataVersion(), tree->getPersistDataVersion());
+        QCOMPARE(getEntities(loadedTree).size(), 30);
+        QVERIFY(loadedTree->findEntityByID(editedID));
+        QCOMPARE(loadedTree->findEntityByID(editedID)->getName(), QString("Edited"));
+        QVERIFY(!loadedTree->findEntityByID(deletedID));
+        QVERIFY(loadedTree->findEntityByID(addedID));
+        QCOMPARE(loadedTree->findEntityByID(addedID)->getName(), QString("Added"));
+    };
+    loadAndCheck();
+
+    // a batch that was cut short isn't replayed
+    QFile journalFile(journalFileName);
+    QVERIFY(journalFile.open(QIODevice::WriteOnly | QIODevice::Append));
+    QCOMPARE(journalFile.write(QByteArray(3, 0)), (qint64)3);
+    journalFile.close();
+    {
+        OctreeJournalReader journal;
+        QVERIFY(journal.open(journalFileName, tree->expectedDataPacketType(), tree->getPersistID(), snapshotDataVersion));
+        QVERIFY(journal.hasUncommittedRecords());
+    }
+    loadAndCheck();
+
+    // the journal of an earlier snapshot isn't replayed over a later one
+    tree->incrementPersistDataVersion();
+    QVERIFY(tree->writeToSnapshotFile(snapshotFileName.toLocal8Bit().constData()));
+    loadAndCheck();
+}
+
+void EntitySnapshotTests::saveBenchmark_data() {
+    QTest::addColumn<QString>("fileType");
+    QTest::newRow("json.gz") << QString("json.gz");
+    QTest::newRow(SNAPSHOT_FILE_TYPE.toLatin1().constData()) << SNAPSHOT_FILE_TYPE;
+}
+
+void EntitySnapshotTests::saveBenchmark() {
+    QFETCH(QString, fileType);
+    QTemporaryDir dir;
+    QString fileName = dir.filePath("models." + fileType);
+
+    auto tree = createTree();
+    addTestEntities(tree, BENCHMARK_NUM_ENTITIES);
+
+    bool success = false;
+    QBENCHMARK_ONCE {
+        success = tree->writeToFile(fileName.toLocal8Bit().constData(), nullptr, fileType);
+    }
+    QVERIFY(success);
+}
+
+void EntitySnapshotTests::loadBenchmark_data() {
+    saveBenchmark_data();
+}
+
+void EntitySnapshotTests::loadBenchmark() {
+    QFETCH(QString, fileType);
+    QTemporaryDir dir;
+    QString fileName = dir.filePath("models." + fileType);
+
+    auto tree = createTree();
+    addTestEntities(tree, BENCHMARK_NUM_ENTITIES);
+    QVERIFY(tree->writeToFile(fileName.toLocal8Bit().constData(), nullptr, fileType));
+
+    auto loadedTree = createTree();
+    bool success = false;
+    QBENCHMARK_ONCE {
+        loadedTree->withWriteLock([&] {
+            success = fileType == SNAPSHOT_FILE_TYPE ? loadedTree->readFromSnapshotFile(fileName) :
+                                                       loadedTree->readJSONFromGzippedFile(fileName);
+        });
+    }
+    QVERIFY(success);
+    QCOMPARE(getEntities(loadedTree).size(), BENCHMARK_NUM_ENTITIES);
+}
@@ -0,0 +1,42 @@
+//
+//  EntitySnapshotTests.h
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_EntitySnapshotTests_h
+#define overte_EntitySnapshotTests_h
+
+#pragma once
+
+#include <QtTest/QtTest>
+
+class EntitySnapshotTests : public QObject {
+    Q_OBJECT
+private slots:
+    void initTestCase();
+
+    // Test that the entities read from a snapshot have the properties they were written with
+    void roundTripTest();
+
+    // Test that a snapshot of another data version, or one cut short, isn't read
+    void invalidSnapshotTest();
+
+    // Test that the changes journaled since a snapshot are replayed over it, and only those that were committed
+    void journalReplayTest();
+
+    // Save a large tree as gzipped JSON and as a snapshot
+    void saveBenchmark_data();
+    void saveBenchmark();
+
+    // Load a large tree from gzipped JSON and from a snapshot
+    void loadBenchmark_data();
+    void loadBenchmark();
+};
+
+#endif // overte_EntitySnapshotTests_h
@@ -0,0 +1,43 @@
+//
+//  EntityTestUtils.cpp
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "EntityTestUtils.h"
+
+#include <DependencyManager.h>
+#include <LimitedNodeList.h>
+#include <NodeList.h>
+
+namespace EntityTestUtils {
+
+void setUpEntityServer() {
+    DependencyManager::registerInheritance<LimitedNodeList, NodeList>();
+    DependencyManager::set<NodeList>(NodeType::EntityServer, INVALID_PORT);
+}
+
+EntityTreePointer createTree() {
+    EntityTreePointer tree = std::make_shared<EntityTree>();
+    tree->createRootElement();
+    tree->setIsServer(true);
+    return tree;
+}
+
+EntityItemPointer addBox(const EntityTreePointer& tree, const glm::vec3& position, EntityItemProperties properties) {
+    properties.setType(EntityTypes::Box);
+    properties.setPosition(position);
+    properties.setDimensions(glm::vec3(1.0f));
+    EntityItemPointer entity;
+    tree->withWriteLock([&] {
+        entity = tree->addEntity(EntityItemID(QUuid::createUuid()), properties);
+    });
+    return entity;
+}
+
+}
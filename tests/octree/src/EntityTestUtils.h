@@ -0,0 +1,37 @@
+//
+//  EntityTestUtils.h
+//  tests/octree/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_EntityTestUtils_h
+#define overte_EntityTestUtils_h
+
+#pragma once
+
+#include <glm/glm.hpp>
+
+#include <EntityItemProperties.h>
+#include <EntityTree.h>
+
+// Shared by the entity tests, which run the tree as the entity server does
+namespace EntityTestUtils {
+
+// Sets up the NodeList the tree uses, as an entity server's - call it from initTestCase()
+void setUpEntityServer();
+
+// An empty tree with its root element, that considers itself the server
+EntityTreePointer createTree();
+
+// Adds a 1m box at position, with whatever other properties are given
+EntityItemPointer addBox(const EntityTreePointer& tree, const glm::vec3& position,
+                         EntityItemProperties properties = EntityItemProperties());
+
+}
+
+#endif // overte_EntityTestUtils_h
@@ -58,6 +58,10 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
     const QCommandLineOption listenPortOption("listenPort", "listen port", QString::number(INVALID_PORT));
     parser.addOption(listenPortOption);
 
+    const QCommandLineOption stopAfterOption("stop-after",
+        "stop a download once this many bytes are in, running again resumes it", "bytes");
+    parser.addOption(stopAfterOption);
+
     if (!parser.parse(QCoreApplication::arguments())) {
         qCritical() << parser.errorText() << Qt::endl;
         parser.showHelp();
@@ -126,6 +130,10 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
         _listenPort = parser.value(listenPortOption).toInt();
     }
 
+    if (parser.isSet(stopAfterOption)) {
+        _stopAfterBytes = parser.value(stopAfterOption).toLongLong();
+    }
+
     _domainServerAddress = QString("127.0.0.1") + ":" + QString::number(domainPort);
     if (parser.isSet(domainAddressOption)) {
         _domainServerAddress = parser.value(domainAddressOption);
@@ -206,7 +214,7 @@ ATPClientApp::ATPClientApp(int argc, char* argv[]) :
 
     DependencyManager::get<AddressManager>()->handleLookupString(_domainServerAddress, false);
 
-    QTimer* _timeoutTimer = new QTimer(this);
+    _timeoutTimer = new QTimer(this);
     _timeoutTimer->setSingleShot(true);
     connect(_timeoutTimer, &QTimer::timeout, this, &ATPClientApp::timedOut);
     _timeoutTimer->start(TIMEOUT_MILLISECONDS);
@@ -365,27 +373,46 @@ void ATPClientApp::download(AssetUtils::AssetHash hash) {
     auto assetClient = DependencyManager::get<AssetClient>();
     auto assetRequest = new AssetRequest(hash);
 
+    connect(assetRequest, &AssetRequest::progress, this, [this, assetRequest](qint64 totalReceived, qint64 total) {
+        // a large download can take longer than the timeout, as long as it keeps going
+        _timeoutTimer->start(TIMEOUT_MILLISECONDS);
+
+        if (_verbose) {
+            qDebug() << "received" << totalReceived << "of" << total << "bytes";
+        }
+
+        if (_stopAfterBytes >= 0 && totalReceived >= _stopAfterBytes && assetRequest->getState() != AssetRequest::Finished) {
+            qDebug() << "stopping the download after" << totalReceived << "bytes";
+            assetRequest->deleteLater();
+            finish(2);
+        }
+    });
+
     connect(assetRequest, &AssetRequest::finished, this, [this](AssetRequest* request) mutable {
         Q_ASSERT(request->getState() == AssetRequest::Finished);
 
+        int exitCode = 0;
         if (request->getError() == AssetRequest::Error::NoError) {
-            QString data = QString::fromUtf8(request->getData());
             if (_localOutputFile == "" || _localOutputFile == "-") {
-                QTextStream cout(stdout);
-                cout << data;
+                QFile cout;
+                cout.open(stdout, QIODevice::WriteOnly);
+                cout.write(request->getData());
             } else {
                 QFile outputHandle(_localOutputFile);
-                if (outputHandle.open(QIODevice::ReadWrite)) {
-                    QTextStream stream( &outputHandle );
-                    stream << data;
+                if (outputHandle.open(QIODevice::WriteOnly | QIODevice::Truncate)) {
+                    outputHandle.write(request->getData());
                 } else {
                     qDebug() << "couldn't open output file:" << _localOutputFile;
+                    exitCode = 1;
                 }
             }
+        } else {
+            qDebug() << "download failed:" << request->getErrorString();
+            exitCode = 1;
         }
 
         request->deleteLater();
-        finish(0);
+        finish(exitCode);
     });
 
     assetRequest->start();
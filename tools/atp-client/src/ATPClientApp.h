@@ -54,6 +54,7 @@ private:
     QString _localUploadFile;
 
     int _listenPort { INVALID_PORT };
+    qint64 _stopAfterBytes { -1 };
 
     QString _domainServerAddress;
 
@@ -15,7 +15,13 @@
 #include <QImageReader>
 #include <QtCore/QDebug>
 #include <QFile>
+#include <QtCore/QJsonDocument>
+#include <QtCore/QJsonObject>
 
+#include <cstdio>
+#include <iostream>
+#include <string>
+#include <thread>
 #include <unordered_map>
 
 #include "OvenCLIApplication.h"
@@ -29,6 +35,46 @@ BakerCLI::BakerCLI(OvenCLIApplication* parent) : QObject(parent) {
 
 }
 
+void BakerCLI::startWorker() {
+    _isWorker = true;
+
+    // stdin can't be waited on through the event loop everywhere, it is read on a thread of its own
+    std::thread([this] {
+        std::string line;
+        while (std::getline(std::cin, line)) {
+            QMetaObject::invokeMethod(this, "bakeJob", Qt::QueuedConnection,
+                                      Q_ARG(QString, QString::fromStdString(line).trimmed()));
+        }
+        QMetaObject::invokeMethod(QCoreApplication::instance(), "quit", Qt::QueuedConnection);
+    }).detach();
+}
+
+void BakerCLI::bakeJob(const QString& job) {
+    if (job.isEmpty()) {
+        return;
+    }
+
+    // the asset server waits for the result of a job before it sends the next one
+    auto jobObject = QJsonDocument::fromJson(job.toUtf8()).object();
+    bakeFile(QUrl(QDir::fromNativeSeparators(jobObject["input"].toString())),
+             QDir::fromNativeSeparators(jobObject["output"].toString()), jobObject["type"].toString());
+}
+
+void BakerCLI::finishBake(int exitCode) {
+    if (!_isWorker) {
+        QCoreApplication::exit(exitCode);
+        return;
+    }
+
+    if (_baker) {
+        _baker.release()->deleteLater();
+    }
+
+    // log lines go to stdout as well, the result goes on a line of its own
+    fprintf(stdout, "\n%s %d\n", qPrintable(OVEN_BAKE_RESULT_PREFIX), exitCode);
+    fflush(stdout);
+}
+
 void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type) {
 
     // if the URL doesn't have a scheme, assume it is a local file
@@ -91,7 +137,8 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
             auto it = STRING_TO_TEXTURE_USAGE_TYPE_MAP.find(type);
             if (it == STRING_TO_TEXTURE_USAGE_TYPE_MAP.end()) {
                 qCDebug(model_baking) << "Unknown texture usage type:" << type;
-                QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+                finishBake(OVEN_STATUS_CODE_FAIL);
+                return;
             }
             _baker = std::unique_ptr<Baker> { new TextureBaker(inputUrl, it->second, outputPath) };
             _baker->moveToThread(Oven::instance().getNextWorkerThread());
@@ -100,7 +147,7 @@ void BakerCLI::bakeFile(QUrl inputUrl, const QString& outputPath, const QString&
 
     if (!_baker) {
         qCDebug(model_baking) << "Failed to determine baker type for file" << inputUrl;
-        QCoreApplication::exit(OVEN_STATUS_CODE_FAIL);
+        finishBake(OVEN_STATUS_CODE_FAIL);
         return;
     }
 
@@ -125,5 +172,5 @@ void BakerCLI::handleFinishedBaker() {
             errorFile.close();
         }
     }
-    QCoreApplication::exit(exitCode);
+    finishBake(exitCode);
 }
@@ -27,21 +27,31 @@ static const int OVEN_STATUS_CODE_ABORT { 2 };
 
 static const QString OVEN_ERROR_FILENAME = "errors.txt";
 
+// In worker mode the result of each bake is written to stdout on its own line, after this prefix
+static const QString OVEN_BAKE_RESULT_PREFIX = "OVEN_BAKE_RESULT";
+
 class BakerCLI : public QObject {
     Q_OBJECT
 
 public:
     BakerCLI(OvenCLIApplication* parent);
 
+    // Bakes the jobs read from stdin one after another, until stdin is closed
+    void startWorker();
+
 public slots:
     void bakeFile(QUrl inputUrl, const QString& outputPath, const QString& type = QString());
 
 private slots:
     void handleFinishedBaker();  
+    void bakeJob(const QString& job);
 
 private:
+    void finishBake(int exitCode);
+
     QDir _outputPath;
     std::unique_ptr<Baker> _baker;
+    bool _isWorker { false };
 };
 
 #endif // hifi_BakerCLI_h
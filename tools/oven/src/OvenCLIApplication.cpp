@@ -25,17 +25,23 @@ static const QString CLI_INPUT_PARAMETER = "i";
 static const QString CLI_OUTPUT_PARAMETER = "o";
 static const QString CLI_TYPE_PARAMETER = "t";
 static const QString CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER = "disable-texture-compression";
+static const QString CLI_WORKER_PARAMETER = "worker";
 
 QUrl OvenCLIApplication::_inputUrlParameter;
 QUrl OvenCLIApplication::_outputUrlParameter;
 QString OvenCLIApplication::_typeParameter;
+bool OvenCLIApplication::_workerParameter { false };
 
 OvenCLIApplication::OvenCLIApplication(int argc, char* argv[]) :
     QCoreApplication(argc, argv)
 {
     BakerCLI* cli = new BakerCLI(this);
-    QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
-                              Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
+    if (_workerParameter) {
+        cli->startWorker();
+    } else {
+        QMetaObject::invokeMethod(cli, "bakeFile", Qt::QueuedConnection, Q_ARG(QUrl, _inputUrlParameter),
+                                  Q_ARG(QString, _outputUrlParameter.toString()), Q_ARG(QString, _typeParameter));
+    }
 }
 
 OvenCLIApplication::parseResult OvenCLIApplication::parseCommandLine(int argc, char* argv[], bool &enableCrashHandler) {
@@ -47,7 +53,9 @@ OvenCLIApplication::parseResult OvenCLIApplication::parseCommandLine(int argc, c
         { CLI_INPUT_PARAMETER, "Path to file that you would like to bake.", "input" },
         { CLI_OUTPUT_PARAMETER, "Path to folder that will be used as output.", "output" },
         { CLI_TYPE_PARAMETER, "Type of asset. [model|material]"/*|js]"*/, "type" },
-        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." }
+        { CLI_DISABLE_TEXTURE_COMPRESSION_PARAMETER, "Disable texture compression." },
+        { CLI_WORKER_PARAMETER, "Bake the jobs read from stdin, one JSON object with input, output and type per line, "
+                                "reporting the result of each on stdout." }
     });
 
 
@@ -92,6 +100,11 @@ OvenCLIApplication::parseResult OvenCLIApplication::parseCommandLine(int argc, c
         Q_UNREACHABLE();
     }
 
+    if (parser.isSet(CLI_WORKER_PARAMETER)) {
+        _workerParameter = true;
+        return OvenCLIApplication::CLIMode;
+    }
+
     if (parser.isSet(CLI_INPUT_PARAMETER) &&  parser.isSet(CLI_OUTPUT_PARAMETER)) {
         _inputUrlParameter = QDir::fromNativeSeparators(parser.value(CLI_INPUT_PARAMETER));
         _outputUrlParameter = QDir::fromNativeSeparators(parser.value(CLI_OUTPUT_PARAMETER));
@@ -0,0 +1,241 @@
+//
+//  LinkSimulation.cpp
+//  tools/udt-test/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#include "LinkSimulation.h"
+
+#include <algorithm>
+#include <queue>
+#include <thread>
+#include <vector>
+
+#include <udt/Constants.h>
+#include <udt/LossList.h>
+
+using namespace udt;
+using namespace std::chrono;
+
+using Clock = p_high_resolution_clock;
+
+namespace {
+
+struct Event {
+    enum Type { DataArrival, ACKArrival };
+
+    Clock::time_point time;
+    Type type;
+    SequenceNumber sequenceNumber;
+
+    bool operator>(const Event& other) const { return time > other.time; }
+};
+
+}
+
+LinkSimulation::Results LinkSimulation::run(CongestionControl& congestionControl) {
+    static const double BITS_PER_BYTE = 8.0;
+    static const double BITS_PER_MEGABIT = 1000000.0;
+
+    // these mirror the clamps SendQueue puts on the estimated timeout
+    static const microseconds MINIMUM_ESTIMATED_TIMEOUT = milliseconds(10);
+    static const microseconds MAXIMUM_ESTIMATED_TIMEOUT = seconds(5);
+
+    // waits shorter than this are spun out, so the pacing isn't at the mercy of the sleep granularity
+    static const microseconds SPIN_THRESHOLD = microseconds(200);
+
+    const int packetSize = MAX_PACKET_SIZE;
+    const auto serviceTime = duration_cast<Clock::duration>(
+        duration<double>(packetSize * BITS_PER_BYTE / (_parameters.bandwidth * BITS_PER_MEGABIT)));
+    const auto oneWayDelay = duration_cast<Clock::duration>(milliseconds(_parameters.rtt) / 2);
+
+    int queueSize = _parameters.queueSize;
+    if (queueSize < 0) {
+        queueSize = std::max(1, (int)(duration_cast<Clock::duration>(milliseconds(_parameters.rtt)) / serviceTime));
+    }
+
+    std::uniform_real_distribution<double> lossDistribution(0.0, 1.0);
+    std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events;
+
+    Results results;
+    int64_t deliveredPackets = 0;
+    Clock::duration totalQueueDelay { 0 };
+
+    // sender state, as in SendQueue
+    SequenceNumber currentSequenceNumber { (SequenceNumber::UType)(_generator() & SequenceNumber::MAX) };
+    SequenceNumber lastACK = currentSequenceNumber;
+    LossList naks;
+    auto nextPacketTimestamp = Clock::now();
+    auto lastPacketSentAt = nextPacketTimestamp;
+    auto stuckTimestamp = Clock::time_point::max();
+
+    // receiver state, as in Connection
+    SequenceNumber lastReceivedSequenceNumber = currentSequenceNumber;
+    LossList receiverLossList;
+
+    // the link
+    auto linkFreeTime = Clock::time_point();
+
+    congestionControl.setMSS(packetSize);
+    congestionControl.setMaxBandwidth(-1);
+    congestionControl.init();
+    congestionControl.setInitialSendSequenceNumber(currentSequenceNumber);
+
+    auto sendToLink = [&](SequenceNumber sequenceNumber, Clock::time_point now) {
+        if (lossDistribution(_generator) < _parameters.lossRate) {
+            ++results.droppedPackets;
+            return;
+        }
+
+        auto queueDelay = std::max(linkFreeTime, now) - now;
+        if (queueDelay / serviceTime >= queueSize) {
+            ++results.droppedPackets;
+            return;
+        }
+
+        totalQueueDelay += queueDelay;
+        linkFreeTime = now + queueDelay + serviceTime;
+        events.push({ linkFreeTime + oneWayDelay, Event::DataArrival, sequenceNumber });
+    };
+
+    auto receive = [&](SequenceNumber sequenceNumber, Clock::time_point now) {
+        bool wasDuplicate = false;
+
+        if (sequenceNumber > lastReceivedSequenceNumber + 1) {
+            receiverLossList.append(lastReceivedSequenceNumber + 1, sequenceNumber - 1);
+        }
+
+        if (sequenceNumber > lastReceivedSequenceNumber) {
+            lastReceivedSequenceNumber = sequenceNumber;
+        } else {
+            wasDuplicate = !receiverLossList.remove(sequenceNumber);
+        }
+
+        if (!wasDuplicate) {
+            ++deliveredPackets;
+        }
+
+        auto ack = receiverLossList.isEmpty() ? lastReceivedSequenceNumber
+                                              : receiverLossList.getFirstSequenceNumber() - 1;
+        events.push({ now + oneWayDelay, Event::ACKArrival, ack });
+    };
+
+    auto processACK = [&](SequenceNumber ack, Clock::time_point now) {
+        if (ack < lastACK) {
+            return;
+        }
+
+        if (ack > lastACK) {
+            lastACK = ack;
+            if (!naks.isEmpty() && naks.getFirstSequenceNumber() <= ack) {
+                naks.remove(naks.getFirstSequenceNumber(), ack);
+            }
+        }
+
+        congestionControl.setSendCurrentSequenceNumber(currentSequenceNumber);
+        if (congestionControl.onACK(ack, now) && ack + 1 <= currentSequenceNumber) {
+            naks.insert(ack + 1, ack + 1);
+        }
+    };
+
+    auto trySendPacket = [&](Clock::time_point now) {
+        while (!naks.isEmpty()) {
+            auto sequenceNumber = naks.popFirstSequenceNumber();
+            if (sequenceNumber > lastACK) {
+                congestionControl.onPacketReSent(packetSize, sequenceNumber, now);
+                sendToLink(sequenceNumber, now);
+                ++results.resentPackets;
+                return true;
+            }
+        }
+
+        int packetsInFlight = seqlen(lastACK, currentSequenceNumber);
+        bool isFlowWindowFull = packetsInFlight > congestionControl._congestionWindowSize
+            || packetsInFlight > MAX_PACKETS_IN_FLIGHT;
+        if (isFlowWindowFull) {
+            return false;
+        }
+
+        ++currentSequenceNumber;
+        congestionControl.onPacketSent(packetSize, currentSequenceNumber, now);
+        sendToLink(currentSequenceNumber, now);
+        ++results.sentPackets;
+        return true;
+    };
+
+    auto start = Clock::now();
+    auto end = start + seconds(_parameters.duration);
+
+    while (true) {
+        auto now = Clock::now();
+        if (now >= end) {
+            break;
+        }
+
+        while (!events.empty() && events.top().time <= now) {
+            auto event = events.top();
+            events.pop();
+
+            if (event.type == Event::DataArrival) {
+                receive(event.sequenceNumber, now);
+            } else {
+                processACK(event.sequenceNumber, now);
+            }
+        }
+
+        auto nextWakeTime = events.empty() ? end : std::min(end, events.top().time);
+
+        if (now >= nextPacketTimestamp) {
+            if (trySendPacket(now)) {
+                lastPacketSentAt = now;
+                stuckTimestamp = Clock::time_point::max();
+
+                auto packetSendPeriod = duration_cast<Clock::duration>(
+                    duration<double, std::micro>(congestionControl._packetSendPeriod));
+
+                // make up for at most one period we've fallen behind, rather than bursting to catch up on the schedule
+                nextPacketTimestamp = std::max(nextPacketTimestamp + packetSendPeriod, now - packetSendPeriod);
+                continue;
+            }
+
+            if (lastACK < currentSequenceNumber) {
+                auto estimatedTimeout = std::min(MAXIMUM_ESTIMATED_TIMEOUT,
+                    std::max(MINIMUM_ESTIMATED_TIMEOUT, microseconds(congestionControl.estimatedTimeout())));
+
+                if (stuckTimestamp == Clock::time_point::max()) {
+                    stuckTimestamp = now + estimatedTimeout;
+                } else if (now >= stuckTimestamp || now - lastPacketSentAt > estimatedTimeout) {
+                    naks.append(lastACK + 1, currentSequenceNumber);
+                    stuckTimestamp = Clock::time_point::max();
+                    congestionControl.onTimeout();
+                    ++results.timeouts;
+                    continue;
+                }
+                nextWakeTime = std::min(nextWakeTime, stuckTimestamp);
+            }
+        } else {
+            nextWakeTime = std::min(nextWakeTime, nextPacketTimestamp);
+        }
+
+        if (nextWakeTime - Clock::now() > SPIN_THRESHOLD) {
+            std::this_thread::sleep_until(nextWakeTime - SPIN_THRESHOLD);
+        } else {
+            std::this_thread::yield();
+        }
+    }
+
+    auto elapsed = duration<double>(Clock::now() - start).count();
+    results.goodput = deliveredPackets * packetSize * BITS_PER_BYTE / BITS_PER_MEGABIT / elapsed;
+
+    int64_t queuedPackets = results.sentPackets + results.resentPackets - results.droppedPackets;
+    if (queuedPackets > 0) {
+        results.averageQueueDelay = duration<double, std::milli>(totalQueueDelay).count() / queuedPackets;
+    }
+
+    return results;
+}
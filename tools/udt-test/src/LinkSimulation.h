@@ -0,0 +1,58 @@
+//
+//  LinkSimulation.h
+//  tools/udt-test/src
+//
+//  Created by Overte e.V. on 2026-10-16.
+//  Copyright 2026 Overte e.V.
+//
+//  Distributed under the Apache License, Version 2.0.
+//  See the accompanying file LICENSE or http://www.apache.org/licenses/LICENSE-2.0.html
+//
+
+#ifndef overte_LinkSimulation_h
+#define overte_LinkSimulation_h
+
+#include <cstdint>
+#include <random>
+
+#include <udt/CongestionControl.h>
+
+/// @brief Runs a congestion control against a simulated bottleneck link.
+/// @details The link has a fixed bandwidth, a drop-tail queue in front of it, a fixed propagation delay, and drops
+/// packets at random before they reach the queue. The sender and receiver are modelled on <code>SendQueue</code> and
+/// <code>Connection</code> - packets are paced at the congestion control's send period inside its congestion window,
+/// losses are re-sent first, the receiver ACKs every packet cumulatively, and ACKs travel back without loss.
+/// <p>The simulation runs in real time on the calling thread, since the congestion controls read the clock themselves.</p>
+class LinkSimulation {
+public:
+    struct Parameters {
+        double bandwidth { 20.0 }; // Mb/s
+        int rtt { 50 }; // round-trip propagation delay, in milliseconds
+        double lossRate { 0.0 }; // chance of losing each packet, 0 to 1
+        int queueSize { -1 }; // in packets, -1 for one bandwidth-delay product
+        int duration { 10 }; // in seconds
+    };
+
+    struct Results {
+        double goodput { 0.0 }; // unique packets delivered, in Mb/s
+        int64_t sentPackets { 0 };
+        int64_t resentPackets { 0 };
+        int64_t droppedPackets { 0 }; // dropped at random or at the queue
+        int64_t timeouts { 0 };
+        double averageQueueDelay { 0.0 }; // in milliseconds
+    };
+
+    LinkSimulation(const Parameters& parameters) : _parameters(parameters) {}
+
+    /// @brief Runs a transfer with an unlimited amount of data to send, for the duration.
+    /// @param congestionControl A freshly created congestion control.
+    /// @return What made it through the link.
+    Results run(udt::CongestionControl& congestionControl);
+
+private:
+    Parameters _parameters;
+
+    std::mt19937 _generator { 742272 };
+};
+
+#endif // overte_LinkSimulation_h
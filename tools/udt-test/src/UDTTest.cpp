@@ -20,6 +20,8 @@
 
 #include <LogHandler.h>
 
+#include "LinkSimulation.h"
+
 const QCommandLineOption PORT_OPTION { "p", "listening port for socket (defaults to random)", "port", 0 };
 const QCommandLineOption TARGET_OPTION {
     "target", "target for sent packets (default is listen only)",
@@ -56,6 +58,27 @@ const QCommandLineOption MESSAGE_SEED {
 const QCommandLineOption STATS_INTERVAL {
     "stats-interval", "stats output interval (default is 100ms)", "milliseconds"
 };
+const QCommandLineOption CONGESTION_CONTROL {
+    "congestion-control", "congestion control for new connections - vegas or bbr (default is vegas)", "name"
+};
+const QCommandLineOption SIMULATE {
+    "simulate", "compare the goodput of each congestion control over a simulated link, instead of using the network"
+};
+const QCommandLineOption SIMULATED_BANDWIDTH {
+    "sim-bandwidth", "bandwidth of the simulated link (default is 20Mb/s)", "megabits per second"
+};
+const QCommandLineOption SIMULATED_RTT {
+    "sim-rtt", "round-trip propagation delay of the simulated link (default is 50ms)", "milliseconds"
+};
+const QCommandLineOption SIMULATED_LOSS {
+    "sim-loss", "random packet loss on the simulated link (default is 1%)", "percent"
+};
+const QCommandLineOption SIMULATED_QUEUE {
+    "sim-queue", "queue size at the simulated bottleneck (default is one bandwidth-delay product)", "packets"
+};
+const QCommandLineOption SIMULATED_DURATION {
+    "sim-duration", "length of each simulated transfer (default is 10s)", "seconds"
+};
 
 const QStringList CLIENT_STATS_TABLE_HEADERS {
     "Send (Mb/s)", "Est. Max (Mb/s)", "RTT (ms)", "CW (P)", "Period (us)",
@@ -71,6 +94,18 @@ UDTTest::UDTTest(int& argc, char** argv) :
     QCoreApplication(argc, argv)
 {
     parseArguments();
+
+    if (_argumentParser.isSet(SIMULATE)) {
+        runSimulations();
+        QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        return;
+    }
+
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        if (!_socket.setCongestionControl(_argumentParser.value(CONGESTION_CONTROL))) {
+            QMetaObject::invokeMethod(this, "quit", Qt::QueuedConnection);
+        }
+    }
     
     // randomize the seed for packet size randomization
     srand(time(NULL));
@@ -225,7 +260,8 @@ void UDTTest::parseArguments() {
     _argumentParser.addOptions({
         PORT_OPTION, TARGET_OPTION, PACKET_SIZE, MIN_PACKET_SIZE, MAX_PACKET_SIZE,
         MAX_SEND_BYTES, MAX_SEND_PACKETS, UNRELIABLE_PACKETS, ORDERED_PACKETS,
-        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL
+        MESSAGE_SIZE, MESSAGE_SEED, STATS_INTERVAL, CONGESTION_CONTROL, SIMULATE, SIMULATED_BANDWIDTH,
+        SIMULATED_RTT, SIMULATED_LOSS, SIMULATED_QUEUE, SIMULATED_DURATION
     });
     
     if (!_argumentParser.parse(arguments())) {
@@ -240,6 +276,71 @@ void UDTTest::parseArguments() {
     }
 }
 
+void UDTTest::runSimulations() {
+    static const double PERCENT = 100.0;
+
+    LinkSimulation::Parameters parameters;
+    parameters.lossRate = 0.01;
+
+    if (_argumentParser.isSet(SIMULATED_BANDWIDTH)) {
+        parameters.bandwidth = _argumentParser.value(SIMULATED_BANDWIDTH).toDouble();
+    }
+    if (_argumentParser.isSet(SIMULATED_RTT)) {
+        parameters.rtt = _argumentParser.value(SIMULATED_RTT).toInt();
+    }
+    if (_argumentParser.isSet(SIMULATED_LOSS)) {
+        parameters.lossRate = _argumentParser.value(SIMULATED_LOSS).toDouble() / PERCENT;
+    }
+    if (_argumentParser.isSet(SIMULATED_QUEUE)) {
+        parameters.queueSize = _argumentParser.value(SIMULATED_QUEUE).toInt();
+    }
+    if (_argumentParser.isSet(SIMULATED_DURATION)) {
+        parameters.duration = _argumentParser.value(SIMULATED_DURATION).toInt();
+    }
+
+    // run the controls given on the command line, or compare the default one against the alternative
+    QStringList names { "vegas", "bbr" };
+    if (_argumentParser.isSet(CONGESTION_CONTROL)) {
+        names = _argumentParser.value(CONGESTION_CONTROL).split(',');
+    }
+
+    qDebug() << "Simulating" << parameters.duration << "s transfers over a" << parameters.bandwidth << "Mb/s link with"
+        << parameters.rtt << "ms RTT and" << parameters.lossRate * PERCENT << "% random loss";
+
+    const QStringList SIMULATION_TABLE_HEADERS {
+        "Control", "Goodput (Mb/s)", "Utilization (%)", "Sent (P)", "Re-sent (P)", "Dropped (P)", "Timeouts",
+        "Queue Delay (ms)"
+    };
+    qDebug() << qPrintable(SIMULATION_TABLE_HEADERS.join(" | "));
+
+    for (auto& name : names) {
+        auto ccFactory = udt::Socket::createCongestionControlFactory(name);
+        if (!ccFactory) {
+            qCritical() << "Unknown congestion control" << name;
+            continue;
+        }
+
+        auto congestionControl = ccFactory->create();
+        auto results = LinkSimulation(parameters).run(*congestionControl);
+
+        int headerIndex = -1;
+
+        QStringList values {
+            name.rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(results.goodput, 'f', 2).rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(results.goodput / parameters.bandwidth * PERCENT, 'f', 1)
+                .rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(results.sentPackets).rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(results.resentPackets).rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(results.droppedPackets).rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(results.timeouts).rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size()),
+            QString::number(results.averageQueueDelay, 'f', 2).rightJustified(SIMULATION_TABLE_HEADERS[++headerIndex].size())
+        };
+
+        qDebug() << qPrintable(values.join(" | "));
+    }
+}
+
 void UDTTest::sendInitialPackets() {
     static const int NUM_INITIAL_PACKETS = 500;
     
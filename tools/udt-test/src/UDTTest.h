@@ -43,6 +43,7 @@ public slots:
 private:
     void parseArguments();
     void handleMessage(std::unique_ptr<Message> message);
+    void runSimulations(); // compares the congestion controls over a simulated link, then we quit
     
     void sendInitialPackets(); // fills the queue with packets to start
     void sendPacket(); // constructs and sends a packet according to the test parameters